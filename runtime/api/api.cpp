@@ -3741,16 +3741,10 @@ cl_int CL_API_CALL clEnqueueSVMMigrateMem(cl_command_queue commandQueue,
 
     for (uint32_t i = 0; i < numSvmPointers; i++) {
         SVMAllocsManager *pSvmAllocMgr = pCommandQueue->getContext().getSVMAllocsManager();
-        GraphicsAllocation *pSvmAlloc = pSvmAllocMgr->getSVMAlloc(svmPointers[i]);
+        GraphicsAllocation *pSvmAlloc = pSvmAllocMgr->getSVMAlloc(svmPointers[i], sizes != nullptr ? sizes[i] : 0);
         if (pSvmAlloc == nullptr) {
             return CL_INVALID_VALUE;
         }
-        if (sizes != nullptr && sizes[i] != 0) {
-            pSvmAlloc = pSvmAllocMgr->getSVMAlloc(reinterpret_cast<void *>((size_t)svmPointers[i] + sizes[i] - 1));
-            if (pSvmAlloc == nullptr) {
-                return CL_INVALID_VALUE;
-            }
-        }
     }
 
     for (uint32_t i = 0; i < numEventsInWaitList; i++) {
@@ -0,0 +1,220 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/aub_mem_dump/aub_compression.h"
+#include <cstring>
+#include <vector>
+
+namespace AubMemDump {
+namespace Lz {
+namespace {
+const uint32_t hashBits = 14;
+const size_t lastLiterals = 8;
+
+inline uint32_t read32(const char *ptr) {
+    uint32_t value;
+    memcpy(&value, ptr, sizeof(value));
+    return value;
+}
+
+inline uint32_t hashSequence(uint32_t sequence) {
+    return (sequence * 2654435761u) >> (32 - hashBits);
+}
+
+inline bool writeLength(char *&dst, const char *dstEnd, size_t length) {
+    while (length >= 255) {
+        if (dst >= dstEnd) {
+            return false;
+        }
+        *dst++ = static_cast<char>(255);
+        length -= 255;
+    }
+    if (dst >= dstEnd) {
+        return false;
+    }
+    *dst++ = static_cast<char>(length);
+    return true;
+}
+
+inline bool readLength(const unsigned char *&src, const unsigned char *srcEnd, size_t &length) {
+    unsigned char value;
+    do {
+        if (src >= srcEnd) {
+            return false;
+        }
+        value = *src++;
+        length += value;
+    } while (value == 255);
+    return true;
+}
+
+bool emitSequence(char *&dst, const char *dstEnd, const char *literals, size_t literalCount, size_t offset, size_t matchLength) {
+    if (dst >= dstEnd) {
+        return false;
+    }
+    auto token = dst++;
+    auto literalNibble = literalCount < 15 ? literalCount : 15;
+    auto matchNibble = 0u;
+    if (literalCount >= 15 && !writeLength(dst, dstEnd, literalCount - 15)) {
+        return false;
+    }
+    if (static_cast<size_t>(dstEnd - dst) < literalCount) {
+        return false;
+    }
+    memcpy(dst, literals, literalCount);
+    dst += literalCount;
+
+    if (matchLength != 0) {
+        if (dstEnd - dst < 2) {
+            return false;
+        }
+        *dst++ = static_cast<char>(offset & 0xFF);
+        *dst++ = static_cast<char>(offset >> 8);
+        auto matchCode = matchLength - minMatch;
+        matchNibble = matchCode < 15 ? static_cast<unsigned int>(matchCode) : 15u;
+        if (matchCode >= 15 && !writeLength(dst, dstEnd, matchCode - 15)) {
+            return false;
+        }
+    }
+    *token = static_cast<char>((literalNibble << 4) | matchNibble);
+    return true;
+}
+} // namespace
+
+size_t getMaxCompressedSize(size_t size) {
+    return size + size / 255 + 16;
+}
+
+size_t compress(const char *src, size_t srcSize, char *dst, size_t dstCapacity) {
+    std::vector<uint32_t> table(1u << hashBits, 0u);
+    auto dstStart = dst;
+    auto dstEnd = dst + dstCapacity;
+    size_t anchor = 0;
+    size_t pos = 0;
+
+    if (srcSize > lastLiterals + minMatch) {
+        auto matchLimit = srcSize - lastLiterals;
+        while (pos + minMatch <= matchLimit) {
+            auto sequence = read32(src + pos);
+            auto &entry = table[hashSequence(sequence)];
+            // entries hold position + 1, 0 marks an empty slot
+            size_t candidate = entry;
+            entry = static_cast<uint32_t>(pos + 1);
+
+            if (candidate == 0 || pos - (candidate - 1) > maxOffset || read32(src + candidate - 1) != sequence) {
+                pos++;
+                continue;
+            }
+            auto matchStart = candidate - 1;
+            auto matchLength = minMatch;
+            while (pos + matchLength < matchLimit && src[matchStart + matchLength] == src[pos + matchLength]) {
+                matchLength++;
+            }
+            if (!emitSequence(dst, dstEnd, src + anchor, pos - anchor, pos - matchStart, matchLength)) {
+                return 0;
+            }
+            pos += matchLength;
+            anchor = pos;
+        }
+    }
+    if (!emitSequence(dst, dstEnd, src + anchor, srcSize - anchor, 0, 0)) {
+        return 0;
+    }
+    return static_cast<size_t>(dst - dstStart);
+}
+
+bool decompress(const char *srcIn, size_t srcSize, char *dst, size_t dstSize) {
+    auto src = reinterpret_cast<const unsigned char *>(srcIn);
+    auto srcEnd = src + srcSize;
+    size_t written = 0;
+
+    while (src < srcEnd) {
+        auto token = *src++;
+        size_t literalCount = token >> 4;
+        if (literalCount == 15 && !readLength(src, srcEnd, literalCount)) {
+            return false;
+        }
+        if (static_cast<size_t>(srcEnd - src) < literalCount || dstSize - written < literalCount) {
+            return false;
+        }
+        memcpy(dst + written, src, literalCount);
+        src += literalCount;
+        written += literalCount;
+
+        if (src == srcEnd) {
+            break;
+        }
+        if (srcEnd - src < 2) {
+            return false;
+        }
+        size_t offset = src[0] | (src[1] << 8);
+        src += 2;
+        size_t matchLength = token & 0xF;
+        if (matchLength == 15 && !readLength(src, srcEnd, matchLength)) {
+            return false;
+        }
+        matchLength += minMatch;
+        if (offset == 0 || offset > written || dstSize - written < matchLength) {
+            return false;
+        }
+        // matches may overlap the bytes they produce
+        for (size_t i = 0; i < matchLength; i++, written++) {
+            dst[written] = dst[written - offset];
+        }
+    }
+    return written == dstSize;
+}
+} // namespace Lz
+
+bool decompressAubStream(std::istream &in, std::ostream &out) {
+    char magic[sizeof(compressedFileMagic)];
+    if (!in.read(magic, sizeof(magic)) || memcmp(magic, compressedFileMagic, sizeof(magic)) != 0) {
+        return false;
+    }
+
+    std::vector<char> stored;
+    std::vector<char> frame;
+    uint32_t frameHeader[2];
+    while (in.read(reinterpret_cast<char *>(frameHeader), sizeof(frameHeader))) {
+        auto uncompressedSize = frameHeader[0];
+        auto storedSize = frameHeader[1] & ~frameStoredRaw;
+
+        stored.resize(storedSize);
+        if (!in.read(stored.data(), storedSize)) {
+            return false;
+        }
+        if (frameHeader[1] & frameStoredRaw) {
+            if (storedSize != uncompressedSize) {
+                return false;
+            }
+            out.write(stored.data(), storedSize);
+            continue;
+        }
+        frame.resize(uncompressedSize);
+        if (!Lz::decompress(stored.data(), storedSize, frame.data(), uncompressedSize)) {
+            return false;
+        }
+        out.write(frame.data(), uncompressedSize);
+    }
+    return in.eof() && in.gcount() == 0 && out.good();
+}
+} // namespace AubMemDump
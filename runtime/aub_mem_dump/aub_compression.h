@@ -0,0 +1,49 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+
+namespace AubMemDump {
+// Byte oriented LZ77 codec used for compressed AUB captures.
+// A block is a sequence of (token, literals, offset, match) groups, the last group carries literals only.
+// Token high nibble holds the literal count, low nibble the match length minus minMatch,
+// a nibble of 15 is followed by extra length bytes, each 255 meaning "continue".
+namespace Lz {
+const size_t minMatch = 4;
+const size_t maxOffset = 0xFFFF;
+
+size_t getMaxCompressedSize(size_t size);
+size_t compress(const char *src, size_t srcSize, char *dst, size_t dstCapacity);
+bool decompress(const char *src, size_t srcSize, char *dst, size_t dstSize);
+} // namespace Lz
+
+// Compressed AUB file: fileMagic followed by frames of
+// { uint32_t uncompressedSize, uint32_t storedSize | frameStoredRaw, data }
+const char compressedFileMagic[8] = {'A', 'U', 'B', 'L', 'Z', '0', '0', '1'};
+const uint32_t frameStoredRaw = 0x80000000u;
+
+bool decompressAubStream(std::istream &in, std::ostream &out);
+} // namespace AubMemDump
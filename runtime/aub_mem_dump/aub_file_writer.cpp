@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/aub_mem_dump/aub_file_writer.h"
+#include "runtime/aub_mem_dump/aub_compression.h"
+#include <algorithm>
+
+namespace AubMemDump {
+
+AubFileWriter::AubFileWriter(std::ofstream &fileHandle, bool compress, size_t bufferSize, size_t numBuffers)
+    : fileHandle(fileHandle), compress(compress), bufferSize(bufferSize), buffers(numBuffers) {
+    for (size_t i = 0; i < numBuffers; i++) {
+        buffers[i].reserve(bufferSize);
+        if (i != currentBuffer) {
+            freeBuffers.push_back(i);
+        }
+    }
+    if (compress) {
+        compressed.resize(Lz::getMaxCompressedSize(bufferSize));
+        fileHandle.write(compressedFileMagic, sizeof(compressedFileMagic));
+    }
+    writerThread = std::thread(&AubFileWriter::run, this);
+}
+
+AubFileWriter::~AubFileWriter() {
+    flush();
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        stopping = true;
+    }
+    pendingCondition.notify_one();
+    writerThread.join();
+}
+
+void AubFileWriter::write(const char *data, size_t size) {
+    bytesSubmitted += size;
+    while (size > 0) {
+        auto &buffer = buffers[currentBuffer];
+        auto toCopy = std::min(size, bufferSize - buffer.size());
+        buffer.insert(buffer.end(), data, data + toCopy);
+        data += toCopy;
+        size -= toCopy;
+        if (buffer.size() == bufferSize) {
+            submitCurrentBuffer();
+        }
+    }
+}
+
+void AubFileWriter::flush() {
+    if (!buffers[currentBuffer].empty()) {
+        submitCurrentBuffer();
+    }
+    std::unique_lock<std::mutex> lock(mtx);
+    freeCondition.wait(lock, [this] { return pendingBuffers.empty() && !writing; });
+    fileHandle.flush();
+}
+
+void AubFileWriter::submitCurrentBuffer() {
+    std::unique_lock<std::mutex> lock(mtx);
+    pendingBuffers.push_back(currentBuffer);
+    pendingCondition.notify_one();
+
+    freeCondition.wait(lock, [this] { return !freeBuffers.empty(); });
+    currentBuffer = freeBuffers.front();
+    freeBuffers.pop_front();
+}
+
+void AubFileWriter::writeBuffer(const std::vector<char> &buffer) {
+    if (!compress) {
+        fileHandle.write(buffer.data(), buffer.size());
+        return;
+    }
+    uint32_t frameHeader[2];
+    frameHeader[0] = static_cast<uint32_t>(buffer.size());
+    auto compressedSize = Lz::compress(buffer.data(), buffer.size(), compressed.data(), compressed.size());
+    if (compressedSize == 0 || compressedSize >= buffer.size()) {
+        frameHeader[1] = static_cast<uint32_t>(buffer.size()) | frameStoredRaw;
+        fileHandle.write(reinterpret_cast<const char *>(frameHeader), sizeof(frameHeader));
+        fileHandle.write(buffer.data(), buffer.size());
+        return;
+    }
+    frameHeader[1] = static_cast<uint32_t>(compressedSize);
+    fileHandle.write(reinterpret_cast<const char *>(frameHeader), sizeof(frameHeader));
+    fileHandle.write(compressed.data(), compressedSize);
+}
+
+void AubFileWriter::run() {
+    std::unique_lock<std::mutex> lock(mtx);
+    while (true) {
+        pendingCondition.wait(lock, [this] { return !pendingBuffers.empty() || stopping; });
+        if (pendingBuffers.empty()) {
+            return;
+        }
+        auto index = pendingBuffers.front();
+        pendingBuffers.pop_front();
+        writing = true;
+        lock.unlock();
+
+        writeBuffer(buffers[index]);
+        buffers[index].clear();
+
+        lock.lock();
+        writing = false;
+        freeBuffers.push_back(index);
+        freeCondition.notify_all();
+    }
+}
+} // namespace AubMemDump
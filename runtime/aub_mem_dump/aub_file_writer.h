@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace AubMemDump {
+// Collects AUB records into large buffers that a dedicated thread writes
+// (optionally compressed) to the file, so submissions don't block on disk I/O.
+// At most numBuffers are in flight - producer waits for a free buffer when the disk lags behind.
+class AubFileWriter {
+  public:
+    static const size_t defaultBufferSize = 8 * 1024 * 1024;
+    static const size_t defaultNumBuffers = 4;
+
+    AubFileWriter(std::ofstream &fileHandle, bool compress, size_t bufferSize = defaultBufferSize, size_t numBuffers = defaultNumBuffers);
+    ~AubFileWriter();
+
+    AubFileWriter(const AubFileWriter &) = delete;
+    AubFileWriter &operator=(const AubFileWriter &) = delete;
+
+    void write(const char *data, size_t size);
+    void flush();
+
+    uint64_t getBytesSubmitted() const {
+        return bytesSubmitted;
+    }
+
+  protected:
+    void submitCurrentBuffer();
+    void writeBuffer(const std::vector<char> &buffer);
+    void run();
+
+    std::ofstream &fileHandle;
+    const bool compress;
+    const size_t bufferSize;
+
+    std::vector<std::vector<char>> buffers;
+    std::vector<char> compressed;
+    size_t currentBuffer = 0;
+    std::deque<size_t> freeBuffers;
+    std::deque<size_t> pendingBuffers;
+    bool writing = false;
+    bool stopping = false;
+    uint64_t bytesSubmitted = 0;
+
+    std::mutex mtx;
+    std::condition_variable pendingCondition;
+    std::condition_variable freeCondition;
+    std::thread writerThread;
+};
+} // namespace AubMemDump
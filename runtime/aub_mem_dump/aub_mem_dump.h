@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017, Intel Corporation
+ * Copyright (c) 2017 - 2018, Intel Corporation
  *
  * Permission is hereby granted, free of charge, to any person obtaining a
  * copy of this software and associated documentation files (the "Software"),
@@ -24,6 +24,7 @@
 #include <cstdio>
 #include <cstdint>
 #include <fstream>
+#include <memory>
 
 #ifndef BIT
 #define BIT(x) (((uint64_t)1) << (x))
@@ -124,7 +125,12 @@ struct AubStream {
     virtual ~AubStream() = default;
 };
 
+class AubFileWriter;
+
 struct AubFileStream : public AubStream {
+    AubFileStream();
+    ~AubFileStream() override;
+
     void open(const char *filePath) override;
     void close() override;
     bool init(uint32_t stepping, uint32_t device) override;
@@ -137,8 +143,11 @@ struct AubFileStream : public AubStream {
     void registerPoll(uint32_t registerOffset, uint32_t mask, uint32_t value, bool pollNotEqual, uint32_t timeoutAction) override;
     MOCKABLE_VIRTUAL void expectMemory(uint64_t physAddress, const void *memory, size_t size);
     MOCKABLE_VIRTUAL bool addComment(const char *message);
+    void write(const char *data, size_t size);
+    void flush();
 
     std::ofstream fileHandle;
+    std::unique_ptr<AubFileWriter> writer;
 };
 
 template <int addressingBits>
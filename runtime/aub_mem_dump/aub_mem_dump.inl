@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017, Intel Corporation
+ * Copyright (c) 2017 - 2018, Intel Corporation
  *
  * Permission is hereby granted, free of charge, to any person obtaining a
  * copy of this software and associated documentation files (the "Software"),
@@ -133,8 +133,19 @@ template <typename Traits>
 void AubDump<Traits>::reserveAddressGGTTAndWriteMmeory(typename Traits::Stream &stream, uintptr_t gfxAddress, const void *memory, uint64_t physAddress, size_t size, size_t offset) {
     auto vmAddr = (gfxAddress + offset) & ~(MemoryConstants::pageSize - 1);
     auto pAddr = physAddress & ~(MemoryConstants::pageSize - 1);
+    // physAddress may start a run of physically contiguous pages, map all of them at once
+    auto vmEnd = (gfxAddress + offset + size + MemoryConstants::pageSize - 1) & ~(MemoryConstants::pageSize - 1);
 
-    AubDump<Traits>::reserveAddressPPGTT(stream, vmAddr, MemoryConstants::pageSize, pAddr);
+    // each PPGTT level is written with a single memory write header, keep the PTE block within its dword count
+    auto sizeMemoryWriteHeader = sizeof(CmdServicesMemTraceMemoryWrite) - sizeof(CmdServicesMemTraceMemoryWrite::data);
+    auto maxPTEs = (g_dwordCountMax * sizeof(uint32_t) - sizeMemoryWriteHeader) / sizeof(uint64_t);
+    auto maxReserveSize = maxPTEs * MemoryConstants::pageSize;
+    while (vmAddr < vmEnd) {
+        auto reserveSize = std::min(static_cast<size_t>(vmEnd - vmAddr), maxReserveSize);
+        AubDump<Traits>::reserveAddressPPGTT(stream, vmAddr, reserveSize, pAddr);
+        vmAddr += reserveSize;
+        pAddr += reserveSize;
+    }
 
     AubDump<Traits>::addMemoryWrite(stream, physAddress,
                                     reinterpret_cast<void *>(reinterpret_cast<uintptr_t>(memory) + offset),
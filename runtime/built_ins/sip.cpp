@@ -83,7 +83,7 @@ SipKernel::SipKernel(SipKernelType type, Program *sipProgram)
 }
 
 GraphicsAllocation *SipKernel::getSipAllocation() const {
-    return program->getKernelInfo(size_t{0})->getGraphicsAllocation();
+    return program->getKernelIsaAllocation(*program->getKernelInfo(size_t{0}));
 }
 
 const char *SipKernel::getBinary() const {
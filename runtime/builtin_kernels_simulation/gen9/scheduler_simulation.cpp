@@ -1,5 +1,5 @@
 /*
-* Copyright (c) 2017, Intel Corporation
+* Copyright (c) 2017 - 2018, Intel Corporation
 *
 * Permission is hereby granted, free of charge, to any person obtaining a
 * copy of this software and associated documentation files (the "Software"),
@@ -62,12 +62,6 @@ void SchedulerSimulation<SKLFamily>::startScheduler(uint32_t index,
                                                     GraphicsAllocation *queueStorageBuffer,
                                                     GraphicsAllocation *ssh,
                                                     GraphicsAllocation *debugQueue) {
-
-    threadIDToLocalIDmap.insert(std::make_pair(std::this_thread::get_id(), index));
-
-    while (!conditionReady) {
-    }
-
     Gen9SchedulerSimulation::SchedulerParallel20((IGIL_CommandQueue *)queue->getUnderlyingBuffer(),
                                                  (uint *)commandsStack->getUnderlyingBuffer(),
                                                  (IGIL_EventPool *)eventsPool->getUnderlyingBuffer(),
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017, Intel Corporation
+ * Copyright (c) 2017 - 2018, Intel Corporation
  *
  * Permission is hereby granted, free of charge, to any person obtaining a
  * copy of this software and associated documentation files (the "Software"),
@@ -30,14 +30,50 @@ namespace BuiltinKernelsSimulation {
 #define SCHEDULER_EMULATION 1
 
 // globals
-std::mutex gMutex;
+std::mutex gAtomicLocks[NUM_OF_ATOMIC_LOCKS];
 unsigned int globalID[3];
 unsigned int localID[3];
 unsigned int localSize[3];
+unsigned int numOfGroups = 1;
 
-std::map<std::thread::id, uint32_t> threadIDToLocalIDmap;
+std::vector<std::unique_ptr<SynchronizationBarrier>> groupBarriers;
 
-SynchronizationBarrier *pGlobalBarrier = nullptr;
+thread_local bool isSimulationThread = false;
+thread_local uint32_t simulationGlobalID = 0;
+
+void runOnHostThreads(uint32_t groups, const std::function<void(uint32_t)> &workItem) {
+    numOfGroups = groups;
+    localSize[0] = NUM_OF_THREADS;
+    localSize[1] = 1;
+    localSize[2] = 1;
+
+    groupBarriers.clear();
+    for (uint32_t i = 0; i < groups; i++) {
+        groupBarriers.emplace_back(new SynchronizationBarrier(NUM_OF_THREADS));
+    }
+
+    auto runWorkItem = [&workItem](uint32_t id) {
+        isSimulationThread = true;
+        simulationGlobalID = id;
+        workItem(id);
+        isSimulationThread = false;
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(groups * NUM_OF_THREADS);
+    for (uint32_t i = 1; i < groups * NUM_OF_THREADS; i++) {
+        threads.emplace_back(runWorkItem, i);
+    }
+
+    runWorkItem(0);
+
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    groupBarriers.clear();
+    numOfGroups = 1;
+}
 
 uint4 operator+(uint4 const &a, uint4 const &b) {
     uint4 c(0, 0, 0, 0);
@@ -61,9 +97,8 @@ uint get_local_id(int dim) {
     uint LID = 0;
 
     // use thread id
-    if (threadIDToLocalIDmap.size() > 0) {
-        std::thread::id id = std::this_thread::get_id();
-        LID = threadIDToLocalIDmap[id] % 24;
+    if (isSimulationThread) {
+        LID = simulationGlobalID % NUM_OF_THREADS;
     }
     // use id from loop iteration
     else {
@@ -76,9 +111,8 @@ uint get_global_id(int dim) {
     uint GID = 0;
 
     // use thread id
-    if (threadIDToLocalIDmap.size() > 0) {
-        std::thread::id id = std::this_thread::get_id();
-        GID = threadIDToLocalIDmap[id];
+    if (isSimulationThread) {
+        GID = simulationGlobalID;
     }
     // use id from loop iteration
     else {
@@ -92,15 +126,15 @@ uint get_local_size(int dim) {
 }
 
 uint get_num_groups(int dim) {
-    return NUM_OF_THREADS / 24;
+    return numOfGroups;
 }
 
 uint get_group_id(int dim) {
-    return get_global_id(dim) / 24;
+    return get_global_id(dim) / NUM_OF_THREADS;
 }
 
 void barrier(int x) {
-    pGlobalBarrier->enter();
+    groupBarriers[get_group_id(0)]->enter();
 
     // int LID = get_local_id(0);
     volatile int BreakPointHere = 0;
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017, Intel Corporation
+ * Copyright (c) 2017 - 2018, Intel Corporation
  *
  * Permission is hereby granted, free of charge, to any person obtaining a
  * copy of this software and associated documentation files (the "Software"),
@@ -23,8 +23,10 @@
 #pragma once
 #include <mutex>
 #include <condition_variable>
-#include <map>
+#include <functional>
+#include <memory>
 #include <thread>
+#include <vector>
 #include <string.h>
 #include <cstdint>
 
@@ -38,6 +40,10 @@ namespace BuiltinKernelsSimulation {
 
 // number of threads in wkg
 #define NUM_OF_THREADS 24
+// max number of wkgs run concurrently, matches PARALLEL_SCHEDULER_HW_GROUPS
+#define MAX_NUM_OF_GROUPS 8
+// number of locks guarding emulated atomics, picked by address
+#define NUM_OF_ATOMIC_LOCKS 64
 
 #define CLK_GLOBAL_MEM_FENCE 1
 #define CLK_LOCAL_MEM_FENCE 2
@@ -79,12 +85,24 @@ class SynchronizationBarrier {
 };
 
 // globals
-extern std::mutex gMutex;
+extern std::mutex gAtomicLocks[NUM_OF_ATOMIC_LOCKS];
 extern unsigned int globalID[3];
 extern unsigned int localID[3];
 extern unsigned int localSize[3];
-extern std::map<std::thread::id, uint32_t> threadIDToLocalIDmap;
-extern SynchronizationBarrier *pGlobalBarrier;
+extern unsigned int numOfGroups;
+extern std::vector<std::unique_ptr<SynchronizationBarrier>> groupBarriers;
+
+// set on host threads spawned by runOnHostThreads, otherwise ids come from globalID / localID
+extern thread_local bool isSimulationThread;
+extern thread_local uint32_t simulationGlobalID;
+
+// Runs workItem on groups * NUM_OF_THREADS host threads, one per work item.
+// Calling thread executes work item with global id 0 and returns when all work items are done.
+void runOnHostThreads(uint32_t groups, const std::function<void(uint32_t)> &workItem);
+
+inline std::mutex &getAtomicLock(const volatile void *address) {
+    return gAtomicLocks[(reinterpret_cast<uintptr_t>(address) / sizeof(uint32_t)) % NUM_OF_ATOMIC_LOCKS];
+}
 
 typedef struct taguint2 {
     taguint2(uint x, uint y) {
@@ -241,6 +259,27 @@ uint get_local_size(int dim);
 uint get_num_groups(int dim);
 uint get_group_id(int dim);
 void barrier(int x);
+
+// __local variable, each wkg gets its own copy
+template <typename TYPE>
+struct GroupLocal {
+    TYPE &get() {
+        return storage[get_group_id(0)];
+    }
+    operator TYPE &() {
+        return get();
+    }
+    TYPE *operator&() {
+        return &get();
+    }
+    GroupLocal &operator=(const TYPE &value) {
+        get() = value;
+        return *this;
+    }
+
+    TYPE storage[MAX_NUM_OF_GROUPS];
+};
+
 uint4 read_imageui(image *im, int4 coord);
 uint4 write_imageui(image *im, uint4 coord, uint4 color);
 uchar convert_uchar_sat(uint c);
@@ -250,55 +289,53 @@ ushort convert_ushort_sat(uint c);
     uint __LOCAL_ID__ = 0;         \
     __LOCAL_ID__ = get_local_id(0);
 
+// work items outnumber host cores, give up time slice while spinning on global memory
+#define EMULATION_SPIN_WAIT() \
+    std::this_thread::yield();
+
 template <class TYPE, class TYPE2>
 void atomic_xchg(TYPE *dest, TYPE2 val) {
-    gMutex.lock();
+    std::lock_guard<std::mutex> lock(getAtomicLock(dest));
     dest[0] = (TYPE)val;
-    gMutex.unlock();
 }
 
 template <class TYPE, class TYPE2>
 TYPE atomic_add(TYPE *first, TYPE2 second) {
-    gMutex.lock();
+    std::lock_guard<std::mutex> lock(getAtomicLock(first));
     TYPE temp = first[0];
     first[0] = (TYPE)(temp + (TYPE)second);
-    gMutex.unlock();
     return temp;
 }
 
 template <class TYPE, class TYPE2>
 TYPE atomic_sub(TYPE *first, TYPE2 second) {
-    gMutex.lock();
+    std::lock_guard<std::mutex> lock(getAtomicLock(first));
     TYPE temp = first[0];
     first[0] = temp - second;
-    gMutex.unlock();
     return temp;
 }
 
 template <class TYPE>
 TYPE atomic_inc(TYPE *first) {
-    gMutex.lock();
+    std::lock_guard<std::mutex> lock(getAtomicLock(first));
     TYPE temp = first[0];
     first[0] = temp + 1;
-    gMutex.unlock();
     return temp;
 }
 
 template <class TYPE>
 TYPE atomic_dec(TYPE *first) {
-    gMutex.lock();
+    std::lock_guard<std::mutex> lock(getAtomicLock(first));
     TYPE temp = first[0];
     first[0] = temp - 1;
-    gMutex.unlock();
     return temp;
 }
 
 template <class TYPE, class TYPE2>
 TYPE atomic_min(TYPE *first, TYPE2 second) {
-    gMutex.lock();
+    std::lock_guard<std::mutex> lock(getAtomicLock(first));
     TYPE temp = first[0];
     first[0] = (TYPE)((TYPE)second < temp ? (TYPE)second : temp);
-    gMutex.unlock();
     return temp;
 }
 }
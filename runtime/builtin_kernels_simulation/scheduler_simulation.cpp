@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017, Intel Corporation
+ * Copyright (c) 2017 - 2018, Intel Corporation
  *
  * Permission is hereby granted, free of charge, to any person obtaining a
  * copy of this software and associated documentation files (the "Software"),
@@ -21,16 +21,108 @@
  */
 
 #include "runtime/builtin_kernels_simulation/scheduler_simulation.h"
+#include "runtime/builtin_kernels_simulation/scheduler_simulation_replay.h"
 #include "runtime/builtin_kernels_simulation/opencl_c.h"
+#include "runtime/execution_model/device_enqueue.h"
+#include "runtime/helpers/file_io.h"
+#include "runtime/helpers/string.h"
 
-#include <thread>
-
-using namespace std;
 using namespace OCLRT;
 
 namespace BuiltinKernelsSimulation {
 
-bool conditionReady = false;
-std::thread threads[NUM_OF_THREADS];
+const uint32_t SchedulerSimulationRecord::fileMagic = 0x52534353; // "SCSR"
+const uint32_t SchedulerSimulationRecord::fileVersion = 1;
+
+void SchedulerSimulationRecord::capture(GraphicsAllocation *queue,
+                                        GraphicsAllocation *commandsStack,
+                                        GraphicsAllocation *eventsPool,
+                                        GraphicsAllocation *secondaryBatchBuffer,
+                                        GraphicsAllocation *dsh,
+                                        GraphicsAllocation *reflectionSurface,
+                                        GraphicsAllocation *queueStorageBuffer,
+                                        GraphicsAllocation *ssh) {
+    GraphicsAllocation *allocations[NumSurfaces] = {queue, commandsStack, eventsPool, secondaryBatchBuffer, dsh, reflectionSurface, queueStorageBuffer, ssh};
+
+    for (uint32_t i = 0; i < NumSurfaces; i++) {
+        surfaces[i].clear();
+        if (allocations[i] != nullptr) {
+            auto data = reinterpret_cast<const char *>(allocations[i]->getUnderlyingBuffer());
+            surfaces[i].assign(data, data + allocations[i]->getUnderlyingBufferSize());
+        }
+    }
+}
+
+bool SchedulerSimulationRecord::saveToFile(const char *filename) const {
+    std::vector<char> file;
+    auto append = [&file](const void *data, size_t size) {
+        auto bytes = reinterpret_cast<const char *>(data);
+        file.insert(file.end(), bytes, bytes + size);
+    };
+
+    uint32_t header[] = {fileMagic, fileVersion, NumSurfaces};
+    append(header, sizeof(header));
+    for (uint32_t i = 0; i < NumSurfaces; i++) {
+        uint64_t size = surfaces[i].size();
+        append(&size, sizeof(size));
+        append(surfaces[i].data(), surfaces[i].size());
+    }
+
+    return writeDataToFile(filename, file.data(), file.size()) == file.size();
+}
+
+bool SchedulerSimulationRecord::loadFromFile(const char *filename) {
+    void *data = nullptr;
+    size_t fileSize = loadDataFromFile(filename, data);
+    auto file = reinterpret_cast<const char *>(data);
+    size_t offset = 0;
+
+    auto read = [&](void *dst, size_t size) -> bool {
+        if (fileSize - offset < size) {
+            return false;
+        }
+        memcpy_s(dst, size, file + offset, size);
+        offset += size;
+        return true;
+    };
+
+    uint32_t header[3] = {};
+    bool success = read(header, sizeof(header)) && (header[0] == fileMagic) && (header[1] == fileVersion) && (header[2] == NumSurfaces);
+
+    for (uint32_t i = 0; success && i < NumSurfaces; i++) {
+        uint64_t size = 0;
+        success = read(&size, sizeof(size)) && (fileSize - offset >= size);
+        if (success) {
+            surfaces[i].assign(file + offset, file + offset + static_cast<size_t>(size));
+            offset += static_cast<size_t>(size);
+        }
+    }
+
+    if (!success) {
+        for (auto &surface : surfaces) {
+            surface.clear();
+        }
+    }
+
+    deleteDataReadFromFile(data);
+    return success;
+}
+
+uint32_t SchedulerSimulationRecord::getPendingBlocks() const {
+    if (surfaces[Queue].size() < sizeof(IGIL_CommandQueue)) {
+        return 0;
+    }
+    auto igilQueue = reinterpret_cast<const IGIL_CommandQueue *>(surfaces[Queue].data());
+    return igilQueue->m_controls.m_TotalNumberOfQueues - igilQueue->m_controls.m_PreviousNumberOfQueues;
+}
+
+bool SchedulerSimulationRecord::isValid() const {
+    for (auto &surface : surfaces) {
+        if (surface.empty()) {
+            return false;
+        }
+    }
+    return true;
+}
 
 } // namespace BuiltinKernelsSimulation
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017, Intel Corporation
+ * Copyright (c) 2017 - 2018, Intel Corporation
  *
  * Permission is hereby granted, free of charge, to any person obtaining a
  * copy of this software and associated documentation files (the "Software"),
@@ -21,7 +21,6 @@
  */
 #pragma once
 #include <cstdint>
-#include <thread>
 
 #include "runtime/builtin_kernels_simulation/opencl_c.h"
 namespace OCLRT {
@@ -30,9 +29,6 @@ class GraphicsAllocation;
 
 namespace BuiltinKernelsSimulation {
 
-extern bool conditionReady;
-extern std::thread threads[];
-
 template <typename GfxFamily>
 class SchedulerSimulation {
   public:
@@ -46,7 +42,9 @@ class SchedulerSimulation {
                                 OCLRT::GraphicsAllocation *ssh,
                                 OCLRT::GraphicsAllocation *debugQueue);
 
-    void cleanSchedulerSimulation();
+    // Number of wkgs of NUM_OF_THREADS work items run concurrently, clamped to 1..MAX_NUM_OF_GROUPS
+    void setNumberOfGroups(uint32_t groups);
+    uint32_t getNumberOfGroups() const { return numberOfGroups; }
 
     static void startScheduler(uint32_t index,
                                OCLRT::GraphicsAllocation *queue,
@@ -59,16 +57,6 @@ class SchedulerSimulation {
                                OCLRT::GraphicsAllocation *ssh,
                                OCLRT::GraphicsAllocation *debugQueue);
 
-    void initializeSchedulerSimulation(OCLRT::GraphicsAllocation *queue,
-                                       OCLRT::GraphicsAllocation *commandsStack,
-                                       OCLRT::GraphicsAllocation *eventsPool,
-                                       OCLRT::GraphicsAllocation *secondaryBatchBuffer,
-                                       OCLRT::GraphicsAllocation *dsh,
-                                       OCLRT::GraphicsAllocation *reflectionSurface,
-                                       OCLRT::GraphicsAllocation *queueStorageBuffer,
-                                       OCLRT::GraphicsAllocation *ssh,
-                                       OCLRT::GraphicsAllocation *debugQueue);
-
     static void patchGpGpuWalker(uint secondLevelBatchOffset,
                                  __global uint *secondaryBatchBuffer,
                                  uint interfaceDescriptorOffset,
@@ -81,6 +69,9 @@ class SchedulerSimulation {
                                  uint ioHoffset);
     static bool enabled;
     static bool simulationRun;
+
+  protected:
+    uint32_t numberOfGroups = 1;
 };
 
 template <typename GfxFamily>
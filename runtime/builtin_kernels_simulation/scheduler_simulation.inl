@@ -1,5 +1,5 @@
 /*
-* Copyright (c) 2017, Intel Corporation
+* Copyright (c) 2017 - 2018, Intel Corporation
 *
 * Permission is hereby granted, free of charge, to any person obtaining a
 * copy of this software and associated documentation files (the "Software"),
@@ -22,46 +22,22 @@
 
 #include "runtime/memory_manager/graphics_allocation.h"
 #include "runtime/builtin_kernels_simulation/scheduler_simulation.h"
+#include "runtime/execution_model/device_enqueue.h"
 
+#include <algorithm>
 #include <cstdint>
-#include <mutex>
-#include <thread>
 
 using namespace std;
 using namespace OCLRT;
 
 namespace BuiltinKernelsSimulation {
 
-template <typename GfxFamily>
-void SchedulerSimulation<GfxFamily>::cleanSchedulerSimulation() {
-    threadIDToLocalIDmap.clear();
-    delete pGlobalBarrier;
-}
+static_assert(MAX_NUM_OF_GROUPS == PARALLEL_SCHEDULER_HW_GROUPS, "simulation must be able to run all scheduler HW groups");
+static_assert(NUM_OF_THREADS == PARALLEL_SCHEDULER_HWTHREADS_IN_HW_GROUP20 * PARALLEL_SCHEDULER_COMPILATION_SIZE_20, "simulation wkg must match scheduler wkg");
 
 template <typename GfxFamily>
-void SchedulerSimulation<GfxFamily>::initializeSchedulerSimulation(GraphicsAllocation *queue,
-                                                                   GraphicsAllocation *commandsStack,
-                                                                   GraphicsAllocation *eventsPool,
-                                                                   GraphicsAllocation *secondaryBatchBuffer,
-                                                                   GraphicsAllocation *dsh,
-                                                                   GraphicsAllocation *reflectionSurface,
-                                                                   GraphicsAllocation *queueStorageBuffer,
-                                                                   GraphicsAllocation *ssh,
-                                                                   GraphicsAllocation *debugQueue) {
-
-    localSize[0] = NUM_OF_THREADS;
-    localSize[1] = 1;
-    localSize[2] = 1;
-
-    threadIDToLocalIDmap.clear();
-    pGlobalBarrier = new SynchronizationBarrier(NUM_OF_THREADS);
-
-    // Spawn Thread ID == 0 on main thread
-    for (uint32_t i = 1; i < NUM_OF_THREADS; i++) {
-        threads[i] = std::thread(startScheduler, i, queue, commandsStack, eventsPool, secondaryBatchBuffer, dsh, reflectionSurface, queueStorageBuffer, ssh, debugQueue);
-    }
-
-    conditionReady = true;
+void SchedulerSimulation<GfxFamily>::setNumberOfGroups(uint32_t groups) {
+    numberOfGroups = std::min(std::max(groups, 1u), static_cast<uint32_t>(MAX_NUM_OF_GROUPS));
 }
 
 template <typename GfxFamily>
@@ -76,36 +52,19 @@ void SchedulerSimulation<GfxFamily>::runSchedulerSimulation(GraphicsAllocation *
                                                             GraphicsAllocation *debugQueue) {
     simulationRun = true;
     if (enabled) {
-        initializeSchedulerSimulation(queue,
-                                      commandsStack,
-                                      eventsPool,
-                                      secondaryBatchBuffer,
-                                      dsh,
-                                      reflectionSurface,
-                                      queueStorageBuffer,
-                                      ssh,
-                                      debugQueue);
-
-        // start main thread with LID == 0
-        startScheduler(0,
-                       queue,
-                       commandsStack,
-                       eventsPool,
-                       secondaryBatchBuffer,
-                       dsh,
-                       reflectionSurface,
-                       queueStorageBuffer,
-                       ssh,
-                       debugQueue);
-
-        // Wait for all threads on main thread
-        if (threadIDToLocalIDmap[std::this_thread::get_id()] == 0) {
-
-            for (uint32_t i = 1; i < NUM_OF_THREADS; i++)
-                threads[i].join();
-
-            cleanSchedulerSimulation();
-        }
+        // every work item of every HW group runs on its own host thread, main thread runs global id 0
+        runOnHostThreads(numberOfGroups, [&](uint32_t index) {
+            startScheduler(index,
+                           queue,
+                           commandsStack,
+                           eventsPool,
+                           secondaryBatchBuffer,
+                           dsh,
+                           reflectionSurface,
+                           queueStorageBuffer,
+                           ssh,
+                           debugQueue);
+        });
     }
 };
 
@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+#include "runtime/builtin_kernels_simulation/scheduler_simulation.h"
+#include "runtime/helpers/aligned_memory.h"
+#include "runtime/helpers/string.h"
+#include "runtime/memory_manager/graphics_allocation.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace BuiltinKernelsSimulation {
+
+// Copy of device queue surfaces taken right before scheduler runs.
+// Replaying it runs the same scheduler pass again on host threads, without a GPU.
+class SchedulerSimulationRecord {
+  public:
+    enum Surface : uint32_t {
+        Queue = 0,
+        CommandsStack,
+        EventsPool,
+        SecondaryBatchBuffer,
+        Dsh,
+        ReflectionSurface,
+        QueueStorageBuffer,
+        Ssh,
+        NumSurfaces
+    };
+
+    static const uint32_t fileMagic;
+    static const uint32_t fileVersion;
+
+    void capture(OCLRT::GraphicsAllocation *queue,
+                 OCLRT::GraphicsAllocation *commandsStack,
+                 OCLRT::GraphicsAllocation *eventsPool,
+                 OCLRT::GraphicsAllocation *secondaryBatchBuffer,
+                 OCLRT::GraphicsAllocation *dsh,
+                 OCLRT::GraphicsAllocation *reflectionSurface,
+                 OCLRT::GraphicsAllocation *queueStorageBuffer,
+                 OCLRT::GraphicsAllocation *ssh);
+
+    bool saveToFile(const char *filename) const;
+    bool loadFromFile(const char *filename);
+
+    // Number of blocks enqueued on device since previous scheduler pass
+    uint32_t getPendingBlocks() const;
+
+    bool isValid() const;
+
+    const std::vector<char> &getSurface(Surface surface) const { return surfaces[surface]; }
+
+  protected:
+    std::vector<char> surfaces[NumSurfaces];
+};
+
+struct SchedulerSimulationStats {
+    uint64_t schedulerRuns = 0;
+    uint64_t blocksScheduled = 0;
+    double seconds = 0.0;
+
+    double getBlocksPerSecond() const {
+        return seconds > 0.0 ? static_cast<double>(blocksScheduled) / seconds : 0.0;
+    }
+};
+
+template <typename GfxFamily>
+class SchedulerSimulationReplay {
+  public:
+    SchedulerSimulationReplay(const SchedulerSimulationRecord &record) : record(record) {
+        for (uint32_t i = 0; i < SchedulerSimulationRecord::NumSurfaces; i++) {
+            auto &surface = record.getSurface(static_cast<SchedulerSimulationRecord::Surface>(i));
+            auto size = std::max(surface.size(), static_cast<size_t>(MemoryConstants::cacheLineSize));
+            memory[i] = alignedMalloc(size, MemoryConstants::pageSize);
+            allocations[i].reset(new OCLRT::GraphicsAllocation(memory[i], size));
+        }
+    }
+
+    ~SchedulerSimulationReplay() {
+        for (uint32_t i = 0; i < SchedulerSimulationRecord::NumSurfaces; i++) {
+            allocations[i].reset();
+            alignedFree(memory[i]);
+        }
+    }
+
+    // Runs recorded scheduler pass iterations times on groups HW groups,
+    // surfaces are restored from record before every run and restoring is not timed
+    SchedulerSimulationStats replay(uint32_t iterations, uint32_t groups) {
+        SchedulerSimulationStats stats;
+        SchedulerSimulation<GfxFamily> simulation;
+        simulation.setNumberOfGroups(groups);
+
+        for (uint32_t i = 0; i < iterations; i++) {
+            restore();
+
+            auto start = std::chrono::high_resolution_clock::now();
+            simulation.runSchedulerSimulation(allocations[SchedulerSimulationRecord::Queue].get(),
+                                              allocations[SchedulerSimulationRecord::CommandsStack].get(),
+                                              allocations[SchedulerSimulationRecord::EventsPool].get(),
+                                              allocations[SchedulerSimulationRecord::SecondaryBatchBuffer].get(),
+                                              allocations[SchedulerSimulationRecord::Dsh].get(),
+                                              allocations[SchedulerSimulationRecord::ReflectionSurface].get(),
+                                              allocations[SchedulerSimulationRecord::QueueStorageBuffer].get(),
+                                              allocations[SchedulerSimulationRecord::Ssh].get(),
+                                              nullptr);
+            auto end = std::chrono::high_resolution_clock::now();
+
+            stats.schedulerRuns++;
+            stats.blocksScheduled += record.getPendingBlocks();
+            stats.seconds += std::chrono::duration<double>(end - start).count();
+        }
+        return stats;
+    }
+
+    OCLRT::GraphicsAllocation *getAllocation(SchedulerSimulationRecord::Surface surface) const {
+        return allocations[surface].get();
+    }
+
+  protected:
+    void restore() {
+        for (uint32_t i = 0; i < SchedulerSimulationRecord::NumSurfaces; i++) {
+            auto &surface = record.getSurface(static_cast<SchedulerSimulationRecord::Surface>(i));
+            memset(memory[i], 0, allocations[i]->getUnderlyingBufferSize());
+            if (!surface.empty()) {
+                memcpy_s(memory[i], allocations[i]->getUnderlyingBufferSize(), surface.data(), surface.size());
+            }
+        }
+    }
+
+    const SchedulerSimulationRecord &record;
+    void *memory[SchedulerSimulationRecord::NumSurfaces];
+    std::unique_ptr<OCLRT::GraphicsAllocation> allocations[SchedulerSimulationRecord::NumSurfaces];
+};
+
+} // namespace BuiltinKernelsSimulation
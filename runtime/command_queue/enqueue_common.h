@@ -22,6 +22,7 @@
 
 #pragma once
 #include "runtime/builtin_kernels_simulation/scheduler_simulation.h"
+#include "runtime/builtin_kernels_simulation/scheduler_simulation_replay.h"
 #include "hw_cmds.h"
 #include "runtime/command_queue/command_queue_hw.h"
 #include "runtime/command_queue/dispatch_walker.h"
@@ -341,7 +342,21 @@ void CommandQueueHw<GfxFamily>::enqueueHandler(Surface **surfacesForResidency,
                 if (devQueueHw->getSchedulerReturnInstance() > 0) {
                     waitUntilComplete(completionStamp.taskCount, completionStamp.flushStamp, false);
 
+                    if (DebugManager.flags.SchedulerSimulationRecordFile.get() != "unk") {
+                        BuiltinKernelsSimulation::SchedulerSimulationRecord record;
+                        record.capture(devQueueHw->getQueueBuffer(),
+                                       devQueueHw->getStackBuffer(),
+                                       devQueueHw->getEventPoolBuffer(),
+                                       devQueueHw->getSlbBuffer(),
+                                       devQueueHw->getDshBuffer(),
+                                       multiDispatchInfo.begin()->getKernel()->getKernelReflectionSurface(),
+                                       devQueueHw->getQueueStorageBuffer(),
+                                       this->getIndirectHeap(IndirectHeap::SURFACE_STATE).getGraphicsAllocation());
+                        record.saveToFile(DebugManager.flags.SchedulerSimulationRecordFile.get().c_str());
+                    }
+
                     BuiltinKernelsSimulation::SchedulerSimulation<GfxFamily> simulation;
+                    simulation.setNumberOfGroups(static_cast<uint32_t>(DebugManager.flags.SchedulerSimulationHwGroups.get()));
                     simulation.runSchedulerSimulation(devQueueHw->getQueueBuffer(),
                                                       devQueueHw->getStackBuffer(),
                                                       devQueueHw->getEventPoolBuffer(),
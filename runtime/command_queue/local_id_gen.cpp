@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017, Intel Corporation
+ * Copyright (c) 2017 - 2018, Intel Corporation
  *
  * Permission is hereby granted, free of charge, to any person obtaining a
  * copy of this software and associated documentation files (the "Software"),
@@ -22,17 +22,20 @@
 
 #include "runtime/command_queue/local_id_gen.h"
 #include "runtime/helpers/aligned_memory.h"
+#include "runtime/os_interface/debug_settings_manager.h"
 #include "runtime/utilities/cpu_info.h"
+#include <cstring>
 
 namespace OCLRT {
 
 struct uint16x8_t;
 struct uint16x16_t;
+struct uint16x32_t;
 
 // This is the initial value of SIMD for local ID
 // computation.  It correlates to the SIMD lane.
-// Must be 32byte aligned for AVX2 usage
-ALIGNAS(32)
+// Must be 64byte aligned for AVX-512 usage
+ALIGNAS(64)
 const uint16_t initialLocalID[] = {
     0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
     16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31};
@@ -50,13 +53,68 @@ LocalIDHelper::LocalIDHelper() {
         LocalIDHelper::generateSimd16 = generateLocalIDsSimd<uint16x16_t, 16>;
         LocalIDHelper::generateSimd32 = generateLocalIDsSimd<uint16x16_t, 32>;
     }
+    // only SIMD32 fills a whole 512-bit register, narrower kernels keep AVX2/SSE4 paths
+    bool supportsAVX512BW = CpuInfo::getInstance().isFeatureSupported(CpuInfo::featureAvX512Bw);
+    if (supportsAVX512BW) {
+        LocalIDHelper::generateSimd32 = generateLocalIDsSimd<uint16x32_t, 32>;
+    }
 }
 
 LocalIDHelper LocalIDHelper::initializer;
 
-//traditional function to generate local IDs
-void generateLocalIDs(void *buffer, uint32_t simd, size_t lwsX, size_t lwsY, size_t lwsZ) {
-    auto threadsPerWorkGroup = getThreadsPerWG(simd, lwsX * lwsY * lwsZ);
+const size_t LocalIDCache::maxEntries;
+
+LocalIDCache &LocalIDCache::getInstance() {
+    static LocalIDCache instance;
+    return instance;
+}
+
+bool LocalIDCache::copyIfCached(void *buffer, uint32_t simd, size_t lwsX, size_t lwsY, size_t threadsPerWorkGroup, size_t size) {
+    std::shared_ptr<const std::vector<uint8_t>> data;
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        for (auto &entry : entries) {
+            if (entry.simd == simd && entry.lwsX == lwsX && entry.lwsY == lwsY && entry.threadsPerWorkGroup == threadsPerWorkGroup) {
+                entry.lastUse = ++useCounter;
+                data = entry.data;
+                break;
+            }
+        }
+    }
+    if (!data || data->size() != size) {
+        misses++;
+        return false;
+    }
+    hits++;
+    memcpy(buffer, data->data(), size);
+    return true;
+}
+
+void LocalIDCache::store(const void *buffer, uint32_t simd, size_t lwsX, size_t lwsY, size_t threadsPerWorkGroup, size_t size) {
+    auto bytes = reinterpret_cast<const uint8_t *>(buffer);
+    std::shared_ptr<const std::vector<uint8_t>> data(new std::vector<uint8_t>(bytes, bytes + size));
+
+    std::lock_guard<std::mutex> lock(mtx);
+    Entry newEntry = {simd, lwsX, lwsY, threadsPerWorkGroup, ++useCounter, data};
+    if (entries.size() < maxEntries) {
+        entries.push_back(newEntry);
+        return;
+    }
+    auto leastRecentlyUsed = std::min_element(entries.begin(), entries.end(), [](const Entry &a, const Entry &b) { return a.lastUse < b.lastUse; });
+    *leastRecentlyUsed = newEntry;
+}
+
+void LocalIDCache::clear() {
+    std::lock_guard<std::mutex> lock(mtx);
+    entries.clear();
+}
+
+size_t LocalIDCache::peekNumEntries() {
+    std::lock_guard<std::mutex> lock(mtx);
+    return entries.size();
+}
+
+void generateLocalIDsUncached(void *buffer, uint32_t simd, size_t lwsX, size_t lwsY, size_t threadsPerWorkGroup) {
     if (simd == 32) {
         LocalIDHelper::generateSimd32(buffer, lwsX, lwsY, threadsPerWorkGroup);
     } else if (simd == 16) {
@@ -65,4 +123,21 @@ void generateLocalIDs(void *buffer, uint32_t simd, size_t lwsX, size_t lwsY, siz
         LocalIDHelper::generateSimd8(buffer, lwsX, lwsY, threadsPerWorkGroup);
     }
 }
+
+//traditional function to generate local IDs
+void generateLocalIDs(void *buffer, uint32_t simd, size_t lwsX, size_t lwsY, size_t lwsZ) {
+    auto threadsPerWorkGroup = getThreadsPerWG(simd, lwsX * lwsY * lwsZ);
+    if (DebugManager.flags.EnableLocalIdCache.get() == 0) {
+        generateLocalIDsUncached(buffer, simd, lwsX, lwsY, threadsPerWorkGroup);
+        return;
+    }
+
+    auto &cache = LocalIDCache::getInstance();
+    auto size = threadsPerWorkGroup * getPerThreadSizeLocalIDs(simd);
+    if (cache.copyIfCached(buffer, simd, lwsX, lwsY, threadsPerWorkGroup, size)) {
+        return;
+    }
+    generateLocalIDsUncached(buffer, simd, lwsX, lwsY, threadsPerWorkGroup);
+    cache.store(buffer, simd, lwsX, lwsY, threadsPerWorkGroup, size);
+}
 } // namespace OCLRT
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017, Intel Corporation
+ * Copyright (c) 2017 - 2018, Intel Corporation
  *
  * Permission is hereby granted, free of charge, to any person obtaining a
  * copy of this software and associated documentation files (the "Software"),
@@ -24,6 +24,10 @@
 
 #include <cstdint>
 #include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
 #include "runtime/helpers/ptr_math.h"
 
 namespace OCLRT {
@@ -69,10 +73,45 @@ struct LocalIDHelper {
     LocalIDHelper();
 };
 
+// Local IDs depend only on simd, lwsX, lwsY and thread count, while the same
+// handful of work group shapes is typically enqueued over and over.
+// Recently generated blocks are kept here and copied instead of regenerated.
+class LocalIDCache {
+  public:
+    static const size_t maxEntries = 16;
+
+    static LocalIDCache &getInstance();
+
+    bool copyIfCached(void *buffer, uint32_t simd, size_t lwsX, size_t lwsY, size_t threadsPerWorkGroup, size_t size);
+    void store(const void *buffer, uint32_t simd, size_t lwsX, size_t lwsY, size_t threadsPerWorkGroup, size_t size);
+    void clear();
+
+    size_t peekNumEntries();
+    uint64_t peekHits() const { return hits; }
+    uint64_t peekMisses() const { return misses; }
+
+  protected:
+    struct Entry {
+        uint32_t simd;
+        size_t lwsX;
+        size_t lwsY;
+        size_t threadsPerWorkGroup;
+        uint64_t lastUse;
+        std::shared_ptr<const std::vector<uint8_t>> data;
+    };
+
+    std::vector<Entry> entries;
+    uint64_t useCounter = 0;
+    std::atomic<uint64_t> hits{0};
+    std::atomic<uint64_t> misses{0};
+    std::mutex mtx;
+};
+
 extern const uint16_t initialLocalID[];
 
 template <typename Vec, int simd>
 void generateLocalIDsSimd(void *b, size_t lwsX, size_t lwsY, size_t threadsPerWorkGroup);
 
 void generateLocalIDs(void *buffer, uint32_t simd, size_t lwsX, size_t lwsY, size_t lwsZ);
+void generateLocalIDsUncached(void *buffer, uint32_t simd, size_t lwsX, size_t lwsY, size_t threadsPerWorkGroup);
 }
\ No newline at end of file
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017, Intel Corporation
+ * Copyright (c) 2017 - 2018, Intel Corporation
  *
  * Permission is hereby granted, free of charge, to any person obtaining a
  * copy of this software and associated documentation files (the "Software"),
@@ -20,6 +20,7 @@
  * OTHER DEALINGS IN THE SOFTWARE.
  */
 
+#include "runtime/command_queue/local_work_size_cache.h"
 #include "runtime/context/context.h"
 #include "runtime/helpers/array_count.h"
 #include "runtime/helpers/basic_math.h"
@@ -415,21 +416,38 @@ void computeWorkgroupSizeND(WorkSizeInfo wsInfo, size_t workGroupSize[3], const
 
 Vec3<size_t> computeWorkgroupSize(const DispatchInfo &dispatchInfo) {
     size_t workGroupSize[3] = {};
-    if (dispatchInfo.getKernel() != nullptr) {
-        if (DebugManager.flags.EnableComputeWorkSizeND.get()) {
-            WorkSizeInfo wsInfo(dispatchInfo);
-            size_t workItems[3] = {dispatchInfo.getGWS().x, dispatchInfo.getGWS().y, dispatchInfo.getGWS().z};
-            computeWorkgroupSizeND(wsInfo, workGroupSize, workItems, dispatchInfo.getDim());
-        } else {
-            auto maxWorkGroupSize = static_cast<uint32_t>(dispatchInfo.getKernel()->getDevice().getDeviceInfo().maxWorkGroupSize);
-            auto simd = dispatchInfo.getKernel()->getKernelInfo().getMaxSimdSize();
-            size_t workItems[3] = {dispatchInfo.getGWS().x, dispatchInfo.getGWS().y, dispatchInfo.getGWS().z};
-            if (dispatchInfo.getDim() == 1) {
-                computeWorkgroupSize1D(maxWorkGroupSize, workGroupSize, workItems, simd);
-            } else if (DebugManager.flags.EnableComputeWorkSizeSquared.get() && dispatchInfo.getDim() == 2) {
-                computeWorkgroupSizeSquared(maxWorkGroupSize, workGroupSize, workItems, simd, dispatchInfo.getDim());
+    auto kernel = dispatchInfo.getKernel();
+    if (kernel != nullptr) {
+        size_t workItems[3] = {dispatchInfo.getGWS().x, dispatchInfo.getGWS().y, dispatchInfo.getGWS().z};
+        auto executionEnvironment = kernel->getKernelInfo().patchInfo.executionEnvironment;
+        LocalWorkSizeCacheKey cacheKey = {};
+        std::copy(workItems, workItems + 3, cacheKey.gws);
+        cacheKey.workDim = dispatchInfo.getDim();
+        cacheKey.simdSize = static_cast<uint32_t>(kernel->getKernelInfo().getMaxSimdSize());
+        cacheKey.slmTotalSize = kernel->slmTotalSize;
+        cacheKey.hasBarriers = executionEnvironment && executionEnvironment->HasBarriers;
+        cacheKey.useND = !!DebugManager.flags.EnableComputeWorkSizeND.get();
+        cacheKey.useSquared = !!DebugManager.flags.EnableComputeWorkSizeSquared.get();
+
+        bool useCache = DebugManager.flags.EnableLocalWorkSizeCache.get() != 0;
+        auto &cache = kernel->getLocalWorkSizeCache();
+        if (!useCache || !cache.find(cacheKey, workGroupSize)) {
+            if (cacheKey.useND) {
+                WorkSizeInfo wsInfo(dispatchInfo);
+                computeWorkgroupSizeND(wsInfo, workGroupSize, workItems, dispatchInfo.getDim());
             } else {
-                computeWorkgroupSize2D(maxWorkGroupSize, workGroupSize, workItems, simd);
+                auto maxWorkGroupSize = static_cast<uint32_t>(kernel->getDevice().getDeviceInfo().maxWorkGroupSize);
+                auto simd = cacheKey.simdSize;
+                if (dispatchInfo.getDim() == 1) {
+                    computeWorkgroupSize1D(maxWorkGroupSize, workGroupSize, workItems, simd);
+                } else if (cacheKey.useSquared && dispatchInfo.getDim() == 2) {
+                    computeWorkgroupSizeSquared(maxWorkGroupSize, workGroupSize, workItems, simd, dispatchInfo.getDim());
+                } else {
+                    computeWorkgroupSize2D(maxWorkGroupSize, workGroupSize, workItems, simd);
+                }
+            }
+            if (useCache) {
+                cache.store(cacheKey, workGroupSize);
             }
         }
     }
@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+#include "runtime/utilities/vec.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+namespace OCLRT {
+
+struct LocalWorkSizeCacheKey {
+    size_t gws[3];
+    uint32_t workDim;
+    uint32_t simdSize;
+    uint32_t slmTotalSize;
+    bool hasBarriers;
+    // algorithm selection, EnableComputeWorkSizeND / EnableComputeWorkSizeSquared
+    bool useND;
+    bool useSquared;
+
+    bool operator==(const LocalWorkSizeCacheKey &other) const {
+        return gws[0] == other.gws[0] && gws[1] == other.gws[1] && gws[2] == other.gws[2] &&
+               workDim == other.workDim && simdSize == other.simdSize && slmTotalSize == other.slmTotalSize &&
+               hasBarriers == other.hasBarriers &&
+               useND == other.useND && useSquared == other.useSquared;
+    }
+};
+
+// Per kernel memo of local work sizes chosen by computeWorkgroupSize.
+// Device limits and image usage are fixed for a kernel, so they are not part of the key.
+// Entries are kept in most recently used order, the last one is evicted when full.
+class LocalWorkSizeCache {
+  public:
+    static const size_t maxEntries = 8;
+
+    struct Stats {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t evictions = 0;
+    };
+
+    bool find(const LocalWorkSizeCacheKey &key, size_t lws[3]) {
+        std::lock_guard<std::mutex> lock(mtx);
+        for (size_t i = 0; i < numEntries; i++) {
+            if (entries[i].key == key) {
+                std::rotate(entries, entries + i, entries + i + 1);
+                std::copy(entries[0].lws, entries[0].lws + 3, lws);
+                stats.hits++;
+                return true;
+            }
+        }
+        stats.misses++;
+        return false;
+    }
+
+    void store(const LocalWorkSizeCacheKey &key, const size_t lws[3]) {
+        std::lock_guard<std::mutex> lock(mtx);
+        if (numEntries == maxEntries) {
+            stats.evictions++;
+        } else {
+            numEntries++;
+        }
+        std::copy_backward(entries, entries + numEntries - 1, entries + numEntries);
+        entries[0].key = key;
+        std::copy(lws, lws + 3, entries[0].lws);
+    }
+
+    Stats peekStats() {
+        std::lock_guard<std::mutex> lock(mtx);
+        return stats;
+    }
+
+    size_t peekNumEntries() {
+        std::lock_guard<std::mutex> lock(mtx);
+        return numEntries;
+    }
+
+  protected:
+    struct Entry {
+        LocalWorkSizeCacheKey key;
+        size_t lws[3];
+    };
+
+    Entry entries[maxEntries] = {};
+    size_t numEntries = 0;
+    Stats stats;
+    std::mutex mtx;
+};
+} // namespace OCLRT
@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/command_stream/adaptive_dispatcher.h"
+#include "runtime/command_stream/command_stream_receiver.h"
+#include "runtime/helpers/debug_helpers.h"
+#include <algorithm>
+
+namespace OCLRT {
+// GPU completion is not signalled to us, so re-check the tag this often while coalescing
+static const std::chrono::microseconds gpuIdlePollInterval(50);
+
+AdaptiveDispatcher::AdaptiveDispatcher(CommandStreamReceiver &csr, uint32_t queueDepth, std::chrono::microseconds maxDelay)
+    : csr(csr), queueDepth(queueDepth > 0 ? queueDepth : 1), maxDelay(maxDelay) {
+}
+
+AdaptiveDispatcher::~AdaptiveDispatcher() {
+    closeThread();
+}
+
+void AdaptiveDispatcher::notifyCommandBufferRecorded() {
+    std::unique_lock<std::mutex> lock(mtx);
+    //Create on first use
+    openThread();
+
+    if (pendingCount++ == 0) {
+        firstPendingTime = clock::now();
+    }
+    cond.notify_one();
+}
+
+void AdaptiveDispatcher::notifySubmitted() {
+    std::unique_lock<std::mutex> lock(mtx);
+    pendingCount = 0;
+}
+
+bool AdaptiveDispatcher::isGpuIdle() const {
+    auto tagAddress = csr.getTagAddress();
+    return tagAddress && *tagAddress >= csr.peekLatestFlushedTaskCount();
+}
+
+void AdaptiveDispatcher::asyncProcess() {
+    std::unique_lock<std::mutex> lock(mtx);
+
+    while (true) {
+        if (!allowAsyncProcess) {
+            break;
+        }
+        if (pendingCount == 0) {
+            cond.wait(lock);
+            continue;
+        }
+
+        auto deadline = firstPendingTime + maxDelay;
+        if (pendingCount < queueDepth && clock::now() < deadline && !isGpuIdle()) {
+            // GPU is still busy with previous work, keep coalescing until deadline or next record
+            cond.wait_until(lock, std::min(deadline, clock::now() + gpuIdlePollInterval));
+            continue;
+        }
+
+        // flushBatchedSubmissions takes device ownership, don't hold our lock while waiting for it
+        lock.unlock();
+        csr.flushBatchedSubmissions();
+        lock.lock();
+    }
+}
+
+void AdaptiveDispatcher::closeThread() {
+    std::unique_lock<std::mutex> lock(mtx);
+    if (allowAsyncProcess) {
+        allowAsyncProcess = false;
+        cond.notify_one();
+        lock.unlock();
+        thread.get()->join();
+        thread.reset(nullptr);
+    }
+}
+
+void AdaptiveDispatcher::openThread() {
+    if (!thread.get()) {
+        DEBUG_BREAK_IF(allowAsyncProcess);
+        allowAsyncProcess = true;
+        thread.reset(new std::thread([this] { asyncProcess(); }));
+    }
+}
+} // namespace OCLRT
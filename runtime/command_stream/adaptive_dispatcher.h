@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace OCLRT {
+class CommandStreamReceiver;
+
+// Background submitter for CommandStreamReceiver::AdaptiveDispatch.
+// Recorded command buffers are flushed right away when the GPU is idle,
+// otherwise they are accumulated until queueDepth of them is pending or the
+// oldest one waited for maxDelay.
+class AdaptiveDispatcher {
+  public:
+    using clock = std::chrono::steady_clock;
+
+    AdaptiveDispatcher(CommandStreamReceiver &csr, uint32_t queueDepth, std::chrono::microseconds maxDelay);
+    virtual ~AdaptiveDispatcher();
+
+    void notifyCommandBufferRecorded();
+    void notifySubmitted();
+    void closeThread();
+
+    uint32_t peekPendingCount() const { return pendingCount; }
+    uint32_t peekQueueDepth() const { return queueDepth; }
+    std::chrono::microseconds peekMaxDelay() const { return maxDelay; }
+
+  protected:
+    void asyncProcess();
+    MOCKABLE_VIRTUAL bool isGpuIdle() const;
+    MOCKABLE_VIRTUAL void openThread();
+
+    CommandStreamReceiver &csr;
+    const uint32_t queueDepth;
+    const std::chrono::microseconds maxDelay;
+
+    std::atomic<uint32_t> pendingCount{0};
+    clock::time_point firstPendingTime;
+    std::atomic<bool> allowAsyncProcess{false};
+
+    std::unique_ptr<std::thread> thread;
+    std::mutex mtx;
+    std::condition_variable cond;
+};
+} // namespace OCLRT
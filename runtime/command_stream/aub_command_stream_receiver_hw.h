@@ -27,6 +27,7 @@
 #include "runtime/memory_manager/address_mapper.h"
 #include "runtime/memory_manager/page_table.h"
 #include "runtime/memory_manager/os_agnostic_memory_manager.h"
+#include <unordered_map>
 
 namespace OCLRT {
 template <typename GfxFamily>
@@ -39,9 +40,11 @@ class AUBCommandStreamReceiverHw : public CommandStreamReceiverHw<GfxFamily> {
     FlushStamp flush(BatchBuffer &batchBuffer, EngineType engineType, ResidencyContainer *allocationsForResidency) override;
     void makeResident(GraphicsAllocation &gfxAllocation) override;
     void makeNonResident(GraphicsAllocation &gfxAllocation) override;
+    void notifyAllocationReleased(GraphicsAllocation &gfxAllocation) override;
 
     void processResidency(ResidencyContainer *allocationsForResidency) override;
     bool writeMemory(GraphicsAllocation &gfxAllocation);
+    bool isPageDumpRequired(uint64_t gpuAddress, const void *cpuAddress, size_t size, bool trackDirtyPages);
 
     // Family specific version
     void submitLRCA(EngineType engineType, const MiContextDescriptorReg &contextDescriptor);
@@ -91,6 +94,23 @@ class AUBCommandStreamReceiverHw : public CommandStreamReceiverHw<GfxFamily> {
     // remap CPU VA -> GGTT VA
     AddressMapper gttRemap;
 
+    // content hashes of ppgtt ranges already written to the AUB file, keyed by their GPU page
+    struct DumpedPage {
+        uint64_t gpuAddress;
+        size_t size;
+        uint64_t hash;
+    };
+    std::unordered_map<uint64_t, DumpedPage> dumpedPages;
+    bool dirtyPageTracking;
+
+    struct DumpStatistics {
+        uint64_t pagesWritten = 0;
+        uint64_t pagesSkipped = 0;
+        uint64_t bytesWritten = 0;
+        uint64_t bytesSkipped = 0;
+        long long writeMemoryTimeNs = 0;
+    } dumpStatistics;
+
     MOCKABLE_VIRTUAL void *flattenBatchBuffer(BatchBuffer &batchBuffer, size_t &sizeBatchBuffer);
     MOCKABLE_VIRTUAL bool addPatchInfoComments();
 };
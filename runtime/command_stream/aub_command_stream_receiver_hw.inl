@@ -27,7 +27,9 @@
 #include "runtime/memory_manager/graphics_allocation.h"
 #include "runtime/memory_manager/os_agnostic_memory_manager.h"
 #include "runtime/gmm_helper/gmm_helper.h"
+#include "runtime/helpers/fast_hash.h"
 #include "runtime/helpers/string.h"
+#include <chrono>
 #include <cstring>
 
 namespace OCLRT {
@@ -41,6 +43,7 @@ AUBCommandStreamReceiverHw<GfxFamily>::AUBCommandStreamReceiverHw(const Hardware
     if (DebugManager.flags.CsrDispatchMode.get()) {
         this->dispatchMode = (CommandStreamReceiver::DispatchMode)DebugManager.flags.CsrDispatchMode.get();
     }
+    dirtyPageTracking = DebugManager.flags.EnableAUBDirtyPageTracking.get() != 0;
     for (auto &engineInfo : engineInfoTable) {
         engineInfo.pLRCA = nullptr;
         engineInfo.ggttLRCA = 0u;
@@ -55,6 +58,16 @@ AUBCommandStreamReceiverHw<GfxFamily>::AUBCommandStreamReceiverHw(const Hardware
 
 template <typename GfxFamily>
 AUBCommandStreamReceiverHw<GfxFamily>::~AUBCommandStreamReceiverHw() {
+    this->closeAdaptiveDispatcher();
+    if (DebugManager.flags.PrintAUBDumpStatistics.get() && stream->fileHandle.is_open()) {
+        stream->flush();
+        auto fileSize = static_cast<long long>(stream->fileHandle.tellp());
+        printDebugString(true, stdout, "AUB dump: file size: %lld bytes, writeMemory time: %lld us\n",
+                         fileSize, dumpStatistics.writeMemoryTimeNs / 1000);
+        printDebugString(true, stdout, "AUB dump: pages written: %llu (%llu bytes), unchanged pages skipped: %llu (%llu bytes)\n",
+                         static_cast<unsigned long long>(dumpStatistics.pagesWritten), static_cast<unsigned long long>(dumpStatistics.bytesWritten),
+                         static_cast<unsigned long long>(dumpStatistics.pagesSkipped), static_cast<unsigned long long>(dumpStatistics.bytesSkipped));
+    }
     stream->close();
 
     for (auto &engineInfo : engineInfoTable) {
@@ -503,10 +516,44 @@ bool AUBCommandStreamReceiverHw<GfxFamily>::writeMemory(GraphicsAllocation &gfxA
         gfxAllocation.setLocked(true);
     }
 
-    PageWalker walker = [&](uint64_t physAddress, size_t size, size_t offset) {
-        AUB::reserveAddressGGTTAndWriteMmeory(*stream, static_cast<uintptr_t>(gpuAddress), cpuAddress, physAddress, size, offset);
+    // only command buffers and heaps are never written by the GPU, content dumped for
+    // any other allocation may be stale in simulated memory even if the CPU copy matches
+    auto trackDirtyPages = dirtyPageTracking && (allocType == GraphicsAllocation::ALLOCATION_TYPE_LINEAR_STREAM);
+
+    auto writeStart = std::chrono::high_resolution_clock::now();
+    auto walker = [&](uint64_t physAddress, size_t size, size_t offset) {
+        // dirty tracking works on pages, unchanged pages split the run into separate writes
+        size_t writeOffset = offset;
+        size_t writeSize = 0;
+        auto flushWrite = [&]() {
+            if (writeSize != 0) {
+                AUB::reserveAddressGGTTAndWriteMmeory(*stream, static_cast<uintptr_t>(gpuAddress), cpuAddress, physAddress + (writeOffset - offset), writeSize, writeOffset);
+                dumpStatistics.bytesWritten += writeSize;
+                writeSize = 0;
+            }
+        };
+        auto pageOffset = offset;
+        auto runEnd = offset + size;
+        while (pageOffset < runEnd) {
+            auto pageAddress = gpuAddress + pageOffset;
+            auto chunkSize = std::min(static_cast<size_t>(alignDown(pageAddress, MemoryConstants::pageSize) + MemoryConstants::pageSize - pageAddress), runEnd - pageOffset);
+            if (isPageDumpRequired(pageAddress, ptrOffset(cpuAddress, pageOffset), chunkSize, trackDirtyPages)) {
+                if (writeSize == 0) {
+                    writeOffset = pageOffset;
+                }
+                writeSize += chunkSize;
+                dumpStatistics.pagesWritten++;
+            } else {
+                flushWrite();
+                dumpStatistics.pagesSkipped++;
+                dumpStatistics.bytesSkipped += chunkSize;
+            }
+            pageOffset += chunkSize;
+        }
+        flushWrite();
     };
     ppgtt.pageWalk(static_cast<uintptr_t>(gpuAddress), size, 0, walker);
+    dumpStatistics.writeMemoryTimeNs += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now() - writeStart).count();
 
     if (gfxAllocation.isLocked()) {
         this->getMemoryManager()->unlockResource(&gfxAllocation);
@@ -520,6 +567,35 @@ bool AUBCommandStreamReceiverHw<GfxFamily>::writeMemory(GraphicsAllocation &gfxA
     return true;
 }
 
+template <typename GfxFamily>
+bool AUBCommandStreamReceiverHw<GfxFamily>::isPageDumpRequired(uint64_t gpuAddress, const void *cpuAddress, size_t size, bool trackDirtyPages) {
+    auto page = alignDown(gpuAddress, MemoryConstants::pageSize);
+    if (!trackDirtyPages) {
+        dumpedPages.erase(page);
+        return true;
+    }
+    // ppgtt mappings are never torn down, so content already written for this range
+    // is still present in simulated memory unless the CPU copy changed since then
+    auto hash = FastHash::hash(reinterpret_cast<const char *>(cpuAddress), size);
+    auto dumpedPage = dumpedPages.find(page);
+    if (dumpedPage != dumpedPages.end() &&
+        dumpedPage->second.gpuAddress == gpuAddress && dumpedPage->second.size == size && dumpedPage->second.hash == hash) {
+        return false;
+    }
+    dumpedPages[page] = {gpuAddress, size, hash};
+    return true;
+}
+
+template <typename GfxFamily>
+void AUBCommandStreamReceiverHw<GfxFamily>::notifyAllocationReleased(GraphicsAllocation &gfxAllocation) {
+    // GPU VA of a freed allocation can be handed out again, its pages must not be skipped then
+    auto gpuAddress = Gmm::decanonize(gfxAllocation.getGpuAddress());
+    auto size = gfxAllocation.getUnderlyingBufferSize();
+    for (auto page = alignDown(gpuAddress, MemoryConstants::pageSize); page < gpuAddress + size; page += MemoryConstants::pageSize) {
+        dumpedPages.erase(page);
+    }
+}
+
 template <typename GfxFamily>
 void AUBCommandStreamReceiverHw<GfxFamily>::processResidency(ResidencyContainer *allocationsForResidency) {
     auto &residencyAllocations = allocationsForResidency ? *allocationsForResidency : this->getMemoryManager()->getResidencyAllocations();
@@ -31,6 +31,8 @@
 #include "runtime/event/event.h"
 #include "runtime/event/event_builder.h"
 
+#include <algorithm>
+
 namespace OCLRT {
 // Global table of CommandStreamReceiver factories for HW and tests
 CommandStreamReceiverCreateFunc commandStreamReceiverFactory[2 * IGFX_MAX_CORE] = {};
@@ -41,13 +43,40 @@ CommandStreamReceiver::CommandStreamReceiver() {
     if (DebugManager.flags.CsrDispatchMode.get()) {
         this->dispatchMode = (DispatchMode)DebugManager.flags.CsrDispatchMode.get();
     }
+    if (DebugManager.flags.CsrBatchedDispatchCounterLimit.get() > 0) {
+        this->batchedDispatchCounterLimit = static_cast<uint32_t>(DebugManager.flags.CsrBatchedDispatchCounterLimit.get());
+    }
     flushStamp.reset(new FlushStampTracker(true));
 }
 
 CommandStreamReceiver::~CommandStreamReceiver() {
+    closeAdaptiveDispatcher();
     cleanupResources();
 }
 
+void CommandStreamReceiver::closeAdaptiveDispatcher() {
+    if (adaptiveDispatcher) {
+        adaptiveDispatcher->closeThread();
+    }
+}
+
+void CommandStreamReceiver::notifyCommandBufferRecorded() {
+    if (!adaptiveDispatcher) {
+        adaptiveDispatcher.reset(new AdaptiveDispatcher(*this,
+                                                        static_cast<uint32_t>(DebugManager.flags.CsrAdaptiveDispatchQueueDepth.get()),
+                                                        std::chrono::microseconds(DebugManager.flags.CsrAdaptiveDispatchMaxDelayUs.get())));
+    }
+    adaptiveDispatcher->notifyCommandBufferRecorded();
+}
+
+void CommandStreamReceiver::updateDispatchStats(uint32_t batchSize, uint64_t addedLatencyUs) {
+    dispatchStats.submissions++;
+    dispatchStats.commandBuffersSubmitted += batchSize;
+    dispatchStats.maxBatchSize = std::max(dispatchStats.maxBatchSize, batchSize);
+    dispatchStats.totalAddedLatencyUs += addedLatencyUs;
+    dispatchStats.maxAddedLatencyUs = std::max(dispatchStats.maxAddedLatencyUs, addedLatencyUs);
+}
+
 void CommandStreamReceiver::makeResident(GraphicsAllocation &gfxAllocation) {
     auto submissionTaskCount = this->taskCount + 1;
     if (gfxAllocation.residencyTaskCount < (int)submissionTaskCount) {
@@ -21,6 +21,7 @@
  */
 
 #pragma once
+#include "runtime/command_stream/adaptive_dispatcher.h"
 #include "runtime/command_stream/linear_stream.h"
 #include "runtime/command_stream/thread_arbitration_policy.h"
 #include "runtime/command_stream/submissions_aggregator.h"
@@ -44,8 +45,8 @@ class CommandStreamReceiver {
     enum DispatchMode {
         DeviceDefault = 0,          //default for given device
         ImmediateDispatch,          //everything is submitted to the HW immediately
-        AdaptiveDispatch,           //dispatching is handled to async thread, which combines batch buffers basing on load (not implemented)
-        BatchedDispatchWithCounter, //dispatching is batched, after n commands there is implicit flush (not implemented)
+        AdaptiveDispatch,           //dispatching is handled to async thread, which combines batch buffers basing on load
+        BatchedDispatchWithCounter, //dispatching is batched, after n commands there is implicit flush
         BatchedDispatch             // dispatching is batched, explicit clFlush is required
     };
 
@@ -54,6 +55,14 @@ class CommandStreamReceiver {
         samplerCacheFlushBefore, //add sampler cache flush before Walker with redescribed image
         samplerCacheFlushAfter   //add sampler cache flush after Walker with redescribed image
     };
+    struct DispatchStats {
+        uint64_t submissions = 0;
+        uint64_t commandBuffersSubmitted = 0;
+        uint32_t maxBatchSize = 0;
+        uint64_t totalAddedLatencyUs = 0;
+        uint64_t maxAddedLatencyUs = 0;
+    };
+
     CommandStreamReceiver();
     virtual ~CommandStreamReceiver();
 
@@ -72,6 +81,8 @@ class CommandStreamReceiver {
     void makeSurfacePackNonResident(ResidencyContainer *allocationsForResidency);
     virtual void processResidency(ResidencyContainer *allocationsForResidency) {}
     virtual void processEviction();
+    // called by the memory manager right before the allocation is freed
+    virtual void notifyAllocationReleased(GraphicsAllocation &gfxAllocation) {}
     void makeResidentHostPtrAllocation(GraphicsAllocation *gfxAllocation);
 
     virtual void addPipeControl(LinearStream &commandStream, bool dcFlush) = 0;
@@ -100,6 +111,11 @@ class CommandStreamReceiver {
     uint32_t peekLatestFlushedTaskCount() const { return latestFlushedTaskCount; }
 
     void overrideDispatchPolicy(CommandStreamReceiver::DispatchMode overrideValue) { this->dispatchMode = overrideValue; }
+    DispatchMode peekDispatchMode() const { return dispatchMode; }
+    const DispatchStats &peekDispatchStats() const { return dispatchStats; }
+    // async thread flushes through virtual interface, so every derived destructor calls it first
+    // and owners may call it before deleting the CSR to stop flushes earlier
+    void closeAdaptiveDispatcher();
 
     virtual void overrideMediaVFEStateDirty(bool dirty) { mediaVfeStateDirty = dirty; }
 
@@ -132,6 +148,8 @@ class CommandStreamReceiver {
     void setDisableL3Cache(bool val) {
         disableL3Cache = val;
     }
+    void notifyCommandBufferRecorded();
+    void updateDispatchStats(uint32_t batchSize, uint64_t addedLatencyUs);
 
     // taskCount - # of tasks submitted
     uint32_t taskCount = 0;
@@ -171,6 +189,11 @@ class CommandStreamReceiver {
     std::unique_ptr<SubmissionAggregator> submissionAggregator;
 
     DispatchMode dispatchMode = ImmediateDispatch;
+    // command buffers recorded since last flushBatchedSubmissions
+    uint32_t batchedCommandBuffersCount = 0;
+    uint32_t batchedDispatchCounterLimit = 16;
+    std::unique_ptr<AdaptiveDispatcher> adaptiveDispatcher;
+    DispatchStats dispatchStats;
     bool disableL3Cache = false;
     uint32_t requiredScratchSize = 0;
     uint64_t totalMemoryUsed = 0u;
@@ -42,6 +42,7 @@ class CommandStreamReceiverHw : public CommandStreamReceiver {
     }
 
     CommandStreamReceiverHw(const HardwareInfo &hwInfoIn);
+    ~CommandStreamReceiverHw() override;
 
     FlushStamp flush(BatchBuffer &batchBuffer, EngineType engineType, ResidencyContainer *allocationsForResidency) override;
 
@@ -45,6 +45,11 @@ CommandStreamReceiverHw<GfxFamily>::CommandStreamReceiverHw(const HardwareInfo &
     }
 }
 
+template <typename GfxFamily>
+CommandStreamReceiverHw<GfxFamily>::~CommandStreamReceiverHw() {
+    this->closeAdaptiveDispatcher();
+}
+
 template <typename GfxFamily>
 FlushStamp CommandStreamReceiverHw<GfxFamily>::flush(BatchBuffer &batchBuffer, EngineType engineType, ResidencyContainer *allocationsForResidency) {
     return flushStamp->peekStamp();
@@ -376,6 +381,7 @@ CompletionStamp CommandStreamReceiverHw<GfxFamily>::flushTask(
             commandBuffer->pipeControlThatMayBeErasedLocation = currentPipeControlForNooping;
             commandBuffer->epiloguePipeControlLocation = epiloguePipeControlLocation;
             this->submissionAggregator->recordCommandBuffer(commandBuffer);
+            this->batchedCommandBuffersCount++;
         }
     } else {
         this->makeSurfacePackNonResident(nullptr);
@@ -388,8 +394,14 @@ CompletionStamp CommandStreamReceiverHw<GfxFamily>::flushTask(
         }
     }
 
-    if (this->dispatchMode == DispatchMode::BatchedDispatch && (dispatchFlags.blocking || dispatchFlags.implicitFlush)) {
+    if (this->dispatchMode == DispatchMode::BatchedDispatchWithCounter && this->batchedCommandBuffersCount >= this->batchedDispatchCounterLimit) {
+        dispatchFlags.implicitFlush = true;
+    }
+
+    if (this->dispatchMode != DispatchMode::ImmediateDispatch && (dispatchFlags.blocking || dispatchFlags.implicitFlush)) {
         this->flushBatchedSubmissions();
+    } else if (this->dispatchMode == DispatchMode::AdaptiveDispatch && this->batchedCommandBuffersCount > 0) {
+        this->notifyCommandBufferRecorded();
     }
 
     ++taskCount;
@@ -438,6 +450,7 @@ inline void CommandStreamReceiverHw<GfxFamily>::flushBatchedSubmissions() {
             auto nextCommandBuffer = commandBufferList.peekHead();
             auto currentBBendLocation = primaryCmdBuffer->batchBufferEndLocation;
             auto lastTaskCount = primaryCmdBuffer->taskCount;
+            uint32_t batchSize = 1;
 
             FlushStampUpdateHelper flushStampUpdateHelper;
             flushStampUpdateHelper.insert(primaryCmdBuffer->flushStamp->getStampReference());
@@ -461,6 +474,7 @@ inline void CommandStreamReceiverHw<GfxFamily>::flushBatchedSubmissions() {
                 addBatchBufferStart((MI_BATCH_BUFFER_START *)currentBBendLocation, offsetedCommandBuffer);
                 currentBBendLocation = nextCommandBuffer->batchBufferEndLocation;
                 lastTaskCount = nextCommandBuffer->taskCount;
+                batchSize++;
                 nextCommandBuffer = nextCommandBuffer->next;
                 commandBufferList.removeFrontOne();
             }
@@ -475,6 +489,9 @@ inline void CommandStreamReceiverHw<GfxFamily>::flushBatchedSubmissions() {
             }
             auto flushStamp = this->flush(primaryCmdBuffer->batchBuffer, engineType, &surfacesForSubmit);
 
+            auto addedLatency = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - primaryCmdBuffer->recordTime);
+            this->updateDispatchStats(batchSize, static_cast<uint64_t>(addedLatency.count()));
+
             //after flush task level is closed
             this->taskLevel++;
 
@@ -487,6 +504,10 @@ inline void CommandStreamReceiverHw<GfxFamily>::flushBatchedSubmissions() {
         }
         this->totalMemoryUsed = 0;
     }
+    this->batchedCommandBuffersCount = 0;
+    if (this->adaptiveDispatcher) {
+        this->adaptiveDispatcher->notifySubmitted();
+    }
 }
 
 template <typename GfxFamily>
@@ -35,6 +35,7 @@ CommandStreamReceiverWithAUBDump<BaseCSR>::CommandStreamReceiverWithAUBDump(cons
 
 template <typename BaseCSR>
 CommandStreamReceiverWithAUBDump<BaseCSR>::~CommandStreamReceiverWithAUBDump() {
+    this->closeAdaptiveDispatcher();
     delete aubCSR;
 }
 
@@ -111,4 +111,5 @@ OCLRT::BatchBuffer::BatchBuffer(GraphicsAllocation *commandBufferAllocation, siz
 
 OCLRT::CommandBuffer::CommandBuffer() {
     flushStamp.reset(new FlushStampTracker(false));
+    recordTime = std::chrono::steady_clock::now();
 }
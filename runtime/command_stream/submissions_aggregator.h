@@ -25,6 +25,7 @@
 #include "runtime/utilities/stackvec.h"
 #include "runtime/command_stream/linear_stream.h"
 #include "runtime/helpers/properties_helper.h"
+#include <chrono>
 #include <vector>
 namespace OCLRT {
 class Event;
@@ -64,6 +65,7 @@ struct CommandBuffer : public IDNode<CommandBuffer> {
     void *pipeControlThatMayBeErasedLocation = nullptr;
     void *epiloguePipeControlLocation = nullptr;
     std::unique_ptr<FlushStampTracker> flushStamp;
+    std::chrono::steady_clock::time_point recordTime;
 };
 
 struct CommandBufferList : public IDList<CommandBuffer, false, true, false> {};
@@ -47,6 +47,7 @@ TbxCommandStreamReceiverHw<GfxFamily>::TbxCommandStreamReceiverHw(const Hardware
 
 template <typename GfxFamily>
 TbxCommandStreamReceiverHw<GfxFamily>::~TbxCommandStreamReceiverHw() {
+    this->closeAdaptiveDispatcher();
     stream.close();
 
     for (auto &engineInfo : engineInfoTable) {
@@ -340,7 +341,7 @@ bool TbxCommandStreamReceiverHw<GfxFamily>::writeMemory(GraphicsAllocation &gfxA
     if (size == 0)
         return false;
 
-    PageWalker walker = [&](uint64_t physAddress, size_t size, size_t offset) {
+    auto walker = [&](uint64_t physAddress, size_t size, size_t offset) {
         AUB::reserveAddressGGTTAndWriteMmeory(stream, static_cast<uintptr_t>(gpuAddress), cpuAddress, physAddress, size, offset);
     };
     ppgtt.pageWalk(static_cast<uintptr_t>(gpuAddress), size, 0, walker);
@@ -363,7 +364,7 @@ void TbxCommandStreamReceiverHw<GfxFamily>::processResidency(ResidencyContainer
 template <typename GfxFamily>
 void TbxCommandStreamReceiverHw<GfxFamily>::makeCoherent(void *address, size_t length) {
     if (length) {
-        PageWalker walker = [&](uint64_t physAddress, size_t size, size_t offset) {
+        auto walker = [&](uint64_t physAddress, size_t size, size_t offset) {
             DEBUG_BREAK_IF(offset > length);
             stream.readMemory(physAddress, ptrOffset(address, offset), size);
         };
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017, Intel Corporation
+ * Copyright (c) 2017 - 2018, Intel Corporation
  *
  * Permission is hereby granted, free of charge, to any person obtaining a
  * copy of this software and associated documentation files (the "Software"),
@@ -24,24 +24,61 @@
 
 #include <runtime/compiler_interface/binary_cache.h>
 #include <runtime/helpers/aligned_memory.h>
+#include <runtime/helpers/fast_hash.h>
 #include <runtime/helpers/file_io.h>
-#include <runtime/helpers/hash.h>
 #include <runtime/helpers/hw_info.h>
+#include <runtime/os_interface/debug_settings_manager.h>
 #include <runtime/os_interface/os_inc_base.h>
 #include <runtime/program/program.h>
+#include <runtime/utilities/directory.h>
+#include <runtime/utilities/mapped_file.h>
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
 #include <cstring>
+#include <fstream>
+#include <functional>
 #include <string>
 #include <sstream>
 #include <iomanip>
 #include <mutex>
+#include <thread>
+#include <vector>
 
 namespace OCLRT {
-std::mutex BinaryCache::cacheAccessMtx;
+const char *BinaryCache::indexFileName = "cl_cache.index";
+
+static const char *cacheFileExtension = ".cl_cache";
+
+BinaryCache::BinaryCache() : BinaryCache(CL_CACHE_LOCATION, getDefaultSizeLimit()) {
+}
+
+BinaryCache::BinaryCache(const std::string &cacheLocation, size_t sizeLimit) : cacheLocation(cacheLocation), sizeLimit(sizeLimit) {
+}
+
+BinaryCache::~BinaryCache() {
+    std::lock_guard<std::mutex> lock(indexMtx);
+    if (indexDirty) {
+        storeIndex();
+    }
+}
+
+size_t BinaryCache::getDefaultSizeLimit() {
+    int64_t limitMB = 0;
+#if defined(CL_CACHE_SIZE_LIMIT_MB)
+    limitMB = CL_CACHE_SIZE_LIMIT_MB;
+#endif
+    if (DebugManager.flags.OverrideBinaryCacheSizeLimitMB.get() != -1) {
+        limitMB = DebugManager.flags.OverrideBinaryCacheSizeLimitMB.get();
+    }
+    return static_cast<size_t>(limitMB) * MemoryConstants::megaByte;
+}
 
 const std::string BinaryCache::getCachedFileName(const HardwareInfo &hwInfo, const ArrayRef<const char> input,
                                                  const ArrayRef<const char> options, const ArrayRef<const char> internalOptions) {
-    Hash hash;
+    FastHash hash;
 
     hash.update("----", 4);
     hash.update(&*input.begin(), input.size());
@@ -66,46 +103,238 @@ const std::string BinaryCache::getCachedFileName(const HardwareInfo &hwInfo, con
     return stream.str();
 }
 
-bool BinaryCache::cacheBinary(const std::string kernelFileHash, const char *pBinary, uint32_t binarySize) {
-    if (pBinary == nullptr || binarySize == 0) {
+std::string BinaryCache::getFilePath(const std::string &kernelFileHash) const {
+    std::string filePath = cacheLocation;
+    filePath.append(Os::fileSeparator);
+    filePath.append(kernelFileHash + cacheFileExtension);
+    return filePath;
+}
+
+std::string BinaryCache::getIndexPath() const {
+    std::string filePath = cacheLocation;
+    filePath.append(Os::fileSeparator);
+    filePath.append(indexFileName);
+    return filePath;
+}
+
+uint64_t BinaryCache::getTimestamp() {
+    uint64_t now = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count());
+    // keep access order strict within a process even with coarse system clock
+    lastTimestamp = std::max(now, lastTimestamp + 1);
+    return lastTimestamp;
+}
+
+static std::string getTemporaryFileSuffix() {
+    static std::atomic<uint32_t> counter(0);
+    std::stringstream stream;
+    stream << "."
+           << std::hex
+           << std::hash<std::thread::id>()(std::this_thread::get_id())
+           << "_"
+           << std::chrono::steady_clock::now().time_since_epoch().count()
+           << "_"
+           << counter++
+           << ".tmp";
+    return stream.str();
+}
+
+static bool writeFileAtomically(const std::string &filePath, const void *pData, size_t dataSize) {
+    auto tempPath = filePath + getTemporaryFileSuffix();
+    if (writeDataToFile(tempPath.c_str(), pData, dataSize) != dataSize) {
+        std::remove(tempPath.c_str());
         return false;
     }
+    if (std::rename(tempPath.c_str(), filePath.c_str()) != 0) {
+        // some systems do not allow renaming over an existing file
+        std::remove(filePath.c_str());
+        if (std::rename(tempPath.c_str(), filePath.c_str()) != 0) {
+            std::remove(tempPath.c_str());
+            return fileExists(filePath);
+        }
+    }
+    return true;
+}
+
+static void writeIndexRecord(std::ostream &stream, const std::string &name, const BinaryCache::IndexEntry &entry) {
+    stream << name << " " << entry.size << " " << entry.lastAccess << "\n";
+}
+
+BinaryCache::IndexT BinaryCache::readIndexFile(size_t *numRecords) const {
+    IndexT entries;
+    std::ifstream indexFile(getIndexPath());
+    std::string name;
+    IndexEntry entry = {};
+    size_t records = 0;
+    // index is a journal, later records override earlier ones and zero size marks an evicted entry
+    while (indexFile >> name >> entry.size >> entry.lastAccess) {
+        if (entry.size == 0) {
+            entries.erase(name);
+        } else {
+            entries[name] = entry;
+        }
+        records++;
+    }
+    if (numRecords) {
+        *numRecords = records;
+    }
+    return entries;
+}
 
-    std::string hashFilePath = CL_CACHE_LOCATION;
-    hashFilePath.append(Os::fileSeparator);
-    hashFilePath.append(kernelFileHash + ".cl_cache");
+BinaryCache::IndexT BinaryCache::scanCacheDirectory() const {
+    IndexT entries;
+    std::string path = cacheLocation;
+    auto extensionLength = strlen(cacheFileExtension);
+    for (auto &file : Directory::getFiles(path)) {
+        if (file.size() <= extensionLength || file.compare(file.size() - extensionLength, extensionLength, cacheFileExtension) != 0) {
+            continue;
+        }
+        auto nameStart = file.find_last_of("/\\");
+        nameStart = (nameStart == std::string::npos) ? 0 : nameStart + 1;
+        auto name = file.substr(nameStart, file.size() - extensionLength - nameStart);
+        entries[name] = {getFileSize(file), 0u};
+    }
+    return entries;
+}
 
-    std::lock_guard<std::mutex> lock(cacheAccessMtx);
-    if (writeDataToFile(
-            hashFilePath.c_str(),
-            pBinary,
-            binarySize) == 0) {
+void BinaryCache::loadIndex() {
+    if (indexLoaded) {
+        return;
+    }
+    indexLoaded = true;
+    if (fileExists(getIndexPath())) {
+        index = readIndexFile(&numIndexRecords);
+    } else {
+        // cache populated without index, treat existing entries as least recently used
+        index = scanCacheDirectory();
+        indexDirty = !index.empty();
+    }
+}
+
+void BinaryCache::storeIndex() {
+    // merge entries recorded by other processes sharing this cache location
+    for (auto &diskEntry : readIndexFile()) {
+        auto it = index.find(diskEntry.first);
+        if (it == index.end()) {
+            if (fileExists(getFilePath(diskEntry.first))) {
+                index.insert(diskEntry);
+            }
+        } else {
+            it->second.lastAccess = std::max(it->second.lastAccess, diskEntry.second.lastAccess);
+        }
+    }
+
+    evictEntries();
+
+    std::stringstream stream;
+    for (auto &entry : index) {
+        writeIndexRecord(stream, entry.first, entry.second);
+    }
+    auto content = stream.str();
+    if (content.empty()) {
+        std::remove(getIndexPath().c_str());
+    } else {
+        writeFileAtomically(getIndexPath(), content.c_str(), content.size());
+    }
+    numIndexRecords = index.size();
+    indexDirty = false;
+}
+
+bool BinaryCache::appendIndexRecords(const std::string &records) {
+    FILE *fp = nullptr;
+    fopen_s(&fp, getIndexPath().c_str(), "ab");
+    if (fp == nullptr) {
         return false;
     }
+    // single write of a few short lines, appends from other processes do not interleave with it
+    auto written = fwrite(records.c_str(), sizeof(char), records.size(), fp);
+    fclose(fp);
+    return written == records.size();
+}
 
-    return true;
+std::vector<std::string> BinaryCache::evictEntries() {
+    std::vector<std::string> evicted;
+    if (sizeLimit == 0) {
+        return evicted;
+    }
+
+    uint64_t totalSize = 0;
+    std::vector<IndexT::iterator> entries;
+    entries.reserve(index.size());
+    for (auto it = index.begin(); it != index.end(); ++it) {
+        totalSize += it->second.size;
+        entries.push_back(it);
+    }
+    if (totalSize <= sizeLimit) {
+        return evicted;
+    }
+
+    std::sort(entries.begin(), entries.end(), [](const IndexT::iterator &lhs, const IndexT::iterator &rhs) {
+        return lhs->second.lastAccess < rhs->second.lastAccess;
+    });
+    for (auto &entry : entries) {
+        if (totalSize <= sizeLimit) {
+            break;
+        }
+        // files mapped by other processes stay valid until they unmap them
+        std::remove(getFilePath(entry->first).c_str());
+        totalSize -= entry->second.size;
+        evicted.push_back(entry->first);
+        index.erase(entry);
+    }
+    return evicted;
 }
 
-bool BinaryCache::loadCachedBinary(const std::string kernelFileHash, Program &program) {
-    void *pBinary = nullptr;
-    size_t binarySize = 0;
+bool BinaryCache::cacheBinary(const std::string kernelFileHash, const char *pBinary, uint32_t binarySize) {
+    if (pBinary == nullptr || binarySize == 0) {
+        return false;
+    }
+    if (sizeLimit != 0 && binarySize > sizeLimit) {
+        return false;
+    }
+
+    if (!writeFileAtomically(getFilePath(kernelFileHash), pBinary, binarySize)) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(indexMtx);
+    loadIndex();
+    IndexEntry entry = {binarySize, getTimestamp()};
+    index[kernelFileHash] = entry;
 
-    std::string hashFilePath = CL_CACHE_LOCATION;
-    hashFilePath.append(Os::fileSeparator);
-    hashFilePath.append(kernelFileHash + ".cl_cache");
+    std::stringstream records;
+    writeIndexRecord(records, kernelFileHash, entry);
+    size_t numRecords = 1;
+    for (auto &evictedEntry : evictEntries()) {
+        writeIndexRecord(records, evictedEntry, {0u, 0u});
+        numRecords++;
+    }
 
-    {
-        std::lock_guard<std::mutex> lock(cacheAccessMtx);
-        binarySize = loadDataFromFile(hashFilePath.c_str(), pBinary);
+    // append to the index instead of rewriting it, compact only when stale records dominate
+    numIndexRecords += numRecords;
+    if (numIndexRecords > 2 * index.size() || !appendIndexRecords(records.str())) {
+        storeIndex();
     }
 
-    if ((pBinary == nullptr) || (binarySize == 0)) {
-        deleteDataReadFromFile(pBinary);
+    return true;
+}
+
+bool BinaryCache::loadCachedBinary(const std::string kernelFileHash, Program &program) {
+    MappedFile cachedFile;
+
+    if (!cachedFile.open(getFilePath(kernelFileHash))) {
+        std::lock_guard<std::mutex> lock(indexMtx);
+        if (index.erase(kernelFileHash) != 0) {
+            indexDirty = true;
+        }
         return false;
     }
-    program.storeGenBinary(pBinary, binarySize);
 
-    deleteDataReadFromFile(pBinary);
+    program.storeGenBinary(cachedFile.data(), cachedFile.size());
+
+    std::lock_guard<std::mutex> lock(indexMtx);
+    loadIndex();
+    index[kernelFileHash] = {cachedFile.size(), getTimestamp()};
+    indexDirty = true;
 
     return true;
 }
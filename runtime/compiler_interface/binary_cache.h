@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017, Intel Corporation
+ * Copyright (c) 2017 - 2018, Intel Corporation
  *
  * Permission is hereby granted, free of charge, to any person obtaining a
  * copy of this software and associated documentation files (the "Software"),
@@ -24,8 +24,10 @@
 
 #include <cstdint>
 #include <cstring>
+#include <map>
 #include <string>
 #include <mutex>
+#include <vector>
 
 #include "runtime/utilities/arrayref.h"
 
@@ -35,16 +37,51 @@ struct HardwareInfo;
 class Program;
 class BinaryCache {
   public:
+    struct IndexEntry {
+        uint64_t size;
+        uint64_t lastAccess;
+    };
+    using IndexT = std::map<std::string, IndexEntry>;
+
+    static const char *indexFileName;
+
+    BinaryCache();
+    BinaryCache(const std::string &cacheLocation, size_t sizeLimit);
+
     const std::string getCachedFileName(const HardwareInfo &hwInfo, ArrayRef<const char> input,
                                         ArrayRef<const char> options, ArrayRef<const char> internalOptions);
 
-    virtual ~BinaryCache(){};
+    virtual ~BinaryCache();
 
     virtual bool cacheBinary(const std::string kernelFileHash, const char *pBinary, uint32_t binarySize);
     virtual bool loadCachedBinary(const std::string kernelFileHash, Program &program);
 
+    static size_t getDefaultSizeLimit();
+
   protected:
-    static std::mutex cacheAccessMtx;
+    std::string getFilePath(const std::string &kernelFileHash) const;
+    std::string getIndexPath() const;
+    uint64_t getTimestamp();
+
+    void loadIndex();
+    void storeIndex();
+    bool appendIndexRecords(const std::string &records);
+    std::vector<std::string> evictEntries();
+    IndexT readIndexFile(size_t *numRecords = nullptr) const;
+    IndexT scanCacheDirectory() const;
+
+    std::string cacheLocation;
+    size_t sizeLimit;
+
+    // guards in-process view of the index only, entries themselves are
+    // written atomically and can be shared between processes without locking
+    std::mutex indexMtx;
+    IndexT index;
+    bool indexLoaded = false;
+    bool indexDirty = false;
+    // records in the on-disk index known to this process, index is rewritten once they exceed twice its entries
+    size_t numIndexRecords = 0;
+    uint64_t lastTimestamp = 0;
 };
 
 } // namesapce OCLRT
@@ -93,9 +93,13 @@ Device::~Device() {
         performanceCounters->shutdown();
     }
     if (commandStreamReceiver) {
+        commandStreamReceiver->closeAdaptiveDispatcher();
         commandStreamReceiver->flushBatchedSubmissions();
         delete commandStreamReceiver;
         commandStreamReceiver = nullptr;
+        if (memoryManager) {
+            memoryManager->csr = nullptr;
+        }
     }
 
     if (memoryManager) {
@@ -22,9 +22,37 @@
 
 #include "runtime/event/async_events_handler.h"
 #include "runtime/event/event.h"
+#include "runtime/command_queue/command_queue.h"
+#include "runtime/command_stream/command_stream_receiver.h"
+#include "runtime/device/device.h"
+#include "runtime/os_interface/debug_settings_manager.h"
+#include <algorithm>
 #include <iterator>
 
 namespace OCLRT {
+const size_t CallbackLatencyHistogram::numBuckets;
+
+void CallbackLatencyHistogram::record(std::chrono::microseconds latency) {
+    size_t bucket = 0;
+    for (auto count = latency.count(); count > 0 && bucket < numBuckets - 1; count >>= 1) {
+        bucket++;
+    }
+    buckets[bucket]++;
+    samples++;
+    maxLatency = std::max(maxLatency, latency);
+}
+
+static bool hasHigherTaskCount(Event *lhs, Event *rhs) {
+    return lhs->peekTaskCount() > rhs->peekTaskCount();
+}
+
+static CommandStreamReceiver *getCsrToWaitOn(Event *event) {
+    if ((event->getCommandQueue() == nullptr) || (event->peekTaskCount() == Event::eventNotReady) || event->isExternallySynchronized()) {
+        return nullptr;
+    }
+    return &event->getCommandQueue()->getDevice().getCommandStreamReceiver();
+}
+
 AsyncEventsHandler::AsyncEventsHandler() {
     allowAsyncProcess = false;
     registerList.reserve(64);
@@ -34,6 +62,7 @@ AsyncEventsHandler::AsyncEventsHandler() {
 
 AsyncEventsHandler::~AsyncEventsHandler() {
     closeThread();
+    printCallbackLatency();
 }
 
 void AsyncEventsHandler::registerEvent(Event *event) {
@@ -46,6 +75,10 @@ void AsyncEventsHandler::registerEvent(Event *event) {
     asyncCond.notify_one();
 }
 
+bool AsyncEventsHandler::isEventPending(Event *event) {
+    return event->peekHasCallbacks() || (event->isExternallySynchronized() && (event->peekExecutionStatus() > CL_COMPLETE));
+}
+
 Event *AsyncEventsHandler::processList() {
     uint32_t lowestTaskCount = Event::eventNotReady;
     Event *sleepCandidate = nullptr;
@@ -53,18 +86,79 @@ Event *AsyncEventsHandler::processList() {
 
     for (auto event : list) {
         event->updateExecutionStatus();
-        if (event->peekHasCallbacks() || (event->isExternallySynchronized() && (event->peekExecutionStatus() > CL_COMPLETE))) {
-            pendingList.push_back(event);
-            if (event->peekTaskCount() < lowestTaskCount) {
-                sleepCandidate = event;
-                lowestTaskCount = event->peekTaskCount();
-            }
-        } else {
+        if (isEventPending(event) == false) {
             event->decRefInternal();
+            continue;
+        }
+        auto csr = getCsrToWaitOn(event);
+        if (csr != nullptr) {
+            // only completion is left to wait for, park the event until its task count is reached
+            auto &heap = csrHeaps[csr];
+            heap.push_back(event);
+            std::push_heap(heap.begin(), heap.end(), hasHigherTaskCount);
+            eventsInCsrHeaps++;
+            continue;
+        }
+        pendingList.push_back(event);
+        if (event->peekTaskCount() < lowestTaskCount) {
+            sleepCandidate = event;
+            lowestTaskCount = event->peekTaskCount();
         }
     }
 
     list.swap(pendingList);
+
+    auto heapCandidate = processCsrHeaps();
+    if (heapCandidate && (heapCandidate->peekTaskCount() < lowestTaskCount)) {
+        sleepCandidate = heapCandidate;
+    }
+    return sleepCandidate;
+}
+
+Event *AsyncEventsHandler::processCsrHeaps() {
+    uint32_t lowestTaskCount = Event::eventNotReady;
+    Event *sleepCandidate = nullptr;
+
+    for (auto csrHeap = csrHeaps.begin(); csrHeap != csrHeaps.end();) {
+        auto &heap = csrHeap->second;
+        if (heap.empty()) {
+            // the CSR may already be gone once its last parked event was released
+            csrHeap = csrHeaps.erase(csrHeap);
+            continue;
+        }
+        auto completedTaskCount = *csrHeap->first->getTagAddress();
+        // events are popped on the first pass that sees their task count completed,
+        // so the tag read is when the handler learned about completion
+        auto completionSeenTime = std::chrono::steady_clock::now();
+
+        while (!heap.empty() && (heap.front()->peekTaskCount() <= completedTaskCount)) {
+            std::pop_heap(heap.begin(), heap.end(), hasHigherTaskCount);
+            auto event = heap.back();
+            heap.pop_back();
+            eventsInCsrHeaps--;
+
+            bool hadCallbacks = event->peekHasCallbacks();
+            event->updateExecutionStatus();
+            if (isEventPending(event)) {
+                list.push_back(event);
+                continue;
+            }
+            if (hadCallbacks) {
+                callbackLatency.record(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - completionSeenTime));
+            }
+            event->decRefInternal();
+        }
+
+        if (heap.empty()) {
+            csrHeap = csrHeaps.erase(csrHeap);
+            continue;
+        }
+        if (heap.front()->peekTaskCount() < lowestTaskCount) {
+            sleepCandidate = heap.front();
+            lowestTaskCount = sleepCandidate->peekTaskCount();
+        }
+        ++csrHeap;
+    }
     return sleepCandidate;
 }
 
@@ -80,7 +174,7 @@ void AsyncEventsHandler::asyncProcess() {
             releaseEvents();
             break;
         }
-        if (list.empty()) {
+        if (list.empty() && (eventsInCsrHeaps == 0)) {
             asyncCond.wait(lock);
         }
         lock.unlock();
@@ -122,6 +216,27 @@ void AsyncEventsHandler::releaseEvents() {
         event->decRefInternal();
     }
     list.clear();
+    for (auto &csrHeap : csrHeaps) {
+        for (auto event : csrHeap.second) {
+            event->decRefInternal();
+        }
+    }
+    csrHeaps.clear();
+    eventsInCsrHeaps = 0;
     UNRECOVERABLE_IF(!registerList.empty()) // transferred before release
 }
+
+void AsyncEventsHandler::printCallbackLatency() {
+    if (callbackLatency.samples == 0) {
+        return;
+    }
+    printDebugString(DebugManager.flags.PrintAsyncEventsCallbackLatency.get(), stdout, "Async events callback latency, samples: %llu, max: %lld us\n",
+                     static_cast<unsigned long long>(callbackLatency.samples), static_cast<long long>(callbackLatency.maxLatency.count()));
+    for (size_t bucket = 0; bucket < CallbackLatencyHistogram::numBuckets; bucket++) {
+        if (callbackLatency.buckets[bucket] != 0) {
+            printDebugString(DebugManager.flags.PrintAsyncEventsCallbackLatency.get(), stdout, "  < %llu us: %llu\n",
+                             1ull << bucket, static_cast<unsigned long long>(callbackLatency.buckets[bucket]));
+        }
+    }
+}
 } // namespace OCLRT
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017, Intel Corporation
+ * Copyright (c) 2017 - 2018, Intel Corporation
  *
  * Permission is hereby granted, free of charge, to any person obtaining a
  * copy of this software and associated documentation files (the "Software"),
@@ -27,9 +27,28 @@
 #include <atomic>
 #include <mutex>
 #include <condition_variable>
+#include <chrono>
+#include <cstdint>
+#include <unordered_map>
 
 namespace OCLRT {
 class Event;
+class CommandStreamReceiver;
+
+struct CallbackLatencyHistogram {
+    // bucket 0 counts latencies below 1us, bucket n counts latencies in [2^(n-1), 2^n) us,
+    // the last bucket collects everything above.
+    // Latency is measured from the handler reading a CSR tag that shows the event's task count
+    // completed until the event's callbacks have returned; time between the GPU reaching
+    // the task count and the handler reading the tag is not included
+    static const size_t numBuckets = 16;
+
+    void record(std::chrono::microseconds latency);
+
+    uint64_t buckets[numBuckets] = {};
+    uint64_t samples = 0;
+    std::chrono::microseconds maxLatency{0};
+};
 
 class AsyncEventsHandler {
   public:
@@ -38,15 +57,27 @@ class AsyncEventsHandler {
     void registerEvent(Event *event);
     void closeThread();
 
+    const CallbackLatencyHistogram &peekCallbackLatencyHistogram() const { return callbackLatency; }
+
   protected:
+    // submitted events wait in a min-heap of their CSR ordered by task count,
+    // so each pass visits only the events whose task count has been reached
+    typedef std::vector<Event *> EventHeap;
+
     Event *processList();
+    Event *processCsrHeaps();
+    bool isEventPending(Event *event);
     void asyncProcess();
     void releaseEvents();
+    void printCallbackLatency();
     MOCKABLE_VIRTUAL void openThread();
     MOCKABLE_VIRTUAL void transferRegisterList();
     std::vector<Event *> registerList;
     std::vector<Event *> list;
     std::vector<Event *> pendingList;
+    std::unordered_map<CommandStreamReceiver *, EventHeap> csrHeaps;
+    size_t eventsInCsrHeaps = 0;
+    CallbackLatencyHistogram callbackLatency;
 
     std::unique_ptr<std::thread> thread;
     std::mutex asyncMtx;
@@ -37,6 +37,8 @@
 #include "runtime/platform/platform.h"
 #include "runtime/event/async_events_handler.h"
 
+#include <algorithm>
+
 namespace OCLRT {
 
 const cl_uint Event::eventNotReady = 0xFFFFFFF0;
@@ -132,13 +134,15 @@ Event::~Event() {
     }
 
     if (ctx != nullptr) {
+        // GPU may still write to the tags of a released event
+        uint32_t tagsTaskCount = (peekTaskCount() == Event::eventNotReady) ? 0u : peekTaskCount();
         if (timeStampNode != nullptr) {
             TagAllocator<HwTimeStamps> *allocator = ctx->getDevice(0)->getMemoryManager()->getEventTsAllocator();
-            allocator->returnTag(timeStampNode);
+            allocator->returnTagWhenCompleted(timeStampNode, tagsTaskCount);
         }
         if (perfCounterNode != nullptr) {
             TagAllocator<HwPerfCounter> *allocator = ctx->getDevice(0)->getMemoryManager()->getEventPerfCountAllocator();
-            allocator->returnTag(perfCounterNode);
+            allocator->returnTagWhenCompleted(perfCounterNode, tagsTaskCount);
         }
         ctx->decRefInternal();
     }
@@ -306,6 +310,10 @@ inline bool Event::wait(bool blocking, bool useQuickKmdSleep) {
     return true;
 }
 
+bool Event::isWaitableOnCsr() const {
+    return (cmdQueue != nullptr) && (taskCount != Event::eventNotReady) && (isUserEvent() == false);
+}
+
 void Event::updateExecutionStatus() {
     if (taskLevel == Event::eventNotReady) {
         return;
@@ -479,6 +487,41 @@ cl_int Event::waitForEvents(cl_uint numEvents,
         }
     }
 
+    // wait only once per command stream receiver, for the highest task count found on the list
+    struct CsrWait {
+        CommandStreamReceiver *csr;
+        CommandQueue *cmdQueue;
+        uint32_t taskCount;
+        FlushStamp flushStamp;
+    };
+    StackVec<CsrWait, 4> csrWaits;
+    auto findCsrWait = [&csrWaits](Event *event) {
+        auto csr = &event->cmdQueue->getDevice().getCommandStreamReceiver();
+        return std::find_if(csrWaits.begin(), csrWaits.end(), [csr](const CsrWait &csrWait) { return csrWait.csr == csr; });
+    };
+    for (const cl_event *it = eventList, *end = eventList + numEvents; it != end; ++it) {
+        Event *event = castToObjectOrAbort<Event>(*it);
+        if (event->peekExecutionStatus() < CL_COMPLETE) {
+            // failed events are reported right away, without waiting for the rest of the list
+            return CL_EXEC_STATUS_ERROR_FOR_EVENTS_IN_WAIT_LIST;
+        }
+        if (event->isWaitableOnCsr() == false) {
+            continue;
+        }
+        auto csrWait = findCsrWait(event);
+        if (csrWait == csrWaits.end()) {
+            csrWaits.push_back({&event->cmdQueue->getDevice().getCommandStreamReceiver(), event->cmdQueue, event->peekTaskCount(), event->flushStamp->peekStamp()});
+        } else if (event->peekTaskCount() > csrWait->taskCount) {
+            csrWait->cmdQueue = event->cmdQueue;
+            csrWait->taskCount = event->peekTaskCount();
+            csrWait->flushStamp = event->flushStamp->peekStamp();
+        }
+    }
+    for (auto &csrWait : csrWaits) {
+        csrWait.cmdQueue->waitUntilComplete(csrWait.taskCount, csrWait.flushStamp, false);
+        csrWait.cmdQueue->getDevice().getMemoryManager()->cleanAllocationList(csrWait.taskCount, TEMPORARY_ALLOCATION);
+    }
+
     using WorkerListT = StackVec<cl_event, 64>;
     WorkerListT workerList1(eventList, eventList + numEvents);
     WorkerListT workerList2;
@@ -495,6 +538,15 @@ cl_int Event::waitForEvents(cl_uint numEvents,
                 return CL_EXEC_STATUS_ERROR_FOR_EVENTS_IN_WAIT_LIST;
             }
 
+            if (event->isWaitableOnCsr()) {
+                // already covered by the per-CSR wait above, only the status needs to be updated
+                auto csrWait = findCsrWait(event);
+                if (csrWait != csrWaits.end() && event->peekTaskCount() <= csrWait->taskCount) {
+                    event->updateExecutionStatus();
+                    continue;
+                }
+            }
+
             if (event->wait(false, false) == false) {
                 pendingEventsLeft->push_back(event);
             }
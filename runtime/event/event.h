@@ -226,6 +226,7 @@ class Event : public BaseObject<_cl_event>, public IDNode<Event> {
     //returns true on success
     //if(blocking==false), will return with false instead of blocking while waiting for completion
     virtual bool wait(bool blocking, bool useQuickKmdSleep);
+    bool isWaitableOnCsr() const;
 
     bool isUserEvent() const {
         return (CL_COMMAND_USER == cmdType);
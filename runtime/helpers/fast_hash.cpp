@@ -0,0 +1,148 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/helpers/fast_hash.h"
+#include "runtime/utilities/cpu_info.h"
+#include <cstring>
+
+namespace OCLRT {
+
+namespace {
+// Slice-by-8 tables for CRC32C (Castagnoli, reflected polynomial 0x82F63B78).
+// Lane updates match the crc32 instruction, i.e. no pre/post inversion.
+struct Crc32cTables {
+    uint32_t table[8][256];
+
+    Crc32cTables() {
+        for (uint32_t i = 0; i < 256; i++) {
+            uint32_t crc = i;
+            for (int bit = 0; bit < 8; bit++) {
+                crc = (crc >> 1) ^ (0x82F63B78u & (0u - (crc & 1u)));
+            }
+            table[0][i] = crc;
+        }
+        for (uint32_t i = 0; i < 256; i++) {
+            for (int slice = 1; slice < 8; slice++) {
+                table[slice][i] = (table[slice - 1][i] >> 8) ^ table[0][table[slice - 1][i] & 0xFF];
+            }
+        }
+    }
+};
+
+const Crc32cTables &getCrc32cTables() {
+    static const Crc32cTables tables;
+    return tables;
+}
+
+inline uint64_t mix64(uint64_t value) {
+    value ^= value >> 33;
+    value *= 0xff51afd7ed558ccdull;
+    value ^= value >> 33;
+    value *= 0xc4ceb9fe1a85ec53ull;
+    value ^= value >> 33;
+    return value;
+}
+} // namespace
+
+void processBlocksCrc32c(uint32_t *lanes, const char *data, size_t numBlocks) {
+    const auto &t = getCrc32cTables().table;
+    while (numBlocks-- > 0) {
+        for (size_t lane = 0; lane < FastHash::numLanes; lane++) {
+            uint32_t lo, hi;
+            memcpy(&lo, data, sizeof(lo));
+            memcpy(&hi, data + sizeof(lo), sizeof(hi));
+            uint32_t crc = lanes[lane] ^ lo;
+            lanes[lane] = t[7][crc & 0xFF] ^ t[6][(crc >> 8) & 0xFF] ^ t[5][(crc >> 16) & 0xFF] ^ t[4][crc >> 24] ^
+                          t[3][hi & 0xFF] ^ t[2][(hi >> 8) & 0xFF] ^ t[1][(hi >> 16) & 0xFF] ^ t[0][hi >> 24];
+            data += sizeof(uint64_t);
+        }
+    }
+}
+
+FastHash::ProcessBlocksFunc FastHash::processBlocks = processBlocksCrc32c;
+
+// Initialize the block function based on CPU capabilities
+struct FastHashInitializer {
+    FastHashInitializer() {
+        if (CpuInfo::getInstance().isFeatureSupported(CpuInfo::featureSsE42)) {
+            FastHash::processBlocks = processBlocksCrc32cSse42;
+        }
+    }
+} fastHashInitializer;
+
+void FastHash::reset() {
+    lanes[0] = 0x428a2f98;
+    lanes[1] = 0x71374491;
+    lanes[2] = 0xb5c0fbcf;
+    lanes[3] = 0xe9b5dba5;
+    tailSize = 0;
+    totalSize = 0;
+}
+
+void FastHash::update(const char *buff, size_t size) {
+    if (buff == nullptr) {
+        return;
+    }
+    totalSize += size;
+
+    if (tailSize > 0) {
+        auto toCopy = blockSize - tailSize < size ? blockSize - tailSize : size;
+        memcpy(tail + tailSize, buff, toCopy);
+        tailSize += toCopy;
+        buff += toCopy;
+        size -= toCopy;
+        if (tailSize < blockSize) {
+            return;
+        }
+        processBlocks(lanes, tail, 1);
+        tailSize = 0;
+    }
+
+    auto numBlocks = size / blockSize;
+    if (numBlocks > 0) {
+        processBlocks(lanes, buff, numBlocks);
+        buff += numBlocks * blockSize;
+        size -= numBlocks * blockSize;
+    }
+
+    if (size > 0) {
+        memcpy(tail, buff, size);
+        tailSize = size;
+    }
+}
+
+uint64_t FastHash::finish() const {
+    uint32_t result[numLanes];
+    memcpy(result, lanes, sizeof(result));
+
+    if (tailSize > 0) {
+        char lastBlock[blockSize] = {};
+        memcpy(lastBlock, tail, tailSize);
+        processBlocks(result, lastBlock, 1);
+    }
+
+    // length goes into the final mix so that zero padding of the last block is unambiguous
+    auto lo = (static_cast<uint64_t>(result[0]) << 32) | result[1];
+    auto hi = (static_cast<uint64_t>(result[2]) << 32) | result[3];
+    return mix64(mix64(lo ^ (totalSize * 0x9e3779b97f4a7c15ull)) ^ hi);
+}
+} // namespace OCLRT
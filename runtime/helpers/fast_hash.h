@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+namespace OCLRT {
+// Non-cryptographic 64-bit hash for runtime-internal keys (e.g. binary cache file names).
+// Input is consumed in 32-byte blocks by four independent CRC32C lanes, using SSE4.2 crc32
+// when the CPU supports it and an equivalent table driven implementation otherwise.
+// Checksums emitted by the compiler are computed with Hash and must be verified with Hash.
+class FastHash {
+  public:
+    static const size_t numLanes = 4;
+    static const size_t blockSize = numLanes * sizeof(uint64_t);
+
+    typedef void (*ProcessBlocksFunc)(uint32_t *lanes, const char *data, size_t numBlocks);
+
+    FastHash() {
+        reset();
+    }
+
+    void update(const char *buff, size_t size);
+    uint64_t finish() const;
+    void reset();
+
+    static uint64_t hash(const char *buff, size_t size) {
+        FastHash hash;
+        hash.update(buff, size);
+        return hash.finish();
+    }
+
+    static ProcessBlocksFunc processBlocks;
+
+  protected:
+    uint32_t lanes[numLanes];
+    char tail[blockSize];
+    size_t tailSize;
+    uint64_t totalSize;
+};
+
+void processBlocksCrc32c(uint32_t *lanes, const char *data, size_t numBlocks);
+void processBlocksCrc32cSse42(uint32_t *lanes, const char *data, size_t numBlocks);
+} // namespace OCLRT
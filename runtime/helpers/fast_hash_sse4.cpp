@@ -0,0 +1,52 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/helpers/fast_hash.h"
+#include <cstring>
+#include <nmmintrin.h>
+
+namespace OCLRT {
+void processBlocksCrc32cSse42(uint32_t *lanes, const char *data, size_t numBlocks) {
+    // independent lanes hide the latency of crc32
+    uint32_t crc0 = lanes[0], crc1 = lanes[1], crc2 = lanes[2], crc3 = lanes[3];
+    while (numBlocks-- > 0) {
+        uint64_t value[FastHash::numLanes];
+        memcpy(value, data, sizeof(value));
+#if defined(_M_X64) || defined(__x86_64__)
+        crc0 = static_cast<uint32_t>(_mm_crc32_u64(crc0, value[0]));
+        crc1 = static_cast<uint32_t>(_mm_crc32_u64(crc1, value[1]));
+        crc2 = static_cast<uint32_t>(_mm_crc32_u64(crc2, value[2]));
+        crc3 = static_cast<uint32_t>(_mm_crc32_u64(crc3, value[3]));
+#else
+        crc0 = _mm_crc32_u32(_mm_crc32_u32(crc0, static_cast<uint32_t>(value[0])), static_cast<uint32_t>(value[0] >> 32));
+        crc1 = _mm_crc32_u32(_mm_crc32_u32(crc1, static_cast<uint32_t>(value[1])), static_cast<uint32_t>(value[1] >> 32));
+        crc2 = _mm_crc32_u32(_mm_crc32_u32(crc2, static_cast<uint32_t>(value[2])), static_cast<uint32_t>(value[2] >> 32));
+        crc3 = _mm_crc32_u32(_mm_crc32_u32(crc3, static_cast<uint32_t>(value[3])), static_cast<uint32_t>(value[3] >> 32));
+#endif
+        data += FastHash::blockSize;
+    }
+    lanes[0] = crc0;
+    lanes[1] = crc1;
+    lanes[2] = crc2;
+    lanes[3] = crc3;
+}
+} // namespace OCLRT
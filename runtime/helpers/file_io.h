@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017, Intel Corporation
+ * Copyright (c) 2017 - 2018, Intel Corporation
  *
  * Permission is hereby granted, free of charge, to any person obtaining a
  * copy of this software and associated documentation files (the "Software"),
@@ -38,3 +38,4 @@ size_t writeDataToFile(
 
 bool fileExists(const std::string &fileName);
 bool fileExistsHasSize(const std::string &fileName);
+size_t getFileSize(const std::string &fileName);
@@ -0,0 +1,160 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/helpers/host_copy.h"
+#include "runtime/helpers/aligned_memory.h"
+#include "runtime/helpers/ptr_math.h"
+#include "runtime/helpers/string.h"
+#include "runtime/os_interface/debug_settings_manager.h"
+#include "runtime/utilities/worker_pool.h"
+
+#include <algorithm>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define HOST_COPY_STREAMING_STORES 1
+#endif
+
+namespace OCLRT {
+
+const size_t HostCopy::parallelCopyThreshold;
+const size_t HostCopy::minBytesPerTask;
+const size_t HostCopy::nonTemporalCopyThreshold;
+const size_t HostCopy::taskChunkAlignment;
+
+HostCopyRegion HostCopy::mergeContiguousRows(const HostCopyRegion &region) {
+    HostCopyRegion merged = region;
+    if (merged.numRows > 1 && merged.srcRowPitch == merged.rowSize && merged.dstRowPitch == merged.rowSize) {
+        merged.rowSize *= merged.numRows;
+        merged.srcRowPitch = merged.dstRowPitch = merged.rowSize;
+        merged.numRows = 1;
+    }
+    if (merged.numRows == 1 && merged.numSlices > 1 && merged.srcSlicePitch == merged.rowSize && merged.dstSlicePitch == merged.rowSize) {
+        merged.rowSize *= merged.numSlices;
+        merged.srcRowPitch = merged.dstRowPitch = merged.rowSize;
+        merged.srcSlicePitch = merged.dstSlicePitch = merged.rowSize;
+        merged.numSlices = 1;
+    }
+    return merged;
+}
+
+bool HostCopy::isNonTemporalCopyPreferred(size_t size) {
+    auto nonTemporal = DebugManager.flags.HostCopyNonTemporal.get();
+    if (nonTemporal != -1) {
+        return nonTemporal != 0;
+    }
+    return size >= nonTemporalCopyThreshold;
+}
+
+size_t HostCopy::getNumTasks(size_t size, WorkerPool *workerPool) {
+    if (workerPool == nullptr || size < parallelCopyThreshold) {
+        return 1;
+    }
+    return std::max(std::min(static_cast<size_t>(workerPool->getNumWorkers()) + 1, size / minBytesPerTask), size_t(1));
+}
+
+// streaming stores are weakly ordered, callers fence once after the last one
+static void copyStreaming(void *dst, const void *src, size_t size) {
+#ifdef HOST_COPY_STREAMING_STORES
+    auto head = std::min(static_cast<size_t>(alignUp(reinterpret_cast<uintptr_t>(dst), 16) - reinterpret_cast<uintptr_t>(dst)), size);
+    memcpy_s(dst, head, src, head);
+    auto dstBytes = static_cast<char *>(dst) + head;
+    auto srcBytes = static_cast<const char *>(src) + head;
+    size -= head;
+
+    auto dstVector = reinterpret_cast<__m128i *>(dstBytes);
+    auto srcVector = reinterpret_cast<const __m128i *>(srcBytes);
+    for (; size >= 64; size -= 64, dstVector += 4, srcVector += 4) {
+        auto v0 = _mm_loadu_si128(srcVector);
+        auto v1 = _mm_loadu_si128(srcVector + 1);
+        auto v2 = _mm_loadu_si128(srcVector + 2);
+        auto v3 = _mm_loadu_si128(srcVector + 3);
+        _mm_stream_si128(dstVector, v0);
+        _mm_stream_si128(dstVector + 1, v1);
+        _mm_stream_si128(dstVector + 2, v2);
+        _mm_stream_si128(dstVector + 3, v3);
+    }
+    memcpy_s(dstVector, size, srcVector, size);
+#else
+    memcpy_s(dst, size, src, size);
+#endif
+}
+
+static void fenceStreamingStores() {
+#ifdef HOST_COPY_STREAMING_STORES
+    _mm_sfence();
+#endif
+}
+
+void HostCopy::copyNonTemporal(void *dst, const void *src, size_t size) {
+    copyStreaming(dst, src, size);
+    fenceStreamingStores();
+}
+
+void HostCopy::copy(const HostCopyRegion &region, WorkerPool *workerPool) {
+    auto merged = mergeContiguousRows(region);
+    auto totalRows = merged.numRows * merged.numSlices;
+    auto totalSize = merged.rowSize * totalRows;
+    if (totalSize == 0) {
+        return;
+    }
+
+    auto nonTemporal = isNonTemporalCopyPreferred(totalSize);
+    auto numTasks = getNumTasks(totalSize, workerPool);
+
+    // rows are cut into chunks when there are fewer rows than tasks, e.g. a single merged span
+    auto chunksPerRow = (numTasks + totalRows - 1) / totalRows;
+    auto chunkSize = alignUp((merged.rowSize + chunksPerRow - 1) / chunksPerRow, taskChunkAlignment);
+    chunksPerRow = (merged.rowSize + chunkSize - 1) / chunkSize;
+    auto totalChunks = totalRows * chunksPerRow;
+
+    auto copyChunks = [&](size_t taskIndex) {
+        auto firstChunk = totalChunks * taskIndex / numTasks;
+        auto lastChunk = totalChunks * (taskIndex + 1) / numTasks;
+        for (auto chunk = firstChunk; chunk < lastChunk; chunk++) {
+            auto row = chunk / chunksPerRow;
+            auto rowInSlice = row % merged.numRows;
+            auto slice = row / merged.numRows;
+            auto offsetInRow = (chunk % chunksPerRow) * chunkSize;
+            auto size = std::min(chunkSize, merged.rowSize - offsetInRow);
+
+            auto dst = ptrOffset(merged.dst, slice * merged.dstSlicePitch + rowInSlice * merged.dstRowPitch + offsetInRow);
+            auto src = ptrOffset(merged.src, slice * merged.srcSlicePitch + rowInSlice * merged.srcRowPitch + offsetInRow);
+            if (nonTemporal) {
+                copyStreaming(dst, src, size);
+            } else {
+                memcpy_s(dst, size, src, size);
+            }
+        }
+        if (nonTemporal) {
+            // make this thread's stores visible before parallelFor reports the task done
+            fenceStreamingStores();
+        }
+    };
+
+    if (numTasks == 1) {
+        copyChunks(0);
+    } else {
+        workerPool->parallelFor(numTasks, copyChunks);
+    }
+}
+} // namespace OCLRT
@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+#include <cstddef>
+
+namespace OCLRT {
+class WorkerPool;
+
+// numSlices x numRows rows of rowSize bytes, first row starts at dst / src
+struct HostCopyRegion {
+    void *dst;
+    size_t dstRowPitch;
+    size_t dstSlicePitch;
+    const void *src;
+    size_t srcRowPitch;
+    size_t srcSlicePitch;
+    size_t rowSize;
+    size_t numRows;
+    size_t numSlices;
+};
+
+// CPU copies between host memory and memory object storage. Rows with matching pitches are merged
+// into one span, large regions are split across the worker pool and written with streaming stores
+// so the destination does not evict the working set of the calling thread.
+class HostCopy {
+  public:
+    static const size_t parallelCopyThreshold = 2 * 1024 * 1024;
+    static const size_t minBytesPerTask = 512 * 1024;
+    static const size_t nonTemporalCopyThreshold = 4 * 1024 * 1024;
+    static const size_t taskChunkAlignment = 64;
+
+    static void copy(const HostCopyRegion &region, WorkerPool *workerPool);
+    static void copyNonTemporal(void *dst, const void *src, size_t size);
+
+    static HostCopyRegion mergeContiguousRows(const HostCopyRegion &region);
+    static bool isNonTemporalCopyPreferred(size_t size);
+    static size_t getNumTasks(size_t size, WorkerPool *workerPool);
+};
+} // namespace OCLRT
@@ -49,6 +49,14 @@ struct KernelCommandsHelper : public PerThreadDataHelper {
         IndirectHeap &indirectHeap,
         const KernelInfo &kernelInfo);
 
+    static size_t getKernelBinaryOffset(
+        IndirectHeap &indirectHeap,
+        const KernelInfo &kernelInfo);
+
+    static size_t getBindingTablePointer(
+        IndirectHeap &ssh,
+        const Kernel &kernel);
+
     static size_t sendInterfaceDescriptorData(
         const IndirectHeap &indirectHeap,
         uint64_t offsetInterfaceDescriptor,
@@ -162,6 +162,27 @@ size_t KernelCommandsHelper<GfxFamily>::copyKernelBinary(
     return kernelStartOffset;
 }
 
+template <typename GfxFamily>
+size_t KernelCommandsHelper<GfxFamily>::getKernelBinaryOffset(
+    IndirectHeap &indirectHeap,
+    const KernelInfo &kernelInfo) {
+    if (DebugManager.flags.EnableKernelIsaHeapCache.get() == 0) {
+        return copyKernelBinary(indirectHeap, kernelInfo);
+    }
+
+    auto pKernelHeap = kernelInfo.heapInfo.pKernelHeap;
+    auto kernelHeapSize = kernelInfo.heapInfo.pKernelHeader->KernelHeapSize;
+
+    size_t kernelStartOffset = 0;
+    if (indirectHeap.findKernelIsa(kernelInfo.isaId, pKernelHeap, kernelHeapSize, kernelStartOffset)) {
+        return kernelStartOffset;
+    }
+
+    kernelStartOffset = copyKernelBinary(indirectHeap, kernelInfo);
+    indirectHeap.storeKernelIsa(kernelInfo.isaId, pKernelHeap, kernelHeapSize, kernelStartOffset);
+    return kernelStartOffset;
+}
+
 template <typename GfxFamily>
 size_t KernelCommandsHelper<GfxFamily>::sendInterfaceDescriptorData(
     const IndirectHeap &indirectHeap,
@@ -327,6 +348,26 @@ size_t KernelCommandsHelper<GfxFamily>::pushBindingTableAndSurfaceStates(Indirec
     return ptrDiff(dstBtiTableBase, dstHeap.getCpuBase());
 }
 
+template <typename GfxFamily>
+size_t KernelCommandsHelper<GfxFamily>::getBindingTablePointer(
+    IndirectHeap &ssh,
+    const Kernel &kernel) {
+    if (DebugManager.flags.EnableKernelStateReuse.get() == 0) {
+        return pushBindingTableAndSurfaceStates(ssh, kernel);
+    }
+
+    // surface states pushed by an earlier dispatch are still valid if the kernel's SSH did not change since
+    size_t bindingTablePointer = 0;
+    auto sshGeneration = kernel.getSurfaceStateHeapGeneration();
+    if (ssh.findBindingTable(sshGeneration, bindingTablePointer)) {
+        return bindingTablePointer;
+    }
+
+    bindingTablePointer = pushBindingTableAndSurfaceStates(ssh, kernel);
+    ssh.storeBindingTable(sshGeneration, bindingTablePointer, ssh.getUsed());
+    return bindingTablePointer;
+}
+
 template <typename GfxFamily>
 size_t KernelCommandsHelper<GfxFamily>::sendIndirectState(
     LinearStream &commandStream,
@@ -348,13 +389,13 @@ size_t KernelCommandsHelper<GfxFamily>::sendIndirectState(
 
     DEBUG_BREAK_IF(simd != 8 && simd != 16 && simd != 32);
 
-    // Copy the kernel over to the ISH
-    auto kernelStartOffset = copyKernelBinary(ih, kernel.getKernelInfo());
+    // Copy the kernel over to the ISH, unless an earlier dispatch already placed it there
+    auto kernelStartOffset = getKernelBinaryOffset(ih, kernel.getKernelInfo());
 
     const auto &kernelInfo = kernel.getKernelInfo();
     const auto &patchInfo = kernelInfo.patchInfo;
 
-    auto dstBindingTablePointer = pushBindingTableAndSurfaceStates(ssh, kernel);
+    auto dstBindingTablePointer = getBindingTablePointer(ssh, kernel);
 
     // Copy our sampler state if it exists
     size_t samplerStateOffset = 0;
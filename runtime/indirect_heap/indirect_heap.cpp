@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017, Intel Corporation
+ * Copyright (c) 2017 - 2018, Intel Corporation
  *
  * Permission is hereby granted, free of charge, to any person obtaining a
  * copy of this software and associated documentation files (the "Software"),
@@ -29,4 +29,38 @@ IndirectHeap::IndirectHeap(GraphicsAllocation *gfxAllocation) : BaseClass(gfxAll
 
 IndirectHeap::IndirectHeap(void *buffer, size_t bufferSize) : BaseClass(buffer, bufferSize) {
 }
+
+bool IndirectHeap::findKernelIsa(uint64_t isaId, const void *kernelHeap, size_t kernelHeapSize, size_t &offset) const {
+    auto entry = kernelIsaOffsets.find(isaId);
+    if (entry == kernelIsaOffsets.end()) {
+        return false;
+    }
+    auto &isa = entry->second;
+    if ((isa.kernelHeap != kernelHeap) || (isa.kernelHeapSize != kernelHeapSize) || (isa.offset + isa.kernelHeapSize > getUsed())) {
+        return false;
+    }
+    offset = isa.offset;
+    return true;
+}
+
+void IndirectHeap::storeKernelIsa(uint64_t isaId, const void *kernelHeap, size_t kernelHeapSize, size_t offset) {
+    kernelIsaOffsets[isaId] = {kernelHeap, kernelHeapSize, offset};
+}
+
+bool IndirectHeap::findBindingTable(uint64_t sshGeneration, size_t &bindingTablePointer) const {
+    auto entry = bindingTablePointers.find(sshGeneration);
+    if (entry == bindingTablePointers.end()) {
+        return false;
+    }
+    auto &bindingTable = entry->second;
+    if (bindingTable.surfaceStatesEnd > getUsed()) {
+        return false;
+    }
+    bindingTablePointer = bindingTable.bindingTablePointer;
+    return true;
+}
+
+void IndirectHeap::storeBindingTable(uint64_t sshGeneration, size_t bindingTablePointer, size_t surfaceStatesEnd) {
+    bindingTablePointers[sshGeneration] = {bindingTablePointer, surfaceStatesEnd};
+}
 }
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017, Intel Corporation
+ * Copyright (c) 2017 - 2018, Intel Corporation
  *
  * Permission is hereby granted, free of charge, to any person obtaining a
  * copy of this software and associated documentation files (the "Software"),
@@ -25,6 +25,8 @@
 #include "runtime/helpers/aligned_memory.h"
 #include "runtime/helpers/ptr_math.h"
 #include "runtime/helpers/basic_math.h"
+#include <cstdint>
+#include <unordered_map>
 
 namespace OCLRT {
 class GraphicsAllocation;
@@ -54,10 +56,41 @@ class IndirectHeap : public LinearStream {
     IndirectHeap &operator=(const IndirectHeap &) = delete;
 
     void align(size_t alignment);
+    void replaceBuffer(void *buffer, size_t bufferSize);
+
+    // Kernel ISA already copied into this heap can be pointed to by later dispatches,
+    // entries are dropped when the heap gets a new buffer
+    bool findKernelIsa(uint64_t isaId, const void *kernelHeap, size_t kernelHeapSize, size_t &offset) const;
+    void storeKernelIsa(uint64_t isaId, const void *kernelHeap, size_t kernelHeapSize, size_t offset);
+    size_t peekNumCachedKernelIsa() const { return kernelIsaOffsets.size(); }
+
+    // Same for surface states and binding table of a kernel, keyed by its SSH generation
+    bool findBindingTable(uint64_t sshGeneration, size_t &bindingTablePointer) const;
+    void storeBindingTable(uint64_t sshGeneration, size_t bindingTablePointer, size_t surfaceStatesEnd);
+    size_t peekNumCachedBindingTables() const { return bindingTablePointers.size(); }
+
+  protected:
+    struct KernelIsaEntry {
+        const void *kernelHeap;
+        size_t kernelHeapSize;
+        size_t offset;
+    };
+    struct BindingTableEntry {
+        size_t bindingTablePointer;
+        size_t surfaceStatesEnd;
+    };
+    std::unordered_map<uint64_t, KernelIsaEntry> kernelIsaOffsets;
+    std::unordered_map<uint64_t, BindingTableEntry> bindingTablePointers;
 };
 
 inline void IndirectHeap::align(size_t alignment) {
     auto address = alignUp(ptrOffset(buffer, sizeUsed), alignment);
     sizeUsed = ptrDiff(address, buffer);
 }
+
+inline void IndirectHeap::replaceBuffer(void *buffer, size_t bufferSize) {
+    BaseClass::replaceBuffer(buffer, bufferSize);
+    kernelIsaOffsets.clear();
+    bindingTablePointers.clear();
+}
 }
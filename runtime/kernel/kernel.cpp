@@ -50,6 +50,7 @@
 #include "patch_list.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cstdint>
 #include <vector>
 
@@ -98,6 +99,7 @@ Kernel::Kernel(Program *programArg, const KernelInfo &kernelInfoArg, const Devic
       localBindingTableOffset(0),
       pSshLocal(nullptr),
       sshLocalSize(0),
+      sshGeneration(generateSshGeneration()),
       crossThreadData(nullptr),
       crossThreadDataSize(0),
       privateSurface(nullptr),
@@ -185,6 +187,8 @@ cl_int Kernel::initialize() {
         const auto &heapInfo = kernelInfo.heapInfo;
         const auto &patchInfo = kernelInfo.patchInfo;
 
+        program->getKernelIsaAllocation(kernelInfo);
+
         crossThreadDataSize = patchInfo.dataParameterStream
                                   ? patchInfo.dataParameterStream->DataParameterStreamSize
                                   : 0;
@@ -695,6 +699,7 @@ void Kernel::substituteKernelHeap(void *newKernelHeap, size_t newKernelHeapSize)
     SKernelBinaryHeaderCommon *pHeader = const_cast<SKernelBinaryHeaderCommon *>(pKernelInfo->heapInfo.pKernelHeader);
     pHeader->KernelHeapSize = static_cast<uint32_t>(newKernelHeapSize);
     pKernelInfo->isKernelHeapSubstituted = true;
+    pKernelInfo->isaId = KernelInfo::generateIsaId();
 }
 
 bool Kernel::isKernelHeapSubstituted() const {
@@ -717,6 +722,8 @@ const void *Kernel::getSurfaceStateHeap() const {
 }
 
 void *Kernel::getSurfaceStateHeap() {
+    // caller may write surface states, copies pushed to queue heaps can no longer be reused
+    sshGeneration = generateSshGeneration();
     return const_cast<void *>(const_cast<const Kernel *>(this)->getSurfaceStateHeap());
 }
 
@@ -744,6 +751,12 @@ void Kernel::resizeSurfaceStateHeap(void *pNewSsh, size_t newSshSize, size_t new
     sshLocalSize = static_cast<uint32_t>(newSshSize);
     numberOfBindingTableStates = newBindingTableCount;
     localBindingTableOffset = newBindingTableOffset;
+    sshGeneration = generateSshGeneration();
+}
+
+uint64_t Kernel::generateSshGeneration() {
+    static std::atomic<uint64_t> nextSshGeneration(1);
+    return nextSshGeneration++;
 }
 
 uint32_t Kernel::getScratchSizeValueToProgramMediaVfeState(int scratchSize) {
@@ -870,6 +883,22 @@ void Kernel::storeKernelArg(uint32_t argIndex, kernelArgType argType, const void
     kernelArguments[argIndex].size = argSize;
     kernelArguments[argIndex].pSvmAlloc = argSvmAlloc;
     kernelArguments[argIndex].svmFlags = argSvmFlags;
+    kernelArguments[argIndex].patchedAllocation = nullptr;
+}
+
+bool Kernel::isArgPatchedWithBuffer(uint32_t argIndex, Buffer &buffer) const {
+    if (DebugManager.flags.EnableKernelStateReuse.get() == 0 || DebugManager.flags.AddPatchInfoCommentsForAUBDump.get()) {
+        return false;
+    }
+    const auto &arg = kernelArguments[argIndex];
+    auto allocation = buffer.getGraphicsAllocation();
+    return arg.isPatched &&
+           arg.type == BUFFER_OBJ &&
+           arg.object == static_cast<const _cl_mem *>(&buffer) &&
+           arg.patchedAllocation == allocation &&
+           arg.patchedGpuAddress == allocation->getGpuAddress() + buffer.getOffset() &&
+           arg.patchedSize == buffer.getSize() &&
+           arg.patchedFlags == buffer.getFlags();
 }
 
 const void *Kernel::getKernelArg(uint32_t argIndex) const {
@@ -1078,9 +1107,18 @@ cl_int Kernel::setArgBuffer(uint32_t argIndex,
         auto clMemObj = *clMem;
         DBG_LOG_INPUTS("setArgBuffer cl_mem", clMemObj);
 
+        auto buffer = castToObject<Buffer>(clMemObj);
+        auto argPatched = buffer && isArgPatchedWithBuffer(argIndex, *buffer);
+        auto patchedAllocation = kernelArguments[argIndex].patchedAllocation;
+
         storeKernelArg(argIndex, BUFFER_OBJ, clMemObj, argVal, argSize);
 
-        auto buffer = castToObject<Buffer>(clMemObj);
+        if (argPatched) {
+            // cross-thread data and surface state already describe this buffer
+            kernelArguments[argIndex].patchedAllocation = patchedAllocation;
+            return CL_SUCCESS;
+        }
+
         if (!buffer)
             return CL_INVALID_MEM_OBJECT;
 
@@ -1105,6 +1143,12 @@ cl_int Kernel::setArgBuffer(uint32_t argIndex,
             buffer->setArgStateful(const_cast<void *>(surfaceState));
         }
 
+        auto &arg = kernelArguments[argIndex];
+        arg.patchedAllocation = buffer->getGraphicsAllocation();
+        arg.patchedGpuAddress = buffer->getGraphicsAllocation()->getGpuAddress() + buffer->getOffset();
+        arg.patchedSize = buffer->getSize();
+        arg.patchedFlags = buffer->getFlags();
+
         return CL_SUCCESS;
     } else {
 
@@ -22,6 +22,7 @@
 
 #pragma once
 #include "runtime/api/cl_types.h"
+#include "runtime/command_queue/local_work_size_cache.h"
 #include "runtime/command_stream/thread_arbitration_policy.h"
 #include "runtime/device_queue/device_queue.h"
 #include "runtime/helpers/base_object.h"
@@ -33,6 +34,7 @@
 #include <vector>
 
 namespace OCLRT {
+class Buffer;
 struct CompletionStamp;
 class GraphicsAllocation;
 class Surface;
@@ -69,6 +71,11 @@ class Kernel : public BaseObject<_cl_kernel> {
         GraphicsAllocation *pSvmAlloc;
         cl_mem_flags svmFlags;
         bool isPatched = false;
+        // buffer state the arg was last patched with, lets setting the same buffer again skip re-patching
+        const GraphicsAllocation *patchedAllocation = nullptr;
+        uint64_t patchedGpuAddress = 0;
+        size_t patchedSize = 0;
+        cl_mem_flags patchedFlags = 0;
     };
 
     typedef int32_t (Kernel::*KernelArgHandler)(uint32_t argIndex,
@@ -159,6 +166,10 @@ class Kernel : public BaseObject<_cl_kernel> {
     size_t getSurfaceStateHeapSize() const;
     size_t getDynamicStateHeapSize() const;
     size_t getNumberOfBindingTableStates() const;
+    // changes whenever the local SSH may have been modified, unique across kernels
+    uint64_t getSurfaceStateHeapGeneration() const {
+        return sshGeneration;
+    }
     size_t getBindingTableOffset() const {
         return localBindingTableOffset;
     }
@@ -372,6 +383,8 @@ class Kernel : public BaseObject<_cl_kernel> {
 
     std::vector<PatchInfoData> &getPatchInfoDataList() { return patchInfoDataList; };
 
+    LocalWorkSizeCache &getLocalWorkSizeCache() { return localWorkSizeCache; }
+
   protected:
     struct ObjectCounts {
         uint32_t imageCount;
@@ -442,6 +455,8 @@ class Kernel : public BaseObject<_cl_kernel> {
 
   protected:
     void makeArgsResident(CommandStreamReceiver &commandStreamReceiver);
+    bool isArgPatchedWithBuffer(uint32_t argIndex, Buffer &buffer) const;
+    static uint64_t generateSshGeneration();
 
     void *patchBufferOffset(const KernelArgInfo &argInfo, void *svmPtr, GraphicsAllocation *svmAlloc);
 
@@ -468,6 +483,7 @@ class Kernel : public BaseObject<_cl_kernel> {
     size_t localBindingTableOffset;
     char *pSshLocal;
     uint32_t sshLocalSize;
+    uint64_t sshGeneration;
 
     char *crossThreadData;
     uint32_t crossThreadDataSize;
@@ -481,5 +497,6 @@ class Kernel : public BaseObject<_cl_kernel> {
     uint32_t patchedArgumentsNum = 0;
 
     std::vector<PatchInfoData> patchInfoDataList;
+    LocalWorkSizeCache localWorkSizeCache;
 };
 } // namespace OCLRT
@@ -26,12 +26,14 @@
 #include "runtime/mem_obj/buffer.h"
 #include "runtime/memory_manager/memory_manager.h"
 #include "runtime/helpers/aligned_memory.h"
+#include "runtime/helpers/host_copy.h"
 #include "runtime/helpers/hw_info.h"
 #include "runtime/helpers/ptr_math.h"
 #include "runtime/helpers/validators.h"
 #include "runtime/helpers/string.h"
 #include "runtime/memory_manager/svm_memory_manager.h"
 #include "runtime/os_interface/debug_settings_manager.h"
+#include "runtime/platform/platform.h"
 
 namespace OCLRT {
 
@@ -156,10 +158,13 @@ Buffer *Buffer::create(Context *context,
                 memcpy_s(memory->getUnderlyingBuffer(), size, hostPtr, size);
             }
 
+            // pooled SVM pointers live inside a larger allocation
+            void *memoryStorage = isHostPtrSVM ? hostPtr : memory->getUnderlyingBuffer();
+
             pBuffer = createBufferHw(context,
                                      flags,
                                      size,
-                                     memory->getUnderlyingBuffer(),
+                                     memoryStorage,
                                      const_cast<void *>(hostPtr),
                                      memory,
                                      zeroCopy,
@@ -171,6 +176,7 @@ Buffer *Buffer::create(Context *context,
             }
 
             if (pBuffer) {
+                pBuffer->offset = ptrDiff(memoryStorage, memory->getUnderlyingBuffer());
                 pBuffer->setHostPtrMinSize(size);
             }
             break;
@@ -258,7 +264,7 @@ Buffer *Buffer::createSubBuffer(cl_mem_flags flags,
     }
 
     buffer->associatedMemObject = this;
-    buffer->offset = region->origin;
+    buffer->offset = this->offset + region->origin;
     buffer->setParentSharingHandler(this->getSharingHandler());
     this->incRefInternal();
 
@@ -309,9 +315,16 @@ bool Buffer::bufferRectPitchSet(const size_t *bufferOrigin,
 
 void Buffer::transferData(void *dst, void *src, size_t copySize, size_t copyOffset) {
     DBG_LOG(LogMemoryObject, __FUNCTION__, " hostPtr: ", hostPtr, ", size: ", copySize, ", offset: ", copyOffset, ", memoryStorage: ", memoryStorage);
-    auto dstPtr = ptrOffset(dst, copyOffset);
-    auto srcPtr = ptrOffset(src, copyOffset);
-    memcpy_s(dstPtr, copySize, srcPtr, copySize);
+    HostCopyRegion region;
+    region.dst = ptrOffset(dst, copyOffset);
+    region.dstRowPitch = region.dstSlicePitch = copySize;
+    region.src = ptrOffset(src, copyOffset);
+    region.srcRowPitch = region.srcSlicePitch = copySize;
+    region.rowSize = copySize;
+    region.numRows = 1;
+    region.numSlices = 1;
+
+    HostCopy::copy(region, platform()->getWorkerPool());
 }
 
 void Buffer::transferDataToHostPtr(MemObjSizeArray &copySize, MemObjOffsetArray &copyOffset) {
@@ -28,6 +28,7 @@
 #include "runtime/helpers/aligned_memory.h"
 #include "runtime/helpers/basic_math.h"
 #include "runtime/helpers/get_info.h"
+#include "runtime/helpers/host_copy.h"
 #include "runtime/helpers/hw_info.h"
 #include "runtime/helpers/ptr_math.h"
 #include "runtime/helpers/string.h"
@@ -35,6 +36,7 @@
 #include "runtime/mem_obj/buffer.h"
 #include "runtime/memory_manager/memory_manager.h"
 #include "runtime/os_interface/debug_settings_manager.h"
+#include "runtime/platform/platform.h"
 #include "runtime/gmm_helper/gmm_helper.h"
 #include "runtime/gmm_helper/resource_info.h"
 #include "igfxfmid.h"
@@ -97,18 +99,18 @@ void Image::transferData(void *dest, size_t destRowPitch, size_t destSlicePitch,
         std::swap(copyRegion[1], copyRegion[2]);
     }
 
-    for (size_t slice = copyOrigin[2]; slice < (copyOrigin[2] + copyRegion[2]); slice++) {
-        auto srcSliceOffset = ptrOffset(src, srcSlicePitch * slice);
-        auto dstSliceOffset = ptrOffset(dest, destSlicePitch * slice);
-
-        for (size_t height = copyOrigin[1]; height < (copyOrigin[1] + copyRegion[1]); height++) {
-            auto srcRowOffset = ptrOffset(srcSliceOffset, srcRowPitch * height);
-            auto dstRowOffset = ptrOffset(dstSliceOffset, destRowPitch * height);
-
-            memcpy_s(ptrOffset(dstRowOffset, copyOrigin[0] * pixelSize), lineWidth,
-                     ptrOffset(srcRowOffset, copyOrigin[0] * pixelSize), lineWidth);
-        }
-    }
+    HostCopyRegion region;
+    region.dst = ptrOffset(dest, destSlicePitch * copyOrigin[2] + destRowPitch * copyOrigin[1] + copyOrigin[0] * pixelSize);
+    region.dstRowPitch = destRowPitch;
+    region.dstSlicePitch = destSlicePitch;
+    region.src = ptrOffset(src, srcSlicePitch * copyOrigin[2] + srcRowPitch * copyOrigin[1] + copyOrigin[0] * pixelSize);
+    region.srcRowPitch = srcRowPitch;
+    region.srcSlicePitch = srcSlicePitch;
+    region.rowSize = lineWidth;
+    region.numRows = copyRegion[1];
+    region.numSlices = copyRegion[2];
+
+    HostCopy::copy(region, platform()->getWorkerPool());
 }
 
 Image::~Image() = default;
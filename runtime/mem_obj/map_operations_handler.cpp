@@ -23,11 +23,179 @@
 #include "runtime/mem_obj/map_operations_handler.h"
 #include "runtime/helpers/ptr_math.h"
 
+#include <algorithm>
+#include <cstring>
+#include <thread>
+
 using namespace OCLRT;
 
+const size_t MapOperationsHandler::mapInfoWords;
+const size_t MapOperationsHandler::initialCapacity;
+
+bool MapOperationsHandler::RangeIndex::isLess(uintptr_t begin, uintptr_t end, const Node &node) {
+    return begin < node.begin || (begin == node.begin && end < node.end);
+}
+
+void MapOperationsHandler::RangeIndex::update(Node &node) {
+    node.maxEnd = node.end;
+    if (node.left) {
+        node.maxEnd = std::max(node.maxEnd, node.left->maxEnd);
+    }
+    if (node.right) {
+        node.maxEnd = std::max(node.maxEnd, node.right->maxEnd);
+    }
+}
+
+void MapOperationsHandler::RangeIndex::rotateLeft(std::unique_ptr<Node> &node) {
+    auto pivot = std::move(node->right);
+    node->right = std::move(pivot->left);
+    update(*node);
+    pivot->left = std::move(node);
+    update(*pivot);
+    node = std::move(pivot);
+}
+
+void MapOperationsHandler::RangeIndex::rotateRight(std::unique_ptr<Node> &node) {
+    auto pivot = std::move(node->left);
+    node->left = std::move(pivot->right);
+    update(*node);
+    pivot->right = std::move(node);
+    update(*pivot);
+    node = std::move(pivot);
+}
+
+void MapOperationsHandler::RangeIndex::insert(std::unique_ptr<Node> &node, std::unique_ptr<Node> &newNode) {
+    if (!node) {
+        node = std::move(newNode);
+        return;
+    }
+    if (isLess(newNode->begin, newNode->end, *node)) {
+        insert(node->left, newNode);
+        if (node->left->priority > node->priority) {
+            rotateRight(node);
+            return;
+        }
+    } else {
+        insert(node->right, newNode);
+        if (node->right->priority > node->priority) {
+            rotateLeft(node);
+            return;
+        }
+    }
+    update(*node);
+}
+
+void MapOperationsHandler::RangeIndex::remove(std::unique_ptr<Node> &node, uintptr_t begin, uintptr_t end) {
+    if (!node) {
+        return;
+    }
+    if (isLess(begin, end, *node)) {
+        remove(node->left, begin, end);
+    } else if (node->begin != begin || node->end != end) {
+        remove(node->right, begin, end);
+    } else if (!node->left) {
+        node = std::move(node->right);
+        return;
+    } else if (!node->right) {
+        node = std::move(node->left);
+        return;
+    } else if (node->left->priority > node->right->priority) {
+        rotateRight(node);
+        remove(node->right, begin, end);
+    } else {
+        rotateLeft(node);
+        remove(node->left, begin, end);
+    }
+    update(*node);
+}
+
+void MapOperationsHandler::RangeIndex::insert(uintptr_t begin, uintptr_t end) {
+    randomState ^= randomState << 13;
+    randomState ^= randomState >> 17;
+    randomState ^= randomState << 5;
+    std::unique_ptr<Node> newNode(new Node{begin, end, end, randomState, nullptr, nullptr});
+    insert(root, newNode);
+}
+
+void MapOperationsHandler::RangeIndex::remove(uintptr_t begin, uintptr_t end) {
+    remove(root, begin, end);
+}
+
+bool MapOperationsHandler::RangeIndex::isOverlapping(uintptr_t begin, uintptr_t end) const {
+    auto node = root.get();
+    while (node) {
+        if (node->begin <= end && begin < node->end) {
+            return true;
+        }
+        // left subtree reaching past begin without overlap means everything on the right starts after end
+        if (node->left && begin < node->left->maxEnd) {
+            node = node->left.get();
+        } else {
+            node = node->right.get();
+        }
+    }
+    return false;
+}
+
+MapOperationsHandler::MapOperationsHandler() : sequence(0), numEntries(0), storage(nullptr) {
+}
+
 size_t MapOperationsHandler::size() const {
-    std::lock_guard<std::mutex> lock(mtx);
-    return mappedPointers.size();
+    return numEntries.load(std::memory_order_relaxed);
+}
+
+void MapOperationsHandler::beginWrite() {
+    sequence.store(sequence.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+}
+
+void MapOperationsHandler::endWrite() {
+    sequence.store(sequence.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+void MapOperationsHandler::storeMapInfo(Entry &entry, const MapInfo &mapInfo) {
+    uint64_t words[mapInfoWords] = {};
+    memcpy(words, &mapInfo, sizeof(MapInfo));
+    for (size_t i = 0; i < mapInfoWords; i++) {
+        entry.mapInfo[i].store(words[i], std::memory_order_relaxed);
+    }
+}
+
+void MapOperationsHandler::loadMapInfo(const Entry &entry, MapInfo &mapInfo) {
+    uint64_t words[mapInfoWords];
+    for (size_t i = 0; i < mapInfoWords; i++) {
+        words[i] = entry.mapInfo[i].load(std::memory_order_relaxed);
+    }
+    memcpy(&mapInfo, words, sizeof(MapInfo));
+}
+
+void MapOperationsHandler::copyEntry(Entry &dst, const Entry &src) {
+    dst.key.store(src.key.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    for (size_t i = 0; i < mapInfoWords; i++) {
+        dst.mapInfo[i].store(src.mapInfo[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+    dst.used.store(true, std::memory_order_relaxed);
+}
+
+size_t MapOperationsHandler::getHomeSlot(uintptr_t key, size_t capacity) {
+    return static_cast<size_t>((static_cast<uint64_t>(key) * 0x9e3779b97f4a7c15ull) >> 32) & (capacity - 1);
+}
+
+// Linear probing keeps entries of the same ptr in mapping order, the first one found is the oldest
+size_t MapOperationsHandler::findSlot(const Storage &storage, uintptr_t key) {
+    auto mask = storage.capacity - 1;
+    auto slot = getHomeSlot(key, storage.capacity);
+    for (size_t probe = 0; probe < storage.capacity; probe++) {
+        auto &entry = storage.entries[slot];
+        if (!entry.used.load(std::memory_order_relaxed)) {
+            break;
+        }
+        if (entry.key.load(std::memory_order_relaxed) == key) {
+            return slot;
+        }
+        slot = (slot + 1) & mask;
+    }
+    return storage.capacity;
 }
 
 bool MapOperationsHandler::add(void *ptr, size_t ptrLength, cl_map_flags &mapFlags, MemObjSizeArray &size, MemObjOffsetArray &offset) {
@@ -39,7 +207,49 @@ bool MapOperationsHandler::add(void *ptr, size_t ptrLength, cl_map_flags &mapFla
         return false;
     }
 
-    mappedPointers.push_back(mapInfo);
+    auto key = reinterpret_cast<uintptr_t>(ptr);
+    auto count = numEntries.load(std::memory_order_relaxed);
+    auto currentStorage = storage.load(std::memory_order_relaxed);
+
+    beginWrite();
+    // table is kept at most half full, so probe sequences stay short
+    if (currentStorage == nullptr || (count + 1) * 2 > currentStorage->capacity) {
+        storages.push_back(std::unique_ptr<Storage>(new Storage(currentStorage ? currentStorage->capacity * 2 : initialCapacity)));
+        auto grownStorage = storages.back().get();
+        if (currentStorage) {
+            // start right after a free slot so wrapped clusters are rehashed in probe order
+            auto mask = currentStorage->capacity - 1;
+            size_t start = 0;
+            while (currentStorage->entries[start].used.load(std::memory_order_relaxed)) {
+                start++;
+            }
+            for (size_t i = 1; i <= currentStorage->capacity; i++) {
+                auto &src = currentStorage->entries[(start + i) & mask];
+                if (src.used.load(std::memory_order_relaxed)) {
+                    auto slot = getHomeSlot(src.key.load(std::memory_order_relaxed), grownStorage->capacity);
+                    while (grownStorage->entries[slot].used.load(std::memory_order_relaxed)) {
+                        slot = (slot + 1) & (grownStorage->capacity - 1);
+                    }
+                    copyEntry(grownStorage->entries[slot], src);
+                }
+            }
+        }
+        storage.store(grownStorage, std::memory_order_release);
+        currentStorage = grownStorage;
+    }
+
+    auto slot = getHomeSlot(key, currentStorage->capacity);
+    while (currentStorage->entries[slot].used.load(std::memory_order_relaxed)) {
+        slot = (slot + 1) & (currentStorage->capacity - 1);
+    }
+    auto &entry = currentStorage->entries[slot];
+    entry.key.store(key, std::memory_order_relaxed);
+    storeMapInfo(entry, mapInfo);
+    entry.used.store(true, std::memory_order_relaxed);
+    numEntries.store(count + 1, std::memory_order_relaxed);
+    endWrite();
+
+    rangeIndex.insert(key, reinterpret_cast<uintptr_t>(ptrOffset(ptr, ptrLength)));
     return true;
 }
 
@@ -47,42 +257,73 @@ bool MapOperationsHandler::isOverlapping(MapInfo &inputMapInfo) {
     if (inputMapInfo.readOnly) {
         return false;
     }
-    auto inputStartPtr = inputMapInfo.ptr;
-    auto inputEndPtr = ptrOffset(inputStartPtr, inputMapInfo.ptrLength);
+    auto inputStartPtr = reinterpret_cast<uintptr_t>(inputMapInfo.ptr);
+    auto inputEndPtr = reinterpret_cast<uintptr_t>(ptrOffset(inputMapInfo.ptr, inputMapInfo.ptrLength));
 
-    for (auto &mapInfo : mappedPointers) {
-        auto mappedStartPtr = mapInfo.ptr;
-        auto mappedEndPtr = ptrOffset(mappedStartPtr, mapInfo.ptrLength);
-
-        // Requested ptr starts before or inside existing ptr range and overlapping end
-        if (inputStartPtr < mappedEndPtr && inputEndPtr >= mappedStartPtr) {
-            return true;
-        }
-    }
-    return false;
+    // Requested ptr starts before or inside existing ptr range and overlapping end
+    return rangeIndex.isOverlapping(inputStartPtr, inputEndPtr);
 }
 
 bool MapOperationsHandler::find(void *mappedPtr, MapInfo &outMapInfo) {
-    std::lock_guard<std::mutex> lock(mtx);
+    auto key = reinterpret_cast<uintptr_t>(mappedPtr);
 
-    for (auto &mapInfo : mappedPointers) {
-        if (mapInfo.ptr == mappedPtr) {
-            outMapInfo = mapInfo;
-            return true;
+    while (true) {
+        auto startSequence = sequence.load(std::memory_order_acquire);
+        if (startSequence & 1) {
+            std::this_thread::yield();
+            continue;
+        }
+
+        bool found = false;
+        MapInfo mapInfo;
+        auto currentStorage = storage.load(std::memory_order_acquire);
+        if (currentStorage != nullptr) {
+            auto slot = findSlot(*currentStorage, key);
+            if (slot != currentStorage->capacity) {
+                loadMapInfo(currentStorage->entries[slot], mapInfo);
+                found = true;
+            }
+        }
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (sequence.load(std::memory_order_relaxed) == startSequence) {
+            if (found) {
+                outMapInfo = mapInfo;
+            }
+            return found;
         }
     }
-    return false;
 }
 
 void MapOperationsHandler::remove(void *mappedPtr) {
     std::lock_guard<std::mutex> lock(mtx);
+    auto currentStorage = storage.load(std::memory_order_relaxed);
+    if (currentStorage == nullptr) {
+        return;
+    }
 
-    auto endIter = mappedPointers.end();
-    for (auto it = mappedPointers.begin(); it != endIter; it++) {
-        if (it->ptr == mappedPtr) {
-            std::iter_swap(it, mappedPointers.end() - 1);
-            mappedPointers.pop_back();
-            break;
+    auto key = reinterpret_cast<uintptr_t>(mappedPtr);
+    auto hole = findSlot(*currentStorage, key);
+    if (hole == currentStorage->capacity) {
+        return;
+    }
+    MapInfo mapInfo;
+    loadMapInfo(currentStorage->entries[hole], mapInfo);
+    rangeIndex.remove(key, reinterpret_cast<uintptr_t>(ptrOffset(mapInfo.ptr, mapInfo.ptrLength)));
+
+    // Shift following entries of the cluster back, so lookups never need tombstones
+    auto entries = currentStorage->entries.get();
+    auto mask = currentStorage->capacity - 1;
+    beginWrite();
+    for (auto slot = (hole + 1) & mask; entries[slot].used.load(std::memory_order_relaxed); slot = (slot + 1) & mask) {
+        auto home = getHomeSlot(entries[slot].key.load(std::memory_order_relaxed), currentStorage->capacity);
+        bool homeBetween = hole <= slot ? (hole < home && home <= slot) : (hole < home || home <= slot);
+        if (!homeBetween) {
+            copyEntry(entries[hole], entries[slot]);
+            hole = slot;
         }
     }
+    entries[hole].used.store(false, std::memory_order_relaxed);
+    numEntries.store(numEntries.load(std::memory_order_relaxed) - 1, std::memory_order_relaxed);
+    endWrite();
 }
@@ -23,13 +23,16 @@
 #pragma once
 #include "runtime/helpers/properties_helper.h"
 
-#include <vector>
+#include <atomic>
+#include <memory>
 #include <mutex>
+#include <vector>
 
 namespace OCLRT {
 
 class MapOperationsHandler {
   public:
+    MapOperationsHandler();
     virtual ~MapOperationsHandler() = default;
 
     bool add(void *ptr, size_t ptrLength, cl_map_flags &mapFlags, MemObjSizeArray &size, MemObjOffsetArray &offset);
@@ -38,8 +41,65 @@ class MapOperationsHandler {
     size_t size() const;
 
   protected:
+    // Treap of mapped ranges ordered by start, each node knows the highest end in its subtree
+    class RangeIndex {
+      public:
+        void insert(uintptr_t begin, uintptr_t end);
+        void remove(uintptr_t begin, uintptr_t end);
+        // true if any range starts at or before end and ends after begin
+        bool isOverlapping(uintptr_t begin, uintptr_t end) const;
+
+      protected:
+        struct Node {
+            uintptr_t begin;
+            uintptr_t end;
+            uintptr_t maxEnd;
+            uint32_t priority;
+            std::unique_ptr<Node> left;
+            std::unique_ptr<Node> right;
+        };
+        static bool isLess(uintptr_t begin, uintptr_t end, const Node &node);
+        static void update(Node &node);
+        static void rotateLeft(std::unique_ptr<Node> &node);
+        static void rotateRight(std::unique_ptr<Node> &node);
+        static void insert(std::unique_ptr<Node> &node, std::unique_ptr<Node> &newNode);
+        static void remove(std::unique_ptr<Node> &node, uintptr_t begin, uintptr_t end);
+
+        std::unique_ptr<Node> root;
+        uint32_t randomState = 0x9e3779b9;
+    };
+
+    // Open addressed table of mapped ptrs, read by find under sequence counter without taking the lock.
+    // MapInfo is kept as atomic words, so find may copy it while add/remove move entries.
+    static const size_t mapInfoWords = (sizeof(MapInfo) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+    struct Entry {
+        std::atomic<bool> used;
+        std::atomic<uintptr_t> key;
+        std::atomic<uint64_t> mapInfo[mapInfoWords];
+    };
+    struct Storage {
+        explicit Storage(size_t capacity) : capacity(capacity), entries(new Entry[capacity]()) {}
+        const size_t capacity;
+        std::unique_ptr<Entry[]> entries;
+    };
+
     bool isOverlapping(MapInfo &inputMapInfo);
-    std::vector<MapInfo> mappedPointers;
+    static size_t getHomeSlot(uintptr_t key, size_t capacity);
+    static size_t findSlot(const Storage &storage, uintptr_t key);
+    void beginWrite();
+    void endWrite();
+    static void copyEntry(Entry &dst, const Entry &src);
+    static void storeMapInfo(Entry &entry, const MapInfo &mapInfo);
+    static void loadMapInfo(const Entry &entry, MapInfo &mapInfo);
+
+    RangeIndex rangeIndex;
+    std::atomic<uint32_t> sequence;
+    std::atomic<size_t> numEntries;
+    std::atomic<Storage *> storage;
+    // storages are never released while the handler lives, find may still walk a replaced one
+    std::vector<std::unique_ptr<Storage>> storages;
+    static const size_t initialCapacity = 8;
+    // serializes add and remove, find does not take it
     mutable std::mutex mtx;
 };
 
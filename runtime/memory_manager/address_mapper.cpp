@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017, Intel Corporation
+ * Copyright (c) 2017 - 2018, Intel Corporation
  *
  * Permission is hereby granted, free of charge, to any person obtaining a
  * copy of this software and associated documentation files (the "Software"),
@@ -31,52 +31,29 @@ namespace OCLRT {
 
 AddressMapper::AddressMapper() : nextPage(1) {
 }
-AddressMapper::~AddressMapper() {
-    for (auto &m : mapping)
-        delete m;
-}
+AddressMapper::~AddressMapper() = default;
+
 uint32_t AddressMapper::map(void *vm, size_t size) {
     void *aligned = alignDown(vm, MemoryConstants::pageSize);
     size_t alignedSize = alignSizeWholePage(vm, size);
 
-    auto it = mapping.begin();
-    for (; it != mapping.end(); it++) {
-        if ((*it)->vm == aligned) {
-            if ((*it)->size == alignedSize) {
-                return (*it)->ggtt;
-            }
-            break;
-        }
-    }
-    if (it != mapping.end()) {
-        delete *it;
-        mapping.erase(it);
+    auto it = mapping.find(aligned);
+    if (it != mapping.end() && it->second.size == alignedSize) {
+        return it->second.ggtt;
     }
+
     uint32_t numPages = static_cast<uint32_t>(alignedSize / MemoryConstants::pageSize);
     auto tmp = nextPage.fetch_add(numPages);
 
-    MapInfo *m = new MapInfo;
-    m->vm = aligned;
-    m->size = alignedSize;
-    m->ggtt = static_cast<uint32_t>(tmp * MemoryConstants::pageSize);
+    MapInfo &m = mapping[aligned];
+    m.size = alignedSize;
+    m.ggtt = static_cast<uint32_t>(tmp * MemoryConstants::pageSize);
 
-    mapping.push_back(m);
-
-    return m->ggtt;
+    return m.ggtt;
 }
 
 void AddressMapper::unmap(void *vm) {
     void *aligned = alignDown(vm, MemoryConstants::pageSize);
-
-    auto it = mapping.begin();
-    for (; it != mapping.end(); it++) {
-        if ((*it)->vm == aligned) {
-            break;
-        }
-    }
-    if (it != mapping.end()) {
-        delete *it;
-        mapping.erase(it);
-    }
+    mapping.erase(aligned);
 }
 }
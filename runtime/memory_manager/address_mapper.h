@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017, Intel Corporation
+ * Copyright (c) 2017 - 2018, Intel Corporation
  *
  * Permission is hereby granted, free of charge, to any person obtaining a
  * copy of this software and associated documentation files (the "Software"),
@@ -22,7 +22,9 @@
 
 #pragma once
 #include <atomic>
-#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
 
 namespace OCLRT {
 
@@ -38,11 +40,11 @@ class AddressMapper {
 
   protected:
     struct MapInfo {
-        void *vm;
         size_t size;
         uint32_t ggtt;
     };
-    std::vector<MapInfo *> mapping;
+    // keyed by page aligned vm
+    std::unordered_map<void *, MapInfo> mapping;
     std::atomic<uint32_t> nextPage;
 };
 }
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017, Intel Corporation
+ * Copyright (c) 2017 - 2018, Intel Corporation
  *
  * Permission is hereby granted, free of charge, to any person obtaining a
  * copy of this software and associated documentation files (the "Software"),
@@ -24,38 +24,89 @@
 #include "runtime/helpers/ptr_math.h"
 #include "runtime/helpers/abort.h"
 
+#include <algorithm>
+
 using namespace OCLRT;
 
-std::map<void *, FragmentStorage>::iterator OCLRT::HostPtrManager::findElement(void *ptr) {
-    auto nextElement = partialAllocations.lower_bound(ptr);
-    auto element = nextElement;
-    if (element != partialAllocations.end()) {
-        auto &storedFragment = element->second;
-        if (storedFragment.fragmentCpuPointer <= ptr) {
-            return element;
-        } else if (element != partialAllocations.begin()) {
-            element--;
-            auto &storedFragment = element->second;
-            auto storedEndAddress = (uintptr_t)storedFragment.fragmentCpuPointer + storedFragment.fragmentSize;
-            if (storedFragment.fragmentSize == 0) {
-                storedEndAddress++;
-            }
-            if ((uintptr_t)ptr < (uintptr_t)storedEndAddress) {
-                return element;
+const uint32_t HostPtrManager::regionShift;
+const size_t HostPtrManager::numShards;
+
+OCLRT::HostPtrManager::~HostPtrManager() {
+    for (auto &shard : shards) {
+        for (auto &entry : shard.fragments) {
+            // spilled entries are keyed by region base, only the home entry owns the fragment
+            if (entry.first == reinterpret_cast<uintptr_t>(entry.second->fragmentCpuPointer)) {
+                delete entry.second;
             }
         }
-    } else if (element != partialAllocations.begin()) {
-        element--;
-        auto &storedFragment = element->second;
-        auto storedEndAddress = (uintptr_t)storedFragment.fragmentCpuPointer + storedFragment.fragmentSize;
-        if (storedFragment.fragmentSize == 0) {
-            storedEndAddress++;
+    }
+}
+
+uintptr_t OCLRT::HostPtrManager::getFragmentEnd(const FragmentStorage &fragment) {
+    auto size = fragment.fragmentSize ? fragment.fragmentSize : 1;
+    return reinterpret_cast<uintptr_t>(fragment.fragmentCpuPointer) + size;
+}
+
+FragmentStorage *OCLRT::HostPtrManager::findInRegion(Shard &shard, uintptr_t ptr) {
+    auto element = shard.fragments.upper_bound(ptr);
+    if (element == shard.fragments.begin()) {
+        return nullptr;
+    }
+    element--;
+    if (element->first < getRegionBase(getRegion(ptr))) {
+        return nullptr;
+    }
+    return element->second;
+}
+
+FragmentStorage *OCLRT::HostPtrManager::findContaining(Shard &shard, uintptr_t ptr) {
+    auto fragment = findInRegion(shard, ptr);
+    if (fragment && ptr < getFragmentEnd(*fragment)) {
+        return fragment;
+    }
+    return nullptr;
+}
+
+FragmentStorage *OCLRT::HostPtrManager::lockContainingFragment(uintptr_t ptr, std::unique_lock<std::mutex> &lock) {
+    while (true) {
+        auto &shard = getShard(getRegion(ptr));
+        std::unique_lock<std::mutex> regionLock(shard.mtx);
+        auto fragment = findContaining(shard, ptr);
+        if (fragment == nullptr) {
+            lock = std::move(regionLock);
+            return nullptr;
+        }
+        auto fragmentStart = reinterpret_cast<uintptr_t>(fragment->fragmentCpuPointer);
+        auto &homeShard = getShard(getRegion(fragmentStart));
+        if (&homeShard == &shard) {
+            lock = std::move(regionLock);
+            return fragment;
         }
-        if ((uintptr_t)ptr < (uintptr_t)storedEndAddress) {
-            return element;
+        // reference count is guarded by the home shard, never hold two shard locks at once
+        regionLock.unlock();
+        std::unique_lock<std::mutex> homeLock(homeShard.mtx);
+        auto element = homeShard.fragments.find(fragmentStart);
+        if (element != homeShard.fragments.end() && element->second == fragment) {
+            lock = std::move(homeLock);
+            return fragment;
         }
     }
-    return partialAllocations.end();
+}
+
+void OCLRT::HostPtrManager::acquireFragment(FragmentStorage *fragment) {
+    auto &homeShard = getShard(getRegion(reinterpret_cast<uintptr_t>(fragment->fragmentCpuPointer)));
+    std::lock_guard<std::mutex> lock(homeShard.mtx);
+    fragment->refCount++;
+}
+
+void OCLRT::HostPtrManager::unregisterSpilledRegions(FragmentStorage *fragment) {
+    auto firstRegion = getRegion(reinterpret_cast<uintptr_t>(fragment->fragmentCpuPointer));
+    auto lastRegion = getRegion(getFragmentEnd(*fragment) - 1);
+    for (auto region = firstRegion + 1; region <= lastRegion; region++) {
+        auto &shard = getShard(region);
+        std::lock_guard<std::mutex> lock(shard.mtx);
+        shard.fragments.erase(getRegionBase(region));
+    }
 }
 
 AllocationRequirements OCLRT::HostPtrManager::getAllocationRequirements(const void *inputPtr, size_t size) {
@@ -122,7 +173,7 @@ OsHandleStorage OCLRT::HostPtrManager::populateAlreadyAllocatedFragments(Allocat
 
         if (overlapStatus == OverlapStatus::FRAGMENT_WITHIN_STORED_FRAGMENT) {
             DEBUG_BREAK_IF(fragmentStorage == nullptr);
-            fragmentStorage->refCount++;
+            acquireFragment(fragmentStorage);
             handleStorage.fragmentStorageData[i].osHandleStorage = fragmentStorage->osInternalStorage;
             handleStorage.fragmentStorageData[i].cpuPtr = requirements.AllocationFragments[i].allocationPtr;
             handleStorage.fragmentStorageData[i].fragmentSize = requirements.AllocationFragments[i].allocationSize;
@@ -130,7 +181,7 @@ OsHandleStorage OCLRT::HostPtrManager::populateAlreadyAllocatedFragments(Allocat
         } else if (overlapStatus != OverlapStatus::FRAGMENT_OVERLAPING_AND_BIGGER_THEN_STORED_FRAGMENT) {
             if (fragmentStorage != nullptr) {
                 DEBUG_BREAK_IF(overlapStatus != OverlapStatus::FRAGMENT_WITH_EXACT_SIZE_AS_STORED_FRAGMENT);
-                fragmentStorage->refCount++;
+                acquireFragment(fragmentStorage);
                 handleStorage.fragmentStorageData[i].osHandleStorage = fragmentStorage->osInternalStorage;
                 handleStorage.fragmentStorageData[i].residency = fragmentStorage->residency;
             } else {
@@ -149,13 +200,24 @@ OsHandleStorage OCLRT::HostPtrManager::populateAlreadyAllocatedFragments(Allocat
 }
 
 void OCLRT::HostPtrManager::storeFragment(FragmentStorage &fragment) {
-    std::lock_guard<std::mutex> lock(allocationsMutex);
-    auto element = findElement(fragment.fragmentCpuPointer);
-    if (element != partialAllocations.end()) {
-        element->second.refCount++;
-    } else {
-        fragment.refCount++;
-        partialAllocations.insert(std::pair<void *, FragmentStorage>(fragment.fragmentCpuPointer, fragment));
+    auto fragmentStart = reinterpret_cast<uintptr_t>(fragment.fragmentCpuPointer);
+    std::unique_lock<std::mutex> lock;
+    auto storedFragment = lockContainingFragment(fragmentStart, lock);
+    if (storedFragment != nullptr) {
+        storedFragment->refCount++;
+        return;
+    }
+    fragment.refCount++;
+    storedFragment = new FragmentStorage(fragment);
+    getShard(getRegion(fragmentStart)).fragments.insert(std::make_pair(fragmentStart, storedFragment));
+    fragmentCount++;
+    lock.unlock();
+
+    auto lastRegion = getRegion(getFragmentEnd(fragment) - 1);
+    for (auto region = getRegion(fragmentStart) + 1; region <= lastRegion; region++) {
+        auto &shard = getShard(region);
+        std::lock_guard<std::mutex> regionLock(shard.mtx);
+        shard.fragments.insert(std::make_pair(getRegionBase(region), storedFragment));
     }
 }
 
@@ -177,87 +239,76 @@ void OCLRT::HostPtrManager::releaseHandleStorage(OsHandleStorage &fragments) {
 }
 
 bool OCLRT::HostPtrManager::releaseHostPtr(void *ptr) {
-    std::lock_guard<std::mutex> lock(allocationsMutex);
-    bool fragmentReadyToBeReleased = false;
-
-    auto element = findElement(ptr);
+    std::unique_lock<std::mutex> lock;
+    auto fragment = lockContainingFragment(reinterpret_cast<uintptr_t>(ptr), lock);
 
-    DEBUG_BREAK_IF(element == partialAllocations.end());
+    DEBUG_BREAK_IF(fragment == nullptr);
 
-    element->second.refCount--;
-    if (element->second.refCount <= 0) {
-        fragmentReadyToBeReleased = true;
-        partialAllocations.erase(element);
+    fragment->refCount--;
+    if (fragment->refCount > 0) {
+        return false;
     }
 
-    return fragmentReadyToBeReleased;
+    auto fragmentStart = reinterpret_cast<uintptr_t>(fragment->fragmentCpuPointer);
+    getShard(getRegion(fragmentStart)).fragments.erase(fragmentStart);
+    fragmentCount--;
+    lock.unlock();
+
+    unregisterSpilledRegions(fragment);
+    delete fragment;
+    return true;
 }
 
 FragmentStorage *OCLRT::HostPtrManager::getFragment(void *inputPtr) {
-    std::lock_guard<std::mutex> lock(allocationsMutex);
-    auto element = findElement(inputPtr);
-    if (element != partialAllocations.end()) {
-        return &element->second;
-    }
-    return nullptr;
+    auto ptr = reinterpret_cast<uintptr_t>(inputPtr);
+    auto &shard = getShard(getRegion(ptr));
+    std::lock_guard<std::mutex> lock(shard.mtx);
+    return findContaining(shard, ptr);
 }
 
 //for given inputs see if any allocation overlaps
 FragmentStorage *OCLRT::HostPtrManager::getFragmentAndCheckForOverlaps(const void *inPtr, size_t size, OverlapStatus &overlappingStatus) {
-    std::lock_guard<std::mutex> lock(allocationsMutex);
-    void *inputPtr = const_cast<void *>(inPtr);
-    auto nextElement = partialAllocations.lower_bound(inputPtr);
-    auto element = nextElement;
+    auto inputStartAddress = reinterpret_cast<uintptr_t>(inPtr);
+    auto inputEndAddress = inputStartAddress + size;
     overlappingStatus = OverlapStatus::FRAGMENT_NOT_OVERLAPING_WITH_ANY_OTHER;
 
-    if (element != partialAllocations.begin()) {
-        element--;
-    }
+    {
+        auto &shard = getShard(getRegion(inputStartAddress));
+        std::lock_guard<std::mutex> lock(shard.mtx);
+        auto storedFragment = findInRegion(shard, inputStartAddress);
+        if (storedFragment != nullptr) {
+            auto storedStartAddress = reinterpret_cast<uintptr_t>(storedFragment->fragmentCpuPointer);
+            auto storedEndAddress = storedStartAddress + storedFragment->fragmentSize;
 
-    if (element != partialAllocations.end()) {
-        auto &storedFragment = element->second;
-        if (storedFragment.fragmentCpuPointer == inputPtr && storedFragment.fragmentSize == size) {
-            overlappingStatus = OverlapStatus::FRAGMENT_WITH_EXACT_SIZE_AS_STORED_FRAGMENT;
-            return &element->second;
-        }
-
-        auto storedEndAddress = (uintptr_t)storedFragment.fragmentCpuPointer + storedFragment.fragmentSize;
-        auto inputEndAddress = (uintptr_t)inputPtr + size;
-
-        if (inputPtr >= storedFragment.fragmentCpuPointer && (uintptr_t)inputPtr < (uintptr_t)storedEndAddress) {
-            if (inputEndAddress <= storedEndAddress) {
-                overlappingStatus = OverlapStatus::FRAGMENT_WITHIN_STORED_FRAGMENT;
-                return &element->second;
-            } else {
-                overlappingStatus = OverlapStatus::FRAGMENT_OVERLAPING_AND_BIGGER_THEN_STORED_FRAGMENT;
-                return nullptr;
+            if (storedStartAddress == inputStartAddress && storedFragment->fragmentSize == size) {
+                overlappingStatus = OverlapStatus::FRAGMENT_WITH_EXACT_SIZE_AS_STORED_FRAGMENT;
+                return storedFragment;
             }
-        }
-        //next fragment doesn't have to be after the inputPtr
-        if (nextElement != partialAllocations.end()) {
-            auto &storedNextElement = nextElement->second;
-            auto storedNextEndAddress = (uintptr_t)storedNextElement.fragmentCpuPointer + storedNextElement.fragmentSize;
-            auto storedNextStartAddress = (uintptr_t)storedNextElement.fragmentCpuPointer;
-            //check if this allocation is after the inputPtr
-            if ((uintptr_t)inputPtr < storedNextStartAddress) {
-                if (inputEndAddress > storedNextStartAddress) {
-                    overlappingStatus = OverlapStatus::FRAGMENT_OVERLAPING_AND_BIGGER_THEN_STORED_FRAGMENT;
-                    return nullptr;
+            if (inputStartAddress < storedEndAddress) {
+                if (inputEndAddress <= storedEndAddress) {
+                    overlappingStatus = OverlapStatus::FRAGMENT_WITHIN_STORED_FRAGMENT;
+                    return storedFragment;
                 }
-            } else if (inputEndAddress > storedNextEndAddress) {
                 overlappingStatus = OverlapStatus::FRAGMENT_OVERLAPING_AND_BIGGER_THEN_STORED_FRAGMENT;
                 return nullptr;
-            } else {
-                DEBUG_BREAK_IF((uintptr_t)inputPtr != storedNextStartAddress);
-                if (inputEndAddress < storedNextEndAddress) {
-                    overlappingStatus = OverlapStatus::FRAGMENT_WITHIN_STORED_FRAGMENT;
-                } else {
-                    DEBUG_BREAK_IF(inputEndAddress != storedNextEndAddress);
-                    overlappingStatus = OverlapStatus::FRAGMENT_WITH_EXACT_SIZE_AS_STORED_FRAGMENT;
-                }
-                return &nextElement->second;
             }
         }
     }
+
+    if (size == 0) {
+        return nullptr;
+    }
+
+    //no fragment contains inputPtr, any fragment starting inside the input range overlaps it
+    auto lastRegion = getRegion(inputEndAddress - 1);
+    for (auto region = getRegion(inputStartAddress); region <= lastRegion; region++) {
+        auto &shard = getShard(region);
+        std::lock_guard<std::mutex> lock(shard.mtx);
+        auto element = shard.fragments.lower_bound(std::max(inputStartAddress, getRegionBase(region)));
+        if (element != shard.fragments.end() && element->first < inputEndAddress) {
+            overlappingStatus = OverlapStatus::FRAGMENT_OVERLAPING_AND_BIGGER_THEN_STORED_FRAGMENT;
+            return nullptr;
+        }
+    }
     return nullptr;
 }
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017, Intel Corporation
+ * Copyright (c) 2017 - 2018, Intel Corporation
  *
  * Permission is hereby granted, free of charge, to any person obtaining a
  * copy of this software and associated documentation files (the "Software"),
@@ -21,17 +21,27 @@
  */
 
 #pragma once
+#include <array>
+#include <atomic>
 #include <map>
+#include <mutex>
 #include "runtime/helpers/aligned_memory.h"
 #include "runtime/memory_manager/graphics_allocation.h"
 #include "runtime/memory_manager/host_ptr_defines.h"
 
 namespace OCLRT {
 
-typedef std::map<void *, FragmentStorage> HostPtrFragmentsContainer;
-
+// Fragments are indexed per address region, each region belongs to one of the shards.
+// A fragment spanning several regions is registered in every region it touches, so any
+// lookup only needs the locks of the regions covered by the queried range.
 class HostPtrManager {
   public:
+    static const uint32_t regionShift = 22;
+    static const size_t numShards = 64;
+
+    HostPtrManager() = default;
+    ~HostPtrManager();
+
     static AllocationRequirements getAllocationRequirements(const void *inputPtr, size_t size);
     OsHandleStorage populateAlreadyAllocatedFragments(AllocationRequirements &requirements, CheckedFragments *checkedFragments);
     void storeFragment(FragmentStorage &fragment);
@@ -41,13 +51,29 @@ class HostPtrManager {
     bool releaseHostPtr(void *ptr);
 
     FragmentStorage *getFragment(void *inputPtr);
-    size_t getFragmentCount() { return partialAllocations.size(); }
+    size_t getFragmentCount() { return fragmentCount; }
     FragmentStorage *getFragmentAndCheckForOverlaps(const void *inputPtr, size_t size, OverlapStatus &overlappingStatus);
 
-  private:
-    std::map<void *, FragmentStorage>::iterator findElement(void *ptr);
+  protected:
+    typedef std::map<uintptr_t, FragmentStorage *> FragmentIndex;
+
+    struct Shard {
+        FragmentIndex fragments;
+        std::mutex mtx;
+    };
+
+    static uintptr_t getRegion(uintptr_t address) { return address >> regionShift; }
+    static uintptr_t getRegionBase(uintptr_t region) { return region << regionShift; }
+    static uintptr_t getFragmentEnd(const FragmentStorage &fragment);
+    Shard &getShard(uintptr_t region) { return shards[region % numShards]; }
+
+    FragmentStorage *findInRegion(Shard &shard, uintptr_t ptr);
+    FragmentStorage *findContaining(Shard &shard, uintptr_t ptr);
+    FragmentStorage *lockContainingFragment(uintptr_t ptr, std::unique_lock<std::mutex> &lock);
+    void acquireFragment(FragmentStorage *fragment);
+    void unregisterSpilledRegions(FragmentStorage *fragment);
 
-    HostPtrFragmentsContainer partialAllocations;
-    std::mutex allocationsMutex;
+    std::array<Shard, numShards> shards;
+    std::atomic<size_t> fragmentCount{0};
 };
 } // namespace OCLRT
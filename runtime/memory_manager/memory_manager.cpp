@@ -70,6 +70,7 @@ MemoryManager::MemoryManager(bool enable64kbpages) : allocator32Bit(nullptr), en
 MemoryManager::~MemoryManager() {
     freeAllocationsList(-1, graphicsAllocations);
     freeAllocationsList(-1, allocationsForReuse);
+    freeAllocationsList(-1, printfSurfacesForReuse);
 }
 
 void *MemoryManager::allocateSystemMemory(size_t size, size_t alignment) {
@@ -213,6 +214,29 @@ std::unique_ptr<GraphicsAllocation> MemoryManager::obtainReusableAllocation(size
     return allocation;
 }
 
+GraphicsAllocation *MemoryManager::obtainPrintfSurface(size_t requiredSize) {
+    std::unique_lock<decltype(mtx)> lock(mtx);
+    auto printfSurface = printfSurfacesForReuse.detachAllocation(requiredSize, csr ? csr->getTagAddress() : nullptr);
+    lock.unlock();
+    if (printfSurface) {
+        return printfSurface.release();
+    }
+    return createGraphicsAllocationWithRequiredBitness(requiredSize, nullptr);
+}
+
+void MemoryManager::storePrintfSurface(std::unique_ptr<GraphicsAllocation> printfSurface, bool surfaceIdle) {
+    std::lock_guard<decltype(mtx)> lock(mtx);
+
+    if (DebugManager.flags.DisableResourceRecycling.get()) {
+        freeGraphicsMemory(printfSurface.release());
+        return;
+    }
+
+    // surface not known to be idle can be handed out again only after all work submitted so far completes
+    printfSurface->taskCount = (surfaceIdle || csr == nullptr) ? 0 : csr->peekTaskCount();
+    printfSurfacesForReuse.pushTailOne(*printfSurface.release());
+}
+
 void MemoryManager::setForce32BitAllocations(bool newValue) {
     if (newValue && !this->allocator32Bit) {
         this->allocator32Bit.reset(new Allocator32bit);
@@ -232,6 +256,7 @@ void MemoryManager::applyCommonCleanup() {
 
     cleanAllocationList(-1, TEMPORARY_ALLOCATION);
     cleanAllocationList(-1, REUSABLE_ALLOCATION);
+    freeAllocationsList(-1, printfSurfacesForReuse);
 }
 
 bool MemoryManager::cleanAllocationList(uint32_t waitTaskCount, uint32_t allocationType) {
@@ -290,6 +315,9 @@ void MemoryManager::clearEvictionAllocations() {
 }
 
 void MemoryManager::freeGraphicsMemory(GraphicsAllocation *gfxAllocation) {
+    if (csr && gfxAllocation) {
+        csr->notifyAllocationReleased(*gfxAllocation);
+    }
     freeGraphicsMemoryImpl(gfxAllocation);
 }
 //if not in use destroy in place
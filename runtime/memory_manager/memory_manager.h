@@ -166,12 +166,18 @@ class MemoryManager {
 
     std::unique_ptr<GraphicsAllocation> obtainReusableAllocation(size_t requiredSize);
 
+    GraphicsAllocation *obtainPrintfSurface(size_t requiredSize);
+    void storePrintfSurface(std::unique_ptr<GraphicsAllocation> printfSurface, bool surfaceIdle);
+
     //intrusive list of allocation
     AllocationsList graphicsAllocations;
 
     //intrusive list of allocation for re-use
     AllocationsList allocationsForReuse;
 
+    //intrusive list of printf surfaces for re-use
+    AllocationsList printfSurfacesForReuse;
+
     CommandStreamReceiver *csr = nullptr;
     Device *device = nullptr;
     HostPtrManager hostPtrManager;
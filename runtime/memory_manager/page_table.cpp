@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017, Intel Corporation
+ * Copyright (c) 2017 - 2018, Intel Corporation
  *
  * Permission is hereby granted, free of charge, to any person obtaining a
  * copy of this software and associated documentation files (the "Software"),
@@ -48,16 +48,33 @@ uintptr_t PTE::map(uintptr_t vm, size_t size) {
     size_t indexEnd = ((vm + size - 1) >> shift) & mask;
     uintptr_t res = -1;
 
+    mapEntries(indexStart, indexEnd);
     for (size_t index = indexStart; index <= indexEnd; index++) {
-        if (entries[index] == 0x0) {
-            uint64_t tmp = nextPage.fetch_add(1);
-            entries[index] = reinterpret_cast<void *>(tmp * pageSize | 0x1);
-        }
         res = std::min(reinterpret_cast<uintptr_t>(entries[index]) & 0xfffffffeu, res);
     }
     return (res & ~0x1) + (vm & (pageSize - 1));
 }
 
+void PTE::mapEntries(size_t indexStart, size_t indexEnd) {
+    uint32_t pagesToMap = 0;
+    for (size_t index = indexStart; index <= indexEnd; index++) {
+        if (entries[index] == nullptr) {
+            pagesToMap++;
+        }
+    }
+    if (pagesToMap == 0) {
+        return;
+    }
+
+    uint64_t page = nextPage.fetch_add(pagesToMap);
+    for (size_t index = indexStart; index <= indexEnd; index++) {
+        if (entries[index] == nullptr) {
+            entries[index] = reinterpret_cast<void *>(page * pageSize | 0x1);
+            page++;
+        }
+    }
+}
+
 template <class T, uint32_t level, uint32_t bits>
 uintptr_t PageTable<T, level, bits>::map(uintptr_t vm, size_t size) {
     const size_t shift = T::getBits() + 12;
@@ -83,28 +100,9 @@ uintptr_t PageTable<T, level, bits>::map(uintptr_t vm, size_t size) {
 }
 
 void PTE::pageWalk(uintptr_t vm, size_t size, size_t offset, PageWalker &pageWalker) {
-    static const uint32_t bits = 9;
-    const size_t shift = 12;
-    const uint32_t mask = (1 << bits) - 1;
-    size_t indexStart = (vm >> shift) & mask;
-    size_t indexEnd = ((vm + size - 1) >> shift) & mask;
-    uint64_t res = -1;
-    uintptr_t rem = vm & (pageSize - 1);
-
-    for (size_t index = indexStart; index <= indexEnd; index++) {
-        if (entries[index] == 0x0) {
-            uint64_t tmp = nextPage.fetch_add(1);
-            entries[index] = reinterpret_cast<void *>(tmp * pageSize | 0x1);
-        }
-        res = reinterpret_cast<uintptr_t>(entries[index]) & 0xfffffffeu;
-
-        size_t lSize = std::min(pageSize - rem, size);
-        pageWalker((res & ~0x1) + rem, lSize, offset);
-
-        size -= lSize;
-        offset += lSize;
-        rem = 0;
-    }
+    PageRunCollector<PageWalker> runs(pageWalker);
+    walkPages(vm, size, offset, runs);
+    runs.flush();
 }
 
 template <>
@@ -113,26 +111,9 @@ void PageTable<void, 0, 9>::pageWalk(uintptr_t vm, size_t size, size_t offset, P
 
 template <class T, uint32_t level, uint32_t bits>
 void PageTable<T, level, bits>::pageWalk(uintptr_t vm, size_t size, size_t offset, PageWalker &pageWalker) {
-    const size_t shift = T::getBits() + 12;
-    const uintptr_t mask = (1 << bits) - 1;
-    size_t indexStart = (vm >> shift) & mask;
-    size_t indexEnd = ((vm + size - 1) >> shift) & mask;
-    uintptr_t vmMask = (uintptr_t(-1) >> (sizeof(void *) * 8 - shift - bits));
-    auto maskedVm = vm & vmMask;
-
-    for (size_t index = indexStart; index <= indexEnd; index++) {
-        uintptr_t vmStart = (uintptr_t(1) << shift) * index;
-        vmStart = std::max(vmStart, maskedVm);
-        uintptr_t vmEnd = (uintptr_t(1) << shift) * (index + 1) - 1;
-        vmEnd = std::min(vmEnd, maskedVm + size - 1);
-
-        if (entries[index] == nullptr) {
-            entries[index] = new T;
-        }
-        entries[index]->pageWalk(vmStart, vmEnd - vmStart + 1, offset, pageWalker);
-
-        offset += (vmEnd - vmStart + 1);
-    }
+    PageRunCollector<PageWalker> runs(pageWalker);
+    walkPages(vm, size, offset, runs);
+    runs.flush();
 }
 
 template <>
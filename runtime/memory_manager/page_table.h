@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017, Intel Corporation
+ * Copyright (c) 2017 - 2018, Intel Corporation
  *
  * Permission is hereby granted, free of charge, to any person obtaining a
  * copy of this software and associated documentation files (the "Software"),
@@ -23,15 +23,50 @@
 #pragma once
 #include "runtime/helpers/basic_math.h"
 
+#include <algorithm>
 #include <functional>
 #include <atomic>
 #include <array>
 #include <memory>
+#include <type_traits>
 #include <vector>
 
 namespace OCLRT {
 
 typedef std::function<void(uint64_t addr, size_t size, size_t offset)> PageWalker;
+
+// Merges consecutive pages that are contiguous both in VA and in physical memory,
+// so walkers get one call per run instead of one per 4KB page
+template <typename WalkerT>
+class PageRunCollector {
+  public:
+    PageRunCollector(WalkerT &walker) : walker(walker) {}
+
+    void add(uint64_t physAddress, size_t size, size_t offset) {
+        if (runSize != 0 && runPhysAddress + runSize == physAddress && runOffset + runSize == offset) {
+            runSize += size;
+            return;
+        }
+        flush();
+        runPhysAddress = physAddress;
+        runSize = size;
+        runOffset = offset;
+    }
+
+    void flush() {
+        if (runSize != 0) {
+            walker(runPhysAddress, runSize, runOffset);
+            runSize = 0;
+        }
+    }
+
+  protected:
+    WalkerT &walker;
+    uint64_t runPhysAddress = 0;
+    size_t runSize = 0;
+    size_t runOffset = 0;
+};
+
 template <class T, uint32_t level, uint32_t bits = 9>
 class PageTable {
   public:
@@ -43,6 +78,17 @@ class PageTable {
     virtual uintptr_t map(uintptr_t vm, size_t size);
     virtual void pageWalk(uintptr_t vm, size_t size, size_t offset, PageWalker &pageWalker);
 
+    // Maps missing pages and calls pageWalker(physAddress, size, offset) once per physically contiguous run
+    template <typename WalkerT>
+    void pageWalk(uintptr_t vm, size_t size, size_t offset, WalkerT &&pageWalker) {
+        PageRunCollector<typename std::remove_reference<WalkerT>::type> runs(pageWalker);
+        walkPages(vm, size, offset, runs);
+        runs.flush();
+    }
+
+    template <typename CollectorT>
+    void walkPages(uintptr_t vm, size_t size, size_t offset, CollectorT &runs);
+
     static const size_t pageSize = 1 << 12;
     static size_t getBits() {
         return T::getBits() + bits;
@@ -52,16 +98,43 @@ class PageTable {
     std::array<T *, 1 << bits> entries;
 };
 
+template <>
+size_t PageTable<void, 0, 9>::getBits();
+
 class PTE : public PageTable<void, 0u> {
   public:
     uintptr_t map(uintptr_t vm, size_t size) override;
     void pageWalk(uintptr_t vm, size_t size, size_t offset, PageWalker &pageWalker) override;
 
+    template <typename CollectorT>
+    void walkPages(uintptr_t vm, size_t size, size_t offset, CollectorT &runs) {
+        const size_t shift = 12;
+        const uint32_t mask = (1 << bits) - 1;
+        size_t indexStart = (vm >> shift) & mask;
+        size_t indexEnd = ((vm + size - 1) >> shift) & mask;
+        uintptr_t rem = vm & (pageSize - 1);
+
+        mapEntries(indexStart, indexEnd);
+        for (size_t index = indexStart; index <= indexEnd; index++) {
+            uint64_t res = reinterpret_cast<uintptr_t>(entries[index]) & 0xfffffffeu;
+
+            size_t lSize = std::min(pageSize - rem, size);
+            runs.add(res + rem, lSize, offset);
+
+            size -= lSize;
+            offset += lSize;
+            rem = 0;
+        }
+    }
+
     static const uint32_t level = 0;
     static const uint32_t bits = 9;
     static const uint32_t initialPage;
 
   protected:
+    // allocates physical pages for all empty entries in [indexStart, indexEnd] with a single reservation
+    void mapEntries(size_t indexStart, size_t indexEnd);
+
     static std::atomic<uint32_t> nextPage;
 };
 class PDE : public PageTable<class PTE, 1> {
@@ -72,4 +145,29 @@ class PML4 : public PageTable<class PDP, 3> {
 };
 class PDPE : public PageTable<class PDE, 2, 2> {
 };
+
+template <class T, uint32_t level, uint32_t bits>
+template <typename CollectorT>
+void PageTable<T, level, bits>::walkPages(uintptr_t vm, size_t size, size_t offset, CollectorT &runs) {
+    const size_t shift = T::getBits() + 12;
+    const uintptr_t mask = (1 << bits) - 1;
+    size_t indexStart = (vm >> shift) & mask;
+    size_t indexEnd = ((vm + size - 1) >> shift) & mask;
+    uintptr_t vmMask = (uintptr_t(-1) >> (sizeof(void *) * 8 - shift - bits));
+    auto maskedVm = vm & vmMask;
+
+    for (size_t index = indexStart; index <= indexEnd; index++) {
+        uintptr_t vmStart = (uintptr_t(1) << shift) * index;
+        vmStart = std::max(vmStart, maskedVm);
+        uintptr_t vmEnd = (uintptr_t(1) << shift) * (index + 1) - 1;
+        vmEnd = std::min(vmEnd, maskedVm + size - 1);
+
+        if (entries[index] == nullptr) {
+            entries[index] = new T;
+        }
+        entries[index]->walkPages(vmStart, vmEnd - vmStart + 1, offset, runs);
+
+        offset += (vmEnd - vmStart + 1);
+    }
+}
 }
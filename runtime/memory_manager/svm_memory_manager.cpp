@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017, Intel Corporation
+ * Copyright (c) 2017 - 2018, Intel Corporation
  *
  * Permission is hereby granted, free of charge, to any person obtaining a
  * copy of this software and associated documentation files (the "Software"),
@@ -23,72 +23,315 @@
 #include "runtime/memory_manager/memory_manager.h"
 #include "runtime/memory_manager/svm_memory_manager.h"
 #include "runtime/helpers/aligned_memory.h"
+#include "runtime/helpers/ptr_math.h"
 #include "runtime/command_stream/command_stream_receiver.h"
 
+#include <algorithm>
+#include <thread>
+
 namespace OCLRT {
 
-void SVMAllocsManager::MapBasedAllocationTracker::insert(GraphicsAllocation &ga) {
-    allocs.insert(std::make_pair(ga.getUnderlyingBuffer(), &ga));
+const uint32_t SVMAllocsManager::PoolChunk::maxBlocks;
+const size_t SVMAllocsManager::RangeAllocationTracker::initialCapacity;
+const size_t SVMAllocsManager::minPooledSize;
+const size_t SVMAllocsManager::maxPooledSize;
+const size_t SVMAllocsManager::poolChunkSize = MemoryConstants::pageSize64k;
+const size_t SVMAllocsManager::numSizeClasses;
+
+bool SVMAllocsManager::PoolChunk::isBlockLive(uint32_t block) const {
+    return block < blockCount && (liveBlocks[block / 64].load(std::memory_order_acquire) & (1ull << (block % 64))) != 0;
+}
+
+uint32_t SVMAllocsManager::PoolChunk::getBlockIndex(const void *ptr) const {
+    return static_cast<uint32_t>(ptrDiff(ptr, allocation->getUnderlyingBuffer()) / blockSize);
+}
+
+SVMAllocsManager::RangeAllocationTracker::RangeAllocationTracker() : sequence(0), numEntries(0) {
+    storages.push_back(std::unique_ptr<Storage>(new Storage(initialCapacity)));
+    storage.store(storages.back().get(), std::memory_order_release);
+}
+
+void SVMAllocsManager::RangeAllocationTracker::beginWrite() {
+    sequence.store(sequence.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+}
+
+void SVMAllocsManager::RangeAllocationTracker::endWrite() {
+    sequence.store(sequence.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+void SVMAllocsManager::RangeAllocationTracker::copyEntry(Entry &dst, const Entry &src) {
+    dst.begin.store(src.begin.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    dst.end.store(src.end.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    dst.allocation.store(src.allocation.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    dst.chunk.store(src.chunk.load(std::memory_order_relaxed), std::memory_order_relaxed);
+}
+
+void SVMAllocsManager::RangeAllocationTracker::insert(GraphicsAllocation &ga, PoolChunk *chunk) {
+    auto begin = reinterpret_cast<uintptr_t>(ga.getUnderlyingBuffer());
+    auto count = numEntries.load(std::memory_order_relaxed);
+    auto currentStorage = storage.load(std::memory_order_relaxed);
+
+    beginWrite();
+    if (count == currentStorage->capacity) {
+        storages.push_back(std::unique_ptr<Storage>(new Storage(currentStorage->capacity * 2)));
+        auto grownStorage = storages.back().get();
+        for (size_t i = 0; i < count; i++) {
+            copyEntry(grownStorage->entries[i], currentStorage->entries[i]);
+        }
+        storage.store(grownStorage, std::memory_order_release);
+        currentStorage = grownStorage;
+    }
+
+    auto entries = currentStorage->entries.get();
+    auto position = count;
+    while (position > 0 && entries[position - 1].begin.load(std::memory_order_relaxed) > begin) {
+        copyEntry(entries[position], entries[position - 1]);
+        position--;
+    }
+    entries[position].begin.store(begin, std::memory_order_relaxed);
+    entries[position].end.store(begin + ga.getUnderlyingBufferSize(), std::memory_order_relaxed);
+    entries[position].allocation.store(&ga, std::memory_order_relaxed);
+    entries[position].chunk.store(chunk, std::memory_order_relaxed);
+    numEntries.store(count + 1, std::memory_order_relaxed);
+    endWrite();
+}
+
+void SVMAllocsManager::RangeAllocationTracker::remove(GraphicsAllocation &ga) {
+    auto count = numEntries.load(std::memory_order_relaxed);
+    auto entries = storage.load(std::memory_order_relaxed)->entries.get();
+
+    size_t position = 0;
+    while (position < count && entries[position].allocation.load(std::memory_order_relaxed) != &ga) {
+        position++;
+    }
+    if (position == count) {
+        return;
+    }
+
+    beginWrite();
+    for (; position + 1 < count; position++) {
+        copyEntry(entries[position], entries[position + 1]);
+    }
+    numEntries.store(count - 1, std::memory_order_relaxed);
+    endWrite();
 }
 
-void SVMAllocsManager::MapBasedAllocationTracker::remove(GraphicsAllocation &ga) {
-    std::map<const void *, GraphicsAllocation *>::iterator iter;
-    iter = allocs.find(ga.getUnderlyingBuffer());
-    allocs.erase(iter);
+GraphicsAllocation *SVMAllocsManager::RangeAllocationTracker::get(const void *ptr) const {
+    PoolChunk *chunk = nullptr;
+    return get(ptr, chunk);
 }
 
-GraphicsAllocation *SVMAllocsManager::MapBasedAllocationTracker::get(const void *ptr) {
-    std::map<const void *, GraphicsAllocation *>::iterator Iter, End;
-    GraphicsAllocation *GA;
+GraphicsAllocation *SVMAllocsManager::RangeAllocationTracker::get(const void *ptr, PoolChunk *&chunk) const {
+    chunk = nullptr;
     if (ptr == nullptr)
         return nullptr;
-    End = allocs.end();
-    Iter = allocs.lower_bound(ptr);
-    if (((Iter != End) && (Iter->first != ptr)) ||
-        (Iter == End)) {
-        if (Iter == allocs.begin()) {
-            Iter = End;
-        } else {
-            Iter--;
+    auto address = reinterpret_cast<uintptr_t>(ptr);
+
+    while (true) {
+        auto startSequence = sequence.load(std::memory_order_acquire);
+        if (startSequence & 1) {
+            std::this_thread::yield();
+            continue;
+        }
+
+        auto currentStorage = storage.load(std::memory_order_acquire);
+        auto entries = currentStorage->entries.get();
+        size_t low = 0;
+        size_t high = std::min(numEntries.load(std::memory_order_relaxed), currentStorage->capacity);
+        while (low < high) {
+            auto middle = low + (high - low) / 2;
+            if (entries[middle].begin.load(std::memory_order_relaxed) <= address) {
+                low = middle + 1;
+            } else {
+                high = middle;
+            }
+        }
+
+        GraphicsAllocation *allocation = nullptr;
+        PoolChunk *allocationChunk = nullptr;
+        if (low > 0 && address < entries[low - 1].end.load(std::memory_order_relaxed)) {
+            allocation = entries[low - 1].allocation.load(std::memory_order_relaxed);
+            allocationChunk = entries[low - 1].chunk.load(std::memory_order_relaxed);
+        }
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (sequence.load(std::memory_order_relaxed) == startSequence) {
+            chunk = allocationChunk;
+            return allocation;
         }
     }
-    if (Iter != End) {
-        GA = Iter->second;
-        if (ptr < ((char *)GA->getUnderlyingBuffer() + GA->getUnderlyingBufferSize())) {
-            return GA;
+}
+
+SVMAllocsManager::SVMAllocsManager(MemoryManager *memoryManager) : memoryManager(memoryManager), numAllocs(0) {
+}
+
+SVMAllocsManager::~SVMAllocsManager() {
+    for (auto &coherencyPools : pools) {
+        for (auto &pool : coherencyPools) {
+            for (auto &chunk : pool.chunks) {
+                if (memoryManager->csr) {
+                    memoryManager->checkGpuUsageAndDestroyGraphicsAllocations(chunk->allocation);
+                } else {
+                    memoryManager->freeGraphicsMemory(chunk->allocation);
+                }
+            }
         }
     }
-    return nullptr;
 }
 
-SVMAllocsManager::SVMAllocsManager(MemoryManager *memoryManager) : memoryManager(memoryManager) {
+size_t SVMAllocsManager::getSizeClass(size_t size) {
+    size_t sizeClass = 0;
+    while ((minPooledSize << sizeClass) < size) {
+        sizeClass++;
+    }
+    return sizeClass;
 }
 
 void *SVMAllocsManager::createSVMAlloc(size_t size, bool coherent) {
     if (size == 0)
         return nullptr;
 
+    if (size <= maxPooledSize) {
+        return createPooledSVMAlloc(size, coherent);
+    }
+
     std::unique_lock<std::mutex> lock(mtx);
     GraphicsAllocation *GA = memoryManager->allocateGraphicsMemoryForSVM(size, coherent);
     if (!GA) {
         return nullptr;
     }
     this->SVMAllocs.insert(*GA);
+    numAllocs++;
 
     return GA->getUnderlyingBuffer();
 }
 
-GraphicsAllocation *SVMAllocsManager::getSVMAlloc(const void *ptr) {
+void *SVMAllocsManager::createPooledSVMAlloc(size_t size, bool coherent) {
+    auto sizeClass = getSizeClass(size);
+    auto &pool = pools[coherent ? 1 : 0][sizeClass];
+
     std::unique_lock<std::mutex> lock(mtx);
-    return SVMAllocs.get(ptr);
+    while (!pool.pendingBlocks.empty() && isBlockReusable(pool.pendingBlocks.front().taskCount)) {
+        pool.freeBlocks.push_back(pool.pendingBlocks.front());
+        pool.pendingBlocks.pop_front();
+    }
+    if (pool.freeBlocks.empty() && !addPoolChunk(pool, minPooledSize << sizeClass, coherent)) {
+        return nullptr;
+    }
+
+    auto pooledBlock = pool.freeBlocks.back();
+    pool.freeBlocks.pop_back();
+    pooledBlock.chunk->liveBlocks[pooledBlock.block / 64].fetch_or(1ull << (pooledBlock.block % 64), std::memory_order_release);
+    numAllocs++;
+
+    return ptrOffset(pooledBlock.chunk->allocation->getUnderlyingBuffer(), pooledBlock.block * pooledBlock.chunk->blockSize);
+}
+
+SVMAllocsManager::PoolChunk *SVMAllocsManager::addPoolChunk(Pool &pool, size_t blockSize, bool coherent) {
+    GraphicsAllocation *allocation = memoryManager->allocateGraphicsMemoryForSVM(poolChunkSize, coherent);
+    if (!allocation) {
+        return nullptr;
+    }
+
+    std::unique_ptr<PoolChunk> chunk(new PoolChunk);
+    chunk->allocation = allocation;
+    chunk->blockSize = blockSize;
+    chunk->blockCount = static_cast<uint32_t>(poolChunkSize / blockSize);
+    for (auto &liveMask : chunk->liveBlocks) {
+        liveMask.store(0, std::memory_order_relaxed);
+    }
+    // lowest addresses are handed out first
+    for (auto block = chunk->blockCount; block > 0; block--) {
+        pool.freeBlocks.push_back({chunk.get(), block - 1, ObjectNotUsed});
+    }
+
+    SVMAllocs.insert(*allocation, chunk.get());
+    pool.chunks.push_back(std::move(chunk));
+    return pool.chunks.back().get();
+}
+
+bool SVMAllocsManager::isBlockReusable(uint32_t taskCount) const {
+    auto csr = memoryManager->csr;
+    return taskCount == ObjectNotUsed || csr == nullptr || taskCount <= *csr->getTagAddress();
+}
+
+GraphicsAllocation *SVMAllocsManager::getSVMAlloc(const void *ptr) {
+    SvmAllocationData allocData;
+    if (!getSVMAllocData(ptr, allocData)) {
+        return nullptr;
+    }
+    return allocData.gpuAllocation;
+}
+
+// Returns the allocation only if [ptr, ptr + size) lies within a single SVM allocation
+GraphicsAllocation *SVMAllocsManager::getSVMAlloc(const void *ptr, size_t size) {
+    SvmAllocationData allocData;
+    if (!getSVMAllocData(ptr, allocData)) {
+        return nullptr;
+    }
+    auto offset = ptrDiff(ptr, allocData.baseAddress);
+    if (size > allocData.size - offset) {
+        return nullptr;
+    }
+    return allocData.gpuAllocation;
+}
+
+bool SVMAllocsManager::getSVMAllocData(const void *ptr, SvmAllocationData &allocData) {
+    PoolChunk *chunk = nullptr;
+    auto GA = SVMAllocs.get(ptr, chunk);
+    if (!GA) {
+        return false;
+    }
+    if (chunk) {
+        auto block = chunk->getBlockIndex(ptr);
+        if (!chunk->isBlockLive(block)) {
+            return false;
+        }
+        allocData.baseAddress = ptrOffset(GA->getUnderlyingBuffer(), block * chunk->blockSize);
+        allocData.size = chunk->blockSize;
+    } else {
+        allocData.baseAddress = GA->getUnderlyingBuffer();
+        allocData.size = GA->getUnderlyingBufferSize();
+    }
+    allocData.gpuAllocation = GA;
+    return true;
 }
 
 void SVMAllocsManager::freeSVMAlloc(void *ptr) {
-    GraphicsAllocation *GA = getSVMAlloc(ptr);
-    if (GA) {
-        std::unique_lock<std::mutex> lock(mtx);
-        SVMAllocs.remove(*GA);
-        memoryManager->freeGraphicsMemory(GA);
+    std::unique_lock<std::mutex> lock(mtx);
+    PoolChunk *chunk = nullptr;
+    GraphicsAllocation *GA = SVMAllocs.get(ptr, chunk);
+    if (!GA) {
+        return;
+    }
+    if (chunk) {
+        freePooledSVMAlloc(*chunk, ptr);
+        return;
+    }
+    SVMAllocs.remove(*GA);
+    numAllocs--;
+    memoryManager->freeGraphicsMemory(GA);
+}
+
+void SVMAllocsManager::freePooledSVMAlloc(PoolChunk &chunk, void *ptr) {
+    auto block = chunk.getBlockIndex(ptr);
+    if (block >= chunk.blockCount) {
+        return;
+    }
+    auto blockMask = 1ull << (block % 64);
+    if ((chunk.liveBlocks[block / 64].fetch_and(~blockMask, std::memory_order_acq_rel) & blockMask) == 0) {
+        return;
+    }
+    numAllocs--;
+
+    // the chunk's task count covers every submission that used any of its blocks
+    PooledBlock pooledBlock = {&chunk, block, chunk.allocation->taskCount};
+    auto &pool = pools[chunk.allocation->isCoherent() ? 1 : 0][getSizeClass(chunk.blockSize)];
+    if (isBlockReusable(pooledBlock.taskCount)) {
+        pool.freeBlocks.push_back(pooledBlock);
+    } else {
+        pool.pendingBlocks.push_back(pooledBlock);
     }
 }
 } // namespace OCLRT
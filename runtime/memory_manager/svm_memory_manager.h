@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017, Intel Corporation
+ * Copyright (c) 2017 - 2018, Intel Corporation
  *
  * Permission is hereby granted, free of charge, to any person obtaining a
  * copy of this software and associated documentation files (the "Software"),
@@ -21,9 +21,12 @@
  */
 
 #pragma once
+#include <atomic>
 #include <cstdint>
-#include <map>
+#include <deque>
+#include <memory>
 #include <mutex>
+#include <vector>
 
 namespace OCLRT {
 class Device;
@@ -33,26 +36,102 @@ class MemoryManager;
 
 class SVMAllocsManager {
   public:
-    class MapBasedAllocationTracker {
+    // Sub-page SVM allocations are carved out of chunks shared by all
+    // allocations of the same size class
+    struct PoolChunk {
+        static const uint32_t maxBlocks = 256;
+
+        GraphicsAllocation *allocation = nullptr;
+        size_t blockSize = 0;
+        uint32_t blockCount = 0;
+        std::atomic<uint64_t> liveBlocks[maxBlocks / 64];
+
+        bool isBlockLive(uint32_t block) const;
+        uint32_t getBlockIndex(const void *ptr) const;
+    };
+
+    // Sorted array of address ranges, readers do not take a lock and retry
+    // when a writer modified the array in the meantime. Writers have to be
+    // serialized by the owner.
+    class RangeAllocationTracker {
       public:
-        void insert(GraphicsAllocation &);
+        RangeAllocationTracker();
+        void insert(GraphicsAllocation &, PoolChunk *chunk = nullptr);
         void remove(GraphicsAllocation &);
-        GraphicsAllocation *get(const void *);
-        size_t getNumAllocs() const { return allocs.size(); };
+        GraphicsAllocation *get(const void *ptr) const;
+        GraphicsAllocation *get(const void *ptr, PoolChunk *&chunk) const;
+        size_t getNumAllocs() const { return numEntries.load(std::memory_order_relaxed); };
 
       protected:
-        std::map<const void *, GraphicsAllocation *> allocs;
+        struct Entry {
+            std::atomic<uintptr_t> begin;
+            std::atomic<uintptr_t> end;
+            std::atomic<GraphicsAllocation *> allocation;
+            std::atomic<PoolChunk *> chunk;
+        };
+        struct Storage {
+            explicit Storage(size_t capacity) : capacity(capacity), entries(new Entry[capacity]()) {}
+            const size_t capacity;
+            std::unique_ptr<Entry[]> entries;
+        };
+
+        void beginWrite();
+        void endWrite();
+        static void copyEntry(Entry &dst, const Entry &src);
+
+        std::atomic<uint32_t> sequence;
+        std::atomic<size_t> numEntries;
+        std::atomic<Storage *> storage;
+        // storages are never released while the tracker lives, a reader may still walk a replaced one
+        std::vector<std::unique_ptr<Storage>> storages;
+        static const size_t initialCapacity = 64;
     };
 
+    // Range of a single SVM allocation as seen by the user, for pooled
+    // allocations this is the block rather than the whole chunk
+    struct SvmAllocationData {
+        GraphicsAllocation *gpuAllocation = nullptr;
+        const void *baseAddress = nullptr;
+        size_t size = 0;
+    };
+
+    static const size_t minPooledSize = 256;
+    static const size_t maxPooledSize = 2048;
+    static const size_t poolChunkSize;
+
     SVMAllocsManager(MemoryManager *memoryManager);
+    ~SVMAllocsManager();
     void *createSVMAlloc(size_t size, bool coherent = false);
     GraphicsAllocation *getSVMAlloc(const void *ptr);
+    GraphicsAllocation *getSVMAlloc(const void *ptr, size_t size);
+    bool getSVMAllocData(const void *ptr, SvmAllocationData &allocData);
     void freeSVMAlloc(void *ptr);
-    size_t getNumAllocs() const { return SVMAllocs.getNumAllocs(); }
+    size_t getNumAllocs() const { return numAllocs.load(std::memory_order_relaxed); }
 
   protected:
-    MapBasedAllocationTracker SVMAllocs;
+    struct PooledBlock {
+        PoolChunk *chunk;
+        uint32_t block;
+        uint32_t taskCount;
+    };
+    struct Pool {
+        std::vector<std::unique_ptr<PoolChunk>> chunks;
+        std::vector<PooledBlock> freeBlocks;
+        // blocks released while their chunk was still in use by the GPU, ordered by release
+        std::deque<PooledBlock> pendingBlocks;
+    };
+    static const size_t numSizeClasses = 4;
+
+    static size_t getSizeClass(size_t size);
+    void *createPooledSVMAlloc(size_t size, bool coherent);
+    void freePooledSVMAlloc(PoolChunk &chunk, void *ptr);
+    bool isBlockReusable(uint32_t taskCount) const;
+    PoolChunk *addPoolChunk(Pool &pool, size_t blockSize, bool coherent);
+
+    RangeAllocationTracker SVMAllocs;
+    Pool pools[2][numSizeClasses];
     MemoryManager *memoryManager;
+    std::atomic<size_t> numAllocs;
     std::mutex mtx;
 };
 } // namespace OCLRT
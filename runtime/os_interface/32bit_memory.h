@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017, Intel Corporation
+ * Copyright (c) 2017 - 2018, Intel Corporation
  *
  * Permission is hereby granted, free of charge, to any person obtaining a
  * copy of this software and associated documentation files (the "Software"),
@@ -21,7 +21,7 @@
  */
 
 #pragma once
-#include "runtime/utilities/heap_allocator.h"
+#include "runtime/utilities/segregated_heap_allocator.h"
 #include <stdint.h>
 #include <memory>
 
@@ -44,7 +44,7 @@ class Allocator32bit {
 
   protected:
     std::unique_ptr<OsInternals> osInternals;
-    std::unique_ptr<HeapAllocator> heapAllocator;
+    std::unique_ptr<SegregatedHeapAllocator> heapAllocator;
     uint64_t base = 0;
     uint64_t size = 0;
 };
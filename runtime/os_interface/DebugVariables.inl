@@ -28,8 +28,13 @@ DECLARE_DEBUG_VARIABLE(bool, DoCpuCopyOnWriteBuffer, false, "triggers CPU copy p
 DECLARE_DEBUG_VARIABLE(bool, DisableResourceRecycling, false, "when set to true disables resource recycling optimization")
 DECLARE_DEBUG_VARIABLE(int32_t, InitializeMemoryInDebug, 0x10, "Memory initialization in debug")
 DECLARE_DEBUG_VARIABLE(int32_t, SchedulerSimulationReturnInstance, 0, "prints execution model related debug information")
+DECLARE_DEBUG_VARIABLE(int32_t, SchedulerSimulationHwGroups, 1, "number of scheduler HW groups run on host threads by scheduler simulation, up to PARALLEL_SCHEDULER_HW_GROUPS")
+DECLARE_DEBUG_VARIABLE(std::string, SchedulerSimulationRecordFile, std::string("unk"), "when set, device queue surfaces are written to this file before scheduler simulation runs, for replay with SchedulerSimulationReplay")
+DECLARE_DEBUG_VARIABLE(std::string, SchedulerSimulationReplayFile, std::string("unk"), "when set, record written with SchedulerSimulationRecordFile is replayed by unit tests on SchedulerSimulationHwGroups HW groups and scheduler stats are reported")
+DECLARE_DEBUG_VARIABLE(int32_t, SchedulerSimulationReplayIterations, 100, "number of scheduler passes run when replaying SchedulerSimulationReplayFile")
 DECLARE_DEBUG_VARIABLE(bool, ForceDispatchScheduler, false, "dispatches scheduler kernel instead of kernel enqueued")
 DECLARE_DEBUG_VARIABLE(bool, TrackParentEvents, false, "events track their parents")
+DECLARE_DEBUG_VARIABLE(bool, TrackUsedTags, false, "tag allocators keep a list of handed out tags")
 /*LOGGING FLAGS*/
 DECLARE_DEBUG_VARIABLE(bool, PrintDebugMessages, false, "when enabled, some debug messages will be propagated to console")
 DECLARE_DEBUG_VARIABLE(bool, DumpKernels, false, "Enables dumping kernels' program source code to text files and program from binary to bin file")
@@ -84,6 +89,28 @@ DECLARE_DEBUG_VARIABLE(int32_t, OverrideEnableQuickKmdSleepForSporadicWaits, -1,
 DECLARE_DEBUG_VARIABLE(int32_t, OverrideDelayQuickKmdSleepForSporadicWaitsMicroseconds, -1, "-1: dont override, >0: timeout in microseconds")
 DECLARE_DEBUG_VARIABLE(bool, EnableVaLibCalls, true, "Enable cl-va sharing lib calls")
 DECLARE_DEBUG_VARIABLE(int32_t, CsrDispatchMode, 0, "Chooses DispatchMode for Csr")
+DECLARE_DEBUG_VARIABLE(int32_t, OverrideBinaryCacheSizeLimitMB, -1, "-1: dont override, 0: unlimited, >0: size limit of compiled binary cache in MB")
+DECLARE_DEBUG_VARIABLE(int32_t, EnableBufferObjectCache, -1, "-1: default (enabled), 0: disable, 1: enable reusing idle buffer objects in DrmMemoryManager")
+DECLARE_DEBUG_VARIABLE(int32_t, OverrideBufferObjectCacheSizeLimitMB, -1, "-1: dont override, >=0: size limit of idle buffer object cache in MB")
+DECLARE_DEBUG_VARIABLE(int32_t, CsrBatchedDispatchCounterLimit, -1, "-1: default (16), >0: number of command buffers after which BatchedDispatchWithCounter flushes implicitly")
+DECLARE_DEBUG_VARIABLE(int32_t, CsrAdaptiveDispatchQueueDepth, 8, "AdaptiveDispatch: number of pending command buffers that triggers submission")
+DECLARE_DEBUG_VARIABLE(int32_t, CsrAdaptiveDispatchMaxDelayUs, 200, "AdaptiveDispatch: max time in microseconds a command buffer may wait for coalescing")
+DECLARE_DEBUG_VARIABLE(int32_t, EnableLocalIdCache, -1, "-1: default (enabled), 0: disable, 1: enable reusing generated local IDs for repeated work group shapes")
+DECLARE_DEBUG_VARIABLE(int32_t, EnableLocalWorkSizeCache, -1, "-1: default (enabled), 0: disable, 1: enable memoizing driver chosen local work sizes per kernel")
+DECLARE_DEBUG_VARIABLE(bool, PrintAsyncEventsCallbackLatency, false, "prints histogram of async events handler callback latencies, from completed task count being read to callbacks returned, when the handler is destroyed")
+DECLARE_DEBUG_VARIABLE(int32_t, EnableKernelIsaHeapCache, -1, "-1: default (enabled), 0: disable, 1: enable reusing kernel ISA already copied to the instruction heap")
+DECLARE_DEBUG_VARIABLE(int32_t, EnableKernelStateReuse, -1, "-1: default (enabled), 0: disable, 1: enable skipping re-patching of unchanged buffer args and re-pushing of unchanged kernel surface states")
+DECLARE_DEBUG_VARIABLE(int32_t, KernelParsingThreads, -1, "-1: default (hardware concurrency), 0: disable, >0: number of threads parsing kernels of a program binary")
+DECLARE_DEBUG_VARIABLE(bool, DeferKernelIsaUpload, false, "Upload kernel ISA to its internal allocation when the kernel is first created instead of when the program is built")
+DECLARE_DEBUG_VARIABLE(int32_t, EnableAUBDirtyPageTracking, -1, "-1: default (enabled), 0: disable, 1: enable writing only command buffer and heap pages whose content changed since they were last dumped to AUB")
+DECLARE_DEBUG_VARIABLE(bool, PrintAUBDumpStatistics, false, "prints AUB file size, time spent writing memory and written/skipped page counts when AUB CSR is destroyed")
+DECLARE_DEBUG_VARIABLE(int32_t, AUBDumpBufferedWriter, -1, "-1: default (enabled), 0: disable, 1: enable writing AUB file from a dedicated thread fed with large buffers")
+DECLARE_DEBUG_VARIABLE(bool, AUBDumpCompression, false, "Compress AUB file with built-in LZ codec, file gets .lz suffix and has to be decompressed before use")
+DECLARE_DEBUG_VARIABLE(int32_t, TbxSocketBatching, -1, "-1: default (enabled), 0: disable, 1: enable batching and coalescing TBX write requests until a response is needed")
+DECLARE_DEBUG_VARIABLE(int32_t, PlatformWorkerThreads, -1, "-1: default (hardware concurrency - 1, at most 7), 0: disable, >0: number of platform worker threads splitting large host copies")
+DECLARE_DEBUG_VARIABLE(int32_t, HostCopyNonTemporal, -1, "-1: default (streaming stores for host copies of 4MB and more), 0: disable, 1: use streaming stores for all host copies")
+DECLARE_DEBUG_VARIABLE(int32_t, GpuTimestampModelResyncInterval, -1, "-1: default (50 ms), 0: disable model and read GPU timestamp on every query, >0: interval in microseconds between real CPU/GPU timestamp samples")
+DECLARE_DEBUG_VARIABLE(int32_t, GpuTimestampModelErrorBound, -1, "-1: default (10 us), >0: max error in nanoseconds of modeled GPU timestamp before model is recalibrated")
 /*DRIVER TOGGLES*/
 DECLARE_DEBUG_VARIABLE(int32_t, ForceOCLVersion, 0, "Force specific OpenCL API version")
 DECLARE_DEBUG_VARIABLE(int32_t, ForcePreemptionMode, -1, "Keep this variable in sync with PreemptionMode enum. -1 - devices default mode, 1 - disable, 2 - midBatch, 3 - threadGroup, 4 - midThread")
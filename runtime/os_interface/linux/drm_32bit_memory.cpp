@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017, Intel Corporation
+ * Copyright (c) 2017 - 2018, Intel Corporation
  *
  * Permission is hereby granted, free of charge, to any person obtaining a
  * copy of this software and associated documentation files (the "Software"),
@@ -96,7 +96,7 @@ bool OCLRT::is32BitOsAllocatorAvailable = true;
 Allocator32bit::Allocator32bit(uint64_t base, uint64_t size) {
     this->base = base;
     this->size = size;
-    heapAllocator = std::unique_ptr<HeapAllocator>(new HeapAllocator((void *)base, size));
+    heapAllocator = std::unique_ptr<SegregatedHeapAllocator>(new SegregatedHeapAllocator((void *)base, size));
 }
 
 OCLRT::Allocator32bit::Allocator32bit() : Allocator32bit(new OsInternals) {
@@ -133,7 +133,7 @@ OCLRT::Allocator32bit::Allocator32bit(Allocator32bit::OsInternals *osInternalsIn
         base = (uint64_t)ptr;
         size = sizeToMap;
 
-        heapAllocator = std::unique_ptr<HeapAllocator>(new HeapAllocator(ptr, sizeToMap));
+        heapAllocator = std::unique_ptr<SegregatedHeapAllocator>(new SegregatedHeapAllocator(ptr, sizeToMap));
     } else {
         this->osInternals->drmAllocator = new Allocator32bit::OsInternals::Drm32BitAllocator(*this->osInternals);
     }
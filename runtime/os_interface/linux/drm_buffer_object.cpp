@@ -44,6 +44,9 @@
 
 namespace OCLRT {
 
+std::atomic<uint64_t> BufferObject::nextExecObjectVersion(1);
+std::atomic<uint64_t> BufferObject::nextResidencyGeneration(1);
+
 BufferObject::BufferObject(Drm *drm, int handle, bool isAllocated) : drm(drm), refCount(1), handle(handle), isReused(false), isAllocated(isAllocated) {
     this->isSoftpin = false;
 
@@ -56,6 +59,11 @@ BufferObject::BufferObject(Drm *drm, int handle, bool isAllocated) : drm(drm), r
     this->address = nullptr;
     this->lockedAddress = nullptr;
     this->offset64 = 0;
+    updateExecObjectVersion();
+}
+
+void BufferObject::updateExecObjectVersion() {
+    this->execObjectVersion = nextExecObjectVersion++;
 }
 
 uint32_t BufferObject::getRefCount() const {
@@ -65,6 +73,7 @@ uint32_t BufferObject::getRefCount() const {
 bool BufferObject::softPin(uint64_t offset) {
     this->isSoftpin = true;
     this->offset64 = offset;
+    updateExecObjectVersion();
 
     return true;
 };
@@ -137,7 +146,14 @@ void BufferObject::fillExecObject(drm_i915_gem_exec_object2 &execObject) {
 
 void BufferObject::processRelocs(int &idx) {
     for (size_t i = 0; i < this->residency.size(); i++) {
-        residency[i]->fillExecObject(execObjectsStorage[idx]);
+        auto version = residency[i]->execObjectVersion;
+        if (execObjectsVersions == nullptr || execObjectsVersions[idx] != version) {
+            residency[i]->fillExecObject(execObjectsStorage[idx]);
+            if (execObjectsVersions) {
+                execObjectsVersions[idx] = version;
+            }
+            execObjectsFilled++;
+        }
         idx++;
     }
 }
@@ -146,8 +162,14 @@ int BufferObject::exec(uint32_t used, size_t startOffset, unsigned int flags, bo
     drm_i915_gem_execbuffer2 execbuf = {};
 
     int idx = 0;
+    execObjectsFilled = 0;
     processRelocs(idx);
     this->fillExecObject(execObjectsStorage[idx]);
+    if (execObjectsVersions) {
+        // batch buffer slot moves with residency size, never treat it as up to date
+        execObjectsVersions[idx] = 0;
+    }
+    execObjectsFilled++;
     idx++;
 
     execbuf.buffers_ptr = reinterpret_cast<uintptr_t>(execObjectsStorage);
@@ -74,7 +74,10 @@ class BufferObject {
     size_t peekSize() const { return size; }
     int peekHandle() const { return handle; }
     void *peekAddress() const { return address; }
-    void setAddress(void *address) { this->address = address; }
+    void setAddress(void *address) {
+        this->address = address;
+        updateExecObjectVersion();
+    }
     void *peekLockedAddress() const { return lockedAddress; }
     void setLockedAddress(void *cpuAddress) { this->lockedAddress = cpuAddress; }
     void setUnmapSize(uint64_t unmapSize) { this->unmapSize = unmapSize; }
@@ -85,6 +88,16 @@ class BufferObject {
     void setExecObjectsStorage(drm_i915_gem_exec_object2 *storage) {
         execObjectsStorage = storage;
     }
+    // Versions of exec objects already present in the storage, entries that match are not filled again
+    void setExecObjectsVersions(uint64_t *versions) {
+        execObjectsVersions = versions;
+    }
+    uint32_t peekExecObjectsFilled() const { return execObjectsFilled; }
+    uint64_t peekExecObjectVersion() const { return execObjectVersion; }
+    uint64_t peekResidencyGeneration() const { return residencyGeneration; }
+    void setResidencyGeneration(uint64_t generation) { residencyGeneration = generation; }
+    // generations are unique across all command stream receivers sharing this object
+    static uint64_t acquireResidencyGeneration() { return nextResidencyGeneration++; }
     ResidencyVector *getResidency() { return &residency; }
     StorageAllocatorType peekAllocationType() const { return storageAllocatorType; }
     void setAllocationType(StorageAllocatorType allocatorType) { this->storageAllocatorType = allocatorType; }
@@ -109,6 +122,7 @@ class BufferObject {
 
     MOCKABLE_VIRTUAL void fillExecObject(drm_i915_gem_exec_object2 &execObject);
     void processRelocs(int &idx);
+    void updateExecObjectVersion();
 
     uint64_t offset64; // last-seen GPU offset
     size_t size;
@@ -118,5 +132,14 @@ class BufferObject {
     bool isAllocated = false;
     uint64_t unmapSize = 0;
     StorageAllocatorType storageAllocatorType = UNKNOWN_ALLOCATOR;
+
+    // changes whenever data written by fillExecObject changes, 0 is never used
+    uint64_t execObjectVersion = 0;
+    uint64_t *execObjectsVersions = nullptr;
+    uint32_t execObjectsFilled = 0;
+    // last residency generation of the command stream receiver this object was made resident in
+    uint64_t residencyGeneration = 0;
+    static std::atomic<uint64_t> nextExecObjectVersion;
+    static std::atomic<uint64_t> nextResidencyGeneration;
 };
 }
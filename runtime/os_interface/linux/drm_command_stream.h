@@ -48,6 +48,7 @@ class DrmCommandStreamReceiver : public DeviceCommandStreamReceiver<GfxFamily> {
     // When drm is null default implementation is used. In this case DrmCommandStreamReceiver is responsible to free drm.
     // When drm is passed, DCSR will not free it at destruction
     DrmCommandStreamReceiver(const HardwareInfo &hwInfoIn, Drm *drm, gemCloseWorkerMode mode = gemCloseWorkerMode::gemCloseWorkerInactive);
+    ~DrmCommandStreamReceiver() override;
 
     FlushStamp flush(BatchBuffer &batchBuffer, EngineType engineType, ResidencyContainer *allocationsForResidency) override;
     void makeResident(GraphicsAllocation &gfxAllocation) override;
@@ -63,12 +64,28 @@ class DrmCommandStreamReceiver : public DeviceCommandStreamReceiver<GfxFamily> {
         return this->gemCloseWorkerOperationMode;
     }
 
+    struct ResidencyStats {
+        uint64_t flushes = 0;
+        uint64_t execObjects = 0;
+        uint64_t execObjectsFilled = 0;
+        uint64_t duplicatesSkipped = 0;
+        uint32_t lastFlushExecObjects = 0;
+        uint32_t lastFlushExecObjectsFilled = 0;
+    };
+    const ResidencyStats &peekResidencyStats() const { return residencyStats; }
+
   protected:
     void makeResident(BufferObject *bo);
+    void advanceResidencyGeneration();
     void programVFEState(LinearStream &csr, DispatchFlags &dispatchFlags) override;
 
     std::vector<BufferObject *> residency;
     std::vector<drm_i915_gem_exec_object2> execObjectsStorage;
+    // exec object versions stored in execObjectsStorage, kept between flushes so unchanged entries are reused
+    std::vector<uint64_t> execObjectsVersions;
+    // BOs stamped with the current generation are already in residency
+    uint64_t residencyGeneration = 0;
+    ResidencyStats residencyStats;
     Drm *drm;
     gemCloseWorkerMode gemCloseWorkerOperationMode;
     bool mediaVfeStateLowPriorityDirty = true;
@@ -43,10 +43,17 @@ DrmCommandStreamReceiver<GfxFamily>::DrmCommandStreamReceiver(const HardwareInfo
     this->drm = drm ? drm : Drm::get(0);
     residency.reserve(512);
     execObjectsStorage.reserve(512);
+    execObjectsVersions.reserve(512);
+    residencyGeneration = BufferObject::acquireResidencyGeneration();
     CommandStreamReceiver::osInterface = std::unique_ptr<OSInterface>(new OSInterface());
     CommandStreamReceiver::osInterface.get()->get()->setDrm(this->drm);
 }
 
+template <typename GfxFamily>
+DrmCommandStreamReceiver<GfxFamily>::~DrmCommandStreamReceiver() {
+    this->closeAdaptiveDispatcher();
+}
+
 template <typename GfxFamily>
 FlushStamp DrmCommandStreamReceiver<GfxFamily>::flush(BatchBuffer &batchBuffer, EngineType engineType, ResidencyContainer *allocationsForResidency) {
     unsigned int engineFlag = 0xFF;
@@ -68,15 +75,25 @@ FlushStamp DrmCommandStreamReceiver<GfxFamily>::flush(BatchBuffer &batchBuffer,
         if (requiredSize > this->execObjectsStorage.size()) {
             this->execObjectsStorage.resize(requiredSize);
         }
+        this->execObjectsVersions.resize(this->execObjectsStorage.size(), 0);
 
         bb->swapResidencyVector(&this->residency);
         bb->setExecObjectsStorage(this->execObjectsStorage.data());
+        bb->setExecObjectsVersions(this->execObjectsVersions.data());
         this->residency.reserve(512);
+        advanceResidencyGeneration();
 
         bb->exec(static_cast<uint32_t>(alignUp(batchBuffer.usedSize - batchBuffer.startOffset, 8)),
                  alignedStart, engineFlag | I915_EXEC_NO_RELOC,
                  batchBuffer.requiresCoherency,
                  batchBuffer.low_priority);
+        bb->setExecObjectsVersions(nullptr);
+
+        residencyStats.flushes++;
+        residencyStats.lastFlushExecObjects = static_cast<uint32_t>(requiredSize);
+        residencyStats.lastFlushExecObjectsFilled = bb->peekExecObjectsFilled();
+        residencyStats.execObjects += residencyStats.lastFlushExecObjects;
+        residencyStats.execObjectsFilled += residencyStats.lastFlushExecObjectsFilled;
 
         if (this->gemCloseWorkerOperationMode == gemCloseWorkerMode::gemCloseWorkerConsumingCommandBuffers) {
             // Consume all space in CS to force new allocation
@@ -105,6 +122,11 @@ void DrmCommandStreamReceiver<GfxFamily>::makeResident(GraphicsAllocation &gfxAl
 template <typename GfxFamily>
 void DrmCommandStreamReceiver<GfxFamily>::makeResident(BufferObject *bo) {
     if (bo) {
+        if (bo->peekResidencyGeneration() == residencyGeneration) {
+            residencyStats.duplicatesSkipped++;
+            return;
+        }
+        bo->setResidencyGeneration(residencyGeneration);
         if (this->gemCloseWorkerOperationMode == gemCloseWorkerMode::gemCloseWorkerConsumingCommandBuffers) {
             bo->reference();
         }
@@ -112,6 +134,12 @@ void DrmCommandStreamReceiver<GfxFamily>::makeResident(BufferObject *bo) {
     }
 }
 
+template <typename GfxFamily>
+void DrmCommandStreamReceiver<GfxFamily>::advanceResidencyGeneration() {
+    // residency vector was handed over or dropped, every BO has to be added again
+    residencyGeneration = BufferObject::acquireResidencyGeneration();
+}
+
 template <typename GfxFamily>
 void DrmCommandStreamReceiver<GfxFamily>::processResidency(ResidencyContainer *inputAllocationsForResidency) {
     auto &allocationsForResidency = inputAllocationsForResidency ? *inputAllocationsForResidency : getMemoryManager()->getResidencyAllocations();
@@ -144,6 +172,7 @@ void DrmCommandStreamReceiver<GfxFamily>::makeNonResident(GraphicsAllocation &gf
                 }
             }
             this->residency.clear();
+            advanceResidencyGeneration();
         }
         if (gfxAllocation.fragmentsStorage.fragmentCount) {
             for (auto fragmentId = 0u; fragmentId < gfxAllocation.fragmentsStorage.fragmentCount; fragmentId++) {
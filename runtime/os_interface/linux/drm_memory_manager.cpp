@@ -23,6 +23,8 @@
 #include "runtime/device/device.h"
 #include "runtime/helpers/ptr_math.h"
 #include "runtime/helpers/options.h"
+#include "runtime/command_stream/command_stream_receiver.h"
+#include "runtime/os_interface/debug_settings_manager.h"
 #include "runtime/os_interface/32bit_memory.h"
 #include "runtime/os_interface/linux/drm_allocation.h"
 #include "runtime/os_interface/linux/drm_buffer_object.h"
@@ -39,6 +41,9 @@
 
 namespace OCLRT {
 
+const size_t DrmMemoryManager::defaultBufferObjectCacheSizeLimit;
+const size_t DrmMemoryManager::maxCachedBufferObjectSize;
+
 DrmMemoryManager::DrmMemoryManager(Drm *drm, gemCloseWorkerMode mode, bool forcePinAllowed, bool validateHostPtrMemory) : MemoryManager(false),
                                                                                                                           drm(drm),
                                                                                                                           pinBB(nullptr),
@@ -64,10 +69,19 @@ DrmMemoryManager::DrmMemoryManager(Drm *drm, gemCloseWorkerMode mode, bool force
         pinBB->isAllocated = true;
     }
     internal32bitAllocator.reset(new Allocator32bit);
+
+    if (DebugManager.flags.EnableBufferObjectCache.get() != -1) {
+        bufferObjectCacheEnabled = !!DebugManager.flags.EnableBufferObjectCache.get();
+    }
+    if (DebugManager.flags.OverrideBufferObjectCacheSizeLimitMB.get() != -1) {
+        bufferObjectCacheSizeLimit = static_cast<size_t>(DebugManager.flags.OverrideBufferObjectCacheSizeLimitMB.get()) * MemoryConstants::megaByte;
+    }
 }
 
 DrmMemoryManager::~DrmMemoryManager() {
     applyCommonCleanup();
+    bufferObjectCacheEnabled = false;
+    trimBufferObjectCache(0);
     if (gemCloseWorker) {
         gemCloseWorker->close(false);
     }
@@ -179,12 +193,24 @@ DrmAllocation *DrmMemoryManager::allocateGraphicsMemory(size_t size, size_t alig
     // It's needed to prevent overlapping pages with user pointers
     size_t cSize = std::max(alignUp(size, minAlignment), minAlignment);
 
+    BufferObject *bo = obtainCachedBufferObject(cSize, cAlignment);
+    if (bo) {
+        if (forcePinEnabled && pinBB != nullptr && forcePin && size >= this->pinThreshold) {
+            pinBB->pin(&bo, 1);
+        }
+        return new DrmAllocation(bo, bo->address, cSize);
+    }
+
     auto res = alignedMallocWrapper(cSize, cAlignment);
+    if (!res && cachedBufferObjectsSize > 0) {
+        trimBufferObjectCache(0);
+        res = alignedMallocWrapper(cSize, cAlignment);
+    }
 
     if (!res)
         return nullptr;
 
-    BufferObject *bo = allocUserptr(reinterpret_cast<uintptr_t>(res), cSize, 0, true);
+    bo = allocUserptr(reinterpret_cast<uintptr_t>(res), cSize, 0, true);
 
     if (!bo) {
         alignedFreeWrapper(res);
@@ -440,6 +466,10 @@ void DrmMemoryManager::freeGraphicsMemoryImpl(GraphicsAllocation *gfxAllocation)
 
     if (gfxAllocation->peekSharedHandle() != Sharing::nonSharedResource) {
         closeFunction(gfxAllocation->peekSharedHandle());
+    } else if (search && gfxAllocation->getUnderlyingBuffer() == search->address &&
+               storeInBufferObjectCache(search, gfxAllocation->taskCount)) {
+        delete gfxAllocation;
+        return;
     }
 
     delete gfxAllocation;
@@ -448,6 +478,97 @@ void DrmMemoryManager::freeGraphicsMemoryImpl(GraphicsAllocation *gfxAllocation)
     unreference(search);
 }
 
+BufferObject *DrmMemoryManager::obtainCachedBufferObject(size_t size, size_t alignment) {
+    if (!bufferObjectCacheEnabled || !csr || !csr->getTagAddress()) {
+        return nullptr;
+    }
+
+    std::lock_guard<decltype(bufferObjectCacheMtx)> lock(bufferObjectCacheMtx);
+    auto completedTaskCount = *csr->getTagAddress();
+
+    auto bucket = cachedBufferObjects.find(size);
+    if (bucket != cachedBufferObjects.end()) {
+        auto &entries = bucket->second;
+        // entries are ordered by the time they were returned, the oldest ones are the most likely to be idle
+        for (auto it = entries.begin(); it != entries.end(); ++it) {
+            if (it->taskCount != ObjectNotUsed && it->taskCount > completedTaskCount) {
+                continue;
+            }
+            if (reinterpret_cast<uintptr_t>(it->bo->address) % alignment != 0) {
+                continue;
+            }
+            auto bo = it->bo;
+            entries.erase(it);
+            if (entries.empty()) {
+                cachedBufferObjects.erase(bucket);
+            }
+            cachedBufferObjectsSize -= size;
+            bufferObjectCacheStats.hits++;
+            return bo;
+        }
+    }
+    bufferObjectCacheStats.misses++;
+    return nullptr;
+}
+
+bool DrmMemoryManager::storeInBufferObjectCache(BufferObject *bo, uint32_t taskCount) {
+    if (!bufferObjectCacheEnabled || !csr) {
+        return false;
+    }
+    if (!bo->isAllocated || bo->isReused || bo->peekUnmapSize() != 0 || bo->peekLockedAddress() != nullptr ||
+        bo->getRefCount() != 1 || !bo->getResidency()->empty()) {
+        return false;
+    }
+    auto size = bo->peekSize();
+    if (size > maxCachedBufferObjectSize || size > bufferObjectCacheSizeLimit) {
+        return false;
+    }
+
+    bool overLimit = false;
+    {
+        std::lock_guard<decltype(bufferObjectCacheMtx)> lock(bufferObjectCacheMtx);
+        cachedBufferObjects[size].push_back({bo, taskCount, cachedBufferObjectsSequence++});
+        cachedBufferObjectsSize += size;
+        overLimit = cachedBufferObjectsSize > bufferObjectCacheSizeLimit;
+    }
+    if (overLimit) {
+        trimBufferObjectCache(bufferObjectCacheSizeLimit);
+    }
+    return true;
+}
+
+void DrmMemoryManager::trimBufferObjectCache(size_t targetSize) {
+    std::vector<BufferObject *> evictedBufferObjects;
+    {
+        std::lock_guard<decltype(bufferObjectCacheMtx)> lock(bufferObjectCacheMtx);
+        while (cachedBufferObjectsSize > targetSize) {
+            // drop the least recently returned object across all sizes
+            auto oldest = cachedBufferObjects.begin();
+            for (auto it = cachedBufferObjects.begin(); it != cachedBufferObjects.end(); ++it) {
+                if (it->second.front().sequence < oldest->second.front().sequence) {
+                    oldest = it;
+                }
+            }
+            evictedBufferObjects.push_back(oldest->second.front().bo);
+            oldest->second.pop_front();
+            cachedBufferObjectsSize -= oldest->first;
+            if (oldest->second.empty()) {
+                cachedBufferObjects.erase(oldest);
+            }
+            bufferObjectCacheStats.evictions++;
+        }
+    }
+
+    for (auto bo : evictedBufferObjects) {
+        releaseCachedBufferObject(bo);
+    }
+}
+
+void DrmMemoryManager::releaseCachedBufferObject(BufferObject *bo) {
+    bo->wait(-1);
+    unreference(bo);
+}
+
 uint64_t DrmMemoryManager::getSystemSharedMemory() {
     uint64_t hostMemorySize = MemoryConstants::pageSize * (uint64_t)(sysconf(_SC_PHYS_PAGES));
 
@@ -25,6 +25,7 @@
 #include "runtime/memory_manager/memory_manager.h"
 #include "runtime/os_interface/linux/drm_allocation.h"
 #include "runtime/os_interface/linux/drm_neo.h"
+#include <list>
 #include <map>
 #include <sys/mman.h>
 
@@ -79,7 +80,31 @@ class DrmMemoryManager : public MemoryManager {
         return validateHostPtrMemory;
     }
 
+    struct BufferObjectCacheStats {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t evictions = 0;
+    };
+
+    // Releases idle cached buffer objects until the cache holds at most targetSize bytes
+    void trimBufferObjectCache(size_t targetSize);
+    size_t peekBufferObjectCacheSize() const { return cachedBufferObjectsSize; }
+    BufferObjectCacheStats peekBufferObjectCacheStats() const { return bufferObjectCacheStats; }
+    bool isBufferObjectCacheEnabled() const { return bufferObjectCacheEnabled; }
+
+    static const size_t defaultBufferObjectCacheSizeLimit = 64 * MemoryConstants::megaByte;
+    static const size_t maxCachedBufferObjectSize = 4 * MemoryConstants::megaByte;
+
   protected:
+    struct CachedBufferObject {
+        BufferObject *bo;
+        uint32_t taskCount;
+        uint64_t sequence;
+    };
+
+    BufferObject *obtainCachedBufferObject(size_t size, size_t alignment);
+    bool storeInBufferObjectCache(BufferObject *bo, uint32_t taskCount);
+    void releaseCachedBufferObject(BufferObject *bo);
     BufferObject *findAndReferenceSharedBufferObject(int boHandle);
     BufferObject *createSharedBufferObject(int boHandle, size_t size, bool requireSpecificBitness);
     void eraseSharedBufferObject(BufferObject *bo);
@@ -100,5 +125,14 @@ class DrmMemoryManager : public MemoryManager {
     std::vector<BufferObject *> sharingBufferObjects;
     std::recursive_mutex mtx;
     std::unique_ptr<Allocator32bit> internal32bitAllocator;
+
+    // idle userptr buffer objects keyed by size, reused once their last submission has completed
+    bool bufferObjectCacheEnabled = true;
+    size_t bufferObjectCacheSizeLimit = defaultBufferObjectCacheSizeLimit;
+    size_t cachedBufferObjectsSize = 0;
+    uint64_t cachedBufferObjectsSequence = 0;
+    std::map<size_t, std::list<CachedBufferObject>> cachedBufferObjects;
+    BufferObjectCacheStats bufferObjectCacheStats;
+    std::mutex bufferObjectCacheMtx;
 };
 } // namespace OCLRT
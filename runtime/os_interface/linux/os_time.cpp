@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017, Intel Corporation
+ * Copyright (c) 2017 - 2018, Intel Corporation
  *
  * Permission is hereby granted, free of charge, to any person obtaining a
  * copy of this software and associated documentation files (the "Software"),
@@ -25,6 +25,9 @@
 #include "drm/i915_drm.h"
 #include "runtime/os_interface/linux/os_interface.h"
 #include "runtime/os_interface/linux/os_time.h"
+#include "runtime/os_interface/debug_settings_manager.h"
+
+#include <algorithm>
 
 namespace OCLRT {
 
@@ -65,6 +68,16 @@ void OSTimeLinux::timestampTypeDetect() {
         getGpuTime = &OSTimeLinux::getGpuTime36;
         timestampSizeInBits = OCLRT_NUM_TIMESTAMP_BITS;
     }
+
+    uint64_t resyncIntervalInNs = TimestampModel::defaultResyncIntervalInNs;
+    if (DebugManager.flags.GpuTimestampModelResyncInterval.get() != -1) {
+        resyncIntervalInNs = static_cast<uint64_t>(std::max(DebugManager.flags.GpuTimestampModelResyncInterval.get(), 0)) * 1000;
+    }
+    uint64_t errorBoundInNs = TimestampModel::defaultErrorBoundInNs;
+    if (DebugManager.flags.GpuTimestampModelErrorBound.get() > 0) {
+        errorBoundInNs = static_cast<uint64_t>(DebugManager.flags.GpuTimestampModelErrorBound.get());
+    }
+    timestampModel.reset(resyncIntervalInNs > 0 ? new TimestampModel(resyncIntervalInNs, errorBoundInNs, timestampSizeInBits) : nullptr);
 }
 
 bool OSTimeLinux::getCpuTime(uint64_t *timestamp) {
@@ -125,12 +138,31 @@ bool OSTimeLinux::getGpuTimeSplitted(uint64_t *timestamp) {
 }
 
 bool OSTimeLinux::getCpuGpuTime(TimeStampData *pGpuCpuTime) {
+    if (timestampModel == nullptr) {
+        if (!(this->*getGpuTime)(&pGpuCpuTime->GPUTimeStamp)) {
+            return false;
+        }
+        return getCpuTime(&pGpuCpuTime->CPUTimeinNS);
+    }
+
+    uint64_t cpuTimeBefore = 0;
+    if (!getCpuTime(&cpuTimeBefore)) {
+        return false;
+    }
+    if (timestampModel->getGpuTimestamp(cpuTimeBefore, pGpuCpuTime->GPUTimeStamp)) {
+        pGpuCpuTime->CPUTimeinNS = cpuTimeBefore;
+        return true;
+    }
+
+    // resync: GPU counter read is paired with the midpoint of CPU time around it, off by at most half the round trip
     if (!(this->*getGpuTime)(&pGpuCpuTime->GPUTimeStamp)) {
         return false;
     }
     if (!getCpuTime(&pGpuCpuTime->CPUTimeinNS)) {
         return false;
     }
+    auto halfRoundTrip = (pGpuCpuTime->CPUTimeinNS - cpuTimeBefore) / 2;
+    timestampModel->addSample(cpuTimeBefore + halfRoundTrip, pGpuCpuTime->GPUTimeStamp, halfRoundTrip);
 
     return true;
 }
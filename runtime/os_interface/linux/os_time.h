@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017, Intel Corporation
+ * Copyright (c) 2017 - 2018, Intel Corporation
  *
  * Permission is hereby granted, free of charge, to any person obtaining a
  * copy of this software and associated documentation files (the "Software"),
@@ -22,6 +22,7 @@
 
 #pragma once
 #include "runtime/os_interface/os_time.h"
+#include "runtime/os_interface/timestamp_model.h"
 
 #define OCLRT_NUM_TIMESTAMP_BITS (36)
 #define OCLRT_NUM_TIMESTAMP_BITS_FALLBACK (32)
@@ -45,6 +46,7 @@ class OSTimeLinux : public OSTime {
     double getHostTimerResolution() const override;
     double getDynamicDeviceTimerResolution(HardwareInfo const &hwInfo) const override;
     uint64_t getCpuRawTimestamp() override;
+    TimestampModel *getTimestampModel() const { return timestampModel.get(); }
 
   protected:
     typedef int (*resolutionFunc_t)(clockid_t, struct timespec *);
@@ -53,6 +55,7 @@ class OSTimeLinux : public OSTime {
     unsigned timestampSizeInBits;
     resolutionFunc_t resolutionFunc;
     getTimeFunc_t getTimeFunc;
+    std::unique_ptr<TimestampModel> timestampModel;
 };
 
 } // namespace OCLRT
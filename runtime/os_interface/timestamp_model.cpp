@@ -0,0 +1,155 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/os_interface/timestamp_model.h"
+#include "runtime/os_interface/debug_settings_manager.h"
+
+#include <algorithm>
+
+namespace OCLRT {
+
+const uint64_t TimestampModel::minCalibrationWindowInNs;
+const uint64_t TimestampModel::defaultResyncIntervalInNs;
+const uint64_t TimestampModel::defaultErrorBoundInNs;
+
+TimestampModel::TimestampModel(uint64_t resyncIntervalInNs, uint64_t errorBoundInNs, uint32_t gpuTimestampBits)
+    : resyncIntervalInNs(resyncIntervalInNs),
+      errorBoundInNs(errorBoundInNs),
+      gpuTimestampMask(gpuTimestampBits >= 64 ? ~0ull : (1ull << gpuTimestampBits) - 1) {
+}
+
+bool TimestampModel::getGpuTimestamp(uint64_t cpuTimeInNs, uint64_t &gpuTimestamp) {
+    std::lock_guard<std::mutex> lock(mtx);
+    if (gpuTicksPerNs == 0.0 || cpuTimeInNs < anchorCpuTime || cpuTimeInNs - anchorCpuTime >= extrapolationLimitInNs) {
+        return false;
+    }
+    gpuTimestamp = predictGpuTimestamp(cpuTimeInNs);
+    return true;
+}
+
+void TimestampModel::addSample(uint64_t cpuTimeInNs, uint64_t gpuTimestamp, uint64_t uncertaintyInNs) {
+    std::lock_guard<std::mutex> lock(mtx);
+    if (!hasSamples) {
+        restartCalibration(cpuTimeInNs, gpuTimestamp, uncertaintyInNs);
+        return;
+    }
+    if (cpuTimeInNs <= anchorCpuTime) {
+        // sample taken concurrently with a newer one that was already accounted
+        return;
+    }
+
+    if (gpuTicksPerNs != 0.0) {
+        if ((cpuTimeInNs - anchorCpuTime) * gpuTicksPerNs >= static_cast<double>(gpuTimestampMask / 2)) {
+            // counter may have wrapped since the anchor, ticks between them are ambiguous
+            restartCalibration(cpuTimeInNs, gpuTimestamp, uncertaintyInNs);
+            return;
+        }
+        auto errorInTicks = gpuTicksBetween(predictGpuTimestamp(cpuTimeInNs), gpuTimestamp);
+        if (errorInTicks > gpuTimestampMask / 2) {
+            errorInTicks = gpuTimestampMask - errorInTicks + 1;
+        }
+        lastErrorInNs = static_cast<uint64_t>(errorInTicks / gpuTicksPerNs + 0.5);
+        maxErrorInNs = std::max(maxErrorInNs, lastErrorInNs);
+
+        // pairing jitter of both the model and this sample explains part of the error, only a larger one means the clocks moved
+        auto explainedErrorInNs = std::max(errorBoundInNs, predictionErrorBound(cpuTimeInNs)) + uncertaintyInNs;
+        if (lastErrorInNs > explainedErrorInNs) {
+            DBG_LOG(PrintDebugMessages, __FUNCTION__, "GPU timestamp model error (ns) ", lastErrorInNs, " exceeds bound ", explainedErrorInNs, ", recalibrating");
+            recalibrationCount++;
+            restartCalibration(cpuTimeInNs, gpuTimestamp, uncertaintyInNs);
+            return;
+        }
+    }
+
+    baselineGpuTicks += gpuTicksBetween(anchorGpuTimestamp, gpuTimestamp);
+    anchorCpuTime = cpuTimeInNs;
+    anchorGpuTimestamp = gpuTimestamp;
+    anchorUncertainty = uncertaintyInNs;
+
+    auto calibrationWindow = cpuTimeInNs - referenceCpuTime;
+    if (calibrationWindow < minCalibrationWindowInNs) {
+        return;
+    }
+    gpuTicksPerNs = static_cast<double>(baselineGpuTicks) / calibrationWindow;
+
+    // prediction error grows from the anchor uncertainty by the rate error (reference + anchor uncertainty) / window,
+    // extrapolate only as far as it stays within the bound
+    extrapolationLimitInNs = 0;
+    if (anchorUncertainty < errorBoundInNs) {
+        auto rateUncertainty = referenceUncertainty + anchorUncertainty;
+        auto limit = rateUncertainty == 0 ? static_cast<double>(resyncIntervalInNs)
+                                          : static_cast<double>(errorBoundInNs - anchorUncertainty) * calibrationWindow / rateUncertainty;
+        extrapolationLimitInNs = static_cast<uint64_t>(std::min(limit, static_cast<double>(resyncIntervalInNs)));
+    }
+}
+
+bool TimestampModel::isCalibrated() {
+    std::lock_guard<std::mutex> lock(mtx);
+    return gpuTicksPerNs != 0.0;
+}
+
+double TimestampModel::getGpuTicksPerNs() {
+    std::lock_guard<std::mutex> lock(mtx);
+    return gpuTicksPerNs;
+}
+
+uint64_t TimestampModel::getExtrapolationLimitInNs() {
+    std::lock_guard<std::mutex> lock(mtx);
+    return extrapolationLimitInNs;
+}
+
+uint64_t TimestampModel::getLastErrorInNs() {
+    std::lock_guard<std::mutex> lock(mtx);
+    return lastErrorInNs;
+}
+
+uint64_t TimestampModel::getMaxErrorInNs() {
+    std::lock_guard<std::mutex> lock(mtx);
+    return maxErrorInNs;
+}
+
+uint32_t TimestampModel::getRecalibrationCount() {
+    std::lock_guard<std::mutex> lock(mtx);
+    return recalibrationCount;
+}
+
+void TimestampModel::restartCalibration(uint64_t cpuTimeInNs, uint64_t gpuTimestamp, uint64_t uncertaintyInNs) {
+    hasSamples = true;
+    referenceCpuTime = anchorCpuTime = cpuTimeInNs;
+    referenceUncertainty = anchorUncertainty = uncertaintyInNs;
+    anchorGpuTimestamp = gpuTimestamp;
+    baselineGpuTicks = 0;
+    gpuTicksPerNs = 0.0;
+    extrapolationLimitInNs = 0;
+}
+
+uint64_t TimestampModel::predictGpuTimestamp(uint64_t cpuTimeInNs) const {
+    auto elapsedTicks = static_cast<uint64_t>((cpuTimeInNs - anchorCpuTime) * gpuTicksPerNs);
+    return (anchorGpuTimestamp + elapsedTicks) & gpuTimestampMask;
+}
+
+uint64_t TimestampModel::predictionErrorBound(uint64_t cpuTimeInNs) const {
+    auto calibrationWindow = anchorCpuTime - referenceCpuTime;
+    auto rateError = static_cast<double>(cpuTimeInNs - anchorCpuTime) * (referenceUncertainty + anchorUncertainty) / calibrationWindow;
+    return anchorUncertainty + static_cast<uint64_t>(rateError);
+}
+} // namespace OCLRT
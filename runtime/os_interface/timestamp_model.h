@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+#include <cstdint>
+#include <mutex>
+
+namespace OCLRT {
+
+// Linear model of GPU timestamp counter as a function of CPU time.
+// Real CPU/GPU pairs are fed with addSample together with the uncertainty of their
+// pairing. The rate is measured from the first sample of the calibration to the latest
+// one and the latest sample anchors the offset, so every resync lengthens the baseline.
+// GPU timestamps are extrapolated from CPU time only as far as the rate uncertainty
+// keeps the prediction within the error bound, capped at the resync interval.
+class TimestampModel {
+  public:
+    TimestampModel(uint64_t resyncIntervalInNs, uint64_t errorBoundInNs, uint32_t gpuTimestampBits);
+
+    bool getGpuTimestamp(uint64_t cpuTimeInNs, uint64_t &gpuTimestamp);
+    void addSample(uint64_t cpuTimeInNs, uint64_t gpuTimestamp, uint64_t uncertaintyInNs = 0);
+
+    bool isCalibrated();
+    double getGpuTicksPerNs();
+    uint64_t getExtrapolationLimitInNs();
+    uint64_t getLastErrorInNs();
+    uint64_t getMaxErrorInNs();
+    uint32_t getRecalibrationCount();
+
+    uint64_t getResyncIntervalInNs() const { return resyncIntervalInNs; }
+    uint64_t getErrorBoundInNs() const { return errorBoundInNs; }
+
+    static const uint64_t minCalibrationWindowInNs = 1000000;
+    static const uint64_t defaultResyncIntervalInNs = 50000000;
+    static const uint64_t defaultErrorBoundInNs = 10000;
+
+  protected:
+    void restartCalibration(uint64_t cpuTimeInNs, uint64_t gpuTimestamp, uint64_t uncertaintyInNs);
+    uint64_t predictGpuTimestamp(uint64_t cpuTimeInNs) const;
+    uint64_t predictionErrorBound(uint64_t cpuTimeInNs) const;
+    uint64_t gpuTicksBetween(uint64_t from, uint64_t to) const {
+        return (to - from) & gpuTimestampMask;
+    }
+
+    std::mutex mtx;
+    const uint64_t resyncIntervalInNs;
+    const uint64_t errorBoundInNs;
+    const uint64_t gpuTimestampMask;
+
+    bool hasSamples = false;
+    uint64_t referenceCpuTime = 0;
+    uint64_t referenceUncertainty = 0;
+    // GPU ticks from the reference to the anchor, accumulated per sample so the baseline may outlast a counter wrap
+    uint64_t baselineGpuTicks = 0;
+    uint64_t anchorCpuTime = 0;
+    uint64_t anchorGpuTimestamp = 0;
+    uint64_t anchorUncertainty = 0;
+    double gpuTicksPerNs = 0.0;
+    uint64_t extrapolationLimitInNs = 0;
+
+    uint64_t lastErrorInNs = 0;
+    uint64_t maxErrorInNs = 0;
+    uint32_t recalibrationCount = 0;
+};
+} // namespace OCLRT
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017, Intel Corporation
+ * Copyright (c) 2017 - 2018, Intel Corporation
  *
  * Permission is hereby granted, free of charge, to any person obtaining a
  * copy of this software and associated documentation files (the "Software"),
@@ -34,7 +34,7 @@ class Allocator32bit::OsInternals {
 Allocator32bit::Allocator32bit(uint64_t base, uint64_t size) {
     this->base = base;
     this->size = size;
-    heapAllocator = std::unique_ptr<HeapAllocator>(new HeapAllocator((void *)base, size));
+    heapAllocator = std::unique_ptr<SegregatedHeapAllocator>(new SegregatedHeapAllocator((void *)base, size));
 }
 
 OCLRT::Allocator32bit::Allocator32bit() {
@@ -43,7 +43,7 @@ OCLRT::Allocator32bit::Allocator32bit() {
     osInternals = std::unique_ptr<OsInternals>(new OsInternals);
     osInternals.get()->allocatedRange = (void *)((uintptr_t)this->base);
 
-    heapAllocator = std::unique_ptr<HeapAllocator>(new HeapAllocator((void *)this->base, sizeToMap));
+    heapAllocator = std::unique_ptr<SegregatedHeapAllocator>(new SegregatedHeapAllocator((void *)this->base, sizeToMap));
 }
 
 OCLRT::Allocator32bit::~Allocator32bit() {
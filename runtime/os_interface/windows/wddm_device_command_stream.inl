@@ -79,6 +79,7 @@ WddmCommandStreamReceiver<GfxFamily>::WddmCommandStreamReceiver(const HardwareIn
 
 template <typename GfxFamily>
 WddmCommandStreamReceiver<GfxFamily>::~WddmCommandStreamReceiver() {
+    this->closeAdaptiveDispatcher();
     this->cleanupResources();
 
     if (commandBufferHeader)
@@ -30,10 +30,12 @@
 #include "runtime/helpers/get_info.h"
 #include "runtime/helpers/options.h"
 #include "runtime/helpers/string.h"
+#include "runtime/os_interface/debug_settings_manager.h"
 #include "runtime/os_interface/device_factory.h"
 #include "runtime/event/async_events_handler.h"
 #include "runtime/sharings/sharing_factory.h"
 #include "runtime/platform/extensions.h"
+#include "runtime/utilities/worker_pool.h"
 #include "CL/cl_ext.h"
 
 namespace OCLRT {
@@ -175,6 +177,9 @@ bool Platform::isInitialized() {
 
 void Platform::shutdown() {
     asyncEventsHandler->closeThread();
+    if (workerPool) {
+        workerPool->shutdown();
+    }
     TakeOwnershipWrapper<Platform> platformOwnership(*this);
 
     if (state == StateNone) {
@@ -243,4 +248,12 @@ std::unique_ptr<AsyncEventsHandler> Platform::setAsyncEventsHandler(std::unique_
     return handler;
 }
 
+WorkerPool *Platform::getWorkerPool() {
+    // created on first use, debug flags are not read yet when platformImpl is constructed
+    std::call_once(workerPoolCreated, [this] {
+        workerPool.reset(new WorkerPool(DebugManager.flags.PlatformWorkerThreads.get()));
+    });
+    return workerPool.get();
+}
+
 } // namespace OCLRT
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017, Intel Corporation
+ * Copyright (c) 2017 - 2018, Intel Corporation
  *
  * Permission is hereby granted, free of charge, to any person obtaining a
  * copy of this software and associated documentation files (the "Software"),
@@ -27,6 +27,7 @@
 #include "runtime/device/device_vector.h"
 #include "runtime/helpers/base_object.h"
 #include <condition_variable>
+#include <mutex>
 #include <vector>
 
 namespace OCLRT {
@@ -34,6 +35,7 @@ namespace OCLRT {
 class CompilerInterface;
 class Device;
 class AsyncEventsHandler;
+class WorkerPool;
 struct HardwareInfo;
 
 template <>
@@ -67,6 +69,7 @@ class Platform : public BaseObject<_cl_platform_id> {
     const PlatformInfo &getPlatformInfo() const;
     AsyncEventsHandler *getAsyncEventsHandler();
     std::unique_ptr<AsyncEventsHandler> setAsyncEventsHandler(std::unique_ptr<AsyncEventsHandler> handler);
+    WorkerPool *getWorkerPool();
 
   protected:
     enum {
@@ -81,6 +84,8 @@ class Platform : public BaseObject<_cl_platform_id> {
     DeviceVector devices;
     std::string compilerExtensions;
     std::unique_ptr<AsyncEventsHandler> asyncEventsHandler;
+    std::unique_ptr<WorkerPool> workerPool;
+    std::once_flag workerPoolCreated;
 };
 
 Platform *platform();
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017, Intel Corporation
+ * Copyright (c) 2017 - 2018, Intel Corporation
  *
  * Permission is hereby granted, free of charge, to any person obtaining a
  * copy of this software and associated documentation files (the "Software"),
@@ -30,6 +30,7 @@
 #include "runtime/kernel/kernel.h"
 #include "runtime/sampler/sampler.h"
 #include "runtime/helpers/string.h"
+#include <atomic>
 #include <cstdint>
 #include <cstring>
 #include <map>
@@ -212,6 +213,11 @@ KernelInfo *KernelInfo::create() {
     return new KernelInfo();
 }
 
+uint64_t KernelInfo::generateIsaId() {
+    static std::atomic<uint64_t> nextIsaId(1);
+    return nextIsaId++;
+}
+
 KernelInfo::~KernelInfo() {
     kernelArgInfo.clear();
 
@@ -397,6 +403,7 @@ void KernelInfo::storePatchToken(const SPatchString *pStringArg) {
         if (printfStringInfo.pStringData != nullptr) {
             memcpy_s(printfStringInfo.pStringData, printfStringInfo.SizeInBytes, (cl_char *)pStringArg + sizeof(SPatchString), printfStringInfo.SizeInBytes);
             patchInfo.stringDataMap.insert(std::pair<uint32_t, PrintfStringInfo>(stringIndex, printfStringInfo));
+            printfFormats.insert(std::make_pair(stringIndex, PrintfFormat::compile(printfStringInfo.pStringData)));
         }
     }
 }
@@ -423,6 +430,11 @@ const char *KernelInfo::queryPrintfString(uint32_t index) const {
     return printfInfo == patchInfo.stringDataMap.end() ? nullptr : printfInfo->second.pStringData;
 }
 
+const PrintfFormat *KernelInfo::queryPrintfFormat(uint32_t index) const {
+    auto printfFormat = printfFormats.find(index);
+    return printfFormat == printfFormats.end() ? nullptr : &printfFormat->second;
+}
+
 cl_int KernelInfo::resolveKernelInfo() {
     cl_int retVal = CL_SUCCESS;
     std::unordered_map<std::string, uint32_t>::iterator iterUint;
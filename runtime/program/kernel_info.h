@@ -26,6 +26,7 @@
 #include "heap_info.h"
 #include "kernel_arg_info.h"
 #include "patch_info.h"
+#include "runtime/program/printf_format.h"
 #include "runtime/helpers/hw_info.h"
 #include <algorithm>
 #include <cstdint>
@@ -130,6 +131,7 @@ struct KernelInfo {
         reqdWorkGroupSize[0] = WorkloadInfo::undefinedOffset;
         reqdWorkGroupSize[1] = WorkloadInfo::undefinedOffset;
         reqdWorkGroupSize[2] = WorkloadInfo::undefinedOffset;
+        isaId = generateIsaId();
     }
 
     KernelInfo(const KernelInfo &) = delete;
@@ -155,6 +157,7 @@ struct KernelInfo {
     void storePatchToken(const SPatchKernelAttributesInfo *pKernelAttributesInfo);
     void storePatchToken(const SPatchAllocateSystemThreadSurface *pSystemThreadSurface);
     GraphicsAllocation *getGraphicsAllocation() const { return this->kernelAllocation; }
+    static uint64_t generateIsaId();
     cl_int resolveKernelInfo();
     void resizeKernelArgInfoAndRegisterParameter(uint32_t argCount) {
         if (kernelArgInfo.size() <= argCount) {
@@ -169,6 +172,7 @@ struct KernelInfo {
     void storeKernelArgPatchInfo(uint32_t argNum, uint32_t dataSize, uint32_t crossthreadOffset, uint32_t sourceOffset, uint32_t offsetSSH);
 
     const char *queryPrintfString(uint32_t index) const;
+    const PrintfFormat *queryPrintfFormat(uint32_t index) const;
 
     size_t getSamplerStateArrayCount() const;
     size_t getSamplerStateArraySize(const HardwareInfo &hwInfo) const;
@@ -223,6 +227,7 @@ struct KernelInfo {
     std::string attributes;
     HeapInfo heapInfo;
     PatchInfo patchInfo;
+    std::map<uint32_t, PrintfFormat> printfFormats;
     std::vector<KernelArgInfo> kernelArgInfo;
     std::vector<KernelArgInfo> kernelNonArgInfo;
     WorkloadInfo workloadInfo;
@@ -239,6 +244,8 @@ struct KernelInfo {
     uint32_t argumentsToPatchNum = 0;
     uint32_t systemKernelOffset = 0;
     uint64_t kernelId = 0;
+    // process-unique identity of the ISA, used to find it in instruction heaps it was copied to
+    uint64_t isaId = 0;
     bool isKernelHeapSubstituted = false;
     GraphicsAllocation *kernelAllocation = nullptr;
 };
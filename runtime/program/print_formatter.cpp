@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017, Intel Corporation
+ * Copyright (c) 2017 - 2018, Intel Corporation
  *
  * Permission is hereby granted, free of charge, to any person obtaining a
  * copy of this software and associated documentation files (the "Software"),
@@ -24,7 +24,6 @@
 
 #include "runtime/helpers/string.h"
 #include "runtime/memory_manager/graphics_allocation.h"
-#include <iostream>
 
 namespace OCLRT {
 
@@ -45,145 +44,92 @@ void PrintFormatter::printKernelOutput(const std::function<void(char *)> &print)
     read(&bufferSize);
 
     uint32_t stringIndex = 0;
+    char output[maxPrintfOutputLength];
+    std::string batch;
 
     while (offset + 4 <= bufferSize) {
         read(&stringIndex);
-        const char *formatString = kernel.getKernelInfo().queryPrintfString(stringIndex);
-        if (formatString != nullptr) {
-            printString(formatString, print);
-        }
-    }
-}
-
-void PrintFormatter::printString(const char *formatString, const std::function<void(char *)> &print) {
-    size_t length = strnlen_s(formatString, maxPrintfOutputLength);
-    char output[maxPrintfOutputLength];
-
-    size_t cursor = 0;
-    for (size_t i = 0; i <= length; i++) {
-        if (formatString[i] == '\\')
-            output[cursor++] = escapeChar(formatString[++i]);
-        else if (formatString[i] == '%') {
-            size_t end = i;
-            if (end + 1 <= length && formatString[end + 1] == '%') {
-                output[cursor++] = '%';
+        const PrintfFormat *format = kernel.getKernelInfo().queryPrintfFormat(stringIndex);
+        PrintfFormat compiledFormat;
+        if (format == nullptr) {
+            const char *formatString = kernel.getKernelInfo().queryPrintfString(stringIndex);
+            if (formatString == nullptr) {
                 continue;
             }
+            compiledFormat = PrintfFormat::compile(formatString);
+            format = &compiledFormat;
+        }
 
-            while (isConversionSpecifier(formatString[end++]) == false && end < length)
-                ;
-            char dataFormat[maxPrintfOutputLength];
-
-            memcpy_s(dataFormat, maxPrintfOutputLength, formatString + i, end - i);
-            dataFormat[end - i] = '\0';
-
-            if (formatString[end - 1] == 's')
-                cursor += printStringToken(output + cursor, maxPrintfOutputLength - cursor, dataFormat);
-            else
-                cursor += printToken(output + cursor, maxPrintfOutputLength - cursor, dataFormat);
-
-            i = end - 1;
-        } else {
-            output[cursor++] = formatString[i];
+        batch.append(output, printRecord(output, *format));
+        if (batch.length() >= outputBatchSize) {
+            print(&batch[0]);
+            batch.clear();
         }
     }
 
-    print(output);
+    if (!batch.empty()) {
+        print(&batch[0]);
+    }
 }
 
-void PrintFormatter::stripVectorFormat(const char *format, char *stripped) {
-    while (*format != '\0') {
-        if (*format != 'v') {
-            *stripped = *format;
-        } else if (*(format + 1) != '1') {
-            format += 2;
-            continue;
-
-        } else {
-            format += 3;
-            continue;
+size_t PrintFormatter::printRecord(char *output, const PrintfFormat &format) {
+    size_t cursor = 0;
+    for (auto &token : format.getTokens()) {
+        size_t size = maxPrintfOutputLength - cursor;
+        size_t charactersPrinted = 0;
+        switch (token.type) {
+        case PrintfFormatToken::Type::Text:
+            charactersPrinted = std::min(token.format.length(), size - 1);
+            memcpy_s(output + cursor, size, token.format.c_str(), charactersPrinted);
+            break;
+        case PrintfFormatToken::Type::String:
+            charactersPrinted = printStringToken(output + cursor, size, token.format.c_str());
+            break;
+        default:
+            charactersPrinted = printToken(output + cursor, size, token);
+            break;
         }
-        stripped++;
-        format++;
+        cursor = std::min(cursor + charactersPrinted, maxPrintfOutputLength - 1);
     }
-    *stripped = '\0';
-}
+    output[cursor] = '\0';
 
-void PrintFormatter::stripVectorTypeConversion(char *format) {
-    size_t len = strlen(format);
-    if (len > 3 && format[len - 3] == 'h' && format[len - 2] == 'l') {
-        format[len - 3] = format[len - 1];
-        format[len - 2] = '\0';
-    }
+    // record is printed up to its first null character
+    return strnlen_s(output, cursor);
 }
 
-size_t PrintFormatter::printToken(char *output, size_t size, const char *formatString) {
+size_t PrintFormatter::printToken(char *output, size_t size, const PrintfFormatToken &token) {
     PRINTF_DATA_TYPE type(PRINTF_DATA_TYPE::INVALID);
     read(&type);
 
     switch (type) {
     case PRINTF_DATA_TYPE::BYTE:
-        return typedPrintToken<int8_t>(output, size, formatString);
+        return typedPrintToken<int8_t>(output, size, token.format.c_str());
     case PRINTF_DATA_TYPE::SHORT:
-        return typedPrintToken<int16_t>(output, size, formatString);
+        return typedPrintToken<int16_t>(output, size, token.format.c_str());
     case PRINTF_DATA_TYPE::INT:
-        return typedPrintToken<int>(output, size, formatString);
+        return typedPrintToken<int>(output, size, token.format.c_str());
     case PRINTF_DATA_TYPE::FLOAT:
-        return typedPrintToken<float>(output, size, formatString);
+        return typedPrintToken<float>(output, size, token.format.c_str());
     case PRINTF_DATA_TYPE::LONG:
-        return typedPrintToken<int64_t>(output, size, formatString);
+        return typedPrintToken<int64_t>(output, size, token.format.c_str());
     case PRINTF_DATA_TYPE::POINTER:
-        return typedPrintToken<void *>(output, size, formatString);
+        return typedPrintToken<void *>(output, size, token.format.c_str());
     case PRINTF_DATA_TYPE::DOUBLE:
-        return typedPrintToken<double>(output, size, formatString);
+        return typedPrintToken<double>(output, size, token.format.c_str());
     case PRINTF_DATA_TYPE::VECTOR_BYTE:
-        return typedPrintVectorToken<int8_t>(output, size, formatString);
+        return typedPrintVectorToken<int8_t>(output, size, token.vectorFormat.c_str());
     case PRINTF_DATA_TYPE::VECTOR_SHORT:
-        return typedPrintVectorToken<int16_t>(output, size, formatString);
+        return typedPrintVectorToken<int16_t>(output, size, token.vectorFormat.c_str());
     case PRINTF_DATA_TYPE::VECTOR_INT:
-        return typedPrintVectorToken<int>(output, size, formatString);
+        return typedPrintVectorToken<int>(output, size, token.vectorFormat.c_str());
     case PRINTF_DATA_TYPE::VECTOR_LONG:
-        return typedPrintVectorToken<int64_t>(output, size, formatString);
+        return typedPrintVectorToken<int64_t>(output, size, token.vectorFormat.c_str());
     case PRINTF_DATA_TYPE::VECTOR_FLOAT:
-        return typedPrintVectorToken<float>(output, size, formatString);
+        return typedPrintVectorToken<float>(output, size, token.vectorFormat.c_str());
     case PRINTF_DATA_TYPE::VECTOR_DOUBLE:
-        return typedPrintVectorToken<double>(output, size, formatString);
+        return typedPrintVectorToken<double>(output, size, token.vectorFormat.c_str());
     default:
         return 0;
     }
 }
-
-char PrintFormatter::escapeChar(char escape) {
-    switch (escape) {
-    case 'n':
-        return '\n';
-    default:
-        return escape;
-    }
-}
-
-bool PrintFormatter::isConversionSpecifier(char c) {
-    switch (c) {
-    case 'd':
-    case 'i':
-    case 'o':
-    case 'u':
-    case 'x':
-    case 'X':
-    case 'a':
-    case 'A':
-    case 'e':
-    case 'E':
-    case 'f':
-    case 'F':
-    case 'g':
-    case 'G':
-    case 's':
-    case 'c':
-    case 'p':
-        return true;
-    default:
-        return false;
-    }
-}
 } // namespace OCLRT
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017, Intel Corporation
+ * Copyright (c) 2017 - 2018, Intel Corporation
  *
  * Permission is hereby granted, free of charge, to any person obtaining a
  * copy of this software and associated documentation files (the "Software"),
@@ -25,11 +25,13 @@
 #include "runtime/helpers/aligned_memory.h"
 #include "runtime/kernel/kernel.h"
 #include "runtime/os_interface/print.h"
+#include "runtime/program/printf_format.h"
 
 #include <algorithm>
 #include <cctype>
 #include <cstdint>
 #include <functional>
+#include <string>
 
 extern int memcpy_s(void *dst, size_t destSize, const void *src, size_t count);
 
@@ -59,15 +61,12 @@ class PrintFormatter {
     void printKernelOutput(const std::function<void(char *)> &print = [](char *str) { printToSTDOUT(str); });
 
     static const size_t maxPrintfOutputLength = 1024;
+    // formatted records are accumulated and handed to print in chunks of at least this size
+    static const size_t outputBatchSize = 64 * 1024;
 
   protected:
-    void printString(const char *formatString, const std::function<void(char *)> &print);
-    size_t printToken(char *output, size_t size, const char *formatString);
-
-    char escapeChar(char escape);
-    bool isConversionSpecifier(char c);
-    void stripVectorFormat(const char *format, char *stripped);
-    void stripVectorTypeConversion(char *format);
+    size_t printRecord(char *output, const PrintfFormat &format);
+    size_t printToken(char *output, size_t size, const PrintfFormatToken &token);
 
     template <class T>
     bool read(T *value) {
@@ -94,22 +93,21 @@ class PrintFormatter {
     }
 
     template <class T>
-    size_t typedPrintVectorToken(char *output, size_t size, const char *formatString) {
+    size_t typedPrintVectorToken(char *output, size_t size, const char *channelFormat) {
         T value = {0};
         int valueCount = 0;
         read(&valueCount);
 
         size_t charactersPrinted = 0;
-        char strippedFormat[1024];
-
-        stripVectorFormat(formatString, strippedFormat);
-        stripVectorTypeConversion(strippedFormat);
 
         for (int i = 0; i < valueCount; i++) {
             read(&value);
-            charactersPrinted += simple_sprintf(output + charactersPrinted, size - charactersPrinted, strippedFormat, value);
-            if (i < valueCount - 1)
+            charactersPrinted += simple_sprintf(output + charactersPrinted, size - charactersPrinted, channelFormat, value);
+            charactersPrinted = std::min(charactersPrinted, size - 1);
+            if (i < valueCount - 1) {
                 charactersPrinted += simple_sprintf(output + charactersPrinted, size - charactersPrinted, "%c", ',');
+                charactersPrinted = std::min(charactersPrinted, size - 1);
+            }
         }
 
         if (sizeof(T) < 4) {
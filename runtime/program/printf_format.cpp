@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/program/printf_format.h"
+#include "runtime/helpers/string.h"
+
+namespace OCLRT {
+
+const size_t PrintfFormat::maxFormatLength;
+
+PrintfFormat PrintfFormat::compile(const char *formatString) {
+    PrintfFormat format;
+    size_t length = strnlen_s(formatString, maxFormatLength);
+    std::string text;
+
+    for (size_t i = 0; i < length; i++) {
+        if (formatString[i] == '\\') {
+            char escaped = escapeChar(formatString[++i]);
+            if (escaped == '\0') {
+                break;
+            }
+            text += escaped;
+        } else if (formatString[i] == '%') {
+            size_t end = i;
+            // "%%" emits '%' and the second '%' is parsed again as the start of a conversion
+            if (formatString[end + 1] == '%') {
+                text += '%';
+                continue;
+            }
+
+            while (isConversionSpecifier(formatString[end++]) == false && end < length)
+                ;
+
+            format.addText(text);
+            format.addConversion(formatString + i, end - i);
+            i = end - 1;
+        } else {
+            text += formatString[i];
+        }
+    }
+    format.addText(text);
+
+    return format;
+}
+
+void PrintfFormat::addText(std::string &text) {
+    if (text.empty()) {
+        return;
+    }
+    if (!tokens.empty() && tokens.back().type == PrintfFormatToken::Type::Text) {
+        tokens.back().format += text;
+    } else {
+        tokens.push_back({PrintfFormatToken::Type::Text, text, std::string()});
+    }
+    text.clear();
+}
+
+void PrintfFormat::addConversion(const char *specifier, size_t length) {
+    PrintfFormatToken token;
+    token.format.assign(specifier, length);
+    if (token.format.back() == 's') {
+        token.type = PrintfFormatToken::Type::String;
+    } else {
+        token.type = PrintfFormatToken::Type::Conversion;
+        token.vectorFormat = stripVectorFormat(token.format);
+        stripVectorTypeConversion(token.vectorFormat);
+    }
+    tokens.push_back(std::move(token));
+}
+
+std::string PrintfFormat::stripVectorFormat(const std::string &format) {
+    std::string stripped;
+    size_t i = 0;
+    while (i < format.length()) {
+        if (format[i] != 'v') {
+            stripped += format[i++];
+        } else if (i + 1 < format.length() && format[i + 1] == '1') {
+            i += 3;
+        } else {
+            i += 2;
+        }
+    }
+    return stripped;
+}
+
+void PrintfFormat::stripVectorTypeConversion(std::string &format) {
+    size_t len = format.length();
+    if (len > 3 && format[len - 3] == 'h' && format[len - 2] == 'l') {
+        format[len - 3] = format[len - 1];
+        format.resize(len - 2);
+    }
+}
+
+char PrintfFormat::escapeChar(char escape) {
+    switch (escape) {
+    case 'n':
+        return '\n';
+    default:
+        return escape;
+    }
+}
+
+bool PrintfFormat::isConversionSpecifier(char c) {
+    switch (c) {
+    case 'd':
+    case 'i':
+    case 'o':
+    case 'u':
+    case 'x':
+    case 'X':
+    case 'a':
+    case 'A':
+    case 'e':
+    case 'E':
+    case 'f':
+    case 'F':
+    case 'g':
+    case 'G':
+    case 's':
+    case 'c':
+    case 'p':
+        return true;
+    default:
+        return false;
+    }
+}
+} // namespace OCLRT
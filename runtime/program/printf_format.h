@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace OCLRT {
+
+struct PrintfFormatToken {
+    enum class Type : uint8_t {
+        Text,       // literal text with escapes already resolved
+        Conversion, // single conversion, its data type is read from the printf buffer
+        String      // %s conversion, the argument is an index into kernel strings
+    };
+
+    Type type;
+    std::string format;       // literal text or conversion specification, e.g. "%5.2f"
+    std::string vectorFormat; // per channel specification used when conversion carries a vector
+};
+
+// Format string compiled once per kernel string into a sequence of tokens,
+// so that draining printf buffer does not re-parse it for every record.
+class PrintfFormat {
+  public:
+    static PrintfFormat compile(const char *formatString);
+
+    const std::vector<PrintfFormatToken> &getTokens() const { return tokens; }
+
+    static const size_t maxFormatLength = 1024;
+
+  protected:
+    void addText(std::string &text);
+    void addConversion(const char *specifier, size_t length);
+
+    static char escapeChar(char escape);
+    static bool isConversionSpecifier(char c);
+    static std::string stripVectorFormat(const std::string &format);
+    static void stripVectorTypeConversion(std::string &format);
+
+    std::vector<PrintfFormatToken> tokens;
+};
+} // namespace OCLRT
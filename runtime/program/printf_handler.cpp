@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017, Intel Corporation
+ * Copyright (c) 2017 - 2018, Intel Corporation
  *
  * Permission is hereby granted, free of charge, to any person obtaining a
  * copy of this software and associated documentation files (the "Software"),
@@ -35,7 +35,9 @@ namespace OCLRT {
 PrintfHandler::PrintfHandler(Device &deviceArg) : device(deviceArg) {}
 
 PrintfHandler::~PrintfHandler() {
-    device.getMemoryManager()->freeGraphicsMemory(printfSurface);
+    if (printfSurface) {
+        device.getMemoryManager()->storePrintfSurface(std::unique_ptr<GraphicsAllocation>(printfSurface), outputPrinted);
+    }
 }
 
 PrintfHandler *PrintfHandler::create(const MultiDispatchInfo &multiDispatchInfo, Device &device) {
@@ -53,7 +55,7 @@ void PrintfHandler::prepareDispatch(const MultiDispatchInfo &multiDispatchInfo)
     }
     kernel = multiDispatchInfo.begin()->getKernel();
 
-    printfSurface = device.getMemoryManager()->createGraphicsAllocationWithRequiredBitness(printfSurfaceSize, nullptr);
+    printfSurface = device.getMemoryManager()->obtainPrintfSurface(printfSurfaceSize);
 
     *reinterpret_cast<uint32_t *>(printfSurface->getUnderlyingBuffer()) = printfSurfaceInitialDataSize;
 
@@ -77,5 +79,6 @@ void PrintfHandler::makeResident(CommandStreamReceiver &commandStreamReceiver) {
 void PrintfHandler::printEnqueueOutput() {
     PrintFormatter printFormatter(*kernel, *printfSurface);
     printFormatter.printKernelOutput();
+    outputPrinted = true;
 }
 } // namespace OCLRT
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017, Intel Corporation
+ * Copyright (c) 2017 - 2018, Intel Corporation
  *
  * Permission is hereby granted, free of charge, to any person obtaining a
  * copy of this software and associated documentation files (the "Software"),
@@ -50,5 +50,6 @@ class PrintfHandler {
     Device &device;
     Kernel *kernel = nullptr;
     GraphicsAllocation *printfSurface = nullptr;
+    bool outputPrinted = false;
 };
 } // namespace OCLRT
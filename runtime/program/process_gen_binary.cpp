@@ -32,6 +32,8 @@
 #include "runtime/kernel/kernel.h"
 
 #include <algorithm>
+#include <atomic>
+#include <thread>
 
 using namespace iOpenCL;
 
@@ -84,73 +86,205 @@ size_t Program::processKernel(
             break;
         }
 
-        auto pCurKernelPtr = pKernelBlob;
-        pKernelInfo->heapInfo.pBlob = pKernelBlob;
+        sizeProcessed = parseKernel(pKernelBlob, *pKernelInfo, retVal);
+        if (retVal == CL_SUCCESS && !DebugManager.flags.DeferKernelIsaUpload.get()) {
+            retVal = allocateKernelIsa(*pKernelInfo);
+        }
+        if (retVal != CL_SUCCESS) {
+            delete pKernelInfo;
+            break;
+        }
 
-        pKernelInfo->heapInfo.pKernelHeader = reinterpret_cast<const SKernelBinaryHeaderCommon *>(pCurKernelPtr);
-        pCurKernelPtr = ptrOffset(pCurKernelPtr, sizeof(SKernelBinaryHeaderCommon));
+        storeKernelInfo(pKernelInfo);
+    } while (false);
 
-        std::string readName{reinterpret_cast<const char *>(pCurKernelPtr), pKernelInfo->heapInfo.pKernelHeader->KernelNameSize};
-        pKernelInfo->name = readName.c_str();
-        pCurKernelPtr = ptrOffset(pCurKernelPtr, pKernelInfo->heapInfo.pKernelHeader->KernelNameSize);
+    return sizeProcessed;
+}
 
-        pKernelInfo->heapInfo.pKernelHeap = pCurKernelPtr;
-        pCurKernelPtr = ptrOffset(pCurKernelPtr, pKernelInfo->heapInfo.pKernelHeader->KernelHeapSize);
+size_t Program::parseKernel(
+    const void *pKernelBlob,
+    KernelInfo &kernelInfo,
+    cl_int &retVal) {
+    auto pCurKernelPtr = pKernelBlob;
+    kernelInfo.heapInfo.pBlob = pKernelBlob;
 
-        pKernelInfo->heapInfo.pGsh = pCurKernelPtr;
-        pCurKernelPtr = ptrOffset(pCurKernelPtr, pKernelInfo->heapInfo.pKernelHeader->GeneralStateHeapSize);
+    kernelInfo.heapInfo.pKernelHeader = reinterpret_cast<const SKernelBinaryHeaderCommon *>(pCurKernelPtr);
+    pCurKernelPtr = ptrOffset(pCurKernelPtr, sizeof(SKernelBinaryHeaderCommon));
 
-        pKernelInfo->heapInfo.pDsh = pCurKernelPtr;
-        pCurKernelPtr = ptrOffset(pCurKernelPtr, pKernelInfo->heapInfo.pKernelHeader->DynamicStateHeapSize);
+    std::string readName{reinterpret_cast<const char *>(pCurKernelPtr), kernelInfo.heapInfo.pKernelHeader->KernelNameSize};
+    kernelInfo.name = readName.c_str();
+    pCurKernelPtr = ptrOffset(pCurKernelPtr, kernelInfo.heapInfo.pKernelHeader->KernelNameSize);
 
-        pKernelInfo->heapInfo.pSsh = const_cast<void *>(pCurKernelPtr);
-        pCurKernelPtr = ptrOffset(pCurKernelPtr, pKernelInfo->heapInfo.pKernelHeader->SurfaceStateHeapSize);
+    kernelInfo.heapInfo.pKernelHeap = pCurKernelPtr;
+    pCurKernelPtr = ptrOffset(pCurKernelPtr, kernelInfo.heapInfo.pKernelHeader->KernelHeapSize);
 
-        pKernelInfo->heapInfo.pPatchList = pCurKernelPtr;
+    kernelInfo.heapInfo.pGsh = pCurKernelPtr;
+    pCurKernelPtr = ptrOffset(pCurKernelPtr, kernelInfo.heapInfo.pKernelHeader->GeneralStateHeapSize);
 
-        retVal = parsePatchList(*pKernelInfo);
-        if (retVal != CL_SUCCESS) {
-            delete pKernelInfo;
+    kernelInfo.heapInfo.pDsh = pCurKernelPtr;
+    pCurKernelPtr = ptrOffset(pCurKernelPtr, kernelInfo.heapInfo.pKernelHeader->DynamicStateHeapSize);
 
-            sizeProcessed = ptrDiff(pCurKernelPtr, pKernelBlob);
-            break;
+    kernelInfo.heapInfo.pSsh = const_cast<void *>(pCurKernelPtr);
+    pCurKernelPtr = ptrOffset(pCurKernelPtr, kernelInfo.heapInfo.pKernelHeader->SurfaceStateHeapSize);
+
+    kernelInfo.heapInfo.pPatchList = pCurKernelPtr;
+
+    retVal = parsePatchList(kernelInfo);
+    if (retVal != CL_SUCCESS) {
+        return ptrDiff(pCurKernelPtr, pKernelBlob);
+    }
+
+    auto pKernelHeader = kernelInfo.heapInfo.pKernelHeader;
+    auto pKernel = ptrOffset(pKernelBlob, sizeof(SKernelBinaryHeaderCommon));
+
+    if (genBinary)
+        kernelInfo.gpuPointerSize = reinterpret_cast<const SProgramBinaryHeader *>(genBinary)->GPUPointerSizeInBytes;
+
+    uint32_t kernelSize =
+        pKernelHeader->DynamicStateHeapSize +
+        pKernelHeader->GeneralStateHeapSize +
+        pKernelHeader->KernelHeapSize +
+        pKernelHeader->KernelNameSize +
+        pKernelHeader->PatchListSize +
+        pKernelHeader->SurfaceStateHeapSize;
+
+    kernelInfo.heapInfo.blobSize = kernelSize + sizeof(SKernelBinaryHeaderCommon);
+
+    uint32_t kernelCheckSum = kernelInfo.heapInfo.pKernelHeader->CheckSum;
+
+    uint64_t hashValue = Hash::hash(reinterpret_cast<const char *>(pKernel), kernelSize);
+
+    uint32_t calcCheckSum = hashValue & 0xFFFFFFFF;
+    kernelInfo.isValid = (calcCheckSum == kernelCheckSum);
+
+    retVal = CL_SUCCESS;
+    return sizeof(SKernelBinaryHeaderCommon) + kernelSize;
+}
+
+void Program::storeKernelInfo(KernelInfo *pKernelInfo) {
+    kernelInfoArray.push_back(pKernelInfo);
+    if (pKernelInfo->hasDeviceEnqueue()) {
+        parentKernelInfoArray.push_back(pKernelInfo);
+    }
+    if (pKernelInfo->requiresSubgroupIndependentForwardProgress()) {
+        subgroupKernelInfoArray.push_back(pKernelInfo);
+    }
+}
+
+cl_int Program::allocateKernelIsa(KernelInfo &kernelInfo) {
+    cl_int retVal = CL_SUCCESS;
+
+    if (kernelInfo.kernelAllocation == nullptr && kernelInfo.heapInfo.pKernelHeader->KernelHeapSize && this->pDevice) {
+        auto memoryManager = this->pDevice->getMemoryManager();
+        auto kernelIsaSize = kernelInfo.heapInfo.pKernelHeader->KernelHeapSize;
+        auto kernelAllocation = memoryManager->createInternalGraphicsAllocation(nullptr, kernelIsaSize);
+        if (kernelAllocation) {
+            memcpy_s(kernelAllocation->getUnderlyingBuffer(), kernelIsaSize, kernelInfo.heapInfo.pKernelHeap, kernelIsaSize);
+            kernelInfo.kernelAllocation = kernelAllocation;
+        } else {
+            retVal = CL_OUT_OF_HOST_MEMORY;
         }
+    }
 
-        auto pKernelHeader = pKernelInfo->heapInfo.pKernelHeader;
-        auto pKernel = ptrOffset(pKernelBlob, sizeof(SKernelBinaryHeaderCommon));
+    DEBUG_BREAK_IF(kernelInfo.heapInfo.pKernelHeader->KernelHeapSize && !this->pDevice);
 
-        if (genBinary)
-            pKernelInfo->gpuPointerSize = reinterpret_cast<const SProgramBinaryHeader *>(genBinary)->GPUPointerSizeInBytes;
+    return retVal;
+}
+
+GraphicsAllocation *Program::getKernelIsaAllocation(const KernelInfo &kernelInfo) {
+    if (DebugManager.flags.DeferKernelIsaUpload.get()) {
+        // ISA of kernels owned by this program is uploaded on first use
+        std::lock_guard<std::mutex> lock(kernelIsaMutex);
+        allocateKernelIsa(const_cast<KernelInfo &>(kernelInfo));
+    }
+    return kernelInfo.kernelAllocation;
+}
 
-        uint32_t kernelSize =
-            pKernelHeader->DynamicStateHeapSize +
-            pKernelHeader->GeneralStateHeapSize +
-            pKernelHeader->KernelHeapSize +
-            pKernelHeader->KernelNameSize +
-            pKernelHeader->PatchListSize +
-            pKernelHeader->SurfaceStateHeapSize;
+uint32_t Program::getNumKernelParsingThreads(uint32_t numKernels) const {
+    const uint32_t minKernelsPerThread = 8;
+    auto requestedThreads = DebugManager.flags.KernelParsingThreads.get();
+    if (requestedThreads == 0 || DebugManager.flags.LogPatchTokens.get()) {
+        return 1;
+    }
+    uint32_t numThreads = requestedThreads > 0
+                              ? static_cast<uint32_t>(requestedThreads)
+                              : std::max(std::thread::hardware_concurrency(), 1u);
+    return std::max(std::min(numThreads, numKernels / minKernelsPerThread), 1u);
+}
 
-        pKernelInfo->heapInfo.blobSize = kernelSize + sizeof(SKernelBinaryHeaderCommon);
+cl_int Program::processKernelsInParallel(const void *pKernelBlobs, uint32_t numKernels, uint32_t numThreads) {
+    // kernel blobs are located by their headers only, so they can be parsed independently
+    // NumberOfKernels comes from the binary, blobs are collected only as far as they fit in it
+    auto pCurBinaryPtr = pKernelBlobs;
+    auto pBinaryEnd = ptrOffset(genBinary, genBinarySize);
+    if (pCurBinaryPtr > pBinaryEnd) {
+        return CL_INVALID_BINARY;
+    }
+    std::vector<const void *> kernelBlobs;
+    kernelBlobs.reserve(std::min(static_cast<size_t>(numKernels), ptrDiff(pBinaryEnd, pCurBinaryPtr) / sizeof(SKernelBinaryHeaderCommon)));
+    for (uint32_t i = 0; i < numKernels; i++) {
+        auto remainingSize = ptrDiff(pBinaryEnd, pCurBinaryPtr);
+        if (remainingSize < sizeof(SKernelBinaryHeaderCommon)) {
+            return CL_INVALID_BINARY;
+        }
+        auto pKernelHeader = reinterpret_cast<const SKernelBinaryHeaderCommon *>(pCurBinaryPtr);
+        size_t blobSize = sizeof(SKernelBinaryHeaderCommon) +
+                          static_cast<size_t>(pKernelHeader->DynamicStateHeapSize) +
+                          static_cast<size_t>(pKernelHeader->GeneralStateHeapSize) +
+                          static_cast<size_t>(pKernelHeader->KernelHeapSize) +
+                          static_cast<size_t>(pKernelHeader->KernelNameSize) +
+                          static_cast<size_t>(pKernelHeader->PatchListSize) +
+                          static_cast<size_t>(pKernelHeader->SurfaceStateHeapSize);
+        if (blobSize > remainingSize) {
+            return CL_INVALID_BINARY;
+        }
+        kernelBlobs.push_back(pCurBinaryPtr);
+        pCurBinaryPtr = ptrOffset(pCurBinaryPtr, blobSize);
+    }
 
-        uint32_t kernelCheckSum = pKernelInfo->heapInfo.pKernelHeader->CheckSum;
+    if (this->pDevice) {
+        // parsePatchList may request the SLM window, allocate it before workers race for it
+        this->pDevice->prepareSLMWindow();
+    }
 
-        uint64_t hashValue = Hash::hash(reinterpret_cast<const char *>(pKernel), kernelSize);
+    std::vector<KernelInfo *> kernelInfos(numKernels);
+    std::vector<cl_int> results(numKernels, CL_SUCCESS);
+    for (auto &pKernelInfo : kernelInfos) {
+        pKernelInfo = KernelInfo::create();
+    }
 
-        uint32_t calcCheckSum = hashValue & 0xFFFFFFFF;
-        pKernelInfo->isValid = (calcCheckSum == kernelCheckSum);
+    std::atomic<uint32_t> nextKernel(0);
+    auto parseKernels = [&]() {
+        for (uint32_t i = nextKernel++; i < numKernels; i = nextKernel++) {
+            parseKernel(kernelBlobs[i], *kernelInfos[i], results[i]);
+        }
+    };
+    std::vector<std::thread> workers;
+    for (uint32_t i = 1; i < numThreads; i++) {
+        workers.emplace_back(parseKernels);
+    }
+    parseKernels();
+    for (auto &worker : workers) {
+        worker.join();
+    }
 
-        retVal = CL_SUCCESS;
-        sizeProcessed = sizeof(SKernelBinaryHeaderCommon) + kernelSize;
-        kernelInfoArray.push_back(pKernelInfo);
-        if (pKernelInfo->hasDeviceEnqueue()) {
-            parentKernelInfoArray.push_back(pKernelInfo);
+    // register kernels in binary order, stopping at the first one that failed like sequential processing does
+    cl_int retVal = CL_SUCCESS;
+    for (uint32_t i = 0; i < numKernels; i++) {
+        if (retVal == CL_SUCCESS) {
+            retVal = results[i];
         }
-        if (pKernelInfo->requiresSubgroupIndependentForwardProgress()) {
-            subgroupKernelInfoArray.push_back(pKernelInfo);
+        if (retVal == CL_SUCCESS && !DebugManager.flags.DeferKernelIsaUpload.get()) {
+            retVal = allocateKernelIsa(*kernelInfos[i]);
         }
-    } while (false);
+        if (retVal != CL_SUCCESS) {
+            delete kernelInfos[i];
+            continue;
+        }
+        storeKernelInfo(kernelInfos[i]);
+    }
 
-    return sizeProcessed;
+    return retVal;
 }
 
 cl_int Program::parsePatchList(KernelInfo &kernelInfo) {
@@ -806,20 +940,6 @@ cl_int Program::parsePatchList(KernelInfo &kernelInfo) {
         }
     }
 
-    if (kernelInfo.heapInfo.pKernelHeader->KernelHeapSize && this->pDevice) {
-        auto memoryManager = this->pDevice->getMemoryManager();
-        auto kernelIsaSize = kernelInfo.heapInfo.pKernelHeader->KernelHeapSize;
-        auto kernelAllocation = memoryManager->createInternalGraphicsAllocation(nullptr, kernelIsaSize);
-        if (kernelAllocation) {
-            memcpy_s(kernelAllocation->getUnderlyingBuffer(), kernelIsaSize, kernelInfo.heapInfo.pKernelHeap, kernelIsaSize);
-            kernelInfo.kernelAllocation = kernelAllocation;
-        } else {
-            retVal = CL_OUT_OF_HOST_MEMORY;
-        }
-    }
-
-    DEBUG_BREAK_IF(kernelInfo.heapInfo.pKernelHeader->KernelHeapSize && !this->pDevice);
-
     return retVal;
 }
 
@@ -974,6 +1094,12 @@ cl_int Program::processGenBinary() {
         pCurBinaryPtr = ptrOffset(pCurBinaryPtr, pGenBinaryHeader->PatchListSize);
 
         auto numKernels = pGenBinaryHeader->NumberOfKernels;
+        auto numThreads = getNumKernelParsingThreads(numKernels);
+        if (retVal == CL_SUCCESS && numThreads > 1) {
+            retVal = processKernelsInParallel(pCurBinaryPtr, numKernels, numThreads);
+            break;
+        }
+
         for (uint32_t i = 0; i < numKernels && retVal == CL_SUCCESS; i++) {
 
             size_t bytesProcessed = processKernel(pCurBinaryPtr, retVal);
@@ -360,6 +360,7 @@ void Program::separateBlockKernels() {
             }
             if (baseKernelFound) {
                 //Parent or subgroup kernel found -> child kernel
+                getKernelIsaAllocation(*i);
                 blockKernelManager->addBlockKernelInfo(i);
             } else {
                 kernelInfoArray.push_back(i);
@@ -34,6 +34,7 @@
 #include <vector>
 #include <string>
 #include <map>
+#include <mutex>
 
 #define OCLRT_ALIGN(a, b) ((((a) % (b)) != 0) ? ((a) - ((a) % (b)) + (b)) : (a))
 
@@ -146,6 +147,7 @@ class Program : public BaseObject<_cl_program> {
     size_t getNumKernels() const;
     const KernelInfo *getKernelInfo(const char *kernelName) const;
     const KernelInfo *getKernelInfo(size_t ordinal) const;
+    GraphicsAllocation *getKernelIsaAllocation(const KernelInfo &kernelInfo);
 
     cl_int getInfo(cl_program_info paramName, size_t paramValueSize,
                    void *paramValue, size_t *paramValueSizeRet);
@@ -268,6 +270,11 @@ class Program : public BaseObject<_cl_program> {
     cl_int parsePatchList(KernelInfo &pKernelInfo);
 
     size_t processKernel(const void *pKernelBlob, cl_int &retVal);
+    size_t parseKernel(const void *pKernelBlob, KernelInfo &kernelInfo, cl_int &retVal);
+    cl_int processKernelsInParallel(const void *pKernelBlobs, uint32_t numKernels, uint32_t numThreads);
+    uint32_t getNumKernelParsingThreads(uint32_t numKernels) const;
+    cl_int allocateKernelIsa(KernelInfo &kernelInfo);
+    void storeKernelInfo(KernelInfo *pKernelInfo);
 
     void storeBinary(char *&pDst, size_t &dstSize, const void *pSrc, const size_t srcSize);
 
@@ -303,6 +310,7 @@ class Program : public BaseObject<_cl_program> {
     std::vector<KernelInfo*>  kernelInfoArray;
     std::vector<KernelInfo*>  parentKernelInfoArray;
     std::vector<KernelInfo*>  subgroupKernelInfoArray;
+    std::mutex                kernelIsaMutex;
     BlockKernelManager *      blockKernelManager;
 
     const void*               programScopePatchList;
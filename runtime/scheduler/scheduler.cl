@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017, Intel Corporation
+ * Copyright (c) 2017 - 2018, Intel Corporation
  *
  * Permission is hereby granted, free of charge, to any person obtaining a
  * copy of this software and associated documentation files (the "Software"),
@@ -34,6 +34,10 @@ extern float __intel__getProfilingTimerResolution();
 #define EMULATION_ENTER_FUNCTION( )
 #endif
 
+#ifndef EMULATION_SPIN_WAIT
+#define EMULATION_SPIN_WAIT( )
+#endif
+
 #ifndef NULL
 #define NULL                                    0
 #endif
@@ -2715,6 +2719,7 @@ void GlobalBarrier( __global volatile uint* syncSurface )
             {
                 Value = Value & syncSurface[ i ];
             }
+            EMULATION_SPIN_WAIT( );
 
         }
         while( Value == 0 );
@@ -2728,7 +2733,10 @@ void GlobalBarrier( __global volatile uint* syncSurface )
 
     if( get_local_id( 0 ) == 0 )
     {
-        while( syncSurface[ get_group_id( 0 ) ] != 0 );
+        while( syncSurface[ get_group_id( 0 ) ] != 0 )
+        {
+            EMULATION_SPIN_WAIT( );
+        }
     }
     barrier( CLK_GLOBAL_MEM_FENCE );
 }
@@ -2753,6 +2761,7 @@ void GlobalBarrierUpdateQueue( __global volatile uint* syncSurface, __global IGI
             {
                 Value = Value & syncSurface[ i ];
             }
+            EMULATION_SPIN_WAIT( );
         }
         while( Value == 0 );
         barrier( CLK_GLOBAL_MEM_FENCE );
@@ -2768,22 +2777,26 @@ void GlobalBarrierUpdateQueue( __global volatile uint* syncSurface, __global IGI
 
     if( get_local_id(0) == 0 )
     {
-        while( syncSurface[ get_group_id(0) ] != 0 );
+        while( syncSurface[ get_group_id(0) ] != 0 )
+        {
+            EMULATION_SPIN_WAIT( );
+        }
     }
     barrier( CLK_GLOBAL_MEM_FENCE );
 }
 
 
 #ifdef SCHEDULER_EMULATION
-__local int IDTOffset;
-__local int DSHOffset;
-__local int SLBOffset;
-__local int StackOffset;
-__local int QStorageOffset;
-__local int MarkerOffset;
-__local int BTSoffset;
-__local IGIL_WalkerEnumeration WalkerEnum;
-__local uint ObjectIDS[ MAX_GLOBAL_ARGS ];
+//Every HW group needs its own copy of local memory when groups are emulated on host threads
+__local GroupLocal<int> IDTOffset;
+__local GroupLocal<int> DSHOffset;
+__local GroupLocal<int> SLBOffset;
+__local GroupLocal<int> StackOffset;
+__local GroupLocal<int> QStorageOffset;
+__local GroupLocal<int> MarkerOffset;
+__local GroupLocal<int> BTSoffset;
+__local GroupLocal<IGIL_WalkerEnumeration> WalkerEnum;
+__local GroupLocal<uint[ MAX_GLOBAL_ARGS ]> ObjectIDS;
 #endif
 
 #define WA_INT_DESC_MAX 62
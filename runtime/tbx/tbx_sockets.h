@@ -1,5 +1,5 @@
 /*
-* Copyright (c) 2017, Intel Corporation
+* Copyright (c) 2017 - 2018, Intel Corporation
 *
 * Permission is hereby granted, free of charge, to any person obtaining a
 * copy of this software and associated documentation files (the "Software"),
@@ -41,6 +41,9 @@ class TbxSockets {
     virtual bool readMMIO(uint32_t offset, uint32_t *value) = 0;
     virtual bool writeMMIO(uint32_t offset, uint32_t value) = 0;
 
+    // sends writes that implementations may hold back to batch them
+    virtual bool flush() { return true; }
+
     static TbxSockets *create();
 };
 } // namespace OCLRT
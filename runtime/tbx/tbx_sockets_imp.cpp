@@ -23,6 +23,7 @@
 #include "runtime/tbx/tbx_sockets_imp.h"
 #include "runtime/helpers/debug_helpers.h"
 #include "runtime/helpers/string.h"
+#include "runtime/os_interface/debug_settings_manager.h"
 
 #ifdef WIN32
 #ifndef WIN32_LEAN_AND_MEAN
@@ -35,11 +36,13 @@ typedef int socklen_t;
 #include <stdlib.h>
 #include <unistd.h>
 #include <string.h>
+#include <sys/uio.h>
 typedef struct sockaddr SOCKADDR;
 #define SOCKET_ERROR -1
 #define INVALID_SOCKET -1
 #define WSAECONNRESET -1
 #endif
+#include <algorithm>
 #include <cstdint>
 #include "tbx_proto.h"
 
@@ -51,6 +54,7 @@ TbxSocketsImp::TbxSocketsImp(std::ostream &err)
 
 void TbxSocketsImp::close() {
     if (0 != m_socket) {
+        flush();
 #ifdef WIN32
         ::shutdown(m_socket, 0x02 /*SD_BOTH*/);
 
@@ -74,6 +78,7 @@ void TbxSocketsImp::logErrorInfo(const char *tag) {
 }
 
 bool TbxSocketsImp::init(const std::string &hostNameOrIp, uint16_t port) {
+    batching = DebugManager.flags.TbxSocketBatching.get() != 0;
     do {
 #ifdef WIN32
         WSADATA wsaData;
@@ -109,7 +114,8 @@ bool TbxSocketsImp::init(const std::string &hostNameOrIp, uint16_t port) {
         cmd.u.control_req.has_mask = 1;
         cmd.u.control_req.has = 1;
 
-        sendWriteData(&cmd, sizeof(HAS_HDR) + cmd.hdr.size);
+        queueMessage(&cmd, sizeof(HAS_HDR) + cmd.hdr.size, nullptr, 0);
+        flush();
     } while (false);
 
     return m_socket != INVALID_SOCKET;
@@ -159,20 +165,16 @@ bool TbxSocketsImp::readMMIO(uint32_t offset, uint32_t *data) {
         cmd.u.mmio_req.msg_type = MSG_TYPE_MMIO;
         cmd.u.mmio_req.size = sizeof(uint32_t);
 
-        success = sendWriteData(&cmd, sizeof(HAS_HDR) + cmd.hdr.size);
+        // read request goes out together with all batched writes
+        success = queueMessage(&cmd, sizeof(HAS_HDR) + cmd.hdr.size, nullptr, 0) && flush();
         if (!success) {
             break;
         }
 
         HAS_MSG resp;
-        success = getResponseData((char *)(&resp), sizeof(HAS_HDR) + sizeof(HAS_MMIO_RES));
+        success = receiveResponse(cmd.hdr.trans_id, HAS_MMIO_RES_TYPE, &resp, sizeof(HAS_HDR) + sizeof(HAS_MMIO_RES));
         if (!success) {
-            break;
-        }
-
-        if (resp.hdr.msg_type != HAS_MMIO_RES_TYPE || cmd.hdr.trans_id != resp.hdr.trans_id) {
             *data = 0xdeadbeef;
-            success = false;
             break;
         }
 
@@ -196,7 +198,7 @@ bool TbxSocketsImp::writeMMIO(uint32_t offset, uint32_t value) {
     cmd.u.mmio_req.write = 1;
     cmd.u.mmio_req.size = sizeof(uint32_t);
 
-    return sendWriteData(&cmd, sizeof(HAS_HDR) + cmd.hdr.size);
+    return queueMessage(&cmd, sizeof(HAS_HDR) + cmd.hdr.size, nullptr, 0);
 }
 
 bool TbxSocketsImp::readMemory(uint64_t addrOffset, void *data, size_t size) {
@@ -215,23 +217,17 @@ bool TbxSocketsImp::readMemory(uint64_t addrOffset, void *data, size_t size) {
 
     bool success;
     do {
-        success = sendWriteData(&cmd, sizeof(HAS_HDR) + sizeof(HAS_READ_DATA_REQ));
+        success = queueMessage(&cmd, sizeof(HAS_HDR) + sizeof(HAS_READ_DATA_REQ), nullptr, 0) && flush();
         if (!success) {
             break;
         }
 
         HAS_MSG resp;
-        success = getResponseData(&resp, sizeof(HAS_HDR) + sizeof(HAS_READ_DATA_RES));
+        success = receiveResponse(cmd.hdr.trans_id, HAS_READ_DATA_RES_TYPE, &resp, sizeof(HAS_HDR) + sizeof(HAS_READ_DATA_RES));
         if (!success) {
             break;
         }
 
-        if (resp.hdr.msg_type != HAS_READ_DATA_RES_TYPE || resp.hdr.trans_id != cmd.hdr.trans_id) {
-            cerrStream << "Out of sequence read data packet?" << std::endl;
-            success = false;
-            break;
-        }
-
         success = getResponseData(data, size);
     } while (false);
 
@@ -240,7 +236,32 @@ bool TbxSocketsImp::readMemory(uint64_t addrOffset, void *data, size_t size) {
 }
 
 bool TbxSocketsImp::writeMemory(uint64_t physAddr, const void *data, size_t size) {
+    bool success = queueWriteMemory(physAddr, data, size);
+    if (!success) {
+        cerrStream << "Problem sending write data?" << std::endl;
+    }
+    DEBUG_BREAK_IF(!success);
+    return success;
+}
+
+bool TbxSocketsImp::queueWriteMemory(uint64_t physAddr, const void *data, size_t size) {
+    const size_t headerSize = sizeof(HAS_HDR) + sizeof(HAS_WRITE_DATA_REQ);
     HAS_MSG cmd;
+
+    // extend previous write if this one continues it, e.g. consecutive pages of an allocation
+    if (coalescableWriteOffset != noCoalescableWrite && physAddr == coalescableWriteEnd &&
+        size < directSendThreshold && pendingData.size() + size <= maxPendingSize) {
+        memcpy(&cmd, &pendingData[coalescableWriteOffset], headerSize);
+        cmd.u.write_req.size += static_cast<uint32_t>(size);
+        memcpy(&pendingData[coalescableWriteOffset], &cmd, headerSize);
+
+        auto payload = reinterpret_cast<const char *>(data);
+        pendingData.insert(pendingData.end(), payload, payload + size);
+        coalescableWriteEnd += size;
+        statistics.coalescedWrites++;
+        return true;
+    }
+
     memset(&cmd, 0, sizeof(cmd));
     cmd.hdr.msg_type = HAS_WRITE_DATA_REQ_TYPE;
     cmd.hdr.trans_id = transID++;
@@ -254,22 +275,15 @@ bool TbxSocketsImp::writeMemory(uint64_t physAddr, const void *data, size_t size
     cmd.u.write_req.frontdoor = 0;
     cmd.u.write_req.cacheline_disable = cmd.u.write_req.frontdoor;
 
-    bool success;
-    do {
-        success = sendWriteData(&cmd, sizeof(HAS_HDR) + sizeof(HAS_WRITE_DATA_REQ));
-        if (!success) {
-            break;
-        }
-
-        success = sendWriteData(data, size);
-        if (!success) {
-            cerrStream << "Problem sending write data?" << std::endl;
-            break;
-        }
-    } while (false);
-
-    DEBUG_BREAK_IF(!success);
-    return success;
+    if (!queueMessage(&cmd, headerSize, data, size)) {
+        return false;
+    }
+    if (batching && size < directSendThreshold) {
+        // the write is the last message in pendingData
+        coalescableWriteOffset = pendingData.size() - headerSize - size;
+        coalescableWriteEnd = physAddr + size;
+    }
+    return true;
 }
 
 bool TbxSocketsImp::writeGTT(uint32_t offset, uint64_t entry) {
@@ -283,7 +297,69 @@ bool TbxSocketsImp::writeGTT(uint32_t offset, uint64_t entry) {
     cmd.u.gtt64_req.data = static_cast<uint32_t>(entry & 0xffffffff);
     cmd.u.gtt64_req.data_h = static_cast<uint32_t>(entry >> 32);
 
-    return sendWriteData(&cmd, sizeof(HAS_HDR) + cmd.hdr.size);
+    return queueMessage(&cmd, sizeof(HAS_HDR) + cmd.hdr.size, nullptr, 0);
+}
+
+bool TbxSocketsImp::queueMessage(const void *cmd, size_t cmdSize, const void *payload, size_t payloadSize) {
+    statistics.messages++;
+    coalescableWriteOffset = noCoalescableWrite;
+
+    auto cmdData = reinterpret_cast<const char *>(cmd);
+    if (payloadSize >= directSendThreshold) {
+        // header leaves with the pending batch, payload straight from caller memory
+        pendingData.insert(pendingData.end(), cmdData, cmdData + cmdSize);
+        auto success = sendWriteData(pendingData.data(), pendingData.size(), payload, payloadSize);
+        pendingData.clear();
+        return success;
+    }
+
+    if (pendingData.size() + cmdSize + payloadSize > maxPendingSize && !flush()) {
+        return false;
+    }
+    pendingData.insert(pendingData.end(), cmdData, cmdData + cmdSize);
+    if (payloadSize > 0) {
+        auto payloadData = reinterpret_cast<const char *>(payload);
+        pendingData.insert(pendingData.end(), payloadData, payloadData + payloadSize);
+    }
+    return batching ? true : flush();
+}
+
+bool TbxSocketsImp::flush() {
+    coalescableWriteOffset = noCoalescableWrite;
+    if (pendingData.empty()) {
+        return true;
+    }
+    auto success = sendWriteData(pendingData.data(), pendingData.size());
+    pendingData.clear();
+    return success;
+}
+
+bool TbxSocketsImp::receiveResponse(uint32_t transId, uint32_t msgType, void *resp, size_t respSize) {
+    statistics.roundTrips++;
+    HAS_MSG msg;
+    while (true) {
+        if (!getResponseData(&msg.hdr, sizeof(HAS_HDR))) {
+            return false;
+        }
+        auto bodySize = std::min(static_cast<size_t>(msg.hdr.size), sizeof(msg.u));
+        if ((bodySize > 0 && !getResponseData(&msg.u, bodySize)) || !discardResponseData(msg.hdr.size - bodySize)) {
+            return false;
+        }
+        if (msg.hdr.trans_id == transId && msg.hdr.msg_type == msgType) {
+            memcpy_s(resp, respSize, &msg, std::min(respSize, sizeof(HAS_HDR) + bodySize));
+            return true;
+        }
+
+        cerrStream << "Out of sequence response, type: " << msg.hdr.msg_type << " trans_id: " << msg.hdr.trans_id
+                   << " expected: " << transId << std::endl;
+        // only responses to earlier requests can be skipped, anything else means the stream is out of sync
+        if (static_cast<int32_t>(msg.hdr.trans_id - transId) >= 0) {
+            return false;
+        }
+        if (msg.hdr.msg_type == HAS_READ_DATA_RES_TYPE && !discardResponseData(msg.u.read_res.size)) {
+            return false;
+        }
+    }
 }
 
 bool TbxSocketsImp::sendWriteData(const void *buffer, size_t sizeInBytes) {
@@ -291,6 +367,7 @@ bool TbxSocketsImp::sendWriteData(const void *buffer, size_t sizeInBytes) {
     auto dataBuffer = reinterpret_cast<const char *>(buffer);
 
     do {
+        statistics.sendCalls++;
         auto bytesSent = ::send(m_socket, &dataBuffer[totalSent], static_cast<int>(sizeInBytes - totalSent), 0);
         if (bytesSent == 0 || bytesSent == WSAECONNRESET) {
             logErrorInfo("Connection Closed.");
@@ -307,6 +384,58 @@ bool TbxSocketsImp::sendWriteData(const void *buffer, size_t sizeInBytes) {
     return true;
 }
 
+bool TbxSocketsImp::sendWriteData(const void *buffer0, size_t size0, const void *buffer1, size_t size1) {
+#ifdef WIN32
+    return sendWriteData(buffer0, size0) && sendWriteData(buffer1, size1);
+#else
+    iovec chunks[2] = {{const_cast<void *>(buffer0), size0}, {const_cast<void *>(buffer1), size1}};
+    iovec *chunk = chunks;
+    int numChunks = 2;
+
+    while (numChunks > 0) {
+        if (chunk->iov_len == 0) {
+            chunk++;
+            numChunks--;
+            continue;
+        }
+        statistics.sendCalls++;
+        auto bytesSent = ::writev(m_socket, chunk, numChunks);
+        if (bytesSent == 0) {
+            logErrorInfo("Connection Closed.");
+            return false;
+        }
+        if (bytesSent == SOCKET_ERROR) {
+            logErrorInfo("Error on writev()");
+            return false;
+        }
+
+        auto remaining = static_cast<size_t>(bytesSent);
+        while (numChunks > 0 && remaining >= chunk->iov_len) {
+            remaining -= chunk->iov_len;
+            chunk++;
+            numChunks--;
+        }
+        if (numChunks > 0) {
+            chunk->iov_base = reinterpret_cast<char *>(chunk->iov_base) + remaining;
+            chunk->iov_len -= remaining;
+        }
+    }
+    return true;
+#endif
+}
+
+bool TbxSocketsImp::discardResponseData(size_t sizeInBytes) {
+    char scratch[256];
+    while (sizeInBytes > 0) {
+        auto chunk = std::min(sizeInBytes, sizeof(scratch));
+        if (!getResponseData(scratch, chunk)) {
+            return false;
+        }
+        sizeInBytes -= chunk;
+    }
+    return true;
+}
+
 bool TbxSocketsImp::getResponseData(void *buffer, size_t sizeInBytes) {
     size_t totalRecv = 0;
     auto dataBuffer = reinterpret_cast<char *>(buffer);
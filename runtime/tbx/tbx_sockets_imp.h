@@ -23,6 +23,7 @@
 #include "runtime/tbx/tbx_sockets.h"
 #include "os_socket.h"
 #include <iostream>
+#include <vector>
 
 namespace OCLRT {
 
@@ -42,18 +43,46 @@ class TbxSocketsImp : public TbxSockets {
     bool readMMIO(uint32_t offset, uint32_t *data) override;
     bool writeMMIO(uint32_t offset, uint32_t data) override;
 
+    bool flush() override;
+
+    struct Statistics {
+        uint64_t messages = 0;
+        uint64_t coalescedWrites = 0;
+        uint64_t sendCalls = 0;
+        uint64_t roundTrips = 0;
+    };
+    const Statistics &getStatistics() const { return statistics; }
+
+    // writes with larger payloads are sent directly from caller memory instead of being copied
+    static const size_t directSendThreshold = 64 * 1024;
+    static const size_t maxPendingSize = 1024 * 1024;
+
   protected:
     std::ostream &cerrStream;
     SOCKET m_socket = 0;
 
     bool connectToServer(const std::string &hostNameOrIp, uint16_t port);
     bool sendWriteData(const void *buffer, size_t sizeInBytes);
+    bool sendWriteData(const void *buffer0, size_t size0, const void *buffer1, size_t size1);
     bool getResponseData(void *buffer, size_t sizeInBytes);
+    bool discardResponseData(size_t sizeInBytes);
+
+    bool queueMessage(const void *cmd, size_t cmdSize, const void *payload, size_t payloadSize);
+    bool queueWriteMemory(uint64_t physAddr, const void *data, size_t size);
+    bool receiveResponse(uint32_t transId, uint32_t msgType, void *resp, size_t respSize);
 
     inline uint32_t getNextTransID() { return transID++; }
 
     void logErrorInfo(const char *tag);
 
     uint32_t transID = 0;
+
+    // requests not sent yet, writes get batched until a read needs a response or buffer fills up
+    std::vector<char> pendingData;
+    static const size_t noCoalescableWrite = static_cast<size_t>(-1);
+    size_t coalescableWriteOffset = noCoalescableWrite;
+    uint64_t coalescableWriteEnd = 0;
+    bool batching = true;
+    Statistics statistics;
 };
 } // namespace OCLRT
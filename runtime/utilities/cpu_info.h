@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017, Intel Corporation
+ * Copyright (c) 2017 - 2018, Intel Corporation
  *
  * Permission is hereby granted, free of charge, to any person obtaining a
  * copy of this software and associated documentation files (the "Software"),
@@ -61,6 +61,7 @@ struct CpuInfo {
     static const uint64_t featureAvX512Cd = 0x400000000ULL;
     static const uint64_t featureSha = 0x800000000ULL;
     static const uint64_t featureMpx = 0x1000000000ULL;
+    static const uint64_t featureAvX512Bw = 0x2000000000ULL;
 
     CpuInfo() : features(featureNone) {
     }
@@ -174,6 +175,15 @@ struct CpuInfo {
             {
                 features |= cpuInfo[1] & BIT(11) ? featureRtm : featureNone;
             }
+
+            {
+                features |= cpuInfo[1] & BIT(16) ? featureAvX512F : featureNone;
+            }
+
+            {
+                auto mask = BIT(16) | BIT(30);
+                features |= (cpuInfo[1] & mask) == mask ? featureAvX512Bw : featureNone;
+            }
         }
 
         cpuid(cpuInfo, 0x80000000);
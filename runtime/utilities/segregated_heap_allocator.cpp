@@ -0,0 +1,187 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/utilities/segregated_heap_allocator.h"
+#include "runtime/os_interface/debug_settings_manager.h"
+
+namespace OCLRT {
+const size_t SegregatedHeapAllocator::numSizeClasses;
+const size_t SegregatedHeapAllocator::maxSizeClassDepth;
+const size_t SegregatedHeapAllocator::defaultSizeThreshold;
+
+SegregatedHeapAllocator::SegregatedHeapAllocator(void *address, uint64_t size, size_t threshold) : address(address), size(size), availableSize(size), sizeThreshold(threshold) {
+    pLeftBound = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(address));
+    pRightBound = pLeftBound + size;
+}
+
+void *SegregatedHeapAllocator::allocate(size_t &sizeToAllocate) {
+    std::lock_guard<std::mutex> lock(mtx);
+    sizeToAllocate = alignUp(sizeToAllocate, allocationAlignment);
+
+    DBG_LOG(PrintDebugMessages, __FUNCTION__, "Allocator usage == ", this->getUsage());
+
+    if (availableSize < sizeToAllocate) {
+        return nullptr;
+    }
+
+    uint64_t ptrReturn = getFromSizeClasses(sizeToAllocate);
+    if (ptrReturn == 0) {
+        ptrReturn = getFromFreedChunks(sizeToAllocate);
+    }
+    if (ptrReturn == 0) {
+        ptrReturn = getFromBounds(sizeToAllocate);
+    }
+    if (ptrReturn == 0 && sizeInSizeClasses > 0) {
+        // parked chunks may coalesce into a big enough one
+        flushSizeClasses();
+        ptrReturn = getFromFreedChunks(sizeToAllocate);
+        if (ptrReturn == 0) {
+            ptrReturn = getFromBounds(sizeToAllocate);
+        }
+    }
+
+    if (ptrReturn != 0) {
+        availableSize -= sizeToAllocate;
+    }
+    return reinterpret_cast<void *>(static_cast<uintptr_t>(ptrReturn));
+}
+
+void SegregatedHeapAllocator::free(void *ptr, size_t size) {
+    std::lock_guard<std::mutex> lock(mtx);
+    uint64_t ptrIn = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(ptr));
+    if (ptrIn == 0u)
+        return;
+
+    DBG_LOG(PrintDebugMessages, __FUNCTION__, "Allocator usage == ", this->getUsage());
+
+    auto sizeClass = getSizeClass(size);
+    bool adjacentToBounds = (ptrIn == pRightBound) || (ptrIn + size == pLeftBound);
+    if (!adjacentToBounds && sizeClass > 0 && sizeClass <= numSizeClasses &&
+        sizeClass * allocationAlignment == size && sizeClasses[sizeClass].size() < maxSizeClassDepth) {
+        sizeClasses[sizeClass].push_back(ptrIn);
+        sizeInSizeClasses += size;
+    } else {
+        storeInFreedChunks(ptrIn, size);
+    }
+    availableSize += size;
+}
+
+uint64_t SegregatedHeapAllocator::getFromSizeClasses(size_t &sizeToAllocate) {
+    auto sizeClass = getSizeClass(sizeToAllocate);
+    if (sizeClass == 0 || sizeClass > numSizeClasses) {
+        return 0;
+    }
+
+    // exact fit first, otherwise smallest parked chunk below twice the size, handed out whole
+    auto lastClass = std::min(2 * sizeClass - 1, numSizeClasses);
+    for (auto candidate = sizeClass; candidate <= lastClass; candidate++) {
+        auto &chunks = sizeClasses[candidate];
+        if (!chunks.empty()) {
+            auto ptr = chunks.back();
+            chunks.pop_back();
+            sizeToAllocate = candidate * allocationAlignment;
+            sizeInSizeClasses -= sizeToAllocate;
+            return ptr;
+        }
+    }
+    return 0;
+}
+
+uint64_t SegregatedHeapAllocator::getFromFreedChunks(size_t &sizeToAllocate) {
+    auto bestFit = freedChunksBySize.lower_bound(std::make_pair(static_cast<uint64_t>(sizeToAllocate), static_cast<uint64_t>(0)));
+    if (bestFit == freedChunksBySize.end()) {
+        return 0;
+    }
+
+    auto chunkSize = bestFit->first;
+    auto chunkPtr = bestFit->second;
+    freedChunksBySize.erase(bestFit);
+
+    if (chunkSize < (static_cast<uint64_t>(sizeToAllocate) << 1)) {
+        freedChunks.erase(chunkPtr);
+        sizeToAllocate = static_cast<size_t>(chunkSize);
+        return chunkPtr;
+    }
+
+    // split, tail is returned and head stays at the same key in address map
+    auto sizeDelta = chunkSize - sizeToAllocate;
+    freedChunks[chunkPtr] = sizeDelta;
+    freedChunksBySize.emplace(sizeDelta, chunkPtr);
+    return chunkPtr + sizeDelta;
+}
+
+uint64_t SegregatedHeapAllocator::getFromBounds(size_t sizeToAllocate) {
+    if (pRightBound - pLeftBound < sizeToAllocate) {
+        return 0;
+    }
+    if (sizeToAllocate > sizeThreshold) {
+        auto ptr = pLeftBound;
+        pLeftBound += sizeToAllocate;
+        return ptr;
+    }
+    pRightBound -= sizeToAllocate;
+    return pRightBound;
+}
+
+void SegregatedHeapAllocator::eraseFreedChunk(FreeChunks::iterator chunk) {
+    freedChunksBySize.erase(std::make_pair(chunk->second, chunk->first));
+    freedChunks.erase(chunk);
+}
+
+void SegregatedHeapAllocator::storeInFreedChunks(uint64_t ptr, uint64_t size) {
+    auto next = freedChunks.lower_bound(ptr);
+    if (next != freedChunks.end() && next->first == ptr + size) {
+        size += next->second;
+        auto toErase = next++;
+        eraseFreedChunk(toErase);
+    }
+    if (next != freedChunks.begin()) {
+        auto prev = std::prev(next);
+        if (prev->first + prev->second == ptr) {
+            ptr = prev->first;
+            size += prev->second;
+            eraseFreedChunk(prev);
+        }
+    }
+
+    // freed chunks never border the unallocated middle, they are folded into it
+    if (ptr + size == pLeftBound) {
+        pLeftBound = ptr;
+    } else if (ptr == pRightBound) {
+        pRightBound = ptr + size;
+    } else {
+        freedChunks.emplace(ptr, size);
+        freedChunksBySize.emplace(size, ptr);
+    }
+}
+
+void SegregatedHeapAllocator::flushSizeClasses() {
+    for (size_t sizeClass = 1; sizeClass <= numSizeClasses; sizeClass++) {
+        for (auto ptr : sizeClasses[sizeClass]) {
+            storeInFreedChunks(ptr, sizeClass * allocationAlignment);
+        }
+        sizeClasses[sizeClass].clear();
+    }
+    sizeInSizeClasses = 0;
+    DBG_LOG(PrintDebugMessages, __FUNCTION__, "Allocator usage == ", this->getUsage());
+}
+} // namespace OCLRT
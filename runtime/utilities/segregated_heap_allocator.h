@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+#include "runtime/helpers/aligned_memory.h"
+#include "runtime/helpers/debug_helpers.h"
+
+#include <array>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <set>
+#include <utility>
+#include <vector>
+
+namespace OCLRT {
+
+// Drop-in replacement for HeapAllocator with logarithmic free chunk handling.
+// Freed chunks are kept coalesced in an address ordered map with a size ordered
+// index for best fit lookups. Small chunks are first parked in exact size class
+// bins, so steady alloc/free of the same sizes never touches the trees.
+class SegregatedHeapAllocator {
+  public:
+    static const size_t numSizeClasses = 64;
+    static const size_t maxSizeClassDepth = 256;
+
+    SegregatedHeapAllocator(void *address, uint64_t size) : SegregatedHeapAllocator(address, size, defaultSizeThreshold) {}
+    SegregatedHeapAllocator(void *address, uint64_t size, size_t threshold);
+
+    void *allocate(size_t &sizeToAllocate);
+    void free(void *ptr, size_t size);
+
+    uint64_t getLeftSize() {
+        return availableSize;
+    }
+
+    uint64_t getUsedSize() {
+        return size - availableSize;
+    }
+
+    NO_SANITIZE
+    double getUsage() {
+        return 1.0 * (size - availableSize) / (size * 1.0);
+    }
+
+  protected:
+    using FreeChunks = std::map<uint64_t, uint64_t>;
+    using FreeChunksBySize = std::set<std::pair<uint64_t, uint64_t>>;
+
+    static const size_t defaultSizeThreshold = 4096 * 1024;
+
+    uint64_t getFromSizeClasses(size_t &sizeToAllocate);
+    uint64_t getFromFreedChunks(size_t &sizeToAllocate);
+    uint64_t getFromBounds(size_t sizeToAllocate);
+    void storeInFreedChunks(uint64_t ptr, uint64_t size);
+    void eraseFreedChunk(FreeChunks::iterator chunk);
+    void flushSizeClasses();
+
+    size_t getSizeClass(size_t size) const {
+        return size / allocationAlignment;
+    }
+
+    void *address;
+    uint64_t size;
+    uint64_t availableSize;
+    uint64_t pLeftBound, pRightBound;
+    const size_t sizeThreshold;
+    size_t allocationAlignment = MemoryConstants::pageSize;
+
+    FreeChunks freedChunks;
+    FreeChunksBySize freedChunksBySize;
+    // index N holds chunks of exactly N allocation units, index 0 is unused
+    std::array<std::vector<uint64_t>, numSizeClasses + 1> sizeClasses;
+    uint64_t sizeInSizeClasses = 0;
+    std::mutex mtx;
+};
+} // namespace OCLRT
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017, Intel Corporation
+ * Copyright (c) 2017 - 2018, Intel Corporation
  *
  * Permission is hereby granted, free of charge, to any person obtaining a
  * copy of this software and associated documentation files (the "Software"),
@@ -21,13 +21,19 @@
  */
 
 #pragma once
+#include "runtime/command_stream/command_stream_receiver.h"
 #include "runtime/helpers/aligned_memory.h"
 #include "runtime/helpers/debug_helpers.h"
 #include "runtime/memory_manager/memory_manager.h"
+#include "runtime/os_interface/debug_settings_manager.h"
 #include "runtime/utilities/idlist.h"
 #include "runtime/utilities/tag_allocator_base.h"
 
+#include <algorithm>
+#include <atomic>
 #include <cstdint>
+#include <limits>
+#include <memory>
 #include <mutex>
 #include <vector>
 
@@ -42,6 +48,12 @@ struct TagNode : public IDNode<TagNode<TagType>> {
         return gfxAllocation;
     }
 
+    // links of the free and pending lists owned by TagAllocator
+    uint32_t index = 0;
+    std::atomic<uint32_t> nextFree{0};
+    TagNode *nextPending = nullptr;
+    uint32_t returnTaskCount = 0;
+
   protected:
     TagNode() = default;
     GraphicsAllocation *gfxAllocation;
@@ -66,6 +78,12 @@ class TagAllocator : public TagAllocatorBase {
             gfxAllocations.reserve(PrefferedProfilingTagPoolCount);
             tagPoolMemory.reserve(PrefferedProfilingTagPoolCount);
         }
+        poolCountLimit = maxTagPoolCount ? maxTagPoolCount : MaxUnlimitedTagPoolCount;
+        tagPools.reset(new std::atomic<NodeType *>[poolCountLimit]);
+        for (size_t i = 0; i < poolCountLimit; ++i) {
+            tagPools[i].store(nullptr, std::memory_order_relaxed);
+        }
+        trackUsedTags = DebugManager.flags.TrackUsedTags.get();
         populateFreeTags();
     }
 
@@ -74,6 +92,11 @@ class TagAllocator : public TagAllocatorBase {
     }
 
     void cleanUpResources() override {
+        std::unique_lock<std::mutex> lock(allocationsMutex);
+        freeTagsHead.store(0);
+        pendingTags.store(nullptr);
+        usedTags.detachNodes();
+
         size_t size = gfxAllocations.size();
 
         for (uint32_t i = 0; i < size; ++i) {
@@ -83,32 +106,46 @@ class TagAllocator : public TagAllocatorBase {
 
         size = tagPoolMemory.size();
         for (uint32_t i = 0; i < size; ++i) {
+            tagPools[i].store(nullptr, std::memory_order_relaxed);
             delete[] tagPoolMemory[i];
         }
         tagPoolMemory.clear();
     }
 
     NodeType *getTag() {
-        NodeType *node = freeTags.removeFrontOne().release();
+        NodeType *node = popFreeTag();
+        if (!node) {
+            reclaimCompletedTags();
+            node = popFreeTag();
+        }
         if (!node) {
             populateFreeTags();
-            node = freeTags.removeFrontOne().release();
+            node = popFreeTag();
         }
-        if (node)
+        if (node && trackUsedTags)
             usedTags.pushFrontOne(*node);
         return node;
     }
 
     void returnTag(NodeType *node) {
-        NodeType *usedNode = usedTags.removeOne(*node).release();
-        DEBUG_BREAK_IF(usedNode == nullptr);
-        ((void)(usedNode));
-        freeTags.pushFrontOne(*node);
+        untrackUsedTag(node);
+        pushFreeTag(node);
+    }
+
+    // Tags still referenced by submitted work are handed out again only after
+    // the CSR has completed taskCount, they are reclaimed in batches by getTag
+    void returnTagWhenCompleted(NodeType *node, uint32_t taskCount) {
+        if (isCompleted(taskCount)) {
+            returnTag(node);
+            return;
+        }
+        untrackUsedTag(node);
+        node->returnTaskCount = taskCount;
+        pushPendingTag(node);
     }
     size_t peekMaxTagPoolCount() { return maxTagPoolCount; }
 
   protected:
-    IDList<NodeType> freeTags;
     IDList<NodeType> usedTags;
     std::vector<GraphicsAllocation *> gfxAllocations;
     std::vector<NodeType *> tagPoolMemory;
@@ -117,9 +154,83 @@ class TagAllocator : public TagAllocatorBase {
     const size_t maxTagPoolCount;
     size_t tagCount;
     size_t tagAlignment;
+    size_t poolCountLimit = 0;
+    size_t tagsPerPool = 0;
+    bool trackUsedTags = false;
+
+    // Free list head packs the index of the first free tag + 1 in the low half
+    // and a version bumped by every update in the high half, so a pop racing
+    // with pop/push pairs of other threads fails instead of linking a used tag
+    std::atomic<uint64_t> freeTagsHead{0};
+    std::atomic<NodeType *> pendingTags{nullptr};
+    // pool table is written once per pool, lock-free readers map tag indices through it
+    std::unique_ptr<std::atomic<NodeType *>[]> tagPools;
 
     std::mutex allocationsMutex;
 
+    static uint64_t makeHead(uint64_t previousHead, uint32_t link) {
+        return (((previousHead >> 32) + 1) << 32) | link;
+    }
+
+    NodeType *getNodeFromLink(uint32_t link) {
+        auto index = link - 1;
+        return tagPools[index / tagsPerPool].load(std::memory_order_acquire) + index % tagsPerPool;
+    }
+
+    void pushFreeTag(NodeType *node) {
+        auto head = freeTagsHead.load(std::memory_order_relaxed);
+        uint64_t newHead;
+        do {
+            node->nextFree.store(static_cast<uint32_t>(head), std::memory_order_relaxed);
+            newHead = makeHead(head, node->index + 1);
+        } while (!freeTagsHead.compare_exchange_weak(head, newHead, std::memory_order_release, std::memory_order_relaxed));
+    }
+
+    NodeType *popFreeTag() {
+        auto head = freeTagsHead.load(std::memory_order_acquire);
+        while (static_cast<uint32_t>(head) != 0) {
+            auto node = getNodeFromLink(static_cast<uint32_t>(head));
+            auto newHead = makeHead(head, node->nextFree.load(std::memory_order_relaxed));
+            if (freeTagsHead.compare_exchange_weak(head, newHead, std::memory_order_acquire, std::memory_order_acquire)) {
+                return node;
+            }
+        }
+        return nullptr;
+    }
+
+    void pushPendingTag(NodeType *node) {
+        node->nextPending = pendingTags.load(std::memory_order_relaxed);
+        while (!pendingTags.compare_exchange_weak(node->nextPending, node, std::memory_order_release, std::memory_order_relaxed)) {
+            ;
+        }
+    }
+
+    bool isCompleted(uint32_t taskCount) {
+        auto csr = memoryManager->csr;
+        return csr == nullptr || taskCount <= *csr->getTagAddress();
+    }
+
+    void reclaimCompletedTags() {
+        NodeType *node = pendingTags.exchange(nullptr, std::memory_order_acquire);
+        while (node) {
+            auto next = node->nextPending;
+            if (isCompleted(node->returnTaskCount)) {
+                pushFreeTag(node);
+            } else {
+                pushPendingTag(node);
+            }
+            node = next;
+        }
+    }
+
+    void untrackUsedTag(NodeType *node) {
+        if (trackUsedTags) {
+            NodeType *usedNode = usedTags.removeOne(*node).release();
+            DEBUG_BREAK_IF(usedNode == nullptr);
+            ((void)(usedNode));
+        }
+    }
+
     void populateFreeTags() {
 
         size_t tagSize = sizeof(TagType);
@@ -128,8 +239,13 @@ class TagAllocator : public TagAllocatorBase {
 
         std::unique_lock<std::mutex> lock(allocationsMutex);
 
+        if (static_cast<uint32_t>(freeTagsHead.load(std::memory_order_relaxed)) != 0) {
+            // another thread has just added a pool
+            return;
+        }
+
         size_t tagPoolCount = gfxAllocations.size();
-        if (tagPoolCount < maxTagPoolCount || maxTagPoolCount == 0) {
+        if (tagPoolCount < poolCountLimit && (tagPoolCount + 1) * tagsPerPool < std::numeric_limits<uint32_t>::max()) {
             GraphicsAllocation *graphicsAllocation = memoryManager->allocateGraphicsMemory(allocationSizeRequired);
             gfxAllocations.push_back(graphicsAllocation);
 
@@ -137,18 +253,28 @@ class TagAllocator : public TagAllocatorBase {
             uintptr_t Start = reinterpret_cast<uintptr_t>(graphicsAllocation->getUnderlyingBuffer());
             uintptr_t End = Start + Size;
             size_t nodeCount = Size / tagSize;
+            if (tagPoolCount == 0) {
+                tagsPerPool = nodeCount;
+            }
+            nodeCount = std::min(nodeCount, tagsPerPool);
 
             NodeType *nodesMemory = new NodeType[nodeCount];
 
             for (size_t i = 0; i < nodeCount; ++i) {
                 nodesMemory[i].gfxAllocation = graphicsAllocation;
                 nodesMemory[i].tag = reinterpret_cast<TagType *>(Start);
-                freeTags.pushTailOne(nodesMemory[i]);
+                nodesMemory[i].index = static_cast<uint32_t>(tagPoolCount * tagsPerPool + i);
                 Start += tagSize;
             }
             DEBUG_BREAK_IF(Start > End);
             ((void)(End));
             tagPoolMemory.push_back(nodesMemory);
+            tagPools[tagPoolCount].store(nodesMemory, std::memory_order_release);
+
+            // first tag of the pool ends up at the head of free list
+            for (size_t i = nodeCount; i > 0; --i) {
+                pushFreeTag(&nodesMemory[i - 1]);
+            }
         }
     }
 };
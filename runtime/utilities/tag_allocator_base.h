@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017, Intel Corporation
+ * Copyright (c) 2017 - 2018, Intel Corporation
  *
  * Permission is hereby granted, free of charge, to any person obtaining a
  * copy of this software and associated documentation files (the "Software"),
@@ -26,6 +26,8 @@ namespace OCLRT {
 constexpr size_t UnlimitedProfilingCount = 0;
 constexpr size_t ProfilingTagCount = 512;
 constexpr size_t PrefferedProfilingTagPoolCount = 10;
+// pools are addressed through a fixed table, this caps allocators created with unlimited count
+constexpr size_t MaxUnlimitedTagPoolCount = 4096;
 
 constexpr size_t UnlimitedPerfCounterCount = 0;
 constexpr size_t PerfCounterTagCount = 512;
@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/utilities/worker_pool.h"
+
+#include <algorithm>
+
+namespace OCLRT {
+
+const uint32_t WorkerPool::maxDefaultWorkers;
+
+WorkerPool::WorkerPool(int32_t numWorkers) {
+    if (numWorkers < 0) {
+        auto hardwareThreads = std::max(std::thread::hardware_concurrency(), 1u);
+        this->numWorkers = std::min(hardwareThreads - 1, maxDefaultWorkers);
+    } else {
+        this->numWorkers = static_cast<uint32_t>(numWorkers);
+    }
+}
+
+WorkerPool::~WorkerPool() {
+    shutdown();
+}
+
+void WorkerPool::parallelFor(size_t numTasks, const Task &task) {
+    std::unique_lock<std::mutex> jobLock(jobMtx, std::try_to_lock);
+    if (!jobLock.owns_lock() || numWorkers == 0 || numTasks <= 1) {
+        for (size_t i = 0; i < numTasks; i++) {
+            task(i);
+        }
+        return;
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(mtx);
+        if (workers.empty()) {
+            stopping = false;
+            startWorkers();
+        }
+        // a worker that woke up late for the previous job may still be looking at its state
+        doneCondition.wait(lock, [&] { return busyWorkers == 0; });
+        currentTask = &task;
+        currentTaskCount = numTasks;
+        nextTask.store(0);
+        jobId++;
+    }
+    wakeCondition.notify_all();
+
+    runTasks();
+
+    std::unique_lock<std::mutex> lock(mtx);
+    doneCondition.wait(lock, [&] { return busyWorkers == 0; });
+}
+
+void WorkerPool::shutdown() {
+    std::lock_guard<std::mutex> jobLock(jobMtx);
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        stopping = true;
+    }
+    wakeCondition.notify_all();
+    for (auto &worker : workers) {
+        worker.join();
+    }
+    workers.clear();
+}
+
+void WorkerPool::startWorkers() {
+    workers.reserve(numWorkers);
+    for (uint32_t i = 0; i < numWorkers; i++) {
+        workers.emplace_back(&WorkerPool::workerLoop, this, jobId);
+    }
+}
+
+void WorkerPool::workerLoop(uint64_t lastJobId) {
+    std::unique_lock<std::mutex> lock(mtx);
+    while (true) {
+        wakeCondition.wait(lock, [&] { return stopping || jobId != lastJobId; });
+        if (stopping) {
+            return;
+        }
+        lastJobId = jobId;
+        busyWorkers++;
+        lock.unlock();
+
+        runTasks();
+
+        lock.lock();
+        if (--busyWorkers == 0) {
+            doneCondition.notify_all();
+        }
+    }
+}
+
+void WorkerPool::runTasks() {
+    for (auto i = nextTask.fetch_add(1); i < currentTaskCount; i = nextTask.fetch_add(1)) {
+        (*currentTask)(i);
+    }
+}
+} // namespace OCLRT
@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace OCLRT {
+
+// Fixed set of worker threads shared by CPU side data-parallel work (e.g. host copies).
+// Threads are started on first use and joined by shutdown().
+class WorkerPool {
+  public:
+    typedef std::function<void(size_t taskIndex)> Task;
+
+    static const uint32_t maxDefaultWorkers = 7;
+
+    // numWorkers < 0 selects hardware concurrency - 1, capped at maxDefaultWorkers
+    explicit WorkerPool(int32_t numWorkers);
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool &) = delete;
+    WorkerPool &operator=(const WorkerPool &) = delete;
+
+    // Runs task(0) .. task(numTasks - 1) on the calling thread and the workers, returns when all completed.
+    // When another thread already owns the pool all tasks run on the calling thread.
+    void parallelFor(size_t numTasks, const Task &task);
+
+    uint32_t getNumWorkers() const { return numWorkers; }
+    void shutdown();
+
+  protected:
+    void startWorkers();
+    void workerLoop(uint64_t lastJobId);
+    void runTasks();
+
+    uint32_t numWorkers;
+    std::vector<std::thread> workers;
+    std::mutex jobMtx;
+
+    std::mutex mtx;
+    std::condition_variable wakeCondition;
+    std::condition_variable doneCondition;
+    uint64_t jobId = 0;
+    uint32_t busyWorkers = 0;
+    bool stopping = false;
+
+    // valid only while the caller of parallelFor holds jobMtx
+    const Task *currentTask = nullptr;
+    size_t currentTaskCount = 0;
+    std::atomic<size_t> nextTask{0};
+};
+} // namespace OCLRT
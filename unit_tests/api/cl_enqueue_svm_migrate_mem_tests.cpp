@@ -126,6 +126,34 @@ TEST_F(clEnqueueSVMMigrateMemTests, invalidValue_NonZeroSizeIsNotContainedWithin
     }
 }
 
+TEST_F(clEnqueueSVMMigrateMemTests, invalidValue_NonZeroSizeReachesIntoNeighbouringPooledAllocation) {
+    const DeviceInfo &devInfo = pPlatform->getDevice(0)->getDeviceInfo();
+    if (devInfo.svmCapabilities != 0) {
+        void *ptrSvm = clSVMAlloc(pContext, CL_MEM_READ_WRITE, 256, 4);
+        void *ptrNeighbour = clSVMAlloc(pContext, CL_MEM_READ_WRITE, 256, 4);
+        ASSERT_NE(nullptr, ptrSvm);
+        ASSERT_NE(nullptr, ptrNeighbour);
+        ASSERT_EQ(pContext->getSVMAllocsManager()->getSVMAlloc(ptrSvm), pContext->getSVMAllocsManager()->getSVMAlloc(ptrNeighbour));
+
+        const void *svmPtrs[] = {ptrSvm < ptrNeighbour ? ptrSvm : ptrNeighbour};
+        const size_t sizes[] = {256 + 1};
+        auto retVal = clEnqueueSVMMigrateMem(
+            pCommandQueue, // cl_command_queue command_queue
+            1,             // cl_uint num_svm_pointers
+            svmPtrs,       // const void **svm_pointers
+            sizes,         // const size_t *sizes
+            0,             // const cl_mem_migration_flags flags
+            0,             // cl_uint num_events_in_wait_list
+            nullptr,       // const cl_event *event_wait_list
+            nullptr        // cl_event *event
+            );
+        EXPECT_EQ(CL_INVALID_VALUE, retVal);
+
+        clSVMFree(pContext, ptrNeighbour);
+        clSVMFree(pContext, ptrSvm);
+    }
+}
+
 TEST_F(clEnqueueSVMMigrateMemTests, invalidValue_FlagsAreNeitherZeroNorSupported) {
     const DeviceInfo &devInfo = pPlatform->getDevice(0)->getDeviceInfo();
     if (devInfo.svmCapabilities != 0) {
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017, Intel Corporation
+ * Copyright (c) 2017 - 2018, Intel Corporation
  *
  * Permission is hereby granted, free of charge, to any person obtaining a
  * copy of this software and associated documentation files (the "Software"),
@@ -52,13 +52,13 @@ class AUBCommandStreamFixture : public CommandStreamFixture {
 
         // Write our pseudo-op to the AUB file
         auto aubCsr = reinterpret_cast<AUBCommandStreamReceiverHw<FamilyType> *>(pCommandStreamReceiver);
-        aubCsr->stream->fileHandle.write(reinterpret_cast<char *>(&header), sizeof(header));
+        aubCsr->stream->write(reinterpret_cast<char *>(&header), sizeof(header));
     }
 
     template <typename FamilyType>
     void expectMemory(void *gfxAddress, const void *srcAddress, size_t length) {
         auto aubCsr = reinterpret_cast<AUBCommandStreamReceiverHw<FamilyType> *>(pCommandStreamReceiver);
-        PageWalker walker = [&](uint64_t physAddress, size_t size, size_t offset) {
+        auto walker = [&](uint64_t physAddress, size_t size, size_t offset) {
             if (offset > length)
                 abort();
 
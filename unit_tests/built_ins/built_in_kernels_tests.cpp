@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017, Intel Corporation
+ * Copyright (c) 2017 - 2018, Intel Corporation
  *
  * Permission is hereby granted, free of charge, to any person obtaining a
  * copy of this software and associated documentation files (the "Software"),
@@ -23,6 +23,8 @@
 #include "gtest/gtest.h"
 #include "runtime/builtin_kernels_simulation/opencl_c.h"
 
+#include <atomic>
+
 //#include "unit_tests/test_files/4265157215134882557.cl"
 
 namespace BuiltinKernelsSimulation {
@@ -138,4 +140,92 @@ TEST(BuiltInKernelTests, ReadImage) {
     delete[] ptrDst;
     delete[] ptrZero;
 }
+
+TEST(BuiltInKernelTests, givenMultipleGroupsWhenRunOnHostThreadsThenEachWorkItemGetsOwnIds) {
+    const uint32_t groups = 3;
+    std::vector<uint32_t> globalIds(groups * NUM_OF_THREADS, 0);
+    std::vector<uint32_t> groupIds(groups * NUM_OF_THREADS, 0);
+    std::vector<uint32_t> localIds(groups * NUM_OF_THREADS, 0);
+    std::atomic<uint32_t> numGroupsMismatches(0);
+
+    runOnHostThreads(groups, [&](uint32_t index) {
+        globalIds[index] = get_global_id(0);
+        groupIds[index] = get_group_id(0);
+        localIds[index] = get_local_id(0);
+        if (get_num_groups(0) != groups || get_local_size(0) != NUM_OF_THREADS) {
+            numGroupsMismatches++;
+        }
+    });
+
+    for (uint32_t i = 0; i < groups * NUM_OF_THREADS; i++) {
+        EXPECT_EQ(i, globalIds[i]);
+        EXPECT_EQ(i / NUM_OF_THREADS, groupIds[i]);
+        EXPECT_EQ(i % NUM_OF_THREADS, localIds[i]);
+    }
+    EXPECT_EQ(0u, numGroupsMismatches.load());
+    EXPECT_EQ(1u, get_num_groups(0));
+}
+
+TEST(BuiltInKernelTests, givenMultipleGroupsWhenWorkItemsHitBarrierThenOnlyOwnGroupIsSynchronized) {
+    const uint32_t groups = 2;
+    uint32_t arrived[groups] = {};
+    std::atomic<uint32_t> incompleteGroups(0);
+
+    runOnHostThreads(groups, [&](uint32_t index) {
+        atomic_inc(&arrived[get_group_id(0)]);
+        barrier(CLK_GLOBAL_MEM_FENCE);
+        {
+            std::lock_guard<std::mutex> lock(getAtomicLock(&arrived[get_group_id(0)]));
+            if (arrived[get_group_id(0)] != NUM_OF_THREADS) {
+                incompleteGroups++;
+            }
+        }
+        barrier(CLK_GLOBAL_MEM_FENCE);
+        atomic_dec(&arrived[get_group_id(0)]);
+    });
+
+    EXPECT_EQ(0u, incompleteGroups.load());
+    EXPECT_EQ(0u, arrived[0]);
+    EXPECT_EQ(0u, arrived[1]);
+}
+
+TEST(BuiltInKernelTests, givenMultipleGroupsWhenAtomicsAreUsedThenNoUpdateIsLost) {
+    const uint32_t groups = MAX_NUM_OF_GROUPS;
+    const uint32_t iterations = 16;
+    uint counter = 0;
+    ulong sum = 0;
+
+    runOnHostThreads(groups, [&](uint32_t index) {
+        for (uint32_t i = 0; i < iterations; i++) {
+            atomic_inc(&counter);
+            atomic_add(&sum, index);
+        }
+    });
+
+    uint32_t workItems = groups * NUM_OF_THREADS;
+    EXPECT_EQ(workItems * iterations, counter);
+    EXPECT_EQ(static_cast<ulong>(iterations) * workItems * (workItems - 1) / 2, sum);
+}
+
+TEST(BuiltInKernelTests, givenGroupLocalVariableWhenWrittenByEachGroupThenGroupsSeeOwnValue) {
+    const uint32_t groups = MAX_NUM_OF_GROUPS;
+    GroupLocal<uint> groupValue;
+    GroupLocal<uint[4]> groupArray;
+    std::atomic<uint32_t> mismatches(0);
+
+    runOnHostThreads(groups, [&](uint32_t index) {
+        if (get_local_id(0) == 0) {
+            groupValue = get_group_id(0);
+            uint *array = groupArray;
+            array[3] = get_group_id(0) + 1;
+        }
+        barrier(CLK_LOCAL_MEM_FENCE);
+        uint *array = groupArray;
+        if (groupValue != get_group_id(0) || *&groupValue != get_group_id(0) || array[3] != get_group_id(0) + 1) {
+            mismatches++;
+        }
+    });
+
+    EXPECT_EQ(0u, mismatches.load());
+}
 }
@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "gtest/gtest.h"
+#include "runtime/builtin_kernels_simulation/scheduler_simulation_replay.h"
+#include "runtime/execution_model/device_enqueue.h"
+#include "runtime/helpers/file_io.h"
+
+#include <cstdio>
+#include <memory>
+
+using namespace OCLRT;
+using namespace BuiltinKernelsSimulation;
+
+class SchedulerSimulationRecordTest : public testing::Test {
+  public:
+    void SetUp() override {
+        for (uint32_t i = 0; i < SchedulerSimulationRecord::NumSurfaces; i++) {
+            storage[i].resize(sizeof(IGIL_CommandQueue) + i * 64);
+            for (size_t j = 0; j < storage[i].size(); j++) {
+                storage[i][j] = static_cast<char>(i + j);
+            }
+            allocations[i].reset(new GraphicsAllocation(storage[i].data(), storage[i].size()));
+        }
+    }
+
+    void capture(SchedulerSimulationRecord &record) {
+        record.capture(allocations[SchedulerSimulationRecord::Queue].get(),
+                       allocations[SchedulerSimulationRecord::CommandsStack].get(),
+                       allocations[SchedulerSimulationRecord::EventsPool].get(),
+                       allocations[SchedulerSimulationRecord::SecondaryBatchBuffer].get(),
+                       allocations[SchedulerSimulationRecord::Dsh].get(),
+                       allocations[SchedulerSimulationRecord::ReflectionSurface].get(),
+                       allocations[SchedulerSimulationRecord::QueueStorageBuffer].get(),
+                       allocations[SchedulerSimulationRecord::Ssh].get());
+    }
+
+    std::vector<char> storage[SchedulerSimulationRecord::NumSurfaces];
+    std::unique_ptr<GraphicsAllocation> allocations[SchedulerSimulationRecord::NumSurfaces];
+    const char *fileName = "scheduler_simulation_record.tmp";
+};
+
+TEST_F(SchedulerSimulationRecordTest, givenAllocationsWhenCapturedThenRecordHoldsCopiesOfSurfaces) {
+    SchedulerSimulationRecord record;
+    EXPECT_FALSE(record.isValid());
+
+    capture(record);
+    EXPECT_TRUE(record.isValid());
+
+    for (uint32_t i = 0; i < SchedulerSimulationRecord::NumSurfaces; i++) {
+        EXPECT_EQ(storage[i], record.getSurface(static_cast<SchedulerSimulationRecord::Surface>(i)));
+    }
+
+    storage[SchedulerSimulationRecord::Queue][0]++;
+    EXPECT_NE(storage[SchedulerSimulationRecord::Queue], record.getSurface(SchedulerSimulationRecord::Queue));
+}
+
+TEST_F(SchedulerSimulationRecordTest, givenRecordWhenSavedAndLoadedThenSurfacesAreRestored) {
+    SchedulerSimulationRecord record;
+    capture(record);
+    EXPECT_TRUE(record.saveToFile(fileName));
+
+    SchedulerSimulationRecord loadedRecord;
+    EXPECT_TRUE(loadedRecord.loadFromFile(fileName));
+    EXPECT_TRUE(loadedRecord.isValid());
+
+    for (uint32_t i = 0; i < SchedulerSimulationRecord::NumSurfaces; i++) {
+        auto surface = static_cast<SchedulerSimulationRecord::Surface>(i);
+        EXPECT_EQ(record.getSurface(surface), loadedRecord.getSurface(surface));
+    }
+    std::remove(fileName);
+}
+
+TEST_F(SchedulerSimulationRecordTest, givenTruncatedFileWhenLoadedThenFalseIsReturnedAndRecordIsEmpty) {
+    SchedulerSimulationRecord record;
+    capture(record);
+    EXPECT_TRUE(record.saveToFile(fileName));
+
+    void *data = nullptr;
+    size_t size = loadDataFromFile(fileName, data);
+    ASSERT_LT(16u, size);
+    writeDataToFile(fileName, data, size - 16);
+    deleteDataReadFromFile(data);
+
+    SchedulerSimulationRecord loadedRecord;
+    EXPECT_FALSE(loadedRecord.loadFromFile(fileName));
+    EXPECT_FALSE(loadedRecord.isValid());
+    EXPECT_TRUE(loadedRecord.getSurface(SchedulerSimulationRecord::Queue).empty());
+    std::remove(fileName);
+}
+
+TEST_F(SchedulerSimulationRecordTest, givenMissingFileWhenLoadedThenFalseIsReturned) {
+    SchedulerSimulationRecord record;
+    EXPECT_FALSE(record.loadFromFile("scheduler_simulation_record_that_does_not_exist.tmp"));
+    EXPECT_FALSE(record.isValid());
+}
+
+TEST_F(SchedulerSimulationRecordTest, givenQueueWithNewEnqueuesWhenCapturedThenPendingBlocksAreReported) {
+    auto igilQueue = reinterpret_cast<IGIL_CommandQueue *>(storage[SchedulerSimulationRecord::Queue].data());
+    igilQueue->m_controls.m_PreviousNumberOfQueues = 3;
+    igilQueue->m_controls.m_TotalNumberOfQueues = 10;
+
+    SchedulerSimulationRecord record;
+    EXPECT_EQ(0u, record.getPendingBlocks());
+
+    capture(record);
+    EXPECT_EQ(7u, record.getPendingBlocks());
+}
+
+TEST(SchedulerSimulationStatsTest, givenStatsWhenBlocksPerSecondQueriedThenBlocksAreDividedByTime) {
+    SchedulerSimulationStats stats;
+    EXPECT_EQ(0.0, stats.getBlocksPerSecond());
+
+    stats.blocksScheduled = 100;
+    stats.seconds = 0.5;
+    EXPECT_EQ(200.0, stats.getBlocksPerSecond());
+}
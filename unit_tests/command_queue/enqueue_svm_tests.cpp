@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017, Intel Corporation
+ * Copyright (c) 2017 - 2018, Intel Corporation
  *
  * Permission is hereby granted, free of charge, to any person obtaining a
  * copy of this software and associated documentation files (the "Software"),
@@ -27,6 +27,7 @@
 #include "unit_tests/fixtures/buffer_fixture.h"
 #include "unit_tests/fixtures/built_in_fixture.h"
 #include "unit_tests/helpers/debug_manager_state_restore.h"
+#include "runtime/helpers/ptr_math.h"
 #include "runtime/memory_manager/svm_memory_manager.h"
 #include "unit_tests/mocks/mock_context.h"
 #include "unit_tests/mocks/mock_kernel.h"
@@ -372,6 +373,24 @@ TEST_F(EnqueueSvmTest, enqueueSVMMemcpyCoherentBlockedOnEvent_Success) {
     context->getSVMAllocsManager()->freeSVMAlloc(pSrcSVM);
 }
 
+TEST_F(EnqueueSvmTest, enqueueSVMMemcpy_InvalidValueSizeReachesIntoNeighbouringPooledAllocation) {
+    void *pNeighbourSVM = context->getSVMAllocsManager()->createSVMAlloc(256);
+    ASSERT_EQ(context->getSVMAllocsManager()->getSVMAlloc(ptrSVM), context->getSVMAllocsManager()->getSVMAlloc(pNeighbourSVM));
+    void *pLowerSVM = ptrSVM < pNeighbourSVM ? ptrSVM : pNeighbourSVM;
+    void *pUpperSVM = ptrSVM < pNeighbourSVM ? pNeighbourSVM : ptrSVM;
+    retVal = this->pCmdQ->enqueueSVMMemcpy(
+        false,     // cl_bool  blocking_copy
+        pUpperSVM, // void *dst_ptr
+        pLowerSVM, // const void *src_ptr
+        512,       // size_t size
+        0,         // cl_uint num_events_in_wait_list
+        nullptr,   // cl_evebt *event_wait_list
+        nullptr    // cL_event *event
+        );
+    EXPECT_EQ(CL_INVALID_VALUE, retVal);
+    context->getSVMAllocsManager()->freeSVMAlloc(pNeighbourSVM);
+}
+
 TEST_F(EnqueueSvmTest, enqueueSVMMemFill_InvalidValue) {
     void *svmPtr = nullptr;
     const float pattern[1] = {1.2345f};
@@ -403,6 +422,24 @@ TEST_F(EnqueueSvmTest, enqueueSVMMemFill_Success) {
     EXPECT_EQ(CL_SUCCESS, retVal);
 }
 
+TEST_F(EnqueueSvmTest, enqueueSVMMemFill_InvalidValueSizeReachesIntoNeighbouringPooledAllocation) {
+    void *pNeighbourSVM = context->getSVMAllocsManager()->createSVMAlloc(256);
+    ASSERT_EQ(context->getSVMAllocsManager()->getSVMAlloc(ptrSVM), context->getSVMAllocsManager()->getSVMAlloc(pNeighbourSVM));
+    const float pattern[1] = {1.2345f};
+    const size_t patternSize = sizeof(pattern);
+    retVal = this->pCmdQ->enqueueSVMMemFill(
+        ptrSVM < pNeighbourSVM ? ptrSVM : pNeighbourSVM, // void *svm_ptr
+        pattern,                                         // const void *pattern
+        patternSize,                                     // size_t pattern_size
+        512,                                             // size_t size
+        0,                                               // cl_uint num_events_in_wait_list
+        nullptr,                                         // cl_evebt *event_wait_list
+        nullptr                                          // cL_event *event
+        );
+    EXPECT_EQ(CL_INVALID_VALUE, retVal);
+    context->getSVMAllocsManager()->freeSVMAlloc(pNeighbourSVM);
+}
+
 TEST_F(EnqueueSvmTest, enqueueSVMMemFillBlockedOnEvent_Success) {
     const float pattern[1] = {1.2345f};
     const size_t patternSize = sizeof(pattern);
@@ -521,7 +558,8 @@ TEST_F(EnqueueSvmTest, concurentMapAccess) {
             svmPtrs[i] = context->getSVMAllocsManager()->createSVMAlloc(1);
             auto ga = context->getSVMAllocsManager()->getSVMAlloc(svmPtrs[i]);
             EXPECT_NE(nullptr, ga);
-            EXPECT_EQ(ga->getUnderlyingBuffer(), svmPtrs[i]);
+            EXPECT_LE(ga->getUnderlyingBuffer(), svmPtrs[i]);
+            EXPECT_GT(ptrOffset(ga->getUnderlyingBuffer(), ga->getUnderlyingBufferSize()), svmPtrs[i]);
         }
     };
 
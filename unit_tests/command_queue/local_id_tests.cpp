@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017, Intel Corporation
+ * Copyright (c) 2017 - 2018, Intel Corporation
  *
  * Permission is hereby granted, free of charge, to any person obtaining a
  * copy of this software and associated documentation files (the "Software"),
@@ -23,12 +23,19 @@
 #include "runtime/command_queue/local_id_gen.h"
 #include "runtime/helpers/aligned_memory.h"
 #include "runtime/helpers/ptr_math.h"
+#include "runtime/utilities/cpu_info.h"
 #include "gtest/gtest.h"
 #include <algorithm>
 #include <cstdint>
+#include <cstring>
 
 using namespace OCLRT;
 
+namespace OCLRT {
+struct uint16x8_t;
+struct uint16x32_t;
+} // namespace OCLRT
+
 TEST(LocalID, GRFsPerThread_SIMD8) {
     uint32_t simd = 8;
     EXPECT_EQ(1u, getGRFsPerThread(simd));
@@ -255,3 +262,72 @@ INSTANTIATE_TEST_CASE_P(SingleTest, LocalIDFixture,
                             ::testing::Values(5),   //LWSX
                             ::testing::Values(6),   //LWSY
                             ::testing::Values(7))); //LWSZ
+
+TEST(LocalIDCache, givenRepeatedShapeWhenLookedUpThenStoredIdsAreCopied) {
+    LocalIDCache cache;
+    const uint32_t simd = 16;
+    const size_t lwsX = 7, lwsY = 3, lwsZ = 2;
+    auto threadsPerWorkGroup = getThreadsPerWG(simd, lwsX * lwsY * lwsZ);
+    auto size = threadsPerWorkGroup * getPerThreadSizeLocalIDs(simd);
+
+    auto expected = reinterpret_cast<uint16_t *>(alignedMalloc(size, 32));
+    auto copied = reinterpret_cast<uint16_t *>(alignedMalloc(size, 32));
+    memset(copied, 0xff, size);
+
+    EXPECT_FALSE(cache.copyIfCached(copied, simd, lwsX, lwsY, threadsPerWorkGroup, size));
+    EXPECT_EQ(1u, cache.peekMisses());
+
+    generateLocalIDsUncached(expected, simd, lwsX, lwsY, threadsPerWorkGroup);
+    cache.store(expected, simd, lwsX, lwsY, threadsPerWorkGroup, size);
+
+    EXPECT_TRUE(cache.copyIfCached(copied, simd, lwsX, lwsY, threadsPerWorkGroup, size));
+    EXPECT_EQ(1u, cache.peekHits());
+    EXPECT_EQ(0, memcmp(expected, copied, size));
+
+    EXPECT_FALSE(cache.copyIfCached(copied, 8, lwsX, lwsY, threadsPerWorkGroup, size));
+
+    alignedFree(expected);
+    alignedFree(copied);
+}
+
+TEST(LocalIDCache, givenMoreShapesThanEntriesWhenStoredThenLeastRecentlyUsedIsEvicted) {
+    LocalIDCache cache;
+    uint8_t data[sizeof(GRF)] = {};
+
+    for (size_t lwsX = 1; lwsX <= LocalIDCache::maxEntries; lwsX++) {
+        cache.store(data, 8, lwsX, 1, 1, sizeof(data));
+    }
+    EXPECT_EQ(LocalIDCache::maxEntries, cache.peekNumEntries());
+
+    // touch first entry so the second one becomes least recently used
+    EXPECT_TRUE(cache.copyIfCached(data, 8, 1, 1, 1, sizeof(data)));
+    cache.store(data, 8, LocalIDCache::maxEntries + 1, 1, 1, sizeof(data));
+
+    EXPECT_EQ(LocalIDCache::maxEntries, cache.peekNumEntries());
+    EXPECT_TRUE(cache.copyIfCached(data, 8, 1, 1, 1, sizeof(data)));
+    EXPECT_FALSE(cache.copyIfCached(data, 8, 2, 1, 1, sizeof(data)));
+    EXPECT_TRUE(cache.copyIfCached(data, 8, LocalIDCache::maxEntries + 1, 1, 1, sizeof(data)));
+
+    cache.clear();
+    EXPECT_EQ(0u, cache.peekNumEntries());
+}
+
+TEST(LocalID, givenCpuWithAvx512BwWhenGeneratingSimd32IdsThenResultMatchesSse4Path) {
+    if (!CpuInfo::getInstance().isFeatureSupported(CpuInfo::featureAvX512Bw)) {
+        return;
+    }
+    const size_t shapes[][3] = {{1, 1, 1}, {5, 6, 7}, {32, 1, 1}, {16, 16, 1}, {33, 7, 1}, {256, 1, 1}};
+    for (auto &shape : shapes) {
+        auto threadsPerWorkGroup = getThreadsPerWG(32, shape[0] * shape[1] * shape[2]);
+        auto size = threadsPerWorkGroup * getPerThreadSizeLocalIDs(32);
+        auto expected = alignedMalloc(size, 32);
+        auto generated = alignedMalloc(size, 32);
+
+        generateLocalIDsSimd<uint16x8_t, 32>(expected, shape[0], shape[1], threadsPerWorkGroup);
+        generateLocalIDsSimd<uint16x32_t, 32>(generated, shape[0], shape[1], threadsPerWorkGroup);
+        EXPECT_EQ(0, memcmp(expected, generated, size)) << shape[0] << " " << shape[1] << " " << shape[2];
+
+        alignedFree(expected);
+        alignedFree(generated);
+    }
+}
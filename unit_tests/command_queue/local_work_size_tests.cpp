@@ -1,5 +1,5 @@
 /*
-* Copyright (c) 2017, Intel Corporation
+* Copyright (c) 2017 - 2018, Intel Corporation
 *
 * Permission is hereby granted, free of charge, to any person obtaining a
 * copy of this software and associated documentation files (the "Software"),
@@ -665,3 +665,84 @@ TEST(localWorkSizeTest, givenMaxWorkgroupSizeEqualToSimdSizeWhenLwsIsCalculatedT
     EXPECT_EQ(workGroupSize[1], 1u);
     EXPECT_EQ(workGroupSize[2], 1u);
 }
+
+TEST(localWorkSizeTest, givenSameDispatchWhenLwsIsComputedAgainThenItIsTakenFromKernelCache) {
+    MockDevice device(*platformDevices[0]);
+    MockKernelWithInternals kernel(device);
+    DispatchInfo dispatchInfo(kernel.mockKernel, 2, {1024, 768, 1}, {0, 0, 0}, {0, 0, 0});
+
+    auto &cache = kernel.mockKernel->getLocalWorkSizeCache();
+    auto lws = computeWorkgroupSize(dispatchInfo);
+    EXPECT_EQ(0u, cache.peekStats().hits);
+    EXPECT_EQ(1u, cache.peekStats().misses);
+
+    auto cachedLws = computeWorkgroupSize(dispatchInfo);
+    EXPECT_EQ(lws, cachedLws);
+    EXPECT_EQ(1u, cache.peekStats().hits);
+    EXPECT_EQ(1u, cache.peekNumEntries());
+}
+
+TEST(localWorkSizeTest, givenChangedSlmSizeWhenLwsIsComputedThenCachedLwsIsNotReused) {
+    MockDevice device(*platformDevices[0]);
+    MockKernelWithInternals kernel(device);
+    DispatchInfo dispatchInfo(kernel.mockKernel, 2, {1024, 768, 1}, {0, 0, 0}, {0, 0, 0});
+
+    auto &cache = kernel.mockKernel->getLocalWorkSizeCache();
+    computeWorkgroupSize(dispatchInfo);
+    kernel.mockKernel->slmTotalSize = 4096;
+    computeWorkgroupSize(dispatchInfo);
+
+    EXPECT_EQ(0u, cache.peekStats().hits);
+    EXPECT_EQ(2u, cache.peekStats().misses);
+    EXPECT_EQ(2u, cache.peekNumEntries());
+}
+
+TEST(localWorkSizeTest, givenLwsCacheDisabledWhenLwsIsComputedThenCacheIsNotUsed) {
+    DebugManagerStateRestore dbgRestore;
+    DebugManager.flags.EnableLocalWorkSizeCache.set(0);
+    MockDevice device(*platformDevices[0]);
+    MockKernelWithInternals kernel(device);
+    DispatchInfo dispatchInfo(kernel.mockKernel, 1, {4096, 1, 1}, {0, 0, 0}, {0, 0, 0});
+
+    computeWorkgroupSize(dispatchInfo);
+    computeWorkgroupSize(dispatchInfo);
+
+    auto &cache = kernel.mockKernel->getLocalWorkSizeCache();
+    EXPECT_EQ(0u, cache.peekStats().hits);
+    EXPECT_EQ(0u, cache.peekStats().misses);
+    EXPECT_EQ(0u, cache.peekNumEntries());
+}
+
+TEST(LocalWorkSizeCacheTest, givenMoreDispatchesThanEntriesWhenStoredThenLeastRecentlyUsedIsEvicted) {
+    const size_t maxEntries = LocalWorkSizeCache::maxEntries;
+    LocalWorkSizeCache cache;
+    LocalWorkSizeCacheKey key = {};
+    key.workDim = 1;
+    key.simdSize = 32;
+    size_t lws[3] = {};
+
+    for (size_t i = 1; i <= maxEntries; i++) {
+        key.gws[0] = i * 32;
+        size_t storedLws[3] = {i, 1, 1};
+        cache.store(key, storedLws);
+    }
+    EXPECT_EQ(maxEntries, cache.peekNumEntries());
+
+    key.gws[0] = 32;
+    EXPECT_TRUE(cache.find(key, lws));
+    EXPECT_EQ(1u, lws[0]);
+
+    key.gws[0] = (maxEntries + 1) * 32;
+    size_t newLws[3] = {maxEntries + 1, 1, 1};
+    cache.store(key, newLws);
+
+    EXPECT_EQ(maxEntries, cache.peekNumEntries());
+    EXPECT_EQ(1u, cache.peekStats().evictions);
+    key.gws[0] = 64;
+    EXPECT_FALSE(cache.find(key, lws));
+    key.gws[0] = 32;
+    EXPECT_TRUE(cache.find(key, lws));
+    key.gws[0] = (maxEntries + 1) * 32;
+    EXPECT_TRUE(cache.find(key, lws));
+    EXPECT_EQ(maxEntries + 1, lws[0]);
+}
@@ -22,6 +22,7 @@
 
 #include "runtime/command_stream/aub_command_stream_receiver_hw.h"
 #include "runtime/helpers/hw_info.h"
+#include "runtime/memory_manager/memory_constants.h"
 #include "runtime/memory_manager/memory_manager.h"
 #include "runtime/os_interface/debug_settings_manager.h"
 #include "test.h"
@@ -61,6 +62,59 @@ struct MockAubFileStream : public AUBCommandStreamReceiver::AubFileStream {
     MOCK_METHOD1(addComment, bool(const char *message));
 };
 
+struct MemoryWriteHeaderRecordingAubStream : public AubMemDump::AubStream {
+    void open(const char *filePath) override {}
+    void close() override {}
+    bool init(uint32_t stepping, uint32_t device) override { return true; }
+    void writeMemory(uint64_t physAddress, const void *memory, size_t size, uint32_t addressSpace, uint32_t hint) override {
+        writeMemoryWriteHeader(physAddress, size, addressSpace, hint);
+    }
+    void writeMemoryWriteHeader(uint64_t physAddress, size_t size, uint32_t addressSpace, uint32_t hint) override {
+        auto dwordCount = (sizeof(AubMemDump::CmdServicesMemTraceMemoryWrite) - sizeof(AubMemDump::CmdServicesMemTraceMemoryWrite::data) + size) / sizeof(uint32_t);
+        maxDwordCount = std::max(maxDwordCount, dwordCount);
+        writingPTEs = (addressSpace == AubMemDump::AddressSpaceValues::TracePpgttEntry);
+        if (writingPTEs) {
+            ptesReserved += size / sizeof(uint64_t);
+        }
+    }
+    void writePTE(uint64_t physAddress, uint64_t entry) override {
+        if (!writingPTEs) {
+            return;
+        }
+        if (firstPTE == 0) {
+            firstPTE = entry;
+        }
+        lastPTE = entry;
+    }
+    void writeGTT(uint32_t offset, uint64_t entry) override {}
+    void writeMMIO(uint32_t offset, uint32_t value) override {}
+    void registerPoll(uint32_t registerOffset, uint32_t mask, uint32_t value, bool pollNotEqual, uint32_t timeoutAction) override {}
+
+    bool writingPTEs = false;
+    size_t maxDwordCount = 0;
+    size_t ptesReserved = 0;
+    uint64_t firstPTE = 0;
+    uint64_t lastPTE = 0;
+};
+
+HWTEST_F(AubCommandStreamReceiverTests, givenContiguousRunLargerThanMemoryWriteLimitWhenReservedThenPpgttIsWrittenInChunksWithinDwordLimit) {
+    typedef typename AUBFamilyMapper<FamilyType>::AUB AUB;
+    MemoryWriteHeaderRecordingAubStream stream;
+
+    const size_t numPages = 40000;
+    const size_t size = numPages * MemoryConstants::pageSize;
+    uintptr_t gpuAddress = 0x100000;
+    uint64_t physAddress = 0x200000;
+    uint8_t dummyMemory = 0;
+
+    AUB::reserveAddressGGTTAndWriteMmeory(stream, gpuAddress, &dummyMemory, physAddress, size, 0);
+
+    EXPECT_LE(stream.maxDwordCount, AubMemDump::g_dwordCountMax);
+    EXPECT_EQ(numPages, stream.ptesReserved);
+    EXPECT_EQ(physAddress | 7, stream.firstPTE);
+    EXPECT_EQ((physAddress + size - MemoryConstants::pageSize) | 7, stream.lastPTE);
+}
+
 TEST_F(AubCommandStreamReceiverTests, givenAubCommandStreamReceiverWhenItIsCreatedWithWrongGfxCoreFamilyThenNullPointerShouldBeReturned) {
     HardwareInfo hwInfo = *platformDevices[0];
     GFXCORE_FAMILY family = hwInfo.pPlatform->eRenderCoreFamily;
@@ -373,6 +427,122 @@ HWTEST_F(AubCommandStreamReceiverTests, givenAubCommandStreamReceiverWhenGraphic
     memoryManager->freeGraphicsMemory(gfxAllocation);
 }
 
+HWTEST_F(AubCommandStreamReceiverTests, givenUnchangedAllocationWhenWriteMemoryIsCalledAgainThenPagesAreNotDumpedAgain) {
+    DebugManagerStateRestore stateRestore;
+    DebugManager.flags.EnableAUBDirtyPageTracking.set(-1);
+    std::unique_ptr<MemoryManager> memoryManager(nullptr);
+    std::unique_ptr<AUBCommandStreamReceiverHw<FamilyType>> aubCsr(new AUBCommandStreamReceiverHw<FamilyType>(*platformDevices[0], true));
+    memoryManager.reset(aubCsr->createMemoryManager(false));
+
+    auto gfxAllocation = memoryManager->allocateGraphicsMemory(2 * MemoryConstants::pageSize, MemoryConstants::pageSize, false, false);
+    gfxAllocation->setAllocationType(GraphicsAllocation::ALLOCATION_TYPE_LINEAR_STREAM);
+    memset(gfxAllocation->getUnderlyingBuffer(), 0xA5, gfxAllocation->getUnderlyingBufferSize());
+
+    EXPECT_TRUE(aubCsr->writeMemory(*gfxAllocation));
+    EXPECT_EQ(2u, aubCsr->dumpStatistics.pagesWritten);
+    EXPECT_EQ(0u, aubCsr->dumpStatistics.pagesSkipped);
+
+    EXPECT_TRUE(aubCsr->writeMemory(*gfxAllocation));
+    EXPECT_EQ(2u, aubCsr->dumpStatistics.pagesWritten);
+    EXPECT_EQ(2u, aubCsr->dumpStatistics.pagesSkipped);
+    EXPECT_EQ(2 * MemoryConstants::pageSize, aubCsr->dumpStatistics.bytesSkipped);
+
+    memoryManager->freeGraphicsMemory(gfxAllocation);
+}
+
+HWTEST_F(AubCommandStreamReceiverTests, givenAllocationWithOneModifiedPageWhenWriteMemoryIsCalledAgainThenOnlyModifiedPageIsDumped) {
+    DebugManagerStateRestore stateRestore;
+    DebugManager.flags.EnableAUBDirtyPageTracking.set(-1);
+    std::unique_ptr<MemoryManager> memoryManager(nullptr);
+    std::unique_ptr<AUBCommandStreamReceiverHw<FamilyType>> aubCsr(new AUBCommandStreamReceiverHw<FamilyType>(*platformDevices[0], true));
+    memoryManager.reset(aubCsr->createMemoryManager(false));
+
+    auto gfxAllocation = memoryManager->allocateGraphicsMemory(2 * MemoryConstants::pageSize, MemoryConstants::pageSize, false, false);
+    gfxAllocation->setAllocationType(GraphicsAllocation::ALLOCATION_TYPE_LINEAR_STREAM);
+    auto data = static_cast<uint8_t *>(gfxAllocation->getUnderlyingBuffer());
+    memset(data, 0, gfxAllocation->getUnderlyingBufferSize());
+
+    EXPECT_TRUE(aubCsr->writeMemory(*gfxAllocation));
+    EXPECT_EQ(2u, aubCsr->dumpStatistics.pagesWritten);
+
+    data[MemoryConstants::pageSize + 1] = 1;
+    EXPECT_TRUE(aubCsr->writeMemory(*gfxAllocation));
+    EXPECT_EQ(3u, aubCsr->dumpStatistics.pagesWritten);
+    EXPECT_EQ(1u, aubCsr->dumpStatistics.pagesSkipped);
+
+    memoryManager->freeGraphicsMemory(gfxAllocation);
+}
+
+HWTEST_F(AubCommandStreamReceiverTests, givenAllocationWrittenByGpuWhenWriteMemoryIsCalledAgainWithUnchangedContentThenPagesAreDumpedAgain) {
+    DebugManagerStateRestore stateRestore;
+    DebugManager.flags.EnableAUBDirtyPageTracking.set(-1);
+    std::unique_ptr<MemoryManager> memoryManager(nullptr);
+    std::unique_ptr<AUBCommandStreamReceiverHw<FamilyType>> aubCsr(new AUBCommandStreamReceiverHw<FamilyType>(*platformDevices[0], true));
+    memoryManager.reset(aubCsr->createMemoryManager(false));
+
+    auto gfxAllocation = memoryManager->allocateGraphicsMemory(2 * MemoryConstants::pageSize, MemoryConstants::pageSize, false, false);
+    memset(gfxAllocation->getUnderlyingBuffer(), 0, gfxAllocation->getUnderlyingBufferSize());
+
+    EXPECT_TRUE(aubCsr->writeMemory(*gfxAllocation));
+    EXPECT_TRUE(aubCsr->writeMemory(*gfxAllocation));
+    EXPECT_EQ(4u, aubCsr->dumpStatistics.pagesWritten);
+    EXPECT_EQ(0u, aubCsr->dumpStatistics.pagesSkipped);
+    EXPECT_EQ(0u, aubCsr->dumpedPages.size());
+
+    memoryManager->freeGraphicsMemory(gfxAllocation);
+}
+
+HWTEST_F(AubCommandStreamReceiverTests, givenFreedAllocationWhenNewAllocationWithSameContentIsWrittenAtSameGpuAddressThenPagesAreDumpedAgain) {
+    DebugManagerStateRestore stateRestore;
+    DebugManager.flags.EnableAUBDirtyPageTracking.set(-1);
+    std::unique_ptr<MemoryManager> memoryManager(nullptr);
+    std::unique_ptr<AUBCommandStreamReceiverHw<FamilyType>> aubCsr(new AUBCommandStreamReceiverHw<FamilyType>(*platformDevices[0], true));
+    memoryManager.reset(aubCsr->createMemoryManager(false));
+    memoryManager->csr = aubCsr.get();
+
+    auto hostPtr = alignedMalloc(2 * MemoryConstants::pageSize, MemoryConstants::pageSize);
+    memset(hostPtr, 0, 2 * MemoryConstants::pageSize);
+
+    auto gfxAllocation = memoryManager->allocateGraphicsMemory(2 * MemoryConstants::pageSize, hostPtr);
+    gfxAllocation->setAllocationType(GraphicsAllocation::ALLOCATION_TYPE_LINEAR_STREAM);
+    auto gpuAddress = gfxAllocation->getGpuAddress();
+    EXPECT_TRUE(aubCsr->writeMemory(*gfxAllocation));
+    EXPECT_EQ(2u, aubCsr->dumpStatistics.pagesWritten);
+    EXPECT_EQ(2u, aubCsr->dumpedPages.size());
+
+    memoryManager->freeGraphicsMemory(gfxAllocation);
+    EXPECT_EQ(0u, aubCsr->dumpedPages.size());
+
+    gfxAllocation = memoryManager->allocateGraphicsMemory(2 * MemoryConstants::pageSize, hostPtr);
+    gfxAllocation->setAllocationType(GraphicsAllocation::ALLOCATION_TYPE_LINEAR_STREAM);
+    EXPECT_EQ(gpuAddress, gfxAllocation->getGpuAddress());
+    EXPECT_TRUE(aubCsr->writeMemory(*gfxAllocation));
+    EXPECT_EQ(4u, aubCsr->dumpStatistics.pagesWritten);
+    EXPECT_EQ(0u, aubCsr->dumpStatistics.pagesSkipped);
+
+    memoryManager->freeGraphicsMemory(gfxAllocation);
+    memoryManager->csr = nullptr;
+    alignedFree(hostPtr);
+}
+
+HWTEST_F(AubCommandStreamReceiverTests, givenDirtyPageTrackingDisabledWhenWriteMemoryIsCalledAgainThenAllPagesAreDumped) {
+    DebugManagerStateRestore stateRestore;
+    DebugManager.flags.EnableAUBDirtyPageTracking.set(0);
+    std::unique_ptr<MemoryManager> memoryManager(nullptr);
+    std::unique_ptr<AUBCommandStreamReceiverHw<FamilyType>> aubCsr(new AUBCommandStreamReceiverHw<FamilyType>(*platformDevices[0], true));
+    memoryManager.reset(aubCsr->createMemoryManager(false));
+
+    auto gfxAllocation = memoryManager->allocateGraphicsMemory(2 * MemoryConstants::pageSize, MemoryConstants::pageSize, false, false);
+    gfxAllocation->setAllocationType(GraphicsAllocation::ALLOCATION_TYPE_LINEAR_STREAM);
+
+    EXPECT_TRUE(aubCsr->writeMemory(*gfxAllocation));
+    EXPECT_TRUE(aubCsr->writeMemory(*gfxAllocation));
+    EXPECT_EQ(4u, aubCsr->dumpStatistics.pagesWritten);
+    EXPECT_EQ(0u, aubCsr->dumpStatistics.pagesSkipped);
+
+    memoryManager->freeGraphicsMemory(gfxAllocation);
+}
+
 HWTEST_F(AubCommandStreamReceiverTests, givenAubCommandStreamReceiverWhenGraphicsAllocationSizeIsZeroThenWriteMemoryIsNotAllowed) {
     std::unique_ptr<AUBCommandStreamReceiverHw<FamilyType>> aubCsr(new AUBCommandStreamReceiverHw<FamilyType>(*platformDevices[0], true));
     GraphicsAllocation gfxAllocation((void *)0x1234, 0);
@@ -0,0 +1,199 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/aub_mem_dump/aub_compression.h"
+#include "runtime/aub_mem_dump/aub_file_writer.h"
+#include "runtime/aub_mem_dump/aub_mem_dump.h"
+#include "runtime/os_interface/debug_settings_manager.h"
+#include "unit_tests/helpers/debug_manager_state_restore.h"
+#include "gtest/gtest.h"
+
+#include <cstdio>
+#include <random>
+#include <sstream>
+#include <vector>
+
+using namespace AubMemDump;
+
+namespace {
+std::vector<char> getAubLikeData(size_t size) {
+    // mix of zero pages, repeated headers and noise - roughly what memory writes look like
+    std::vector<char> data(size, 0);
+    std::mt19937 generator(size);
+    for (size_t i = 0; i < size; i++) {
+        switch ((i / 4096) % 3) {
+        case 0:
+            break;
+        case 1:
+            data[i] = static_cast<char>(i % 64);
+            break;
+        default:
+            data[i] = static_cast<char>(generator());
+        }
+    }
+    return data;
+}
+
+std::string readFile(const char *fileName) {
+    std::ifstream file(fileName, std::ios::binary);
+    std::stringstream content;
+    content << file.rdbuf();
+    return content.str();
+}
+} // namespace
+
+TEST(AubLz, givenDataWhenCompressedAndDecompressedThenOriginalDataIsRestored) {
+    for (size_t size : {0u, 1u, 11u, 13u, 4096u, 100000u}) {
+        auto data = getAubLikeData(size);
+        std::vector<char> compressed(Lz::getMaxCompressedSize(size));
+        auto compressedSize = Lz::compress(data.data(), size, compressed.data(), compressed.size());
+        ASSERT_NE(0u, compressedSize) << "size " << size;
+
+        std::vector<char> decompressed(size);
+        EXPECT_TRUE(Lz::decompress(compressed.data(), compressedSize, decompressed.data(), size)) << "size " << size;
+        EXPECT_EQ(data, decompressed) << "size " << size;
+    }
+}
+
+TEST(AubLz, givenRepetitiveDataWhenCompressedThenOutputIsSmaller) {
+    std::vector<char> data(64 * 1024, 0x5A);
+    std::vector<char> compressed(Lz::getMaxCompressedSize(data.size()));
+    auto compressedSize = Lz::compress(data.data(), data.size(), compressed.data(), compressed.size());
+    EXPECT_NE(0u, compressedSize);
+    EXPECT_LT(compressedSize, data.size() / 100);
+}
+
+TEST(AubLz, givenRandomDataWhenCompressedThenOutputFitsMaxCompressedSize) {
+    std::vector<char> data(64 * 1024);
+    std::mt19937 generator(7);
+    for (auto &byte : data) {
+        byte = static_cast<char>(generator());
+    }
+    std::vector<char> compressed(Lz::getMaxCompressedSize(data.size()));
+    EXPECT_NE(0u, Lz::compress(data.data(), data.size(), compressed.data(), compressed.size()));
+}
+
+TEST(AubLz, givenTooSmallOutputWhenCompressingThenZeroIsReturned) {
+    auto data = getAubLikeData(3 * 4096);
+    std::vector<char> compressed(16);
+    EXPECT_EQ(0u, Lz::compress(data.data(), data.size(), compressed.data(), compressed.size()));
+}
+
+TEST(AubLz, givenCorruptedInputWhenDecompressingThenFailureIsReturned) {
+    auto data = getAubLikeData(3 * 4096);
+    std::vector<char> compressed(Lz::getMaxCompressedSize(data.size()));
+    auto compressedSize = Lz::compress(data.data(), data.size(), compressed.data(), compressed.size());
+    std::vector<char> decompressed(data.size());
+
+    EXPECT_FALSE(Lz::decompress(compressed.data(), compressedSize - 1, decompressed.data(), decompressed.size()));
+    EXPECT_FALSE(Lz::decompress(compressed.data(), compressedSize, decompressed.data(), decompressed.size() - 1));
+}
+
+TEST(AubFileWriter, givenWritesLargerThanBufferWhenWriterIsDestroyedThenFileContainsAllDataInOrder) {
+    const char *fileName = "aub_file_writer_test.aub";
+    auto data = getAubLikeData(10 * 4096 + 7);
+    {
+        std::ofstream file(fileName, std::ios::binary);
+        AubFileWriter writer(file, false, 4096, 2);
+        size_t offset = 0;
+        size_t chunk = 1;
+        while (offset < data.size()) {
+            auto size = std::min(chunk, data.size() - offset);
+            writer.write(data.data() + offset, size);
+            offset += size;
+            chunk = chunk * 3 + 1;
+        }
+        EXPECT_EQ(data.size(), writer.getBytesSubmitted());
+    }
+    EXPECT_EQ(std::string(data.begin(), data.end()), readFile(fileName));
+    std::remove(fileName);
+}
+
+TEST(AubFileWriter, givenFlushWhenCalledThenAllSubmittedDataIsInFile) {
+    const char *fileName = "aub_file_writer_flush_test.aub";
+    std::ofstream file(fileName, std::ios::binary);
+    AubFileWriter writer(file, false, 4096, 2);
+
+    const char record[] = "record";
+    writer.write(record, sizeof(record));
+    writer.flush();
+
+    EXPECT_EQ(static_cast<std::streamoff>(sizeof(record)), static_cast<std::streamoff>(file.tellp()));
+    EXPECT_EQ(std::string(record, sizeof(record)), readFile(fileName));
+    std::remove(fileName);
+}
+
+TEST(AubFileWriter, givenCompressionWhenFileIsDecompressedThenOriginalStreamIsRestored) {
+    const char *fileName = "aub_file_writer_compressed_test.aub.lz";
+    auto data = getAubLikeData(20 * 4096 + 3);
+    {
+        std::ofstream file(fileName, std::ios::binary);
+        AubFileWriter writer(file, true, 16 * 1024, 3);
+        writer.write(data.data(), data.size());
+    }
+
+    auto compressedFile = readFile(fileName);
+    EXPECT_LT(compressedFile.size(), data.size());
+
+    std::istringstream in(compressedFile);
+    std::ostringstream out;
+    EXPECT_TRUE(decompressAubStream(in, out));
+    EXPECT_EQ(std::string(data.begin(), data.end()), out.str());
+    std::remove(fileName);
+}
+
+TEST(AubFileWriter, givenStreamWithoutMagicWhenDecompressedThenFailureIsReturned) {
+    std::istringstream in("not a compressed aub");
+    std::ostringstream out;
+    EXPECT_FALSE(decompressAubStream(in, out));
+}
+
+TEST(AubFileStreamWriter, givenBufferedWriterEnabledWhenFileIsOpenedThenRecordsGoThroughWriter) {
+    DebugManagerStateRestore stateRestore;
+    OCLRT::DebugManager.flags.AUBDumpBufferedWriter.set(1);
+    const char *fileName = "aub_file_stream_buffered_test.aub";
+
+    AubFileStream stream;
+    stream.open(fileName);
+    ASSERT_TRUE(stream.fileHandle.is_open());
+    EXPECT_NE(nullptr, stream.writer.get());
+
+    stream.writeMMIO(0x2000, 1);
+    stream.flush();
+    EXPECT_LT(0, static_cast<int>(stream.fileHandle.tellp()));
+    stream.close();
+    EXPECT_EQ(nullptr, stream.writer.get());
+    std::remove(fileName);
+}
+
+TEST(AubFileStreamWriter, givenBufferedWriterDisabledWhenFileIsOpenedThenRecordsAreWrittenDirectly) {
+    DebugManagerStateRestore stateRestore;
+    OCLRT::DebugManager.flags.AUBDumpBufferedWriter.set(0);
+    const char *fileName = "aub_file_stream_direct_test.aub";
+
+    AubFileStream stream;
+    stream.open(fileName);
+    ASSERT_TRUE(stream.fileHandle.is_open());
+    EXPECT_EQ(nullptr, stream.writer.get());
+    stream.close();
+    std::remove(fileName);
+}
@@ -2675,6 +2675,125 @@ HWTEST_F(CommandStreamReceiverFlushTaskTests, givenCsrInBatchingModeWhenFlushTas
     EXPECT_EQ(1u, mockCsr->peekLatestFlushedTaskCount());
 }
 
+HWTEST_F(CommandStreamReceiverFlushTaskTests, givenCsrInBatchingModeWithCounterWhenCounterLimitIsReachedThenBatchedSubmissionsAreFlushed) {
+    DebugManagerStateRestore dbgRestore;
+    DebugManager.flags.CsrBatchedDispatchCounterLimit.set(3);
+    CommandQueueHw<FamilyType> commandQueue(nullptr, pDevice, 0);
+    auto &commandStream = commandQueue.getCS(4096u);
+
+    auto mockCsr = new MockCsrHw2<FamilyType>(*platformDevices[0]);
+    pDevice->resetCommandStreamReceiver(mockCsr);
+
+    mockCsr->overrideDispatchPolicy(CommandStreamReceiver::DispatchMode::BatchedDispatchWithCounter);
+
+    auto mockedSubmissionsAggregator = new mockSubmissionsAggregator();
+    mockCsr->overrideSubmissionAggregator(mockedSubmissionsAggregator);
+
+    DispatchFlags dispatchFlags;
+    dispatchFlags.guardCommandBufferWithPipeControl = true;
+
+    for (int i = 0; i < 2; i++) {
+        mockCsr->flushTask(commandStream, 0, dsh, ih, ioh, ssh, taskLevel, dispatchFlags);
+    }
+    EXPECT_EQ(0, mockCsr->flushCalledCount);
+    EXPECT_FALSE(mockedSubmissionsAggregator->peekCmdBufferList().peekIsEmpty());
+
+    mockCsr->flushTask(commandStream, 0, dsh, ih, ioh, ssh, taskLevel, dispatchFlags);
+    EXPECT_EQ(1, mockCsr->flushCalledCount);
+    EXPECT_TRUE(mockedSubmissionsAggregator->peekCmdBufferList().peekIsEmpty());
+    EXPECT_EQ(3u, mockCsr->peekLatestFlushedTaskCount());
+
+    mockCsr->flushTask(commandStream, 0, dsh, ih, ioh, ssh, taskLevel, dispatchFlags);
+    EXPECT_EQ(1, mockCsr->flushCalledCount);
+}
+
+HWTEST_F(CommandStreamReceiverFlushTaskTests, givenCsrInBatchingModeWhenBatchedSubmissionsAreFlushedThenDispatchStatsAreUpdated) {
+    CommandQueueHw<FamilyType> commandQueue(nullptr, pDevice, 0);
+    auto &commandStream = commandQueue.getCS(4096u);
+
+    auto mockCsr = new MockCsrHw2<FamilyType>(*platformDevices[0]);
+    pDevice->resetCommandStreamReceiver(mockCsr);
+
+    mockCsr->overrideDispatchPolicy(CommandStreamReceiver::DispatchMode::BatchedDispatch);
+
+    DispatchFlags dispatchFlags;
+    dispatchFlags.guardCommandBufferWithPipeControl = true;
+
+    mockCsr->flushTask(commandStream, 0, dsh, ih, ioh, ssh, taskLevel, dispatchFlags);
+    mockCsr->flushTask(commandStream, 0, dsh, ih, ioh, ssh, taskLevel, dispatchFlags);
+
+    EXPECT_EQ(0u, mockCsr->peekDispatchStats().submissions);
+
+    mockCsr->flushBatchedSubmissions();
+
+    auto &stats = mockCsr->peekDispatchStats();
+    EXPECT_EQ(1u, stats.submissions);
+    EXPECT_EQ(2u, stats.commandBuffersSubmitted);
+    EXPECT_EQ(2u, stats.maxBatchSize);
+    EXPECT_LE(stats.maxAddedLatencyUs, stats.totalAddedLatencyUs);
+}
+
+HWTEST_F(CommandStreamReceiverFlushTaskTests, givenCsrInAdaptiveModeWhenBlockingCommandIsSentThenItIsFlushedImmediately) {
+    CommandQueueHw<FamilyType> commandQueue(nullptr, pDevice, 0);
+    auto &commandStream = commandQueue.getCS(4096u);
+
+    auto mockCsr = new MockCsrHw2<FamilyType>(*platformDevices[0]);
+    pDevice->resetCommandStreamReceiver(mockCsr);
+
+    mockCsr->overrideDispatchPolicy(CommandStreamReceiver::DispatchMode::AdaptiveDispatch);
+
+    DispatchFlags dispatchFlags;
+    dispatchFlags.guardCommandBufferWithPipeControl = true;
+    dispatchFlags.blocking = true;
+
+    mockCsr->flushTask(commandStream, 0, dsh, ih, ioh, ssh, taskLevel, dispatchFlags);
+
+    EXPECT_EQ(1, mockCsr->flushCalledCount);
+    EXPECT_EQ(1u, mockCsr->peekLatestFlushedTaskCount());
+}
+
+HWTEST_F(CommandStreamReceiverFlushTaskTests, givenCsrInAdaptiveModeWhenGpuIsIdleThenRecordedCommandBufferIsSubmittedByAsyncThread) {
+    CommandQueueHw<FamilyType> commandQueue(nullptr, pDevice, 0);
+    auto &commandStream = commandQueue.getCS(4096u);
+
+    auto mockCsr = new MockCsrHw2<FamilyType>(*platformDevices[0]);
+    pDevice->resetCommandStreamReceiver(mockCsr);
+
+    mockCsr->overrideDispatchPolicy(CommandStreamReceiver::DispatchMode::AdaptiveDispatch);
+
+    DispatchFlags dispatchFlags;
+    dispatchFlags.guardCommandBufferWithPipeControl = true;
+
+    mockCsr->flushTask(commandStream, 0, dsh, ih, ioh, ssh, taskLevel, dispatchFlags);
+
+    auto timeout = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (mockCsr->peekLatestFlushedTaskCount() < 1u && std::chrono::steady_clock::now() < timeout) {
+        std::this_thread::yield();
+    }
+    mockCsr->closeAdaptiveDispatcher();
+
+    EXPECT_EQ(1, mockCsr->flushCalledCount);
+    EXPECT_EQ(1u, mockCsr->peekLatestFlushedTaskCount());
+    EXPECT_EQ(1u, mockCsr->peekDispatchStats().submissions);
+}
+
+HWTEST_F(CommandStreamReceiverFlushTaskTests, givenAdaptiveDispatcherWaitingForCoalescingWhenCsrIsDeletedWithoutExplicitCloseThenDestructorJoinsThread) {
+    DebugManagerStateRestore dbgRestore;
+    DebugManager.flags.CsrAdaptiveDispatchQueueDepth.set(1000);
+    DebugManager.flags.CsrAdaptiveDispatchMaxDelayUs.set(60000000);
+
+    std::unique_ptr<MockCsrHw2<FamilyType>> mockCsr(new MockCsrHw2<FamilyType>(*platformDevices[0]));
+    mockCsr->overrideDispatchPolicy(CommandStreamReceiver::DispatchMode::AdaptiveDispatch);
+
+    // thread is started and keeps coalescing, GPU is never idle without a tag address
+    mockCsr->notifyCommandBufferRecorded();
+    EXPECT_EQ(0u, mockCsr->peekDispatchStats().submissions);
+    EXPECT_EQ(0, mockCsr->flushCalledCount);
+
+    // CommandStreamReceiverHw destructor joins the thread before any CSR member is destroyed
+    mockCsr.reset();
+}
+
 HWTEST_F(CommandStreamReceiverFlushTaskTests, givenCsrInDefaultModeWhenFlushTaskIsCalledThenFlushedTaskCountIsModifed) {
     CommandQueueHw<FamilyType> commandQueue(nullptr, pDevice, 0);
     auto &commandStream = commandQueue.getCS(4096u);
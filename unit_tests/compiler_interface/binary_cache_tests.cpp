@@ -26,12 +26,17 @@
 #include "runtime/compiler_interface/compiler_interface.h"
 #include <runtime/helpers/string.h>
 #include <runtime/helpers/aligned_memory.h>
+#include <runtime/helpers/file_io.h>
+#include <runtime/os_interface/os_inc_base.h>
+#include <runtime/utilities/directory.h>
 #include <unit_tests/global_environment.h>
 #include <unit_tests/fixtures/device_fixture.h>
 #include <unit_tests/fixtures/memory_management_fixture.h>
+#include <unit_tests/helpers/debug_manager_state_restore.h>
 #include <unit_tests/mocks/mock_context.h>
 #include <unit_tests/mocks/mock_program.h>
 
+#include <algorithm>
 #include <memory>
 #include <array>
 #include <list>
@@ -46,6 +51,17 @@ class BinaryCacheFixture : public MemoryManagementFixture
 {
   public:
     void SetUp() override {
+        // tests write real cache entries, remember what was there to restore it afterwards
+        cacheFilesBefore = Directory::getFiles(cacheLocation);
+        indexPath = cacheLocation + Os::fileSeparator + BinaryCache::indexFileName;
+        void *indexData = nullptr;
+        auto indexSize = loadDataFromFile(indexPath.c_str(), indexData);
+        if (indexData) {
+            indexContentBefore.assign(static_cast<char *>(indexData), indexSize);
+            deleteDataReadFromFile(indexData);
+            std::remove(indexPath.c_str());
+        }
+
         MemoryManagementFixture::SetUp();
         cache = new BinaryCache;
     }
@@ -53,8 +69,22 @@ class BinaryCacheFixture : public MemoryManagementFixture
     void TearDown() override {
         delete cache;
         MemoryManagementFixture::TearDown();
+
+        for (auto &file : Directory::getFiles(cacheLocation)) {
+            if (std::find(cacheFilesBefore.begin(), cacheFilesBefore.end(), file) == cacheFilesBefore.end()) {
+                std::remove(file.c_str());
+            }
+        }
+        std::remove(indexPath.c_str());
+        if (!indexContentBefore.empty()) {
+            writeDataToFile(indexPath.c_str(), indexContentBefore.c_str(), indexContentBefore.size());
+        }
     }
     BinaryCache *cache;
+    std::string cacheLocation = CL_CACHE_LOCATION;
+    std::string indexPath;
+    std::string indexContentBefore;
+    std::vector<std::string> cacheFilesBefore;
 };
 
 class TestedCompilerInterface : public CompilerInterface {
@@ -348,6 +378,131 @@ TEST_F(BinaryCacheTests, cacheThenLoad) {
     EXPECT_TRUE(ret);
 }
 
+class BinaryCacheWithIndex : public BinaryCache {
+  public:
+    using BinaryCache::BinaryCache;
+    using BinaryCache::getFilePath;
+    using BinaryCache::index;
+    using BinaryCache::numIndexRecords;
+    using BinaryCache::readIndexFile;
+};
+
+TEST_F(BinaryCacheTests, givenCachedBinaryWhenLoadedThenProgramReceivesExactContent) {
+    MockProgram program;
+    BinaryCacheWithIndex indexedCache(CL_CACHE_LOCATION, 0u);
+    static const char *hash = "CONTENT_HASH";
+    char data[48];
+    for (size_t i = 0; i < sizeof(data); i++)
+        data[i] = static_cast<char>(i * 3);
+
+    EXPECT_TRUE(indexedCache.cacheBinary(hash, data, sizeof(data)));
+    EXPECT_TRUE(indexedCache.loadCachedBinary(hash, program));
+
+    size_t binarySize = 0;
+    auto binary = program.getGenBinary(binarySize);
+    ASSERT_EQ(sizeof(data), binarySize);
+    EXPECT_EQ(0, memcmp(data, binary, sizeof(data)));
+}
+
+TEST_F(BinaryCacheTests, givenCachedBinaryThenEntryIsRecordedInIndexFile) {
+    BinaryCacheWithIndex indexedCache(CL_CACHE_LOCATION, 0u);
+    static const char *hash = "INDEXED_HASH";
+    char data[16] = {};
+
+    EXPECT_TRUE(indexedCache.cacheBinary(hash, data, sizeof(data)));
+
+    auto diskIndex = indexedCache.readIndexFile();
+    auto entry = diskIndex.find(hash);
+    ASSERT_NE(diskIndex.end(), entry);
+    EXPECT_EQ(sizeof(data), entry->second.size);
+    EXPECT_EQ(indexedCache.index[hash].lastAccess, entry->second.lastAccess);
+}
+
+TEST_F(BinaryCacheTests, givenCachedBinariesWhenCachingAgainThenRecordsAreAppendedUntilIndexIsCompacted) {
+    BinaryCacheWithIndex indexedCache(CL_CACHE_LOCATION, 0u);
+    char data[16] = {};
+
+    EXPECT_TRUE(indexedCache.cacheBinary("APPEND_HASH_A", data, sizeof(data)));
+    EXPECT_TRUE(indexedCache.cacheBinary("APPEND_HASH_B", data, sizeof(data)));
+    EXPECT_TRUE(indexedCache.cacheBinary("APPEND_HASH_A", data, sizeof(data)));
+    EXPECT_TRUE(indexedCache.cacheBinary("APPEND_HASH_A", data, sizeof(data)));
+
+    size_t numRecords = 0;
+    auto diskIndex = indexedCache.readIndexFile(&numRecords);
+    EXPECT_EQ(4u, numRecords);
+    EXPECT_EQ(4u, indexedCache.numIndexRecords);
+    ASSERT_EQ(2u, diskIndex.size());
+    EXPECT_EQ(indexedCache.index["APPEND_HASH_A"].lastAccess, diskIndex["APPEND_HASH_A"].lastAccess);
+
+    // stale records would outnumber the entries twice, index gets rewritten
+    EXPECT_TRUE(indexedCache.cacheBinary("APPEND_HASH_B", data, sizeof(data)));
+    diskIndex = indexedCache.readIndexFile(&numRecords);
+    EXPECT_EQ(2u, numRecords);
+    EXPECT_EQ(2u, indexedCache.numIndexRecords);
+    EXPECT_EQ(indexedCache.index["APPEND_HASH_B"].lastAccess, diskIndex["APPEND_HASH_B"].lastAccess);
+}
+
+TEST_F(BinaryCacheTests, givenEntryEvictedWhenCachingThenIndexFileDoesNotContainIt) {
+    char data[32] = {};
+    BinaryCacheWithIndex indexedCache(CL_CACHE_LOCATION, 2 * sizeof(data));
+
+    EXPECT_TRUE(indexedCache.cacheBinary("EVICTED_HASH_A", data, sizeof(data)));
+    EXPECT_TRUE(indexedCache.cacheBinary("EVICTED_HASH_B", data, sizeof(data)));
+    EXPECT_TRUE(indexedCache.cacheBinary("EVICTED_HASH_C", data, sizeof(data)));
+
+    auto diskIndex = indexedCache.readIndexFile();
+    EXPECT_EQ(0u, diskIndex.count("EVICTED_HASH_A"));
+    EXPECT_EQ(1u, diskIndex.count("EVICTED_HASH_B"));
+    EXPECT_EQ(1u, diskIndex.count("EVICTED_HASH_C"));
+}
+
+TEST_F(BinaryCacheTests, givenSizeLimitExceededWhenCachingThenLeastRecentlyUsedEntryIsEvicted) {
+    MockProgram program;
+    char data[32] = {};
+    BinaryCacheWithIndex indexedCache(CL_CACHE_LOCATION, 2 * sizeof(data));
+
+    EXPECT_TRUE(indexedCache.cacheBinary("LRU_HASH_A", data, sizeof(data)));
+    EXPECT_TRUE(indexedCache.cacheBinary("LRU_HASH_B", data, sizeof(data)));
+    // touch A so that B becomes least recently used
+    EXPECT_TRUE(indexedCache.loadCachedBinary("LRU_HASH_A", program));
+    EXPECT_TRUE(indexedCache.cacheBinary("LRU_HASH_C", data, sizeof(data)));
+
+    EXPECT_FALSE(fileExists(indexedCache.getFilePath("LRU_HASH_B")));
+    EXPECT_EQ(0u, indexedCache.index.count("LRU_HASH_B"));
+    EXPECT_TRUE(indexedCache.loadCachedBinary("LRU_HASH_A", program));
+    EXPECT_TRUE(indexedCache.loadCachedBinary("LRU_HASH_C", program));
+    EXPECT_FALSE(indexedCache.loadCachedBinary("LRU_HASH_B", program));
+}
+
+TEST_F(BinaryCacheTests, givenBinaryBiggerThanSizeLimitWhenCachingThenItIsRejected) {
+    char data[32] = {};
+    BinaryCacheWithIndex indexedCache(CL_CACHE_LOCATION, sizeof(data) - 1);
+
+    EXPECT_FALSE(indexedCache.cacheBinary("TOO_BIG_HASH", data, sizeof(data)));
+    EXPECT_FALSE(fileExists(indexedCache.getFilePath("TOO_BIG_HASH")));
+}
+
+TEST_F(BinaryCacheTests, givenMissingEntryWhenLoadingThenItIsDroppedFromIndex) {
+    MockProgram program;
+    char data[16] = {};
+    BinaryCacheWithIndex indexedCache(CL_CACHE_LOCATION, 0u);
+
+    EXPECT_TRUE(indexedCache.cacheBinary("REMOVED_HASH", data, sizeof(data)));
+    std::remove(indexedCache.getFilePath("REMOVED_HASH").c_str());
+
+    EXPECT_FALSE(indexedCache.loadCachedBinary("REMOVED_HASH", program));
+    EXPECT_EQ(0u, indexedCache.index.count("REMOVED_HASH"));
+}
+
+TEST(BinaryCacheSizeLimit, givenDebugOverrideThenDefaultSizeLimitIsOverridden) {
+    DebugManagerStateRestore restorer;
+    DebugManager.flags.OverrideBinaryCacheSizeLimitMB.set(3);
+    EXPECT_EQ(3 * MemoryConstants::megaByte, BinaryCache::getDefaultSizeLimit());
+
+    DebugManager.flags.OverrideBinaryCacheSizeLimitMB.set(0);
+    EXPECT_EQ(0u, BinaryCache::getDefaultSizeLimit());
+}
+
 TEST_F(CompilerInterfaceCachedTests, canInjectCache) {
     std::unique_ptr<BinaryCache> cache(new BinaryCache());
     auto res1 = pCompilerInterface->replaceBinaryCache(cache.get());
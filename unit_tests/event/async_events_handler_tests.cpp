@@ -24,8 +24,12 @@
 #include "runtime/event/event.h"
 #include "runtime/event/user_event.h"
 #include "runtime/platform/platform.h"
+#include "runtime/command_stream/command_stream_receiver.h"
+#include "unit_tests/fixtures/device_fixture.h"
 #include "unit_tests/helpers/debug_manager_state_restore.h"
 #include "unit_tests/mocks/mock_async_event_handler.h"
+#include "unit_tests/mocks/mock_command_queue.h"
+#include "unit_tests/mocks/mock_context.h"
 #include "test.h"
 #include "gmock/gmock.h"
 
@@ -380,3 +384,113 @@ TEST_F(AsyncEventsHandlerTests, asyncProcessCallsProcessListBeforeReturning) {
 
     event->release();
 }
+
+TEST_F(AsyncEventsHandlerTests, givenSubmittedEventWithCallbackWhenTaskCountIsNotReachedThenEventWaitsInCsrHeapUntilTagPassesIt) {
+    std::unique_ptr<Device> device(DeviceHelper<>::create());
+    MockContext context;
+    MockCommandQueue cmdQ(&context, device.get(), nullptr);
+    auto tagAddress = const_cast<uint32_t *>(device->getCommandStreamReceiver().getTagAddress());
+    *tagAddress = 0;
+
+    auto event = new Event(&cmdQ, CL_COMMAND_NDRANGE_KERNEL, 0, 5);
+    event->addCallback(&this->callbackFcn, CL_COMPLETE, &counter);
+    handler->registerEvent(event);
+
+    auto sleepCandidate = handler->process();
+    EXPECT_EQ(event, sleepCandidate);
+    EXPECT_TRUE(handler->peekIsListEmpty());
+    EXPECT_EQ(1u, handler->eventsInCsrHeaps);
+    EXPECT_EQ(0, counter);
+
+    *tagAddress = 5;
+    sleepCandidate = handler->process();
+    EXPECT_EQ(nullptr, sleepCandidate);
+    EXPECT_EQ(0u, handler->eventsInCsrHeaps);
+    EXPECT_EQ(1, counter);
+    EXPECT_EQ(1u, handler->peekCallbackLatencyHistogram().samples);
+
+    event->release();
+}
+
+TEST_F(AsyncEventsHandlerTests, givenEventsInCsrHeapWhenTagPassesSomeOfThemThenOnlyThoseEventsAreCompleted) {
+    std::unique_ptr<Device> device(DeviceHelper<>::create());
+    MockContext context;
+    MockCommandQueue cmdQ(&context, device.get(), nullptr);
+    auto tagAddress = const_cast<uint32_t *>(device->getCommandStreamReceiver().getTagAddress());
+    *tagAddress = 0;
+
+    int counters[3] = {};
+    Event *events[3];
+    uint32_t taskCounts[3] = {7, 3, 5};
+    for (int i = 0; i < 3; i++) {
+        events[i] = new Event(&cmdQ, CL_COMMAND_NDRANGE_KERNEL, 0, taskCounts[i]);
+        events[i]->addCallback(&this->callbackFcn, CL_COMPLETE, &counters[i]);
+        handler->registerEvent(events[i]);
+    }
+
+    EXPECT_EQ(events[1], handler->process());
+    EXPECT_EQ(3u, handler->eventsInCsrHeaps);
+
+    *tagAddress = 5;
+    EXPECT_EQ(events[0], handler->process());
+    EXPECT_EQ(1u, handler->eventsInCsrHeaps);
+    EXPECT_EQ(0, counters[0]);
+    EXPECT_EQ(1, counters[1]);
+    EXPECT_EQ(1, counters[2]);
+
+    *tagAddress = 7;
+    EXPECT_EQ(nullptr, handler->process());
+    EXPECT_EQ(0u, handler->eventsInCsrHeaps);
+    EXPECT_EQ(1, counters[0]);
+
+    for (auto event : events) {
+        event->release();
+    }
+}
+
+TEST_F(AsyncEventsHandlerTests, givenCsrWhoseEventsCompletedWhenCsrIsDestroyedThenFurtherProcessingDoesNotAccessIt) {
+    {
+        std::unique_ptr<Device> device(DeviceHelper<>::create());
+        MockContext context;
+        MockCommandQueue cmdQ(&context, device.get(), nullptr);
+        auto tagAddress = const_cast<uint32_t *>(device->getCommandStreamReceiver().getTagAddress());
+        *tagAddress = 0;
+
+        auto event = new Event(&cmdQ, CL_COMMAND_NDRANGE_KERNEL, 0, 2);
+        event->addCallback(&this->callbackFcn, CL_COMPLETE, &counter);
+        handler->registerEvent(event);
+
+        handler->process();
+        EXPECT_EQ(1u, handler->csrHeaps.size());
+
+        *tagAddress = 2;
+        EXPECT_EQ(nullptr, handler->process());
+        EXPECT_EQ(1, counter);
+        EXPECT_TRUE(handler->csrHeaps.empty());
+
+        event->release();
+    }
+
+    event1->setTaskStamp(0, 0);
+    handler->registerEvent(event1);
+    EXPECT_EQ(nullptr, handler->process());
+    EXPECT_TRUE(handler->csrHeaps.empty());
+    EXPECT_TRUE(handler->peekIsListEmpty());
+}
+
+TEST(CallbackLatencyHistogram, givenLatenciesWhenRecordedThenTheyAreCountedInPowerOfTwoBuckets) {
+    CallbackLatencyHistogram histogram;
+    histogram.record(std::chrono::microseconds(0));
+    histogram.record(std::chrono::microseconds(1));
+    histogram.record(std::chrono::microseconds(3));
+    histogram.record(std::chrono::microseconds(1000));
+    histogram.record(std::chrono::microseconds(1ll << 40));
+
+    EXPECT_EQ(5u, histogram.samples);
+    EXPECT_EQ(1u, histogram.buckets[0]);
+    EXPECT_EQ(1u, histogram.buckets[1]);
+    EXPECT_EQ(1u, histogram.buckets[2]);
+    EXPECT_EQ(1u, histogram.buckets[10]);
+    EXPECT_EQ(1u, histogram.buckets[CallbackLatencyHistogram::numBuckets - 1]);
+    EXPECT_EQ(std::chrono::microseconds(1ll << 40), histogram.maxLatency);
+}
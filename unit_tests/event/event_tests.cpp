@@ -235,6 +235,58 @@ TEST(Event, waitForEventsWithNotReadyEventDoesNotFlushQueue) {
     EXPECT_EQ(0u, cmdQ1->flushCounter);
 }
 
+class MockCommandQueueWithWaitCheck : public MockCommandQueue {
+  public:
+    MockCommandQueueWithWaitCheck(Context &context, Device *device) : MockCommandQueue(&context, device, nullptr) {
+    }
+    void waitUntilComplete(uint32_t taskCountToWait, FlushStamp flushStampToWait, bool useQuickKmdSleep) override {
+        waitCounter++;
+        waitedTaskCount = taskCountToWait;
+        MockCommandQueue::waitUntilComplete(taskCountToWait, flushStampToWait, useQuickKmdSleep);
+    }
+    uint32_t waitCounter = 0;
+    uint32_t waitedTaskCount = 0;
+};
+
+TEST(Event, givenEventsFromQueuesSharingCsrWhenWaitingForEventsThenCsrIsWaitedOnceForHighestTaskCount) {
+    std::unique_ptr<Device> device(DeviceHelper<>::create());
+    MockContext context;
+
+    std::unique_ptr<MockCommandQueueWithWaitCheck> cmdQ1(new MockCommandQueueWithWaitCheck(context, device.get()));
+    std::unique_ptr<MockCommandQueueWithWaitCheck> cmdQ2(new MockCommandQueueWithWaitCheck(context, device.get()));
+    std::unique_ptr<Event> event1(new Event(cmdQ1.get(), CL_COMMAND_NDRANGE_KERNEL, 4, 10));
+    std::unique_ptr<Event> event2(new Event(cmdQ2.get(), CL_COMMAND_NDRANGE_KERNEL, 5, 20));
+    std::unique_ptr<Event> event3(new Event(cmdQ1.get(), CL_COMMAND_NDRANGE_KERNEL, 6, 15));
+
+    cl_event eventWaitlist[] = {event1.get(), event2.get(), event3.get()};
+
+    auto retVal = Event::waitForEvents(3, eventWaitlist);
+    EXPECT_EQ(CL_SUCCESS, retVal);
+
+    EXPECT_EQ(0u, cmdQ1->waitCounter);
+    EXPECT_EQ(1u, cmdQ2->waitCounter);
+    EXPECT_EQ(20u, cmdQ2->waitedTaskCount);
+    EXPECT_EQ(CL_COMPLETE, event1->peekExecutionStatus());
+    EXPECT_EQ(CL_COMPLETE, event2->peekExecutionStatus());
+    EXPECT_EQ(CL_COMPLETE, event3->peekExecutionStatus());
+}
+
+TEST(Event, givenFailedEventInWaitListWhenWaitingForEventsThenErrorIsReturnedWithoutWaitingOnCsr) {
+    std::unique_ptr<Device> device(DeviceHelper<>::create());
+    MockContext context;
+
+    std::unique_ptr<MockCommandQueueWithWaitCheck> cmdQ(new MockCommandQueueWithWaitCheck(context, device.get()));
+    std::unique_ptr<Event> event1(new Event(cmdQ.get(), CL_COMMAND_NDRANGE_KERNEL, 4, 10));
+    std::unique_ptr<Event> event2(new Event(cmdQ.get(), CL_COMMAND_NDRANGE_KERNEL, 5, 20));
+    event2->setStatus(-1);
+
+    cl_event eventWaitlist[] = {event1.get(), event2.get()};
+
+    auto retVal = Event::waitForEvents(2, eventWaitlist);
+    EXPECT_EQ(CL_EXEC_STATUS_ERROR_FOR_EVENTS_IN_WAIT_LIST, retVal);
+    EXPECT_EQ(0u, cmdQ->waitCounter);
+}
+
 TEST_F(EventTest, GetEventInfo_CL_EVENT_COMMAND_EXECUTION_STATUS_sizeReturned) {
     Event event(pCmdQ, CL_COMMAND_NDRANGE_KERNEL, 1, 5);
     cl_int eventStatus = -1;
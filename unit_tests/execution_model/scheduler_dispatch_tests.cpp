@@ -33,8 +33,14 @@
 #include "unit_tests/mocks/mock_command_queue.h"
 #include "unit_tests/mocks/mock_context.h"
 #include "unit_tests/mocks/mock_device_queue.h"
+// Keep this include after execution_model_fixture.h otherwise there is high chance of conflict with macros
+#include "runtime/builtin_kernels_simulation/scheduler_simulation_replay.h"
+
+#include <algorithm>
+#include <cstdio>
 
 using namespace OCLRT;
+using namespace BuiltinKernelsSimulation;
 
 class ExecutionModelSchedulerFixture : public ExecutionModelSchedulerTest,
                                        public testing::Test {
@@ -259,3 +265,99 @@ HWTEST_F(ExecutionModelSchedulerFixture, ForceDispatchSchedulerEnqueuesScheduler
         delete mockCmdQ;
     }
 }
+
+HWTEST_F(ExecutionModelSchedulerFixture, givenRecordWithPendingMarkerWhenReplayedOnOneAndAllHwGroupsThenSchedulerIsPutInSlbAfterMarker) {
+    using GPGPU_WALKER = typename FamilyType::GPGPU_WALKER;
+
+    if (pDevice->getSupportedClVersion() >= 20) {
+        cl_queue_properties properties[3] = {0};
+        MockDeviceQueueHw<FamilyType> mockDevQueue(context, pDevice, properties[0]);
+        mockDevQueue.resetDeviceQueue();
+        parentKernel->createReflectionSurface();
+        auto &ssh = pCmdQ->getIndirectHeap(IndirectHeap::SURFACE_STATE, MemoryConstants::pageSize);
+
+        // Marker needs no DSH patching, so the scheduler pass can be replayed on any surfaces
+        auto igilQueue = mockDevQueue.getIgilQueue();
+        auto marker = reinterpret_cast<IGIL_CommandHeader *>(ptrOffset(igilQueue, igilQueue->m_head));
+        memset(marker, 0, sizeof(IGIL_CommandHeader));
+        marker->m_commandSize = sizeof(IGIL_CommandHeader);
+        marker->m_kernelId = IGIL_KERNEL_ID_ENQUEUE_MARKER;
+        marker->m_event = IGIL_EVENT_INVALID_HANDLE;
+        igilQueue->m_head += marker->m_commandSize;
+        igilQueue->m_controls.m_TotalNumberOfQueues = 1;
+
+        SchedulerSimulationRecord record;
+        record.capture(mockDevQueue.getQueueBuffer(),
+                       mockDevQueue.getStackBuffer(),
+                       mockDevQueue.getEventPoolBuffer(),
+                       mockDevQueue.getSlbBuffer(),
+                       mockDevQueue.getDshBuffer(),
+                       parentKernel->getKernelReflectionSurface(),
+                       mockDevQueue.getQueueStorageBuffer(),
+                       ssh.getGraphicsAllocation());
+        ASSERT_TRUE(record.isValid());
+        EXPECT_EQ(1u, record.getPendingBlocks());
+
+        size_t slbEnqueueSize = mockDevQueue.getMinimumSlbSize() + mockDevQueue.getWaCommandsSize();
+        SchedulerSimulationReplay<FamilyType> replay(record);
+
+        for (uint32_t groups : {1u, static_cast<uint32_t>(PARALLEL_SCHEDULER_HW_GROUPS)}) {
+            auto stats = replay.replay(2, groups);
+            EXPECT_EQ(2u, stats.schedulerRuns);
+            EXPECT_EQ(2u, stats.blocksScheduled);
+            EXPECT_LT(0.0, stats.seconds);
+            EXPECT_LT(0.0, stats.getBlocksPerSecond());
+
+            auto replayedQueue = reinterpret_cast<IGIL_CommandQueue *>(replay.getAllocation(SchedulerSimulationRecord::Queue)->getUnderlyingBuffer());
+            EXPECT_EQ(1u, replayedQueue->m_controls.m_PreviousNumberOfQueues);
+            EXPECT_EQ(0u, replayedQueue->m_controls.m_EnqueueMarkerScheduled);
+            EXPECT_EQ(0u, replayedQueue->m_controls.m_LastScheduleEventNumber);
+            EXPECT_EQ(1u, replayedQueue->m_controls.m_CurrentIDToffset);
+            EXPECT_EQ(replayedQueue->m_head, replayedQueue->m_controls.m_PreviousHead);
+
+            // Scheduler scheduled itself into first SLB enqueue space instead of returning to host
+            EXPECT_EQ(static_cast<uint32_t>(slbEnqueueSize), replayedQueue->m_controls.m_SecondLevelBatchOffset);
+            EXPECT_EQ(-1, replayedQueue->m_controls.m_SLBENDoffsetInBytes);
+
+            LinearStream slb(replay.getAllocation(SchedulerSimulationRecord::SecondaryBatchBuffer)->getUnderlyingBuffer(), slbEnqueueSize);
+            slb.getSpace(slbEnqueueSize);
+            HardwareParse hwParser;
+            hwParser.parseCommands<FamilyType>(slb, 0);
+
+            auto itorWalker = find<GPGPU_WALKER *>(hwParser.cmdList.begin(), hwParser.cmdList.end());
+            ASSERT_NE(hwParser.cmdList.end(), itorWalker);
+            auto *walker = (GPGPU_WALKER *)*itorWalker;
+            EXPECT_EQ(groups, walker->getThreadGroupIdXDimension());
+        }
+    }
+}
+
+typedef ::testing::Test SchedulerSimulationReplayFileTest;
+
+HWTEST_F(SchedulerSimulationReplayFileTest, givenReplayFileWhenReplayedThenSchedulerStatsAreReported) {
+    auto fileName = DebugManager.flags.SchedulerSimulationReplayFile.get();
+    if (fileName == "unk") {
+        return;
+    }
+
+    SchedulerSimulationRecord record;
+    ASSERT_TRUE(record.loadFromFile(fileName.c_str()));
+    ASSERT_TRUE(record.isValid());
+
+    auto iterations = static_cast<uint32_t>(std::max(1, DebugManager.flags.SchedulerSimulationReplayIterations.get()));
+    auto groups = static_cast<uint32_t>(std::max(1, std::min(DebugManager.flags.SchedulerSimulationHwGroups.get(), PARALLEL_SCHEDULER_HW_GROUPS)));
+
+    SchedulerSimulationReplay<FamilyType> replay(record);
+    auto stats = replay.replay(iterations, groups);
+    EXPECT_EQ(iterations, stats.schedulerRuns);
+
+    RecordProperty("pendingBlocks", static_cast<int>(record.getPendingBlocks()));
+    RecordProperty("hwGroups", static_cast<int>(groups));
+    RecordProperty("schedulerRuns", static_cast<int>(stats.schedulerRuns));
+    RecordProperty("blocksScheduled", static_cast<int>(stats.blocksScheduled));
+    RecordProperty("blocksPerSecond", static_cast<int>(stats.getBlocksPerSecond()));
+    printf("%s: %u pending blocks, %u HW groups, %llu scheduler runs, %llu blocks scheduled in %f s, %f blocks per second\n",
+           fileName.c_str(), static_cast<unsigned int>(record.getPendingBlocks()), groups,
+           static_cast<unsigned long long>(stats.schedulerRuns), static_cast<unsigned long long>(stats.blocksScheduled),
+           stats.seconds, stats.getBlocksPerSecond());
+}
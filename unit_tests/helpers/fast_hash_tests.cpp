@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/helpers/fast_hash.h"
+#include "runtime/helpers/hash.h"
+#include "runtime/utilities/cpu_info.h"
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <cstring>
+#include <set>
+#include <vector>
+
+using namespace OCLRT;
+
+namespace {
+std::vector<char> getTestData(size_t size) {
+    std::vector<char> data(size);
+    for (size_t i = 0; i < size; i++) {
+        data[i] = static_cast<char>(i * 131 + 7);
+    }
+    return data;
+}
+} // namespace
+
+TEST(FastHash, givenSameDataWhenHashedTwiceThenResultsAreEqual) {
+    auto data = getTestData(1000);
+    EXPECT_EQ(FastHash::hash(data.data(), data.size()), FastHash::hash(data.data(), data.size()));
+}
+
+TEST(FastHash, givenNullptrWhenUpdateIsCalledThenHashIsNotChanged) {
+    FastHash hash;
+    auto initial = hash.finish();
+    hash.update(nullptr, 10);
+    EXPECT_EQ(initial, hash.finish());
+}
+
+TEST(FastHash, givenShortBuffersOfDifferentLengthsWhenHashedThenResultsAreUnique) {
+    char data[2 * FastHash::blockSize + 1] = {};
+    std::set<uint64_t> hashes;
+    for (size_t i = 0; i <= sizeof(data); i++) {
+        auto res = FastHash::hash(data, i);
+        EXPECT_TRUE(hashes.insert(res).second) << "length " << i;
+    }
+}
+
+TEST(FastHash, givenSingleBitChangeWhenHashedThenResultDiffers) {
+    auto data = getTestData(3 * FastHash::blockSize + 5);
+    auto reference = FastHash::hash(data.data(), data.size());
+    for (size_t i = 0; i < data.size(); i++) {
+        data[i] ^= 1;
+        EXPECT_NE(reference, FastHash::hash(data.data(), data.size())) << "byte " << i;
+        data[i] ^= 1;
+    }
+}
+
+TEST(FastHash, givenDataSplitIntoChunksWhenUpdatedThenResultIsSameAsForWholeBuffer) {
+    auto data = getTestData(1000);
+    auto reference = FastHash::hash(data.data(), data.size());
+
+    for (size_t chunk : {1u, 3u, 31u, 32u, 33u, 100u}) {
+        FastHash hash;
+        for (size_t offset = 0; offset < data.size(); offset += chunk) {
+            hash.update(data.data() + offset, std::min(chunk, data.size() - offset));
+        }
+        EXPECT_EQ(reference, hash.finish()) << "chunk " << chunk;
+    }
+}
+
+TEST(FastHash, givenMisalignedBufferWhenHashedThenResultIsSameAsForAlignedCopy) {
+    auto data = getTestData(257);
+    std::vector<char> misalignedStorage(data.size() + 3);
+    memcpy(misalignedStorage.data() + 3, data.data(), data.size());
+
+    EXPECT_EQ(FastHash::hash(data.data(), data.size()), FastHash::hash(misalignedStorage.data() + 3, data.size()));
+}
+
+TEST(FastHash, givenFinishWhenCalledThenHashCanBeFurtherUpdated) {
+    auto data = getTestData(100);
+    FastHash hash;
+    hash.update(data.data(), 40);
+    hash.finish();
+    hash.update(data.data() + 40, 60);
+    EXPECT_EQ(FastHash::hash(data.data(), data.size()), hash.finish());
+}
+
+TEST(FastHash, givenSse42SupportWhenBlocksAreProcessedThenResultMatchesTableImplementation) {
+    if (!CpuInfo::getInstance().isFeatureSupported(CpuInfo::featureSsE42)) {
+        return;
+    }
+    EXPECT_EQ(processBlocksCrc32cSse42, FastHash::processBlocks);
+
+    auto data = getTestData(16 * FastHash::blockSize + 1);
+    for (size_t offset = 0; offset <= 1; offset++) {
+        uint32_t tableLanes[FastHash::numLanes] = {1, 2, 3, 4};
+        uint32_t sse42Lanes[FastHash::numLanes] = {1, 2, 3, 4};
+        processBlocksCrc32c(tableLanes, data.data() + offset, 16);
+        processBlocksCrc32cSse42(sse42Lanes, data.data() + offset, 16);
+        EXPECT_EQ(0, memcmp(tableLanes, sse42Lanes, sizeof(tableLanes)));
+    }
+}
+
+TEST(FastHash, givenTableImplementationWhenHashingThenResultMatchesDispatchedImplementation) {
+    auto data = getTestData(1000);
+    auto reference = FastHash::hash(data.data(), data.size());
+
+    auto dispatched = FastHash::processBlocks;
+    FastHash::processBlocks = processBlocksCrc32c;
+    auto tableResult = FastHash::hash(data.data(), data.size());
+    FastHash::processBlocks = dispatched;
+
+    EXPECT_EQ(reference, tableResult);
+}
+
+TEST(FastHash, givenZeroLaneAndSingleWordWhenProcessedThenKnownCrc32cIsReturned) {
+    // CRC32C of eight 0xFF bytes without pre/post inversion equals the crc32 instruction result
+    uint32_t lanes[FastHash::numLanes] = {};
+    char block[FastHash::blockSize] = {};
+    memset(block, 0xFF, sizeof(uint64_t));
+    uint32_t expected = 0;
+    for (size_t i = 0; i < sizeof(uint64_t); i++) {
+        expected ^= 0xFF;
+        for (int bit = 0; bit < 8; bit++) {
+            expected = (expected >> 1) ^ (0x82F63B78u & (0u - (expected & 1u)));
+        }
+    }
+    processBlocksCrc32c(lanes, block, 1);
+    EXPECT_EQ(expected, lanes[0]);
+    EXPECT_EQ(0u, lanes[1]);
+}
@@ -0,0 +1,180 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/helpers/host_copy.h"
+#include "runtime/helpers/ptr_math.h"
+#include "runtime/utilities/worker_pool.h"
+#include "unit_tests/helpers/debug_manager_state_restore.h"
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <vector>
+
+using namespace OCLRT;
+
+namespace {
+std::vector<char> getPattern(size_t size, char seed) {
+    std::vector<char> data(size);
+    for (size_t i = 0; i < size; i++) {
+        data[i] = static_cast<char>(seed + i * 13 + (i >> 8));
+    }
+    return data;
+}
+
+HostCopyRegion getRegion(void *dst, size_t dstRowPitch, size_t dstSlicePitch, const void *src, size_t srcRowPitch, size_t srcSlicePitch,
+                         size_t rowSize, size_t numRows, size_t numSlices) {
+    HostCopyRegion region;
+    region.dst = dst;
+    region.dstRowPitch = dstRowPitch;
+    region.dstSlicePitch = dstSlicePitch;
+    region.src = src;
+    region.srcRowPitch = srcRowPitch;
+    region.srcSlicePitch = srcSlicePitch;
+    region.rowSize = rowSize;
+    region.numRows = numRows;
+    region.numSlices = numSlices;
+    return region;
+}
+
+// dst rows and slices outside of the region have to stay untouched
+void expectRegionCopied(const std::vector<char> &dst, const std::vector<char> &dstBefore, const std::vector<char> &src, const HostCopyRegion &region) {
+    std::vector<char> expected(dstBefore);
+    for (size_t slice = 0; slice < region.numSlices; slice++) {
+        for (size_t row = 0; row < region.numRows; row++) {
+            auto dstOffset = ptrDiff(region.dst, dst.data()) + slice * region.dstSlicePitch + row * region.dstRowPitch;
+            auto srcOffset = ptrDiff(region.src, src.data()) + slice * region.srcSlicePitch + row * region.srcRowPitch;
+            std::copy(src.begin() + srcOffset, src.begin() + srcOffset + region.rowSize, expected.begin() + dstOffset);
+        }
+    }
+    EXPECT_TRUE(expected == dst);
+}
+} // namespace
+
+TEST(HostCopy, givenRowsWithPitchEqualToRowSizeWhenMergedThenRowsAndSlicesBecomeSingleSpan) {
+    char dst[1], src[1];
+    auto merged = HostCopy::mergeContiguousRows(getRegion(dst, 64, 64 * 8, src, 64, 64 * 8, 64, 8, 3));
+    EXPECT_EQ(64u * 8u * 3u, merged.rowSize);
+    EXPECT_EQ(1u, merged.numRows);
+    EXPECT_EQ(1u, merged.numSlices);
+}
+
+TEST(HostCopy, givenSlicePitchLargerThanSliceWhenMergedThenOnlyRowsAreMerged) {
+    char dst[1], src[1];
+    auto merged = HostCopy::mergeContiguousRows(getRegion(dst, 64, 1024, src, 64, 512, 64, 8, 3));
+    EXPECT_EQ(64u * 8u, merged.rowSize);
+    EXPECT_EQ(1u, merged.numRows);
+    EXPECT_EQ(3u, merged.numSlices);
+    EXPECT_EQ(1024u, merged.dstSlicePitch);
+    EXPECT_EQ(512u, merged.srcSlicePitch);
+}
+
+TEST(HostCopy, givenRowPitchLargerThanRowWhenMergedThenRegionIsUnchanged) {
+    char dst[1], src[1];
+    auto merged = HostCopy::mergeContiguousRows(getRegion(dst, 64, 64 * 8, src, 80, 80 * 8, 64, 8, 3));
+    EXPECT_EQ(64u, merged.rowSize);
+    EXPECT_EQ(8u, merged.numRows);
+    EXPECT_EQ(3u, merged.numSlices);
+}
+
+TEST(HostCopy, givenCopySizeWhenNumberOfTasksIsQueriedThenSmallCopiesAndMissingPoolUseSingleTask) {
+    WorkerPool pool(3);
+    EXPECT_EQ(1u, HostCopy::getNumTasks(HostCopy::parallelCopyThreshold - 1, &pool));
+    EXPECT_EQ(1u, HostCopy::getNumTasks(64 * HostCopy::parallelCopyThreshold, nullptr));
+    EXPECT_EQ(HostCopy::parallelCopyThreshold / HostCopy::minBytesPerTask, HostCopy::getNumTasks(HostCopy::parallelCopyThreshold, &pool));
+    EXPECT_EQ(4u, HostCopy::getNumTasks(64 * HostCopy::parallelCopyThreshold, &pool));
+}
+
+TEST(HostCopy, givenNonTemporalFlagWhenQueriedThenItOverridesSizeHeuristic) {
+    DebugManagerStateRestore restore;
+    EXPECT_FALSE(HostCopy::isNonTemporalCopyPreferred(HostCopy::nonTemporalCopyThreshold - 1));
+    EXPECT_TRUE(HostCopy::isNonTemporalCopyPreferred(HostCopy::nonTemporalCopyThreshold));
+    DebugManager.flags.HostCopyNonTemporal.set(0);
+    EXPECT_FALSE(HostCopy::isNonTemporalCopyPreferred(HostCopy::nonTemporalCopyThreshold));
+    DebugManager.flags.HostCopyNonTemporal.set(1);
+    EXPECT_TRUE(HostCopy::isNonTemporalCopyPreferred(1));
+}
+
+TEST(HostCopy, givenUnalignedPointersAndSizesWhenCopiedNonTemporallyThenDataMatches) {
+    auto src = getPattern(512, 3);
+    for (size_t dstOffset = 0; dstOffset < 17; dstOffset += 3) {
+        for (size_t size = 0; size < 300; size += 7) {
+            std::vector<char> dst(512, 0);
+            HostCopy::copyNonTemporal(dst.data() + dstOffset, src.data() + 5, size);
+            EXPECT_TRUE(std::equal(src.begin() + 5, src.begin() + 5 + size, dst.begin() + dstOffset));
+            EXPECT_TRUE(std::all_of(dst.begin() + dstOffset + size, dst.end(), [](char c) { return c == 0; }));
+        }
+    }
+}
+
+struct HostCopyRegionTest : public ::testing::TestWithParam<int32_t> {
+};
+
+TEST_P(HostCopyRegionTest, givenPitchedVolumeWhenCopiedThenOnlyRegionIsWritten) {
+    DebugManagerStateRestore restore;
+    DebugManager.flags.HostCopyNonTemporal.set(GetParam());
+    WorkerPool pool(3);
+
+    // large enough to be split across the pool
+    const size_t rowSize = 4096 + 12, numRows = 100, numSlices = 7;
+    const size_t srcRowPitch = rowSize + 100, srcSlicePitch = srcRowPitch * (numRows + 2);
+    const size_t dstRowPitch = rowSize + 36, dstSlicePitch = dstRowPitch * numRows;
+    auto src = getPattern(srcSlicePitch * numSlices + 64, 1);
+    auto dstBefore = getPattern(dstSlicePitch * numSlices + 64, 77);
+    auto dst = dstBefore;
+
+    auto region = getRegion(dst.data() + 3, dstRowPitch, dstSlicePitch, src.data() + 9, srcRowPitch, srcSlicePitch, rowSize, numRows, numSlices);
+    ASSERT_LT(1u, HostCopy::getNumTasks(rowSize * numRows * numSlices, &pool));
+    HostCopy::copy(region, &pool);
+    expectRegionCopied(dst, dstBefore, src, region);
+}
+
+TEST_P(HostCopyRegionTest, givenContiguousRegionLargerThanParallelThresholdWhenCopiedThenSpanIsSplitAndCopied) {
+    DebugManagerStateRestore restore;
+    DebugManager.flags.HostCopyNonTemporal.set(GetParam());
+    WorkerPool pool(3);
+
+    const size_t rowSize = 1000, numRows = 3000;
+    auto src = getPattern(rowSize * numRows + 16, 5);
+    auto dstBefore = getPattern(rowSize * numRows + 16, 9);
+    auto dst = dstBefore;
+
+    auto region = getRegion(dst.data() + 1, rowSize, rowSize * numRows, src.data() + 7, rowSize, rowSize * numRows, rowSize, numRows, 1);
+    HostCopy::copy(region, &pool);
+    expectRegionCopied(dst, dstBefore, src, region);
+}
+
+TEST_P(HostCopyRegionTest, givenSmallRegionWithoutPoolWhenCopiedThenDataMatches) {
+    DebugManagerStateRestore restore;
+    DebugManager.flags.HostCopyNonTemporal.set(GetParam());
+
+    auto src = getPattern(64 * 16 * 2, 5);
+    auto dstBefore = getPattern(64 * 16 * 2, 9);
+    auto dst = dstBefore;
+
+    auto region = getRegion(dst.data() + 4, 64, 64 * 16, src.data() + 8, 64, 64 * 16, 40, 15, 2);
+    HostCopy::copy(region, nullptr);
+    expectRegionCopied(dst, dstBefore, src, region);
+}
+
+INSTANTIATE_TEST_CASE_P(HostCopyRegionTest,
+                        HostCopyRegionTest,
+                        ::testing::Values(-1, 0, 1));
@@ -104,6 +104,30 @@ HWTEST_F(KernelCommandsTest, copyKernelBinaryResourceUsage) {
     EXPECT_EQ(kernel->getKernelHeapSize(), usedIndirectHeapAfter - usedIndirectHeapBefore);
 }
 
+HWTEST_F(KernelCommandsTest, givenKernelBinaryAlreadyInInstructionHeapWhenGetKernelBinaryOffsetIsCalledThenBinaryIsNotCopiedAgain) {
+    DebugManagerStateRestore dbgRestore;
+    DebugManager.flags.EnableKernelIsaHeapCache.set(1);
+    CommandQueueHw<FamilyType> cmdQ(pContext, pDevice, 0);
+
+    MockKernelWithInternals mockKernel(*pDevice, pContext);
+    mockKernel.kernelHeader.KernelHeapSize = sizeof(mockKernel.kernelIsa);
+    auto &kernelInfo = mockKernel.kernelInfo;
+
+    auto &ih = cmdQ.getIndirectHeap(IndirectHeap::INSTRUCTION, 8192);
+    auto firstOffset = KernelCommandsHelper<FamilyType>::getKernelBinaryOffset(ih, kernelInfo);
+    auto usedAfterFirstCopy = ih.getUsed();
+    EXPECT_EQ(sizeof(mockKernel.kernelIsa), usedAfterFirstCopy - firstOffset);
+
+    auto secondOffset = KernelCommandsHelper<FamilyType>::getKernelBinaryOffset(ih, kernelInfo);
+    EXPECT_EQ(firstOffset, secondOffset);
+    EXPECT_EQ(usedAfterFirstCopy, ih.getUsed());
+
+    DebugManager.flags.EnableKernelIsaHeapCache.set(0);
+    auto thirdOffset = KernelCommandsHelper<FamilyType>::getKernelBinaryOffset(ih, kernelInfo);
+    EXPECT_EQ(usedAfterFirstCopy, thirdOffset);
+    EXPECT_LT(usedAfterFirstCopy, ih.getUsed());
+}
+
 HWTEST_F(KernelCommandsTest, programInterfaceDescriptorDataResourceUsage) {
     CommandQueueHw<FamilyType> cmdQ(pContext, pDevice, 0);
 
@@ -424,6 +448,46 @@ HWTEST_F(KernelCommandsTest, usedBindingTableStatePointer) {
     EXPECT_EQ(0x00000040u, *(&bindingTableStatesPointers[1]));
 }
 
+HWTEST_F(KernelCommandsTest, givenUnchangedKernelSshWhenBindingTablePointerIsRequestedAgainThenSurfaceStatesAreNotPushedAgain) {
+    CommandQueueHw<FamilyType> cmdQ(pContext, pDevice, 0);
+    std::unique_ptr<Image> dstImage(Image2dHelper<>::create(pContext));
+    ASSERT_NE(nullptr, dstImage.get());
+
+    MultiDispatchInfo multiDispatchInfo;
+    auto &builder = BuiltIns::getInstance().getBuiltinDispatchInfoBuilder(EBuiltInOps::CopyBufferToImage3d,
+                                                                          cmdQ.getContext(), cmdQ.getDevice());
+    ASSERT_NE(nullptr, &builder);
+
+    BuiltinDispatchInfoBuilder::BuiltinOpParams dc;
+    dc.srcPtr = nullptr;
+    dc.dstMemObj = dstImage.get();
+    dc.dstOffset = {0, 0, 0};
+    dc.size = {1, 1, 1};
+    dc.dstRowPitch = 0;
+    dc.dstSlicePitch = 0;
+    builder.buildDispatchInfos(multiDispatchInfo, dc);
+    EXPECT_NE(0u, multiDispatchInfo.size());
+
+    auto kernel = multiDispatchInfo.begin()->getKernel();
+    ASSERT_NE(nullptr, kernel);
+
+    auto &ssh = cmdQ.getIndirectHeap(IndirectHeap::SURFACE_STATE, 8192);
+    auto usedBefore = ssh.getUsed();
+
+    auto firstBindingTablePointer = KernelCommandsHelper<FamilyType>::getBindingTablePointer(ssh, *kernel);
+    auto usedAfterFirstPush = ssh.getUsed();
+    EXPECT_LT(usedBefore, usedAfterFirstPush);
+
+    auto secondBindingTablePointer = KernelCommandsHelper<FamilyType>::getBindingTablePointer(ssh, *kernel);
+    EXPECT_EQ(firstBindingTablePointer, secondBindingTablePointer);
+    EXPECT_EQ(usedAfterFirstPush, ssh.getUsed());
+
+    // mutable access to the kernel's SSH invalidates copies pushed earlier
+    kernel->getSurfaceStateHeap();
+    KernelCommandsHelper<FamilyType>::getBindingTablePointer(ssh, *kernel);
+    EXPECT_LT(usedAfterFirstPush, ssh.getUsed());
+}
+
 HWTEST_F(KernelCommandsTest, usedBindingTableStatePointersForGlobalAndConstantAndPrivateAndEventPoolAndDefaultCommandQueueSurfaces) {
     using INTERFACE_DESCRIPTOR_DATA = typename FamilyType::INTERFACE_DESCRIPTOR_DATA;
 
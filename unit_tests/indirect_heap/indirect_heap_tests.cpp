@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017, Intel Corporation
+ * Copyright (c) 2017 - 2018, Intel Corporation
  *
  * Permission is hereby granted, free of charge, to any person obtaining a
  * copy of this software and associated documentation files (the "Software"),
@@ -102,3 +102,72 @@ TEST_F(IndirectHeapTest, givenIndirectHeapWhenGetCpuBaseIsCalledThenCpuAddressIs
     auto base = indirectHeap.getCpuBase();
     EXPECT_EQ(base, buffer);
 }
+
+TEST_F(IndirectHeapTest, givenStoredKernelIsaWhenFindKernelIsaIsCalledThenOffsetIsReturned) {
+    uint8_t kernelHeap[16] = {};
+    indirectHeap.getSpace(32);
+    size_t isaOffset = indirectHeap.getUsed();
+    indirectHeap.getSpace(sizeof(kernelHeap));
+    indirectHeap.storeKernelIsa(7u, kernelHeap, sizeof(kernelHeap), isaOffset);
+
+    size_t offset = 0;
+    EXPECT_TRUE(indirectHeap.findKernelIsa(7u, kernelHeap, sizeof(kernelHeap), offset));
+    EXPECT_EQ(isaOffset, offset);
+    EXPECT_FALSE(indirectHeap.findKernelIsa(8u, kernelHeap, sizeof(kernelHeap), offset));
+}
+
+TEST_F(IndirectHeapTest, givenStoredKernelIsaWhenKernelHeapDiffersThenFindKernelIsaFails) {
+    uint8_t kernelHeap[16] = {};
+    uint8_t otherKernelHeap[16] = {};
+    indirectHeap.getSpace(sizeof(kernelHeap));
+    indirectHeap.storeKernelIsa(7u, kernelHeap, sizeof(kernelHeap), 0u);
+
+    size_t offset = 0;
+    EXPECT_FALSE(indirectHeap.findKernelIsa(7u, otherKernelHeap, sizeof(otherKernelHeap), offset));
+    EXPECT_FALSE(indirectHeap.findKernelIsa(7u, kernelHeap, sizeof(kernelHeap) / 2, offset));
+}
+
+TEST_F(IndirectHeapTest, givenStoredKernelIsaWhenBufferIsReplacedThenCachedIsaIsDropped) {
+    uint8_t kernelHeap[16] = {};
+    indirectHeap.getSpace(sizeof(kernelHeap));
+    indirectHeap.storeKernelIsa(7u, kernelHeap, sizeof(kernelHeap), 0u);
+    EXPECT_EQ(1u, indirectHeap.peekNumCachedKernelIsa());
+
+    indirectHeap.replaceBuffer(buffer, sizeof(buffer));
+    EXPECT_EQ(0u, indirectHeap.peekNumCachedKernelIsa());
+
+    size_t offset = 0;
+    EXPECT_FALSE(indirectHeap.findKernelIsa(7u, kernelHeap, sizeof(kernelHeap), offset));
+}
+
+TEST_F(IndirectHeapTest, givenStoredBindingTableWhenFindBindingTableIsCalledThenPointerIsReturned) {
+    indirectHeap.getSpace(64);
+    indirectHeap.storeBindingTable(3u, 32u, indirectHeap.getUsed());
+    EXPECT_EQ(1u, indirectHeap.peekNumCachedBindingTables());
+
+    size_t bindingTablePointer = 0;
+    EXPECT_TRUE(indirectHeap.findBindingTable(3u, bindingTablePointer));
+    EXPECT_EQ(32u, bindingTablePointer);
+    EXPECT_FALSE(indirectHeap.findBindingTable(4u, bindingTablePointer));
+}
+
+TEST_F(IndirectHeapTest, givenStoredBindingTableWhenHeapUsageDropsBelowItsSurfaceStatesThenFindBindingTableFails) {
+    indirectHeap.getSpace(64);
+    indirectHeap.storeBindingTable(3u, 32u, indirectHeap.getUsed());
+    indirectHeap.putSpace(16);
+
+    size_t bindingTablePointer = 0;
+    EXPECT_FALSE(indirectHeap.findBindingTable(3u, bindingTablePointer));
+    EXPECT_EQ(0u, bindingTablePointer);
+}
+
+TEST_F(IndirectHeapTest, givenStoredBindingTableWhenBufferIsReplacedThenCachedBindingTableIsDropped) {
+    indirectHeap.getSpace(64);
+    indirectHeap.storeBindingTable(3u, 32u, indirectHeap.getUsed());
+
+    indirectHeap.replaceBuffer(buffer, sizeof(buffer));
+    EXPECT_EQ(0u, indirectHeap.peekNumCachedBindingTables());
+
+    size_t bindingTablePointer = 0;
+    EXPECT_FALSE(indirectHeap.findBindingTable(3u, bindingTablePointer));
+}
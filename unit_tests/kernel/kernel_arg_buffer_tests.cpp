@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017, Intel Corporation
+ * Copyright (c) 2017 - 2018, Intel Corporation
  *
  * Permission is hereby granted, free of charge, to any person obtaining a
  * copy of this software and associated documentation files (the "Software"),
@@ -27,6 +27,7 @@
 #include "unit_tests/fixtures/context_fixture.h"
 #include "unit_tests/fixtures/device_fixture.h"
 #include "unit_tests/fixtures/memory_management_fixture.h"
+#include "unit_tests/helpers/debug_manager_state_restore.h"
 #include "unit_tests/kernel/kernel_arg_buffer_fixture.h"
 #include "test.h"
 #include "unit_tests/mocks/mock_buffer.h"
@@ -116,6 +117,80 @@ HWTEST_F(KernelArgBufferTest, SetKernelArgBufferFromSvmPtr) {
     delete buffer;
 }
 
+TEST_F(KernelArgBufferTest, givenBufferArgSetAgainWhenBufferIsUnchangedThenSurfaceStateIsNotReprogrammed) {
+    MockBuffer buffer;
+    auto val = static_cast<cl_mem>(&buffer);
+
+    EXPECT_EQ(CL_SUCCESS, pKernel->setArg(0, sizeof(cl_mem *), &val));
+    auto sshGeneration = pKernel->getSurfaceStateHeapGeneration();
+
+    EXPECT_EQ(CL_SUCCESS, pKernel->setArg(0, sizeof(cl_mem *), &val));
+    EXPECT_EQ(sshGeneration, pKernel->getSurfaceStateHeapGeneration());
+    EXPECT_EQ(val, pKernel->getKernelArg(0));
+}
+
+TEST_F(KernelArgBufferTest, givenBufferArgSetAgainWhenBufferIsUnchangedThenNewArgValueIsStored) {
+    MockBuffer buffer;
+    auto val1 = static_cast<cl_mem>(&buffer);
+    auto val2 = static_cast<cl_mem>(&buffer);
+
+    EXPECT_EQ(CL_SUCCESS, pKernel->setArg(0, sizeof(cl_mem *), &val1));
+    EXPECT_EQ(&val1, pKernel->getKernelArgInfo(0).value);
+
+    auto sshGeneration = pKernel->getSurfaceStateHeapGeneration();
+    EXPECT_EQ(CL_SUCCESS, pKernel->setArg(0, sizeof(cl_mem *), &val2));
+    EXPECT_EQ(sshGeneration, pKernel->getSurfaceStateHeapGeneration());
+    EXPECT_EQ(&val2, pKernel->getKernelArgInfo(0).value);
+    EXPECT_EQ(buffer.getGraphicsAllocation(), pKernel->getKernelArgInfo(0).patchedAllocation);
+
+    // arg is still recognized as patched after the value was refreshed
+    EXPECT_EQ(CL_SUCCESS, pKernel->setArg(0, sizeof(cl_mem *), &val1));
+    EXPECT_EQ(sshGeneration, pKernel->getSurfaceStateHeapGeneration());
+}
+
+TEST_F(KernelArgBufferTest, givenBufferArgSetAgainWhenKernelStateReuseIsDisabledThenSurfaceStateIsReprogrammed) {
+    DebugManagerStateRestore dbgRestore;
+    DebugManager.flags.EnableKernelStateReuse.set(0);
+    MockBuffer buffer;
+    auto val = static_cast<cl_mem>(&buffer);
+
+    EXPECT_EQ(CL_SUCCESS, pKernel->setArg(0, sizeof(cl_mem *), &val));
+    auto sshGeneration = pKernel->getSurfaceStateHeapGeneration();
+
+    EXPECT_EQ(CL_SUCCESS, pKernel->setArg(0, sizeof(cl_mem *), &val));
+    EXPECT_NE(sshGeneration, pKernel->getSurfaceStateHeapGeneration());
+}
+
+TEST_F(KernelArgBufferTest, givenBufferArgWhenOtherBufferWasSetInBetweenThenArgIsPatchedAgain) {
+    MockBuffer buffer1;
+    MockBuffer buffer2;
+    auto val1 = static_cast<cl_mem>(&buffer1);
+    auto val2 = static_cast<cl_mem>(&buffer2);
+    auto pKernelArg = reinterpret_cast<void **>(pKernel->getCrossThreadData() +
+                                                pKernelInfo->kernelArgInfo[0].kernelArgPatchInfoVector[0].crossthreadOffset);
+
+    EXPECT_EQ(CL_SUCCESS, pKernel->setArg(0, sizeof(cl_mem *), &val1));
+    EXPECT_EQ(CL_SUCCESS, pKernel->setArg(0, sizeof(cl_mem *), &val2));
+    EXPECT_EQ(buffer2.getCpuAddress(), *pKernelArg);
+
+    auto sshGeneration = pKernel->getSurfaceStateHeapGeneration();
+    EXPECT_EQ(CL_SUCCESS, pKernel->setArg(0, sizeof(cl_mem *), &val1));
+    EXPECT_NE(sshGeneration, pKernel->getSurfaceStateHeapGeneration());
+    EXPECT_EQ(buffer1.getCpuAddress(), *pKernelArg);
+}
+
+TEST_F(KernelArgBufferTest, givenBufferArgWhenArgWasUnsetThenSameBufferIsPatchedAgain) {
+    MockBuffer buffer;
+    auto val = static_cast<cl_mem>(&buffer);
+
+    EXPECT_EQ(CL_SUCCESS, pKernel->setArg(0, sizeof(cl_mem *), &val));
+    pKernel->unsetArg(0);
+    auto sshGeneration = pKernel->getSurfaceStateHeapGeneration();
+
+    EXPECT_EQ(CL_SUCCESS, pKernel->setArg(0, sizeof(cl_mem *), &val));
+    EXPECT_NE(sshGeneration, pKernel->getSurfaceStateHeapGeneration());
+}
+
 TEST_F(KernelArgBufferTest, SetKernelArgFakeBuffer) {
     char *ptr = new char[sizeof(Buffer)];
 
@@ -113,6 +113,7 @@ class UltCommandStreamReceiver : public CommandStreamReceiverHw<GfxFamily> {
 
 template <typename GfxFamily>
 UltCommandStreamReceiver<GfxFamily>::~UltCommandStreamReceiver() {
+    this->closeAdaptiveDispatcher();
     this->setTagAllocation(nullptr);
     delete tempTagLocation;
 }
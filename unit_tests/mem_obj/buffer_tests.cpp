@@ -606,6 +606,33 @@ TEST_P(ValidHostPtr, SvmHostPtr) {
     }
 }
 
+TEST_P(ValidHostPtr, givenPointerInsideSvmAllocationWhenBufferIsCreatedThenOffsetIntoAllocationIsStored) {
+    const DeviceInfo &devInfo = pPlatform->getDevice(0)->getDeviceInfo();
+    if (devInfo.svmCapabilities != 0) {
+        auto ptr = clSVMAlloc(&context, CL_MEM_READ_WRITE, 64, 64);
+        auto svmAllocation = context.getSVMAllocsManager()->getSVMAlloc(ptr);
+        ASSERT_NE(nullptr, svmAllocation);
+        auto bufferPtr = ptrOffset(ptr, 32);
+        auto expectedOffset = ptrDiff(bufferPtr, svmAllocation->getUnderlyingBuffer());
+
+        auto bufferSvm = Buffer::create(&context, CL_MEM_READ_WRITE | CL_MEM_USE_HOST_PTR, 32, bufferPtr, retVal);
+        ASSERT_NE(nullptr, bufferSvm);
+        EXPECT_EQ(svmAllocation, bufferSvm->getGraphicsAllocation());
+        EXPECT_EQ(bufferPtr, bufferSvm->getCpuAddress());
+        EXPECT_EQ(expectedOffset, bufferSvm->getOffset());
+
+        cl_buffer_region region = {16, 16};
+        auto subBuffer = bufferSvm->createSubBuffer(CL_MEM_READ_WRITE, &region, retVal);
+        ASSERT_NE(nullptr, subBuffer);
+        EXPECT_EQ(ptrOffset(bufferPtr, 16), subBuffer->getCpuAddress());
+        EXPECT_EQ(expectedOffset + 16, subBuffer->getOffset());
+
+        subBuffer->release();
+        delete bufferSvm;
+        clSVMFree(&context, ptr);
+    }
+}
+
 // Parameterized test that tests buffer creation with all flags that should be
 // valid with a valid host ptr
 cl_mem_flags ValidHostPtrFlags[] = {
@@ -30,7 +30,13 @@ using namespace OCLRT;
 
 struct MockMapOperationsHandler : public MapOperationsHandler {
     using MapOperationsHandler::isOverlapping;
-    using MapOperationsHandler::mappedPointers;
+    using MapOperationsHandler::storages;
+
+    MapInfo getMapInfo(void *mappedPtr) {
+        MapInfo mapInfo;
+        EXPECT_TRUE(find(mappedPtr, mapInfo));
+        return mapInfo;
+    }
 };
 
 struct MapOperationsHandlerTests : public ::testing::Test {
@@ -88,27 +94,27 @@ TEST_F(MapOperationsHandlerTests, givenMappedPtrsWhenDoubleRemovedThenDoNothing)
 TEST_F(MapOperationsHandlerTests, givenMapInfoWhenAddedThenSetReadOnlyFlag) {
     mapFlags = CL_MAP_READ;
     mockHandler.add(mappedPtrs[0].ptr, mappedPtrs[0].ptrLength, mapFlags, mappedPtrs[0].size, mappedPtrs[0].offset);
-    EXPECT_TRUE(mockHandler.mappedPointers.back().readOnly);
+    EXPECT_TRUE(mockHandler.getMapInfo(mappedPtrs[0].ptr).readOnly);
     mockHandler.remove(mappedPtrs[0].ptr);
 
     mapFlags = CL_MAP_WRITE;
     mockHandler.add(mappedPtrs[0].ptr, mappedPtrs[0].ptrLength, mapFlags, mappedPtrs[0].size, mappedPtrs[0].offset);
-    EXPECT_FALSE(mockHandler.mappedPointers.back().readOnly);
+    EXPECT_FALSE(mockHandler.getMapInfo(mappedPtrs[0].ptr).readOnly);
     mockHandler.remove(mappedPtrs[0].ptr);
 
     mapFlags = CL_MAP_WRITE_INVALIDATE_REGION;
     mockHandler.add(mappedPtrs[0].ptr, mappedPtrs[0].ptrLength, mapFlags, mappedPtrs[0].size, mappedPtrs[0].offset);
-    EXPECT_FALSE(mockHandler.mappedPointers.back().readOnly);
+    EXPECT_FALSE(mockHandler.getMapInfo(mappedPtrs[0].ptr).readOnly);
     mockHandler.remove(mappedPtrs[0].ptr);
 
     mapFlags = CL_MAP_READ | CL_MAP_WRITE;
     mockHandler.add(mappedPtrs[0].ptr, mappedPtrs[0].ptrLength, mapFlags, mappedPtrs[0].size, mappedPtrs[0].offset);
-    EXPECT_FALSE(mockHandler.mappedPointers.back().readOnly);
+    EXPECT_FALSE(mockHandler.getMapInfo(mappedPtrs[0].ptr).readOnly);
     mockHandler.remove(mappedPtrs[0].ptr);
 
     mapFlags = CL_MAP_READ | CL_MAP_WRITE_INVALIDATE_REGION;
     mockHandler.add(mappedPtrs[0].ptr, mappedPtrs[0].ptrLength, mapFlags, mappedPtrs[0].size, mappedPtrs[0].offset);
-    EXPECT_FALSE(mockHandler.mappedPointers.back().readOnly);
+    EXPECT_FALSE(mockHandler.getMapInfo(mappedPtrs[0].ptr).readOnly);
     mockHandler.remove(mappedPtrs[0].ptr);
 }
 
@@ -118,7 +124,7 @@ TEST_F(MapOperationsHandlerTests, givenNonReadOnlyOverlappingPtrWhenAddingThenRe
     mockHandler.add(mappedPtrs[0].ptr, mappedPtrs[0].ptrLength, mapFlags, mappedPtrs[0].size, mappedPtrs[0].offset);
 
     EXPECT_EQ(1u, mockHandler.size());
-    EXPECT_FALSE(mockHandler.mappedPointers.back().readOnly);
+    EXPECT_FALSE(mockHandler.getMapInfo(mappedPtrs[0].ptr).readOnly);
     EXPECT_TRUE(mockHandler.isOverlapping(mappedPtrs[0]));
     EXPECT_FALSE(mockHandler.add(mappedPtrs[0].ptr, mappedPtrs[0].ptrLength, mapFlags, mappedPtrs[0].size, mappedPtrs[0].offset));
     EXPECT_EQ(1u, mockHandler.size());
@@ -130,11 +136,11 @@ TEST_F(MapOperationsHandlerTests, givenReadOnlyOverlappingPtrWhenAddingThenRetur
     mockHandler.add(mappedPtrs[0].ptr, mappedPtrs[0].ptrLength, mapFlags, mappedPtrs[0].size, mappedPtrs[0].offset);
 
     EXPECT_EQ(1u, mockHandler.size());
-    EXPECT_TRUE(mockHandler.mappedPointers.back().readOnly);
+    EXPECT_TRUE(mockHandler.getMapInfo(mappedPtrs[0].ptr).readOnly);
     EXPECT_FALSE(mockHandler.isOverlapping(mappedPtrs[0]));
     EXPECT_TRUE(mockHandler.add(mappedPtrs[0].ptr, mappedPtrs[0].ptrLength, mapFlags, mappedPtrs[0].size, mappedPtrs[0].offset));
     EXPECT_EQ(2u, mockHandler.size());
-    EXPECT_TRUE(mockHandler.mappedPointers.back().readOnly);
+    EXPECT_TRUE(mockHandler.getMapInfo(mappedPtrs[0].ptr).readOnly);
 }
 
 const std::tuple<void *, size_t, void *, size_t, bool> overlappingCombinations[] = {
@@ -147,6 +153,8 @@ const std::tuple<void *, size_t, void *, size_t, bool> overlappingCombinations[]
     std::make_tuple((void *)5000, 50, (void *)6000, 1, false),  //requested after, non-overlapping
     std::make_tuple((void *)5000, 50, (void *)5000, 1, true),   //requested on start, overlapping inside
     std::make_tuple((void *)5000, 50, (void *)5000, 100, true), //requested on start, overlapping outside
+    std::make_tuple((void *)5000, 50, (void *)4990, 10, true),  //requested before, ending on start
+    std::make_tuple((void *)5000, 50, (void *)5050, 10, false), //requested after, starting on end
 };
 
 struct MapOperationsHandlerOverlapTests : public ::testing::WithParamInterface<std::tuple<void *, size_t, void *, size_t, bool>>,
@@ -174,3 +182,84 @@ TEST_P(MapOperationsHandlerOverlapTests, givenAlreadyMappedPtrWhenAskingForOverl
 INSTANTIATE_TEST_CASE_P(MapOperationsHandlerOverlapTests,
                         MapOperationsHandlerOverlapTests,
                         ::testing::ValuesIn(overlappingCombinations));
+
+TEST_F(MapOperationsHandlerTests, givenNoMappedPtrsWhenFindingOrRemovingThenNothingIsFound) {
+    MapInfo receivedMapInfo;
+    EXPECT_FALSE(mockHandler.find(mappedPtrs[0].ptr, receivedMapInfo));
+    mockHandler.remove(mappedPtrs[0].ptr);
+    EXPECT_EQ(0u, mockHandler.size());
+    EXPECT_TRUE(mockHandler.storages.empty());
+}
+
+TEST_F(MapOperationsHandlerTests, givenReadOnlyPtrNestedInLargerOneWhenWritablePtrOverlapsOnlyLargerOneThenOverlapIsDetected) {
+    mockHandler.add((void *)0x1000, 0x1000, mapFlags, mappedPtrs[0].size, mappedPtrs[0].offset);
+    mockHandler.add((void *)0x1100, 0x10, mapFlags, mappedPtrs[0].size, mappedPtrs[0].offset);
+
+    cl_map_flags writeFlags = CL_MAP_WRITE;
+    EXPECT_FALSE(mockHandler.add((void *)0x1800, 0x10, writeFlags, mappedPtrs[0].size, mappedPtrs[0].offset));
+
+    mockHandler.remove((void *)0x1000);
+    EXPECT_TRUE(mockHandler.add((void *)0x1800, 0x10, writeFlags, mappedPtrs[0].size, mappedPtrs[0].offset));
+    EXPECT_FALSE(mockHandler.add((void *)0x1105, 0x10, writeFlags, mappedPtrs[0].size, mappedPtrs[0].offset));
+    EXPECT_EQ(2u, mockHandler.size());
+}
+
+TEST_F(MapOperationsHandlerTests, givenSamePtrMappedTwiceWhenFindingThenOldestMappingIsReturnedUntilRemoved) {
+    mockHandler.add(mappedPtrs[0].ptr, mappedPtrs[0].ptrLength, mapFlags, mappedPtrs[0].size, mappedPtrs[0].offset);
+    mockHandler.add(mappedPtrs[0].ptr, mappedPtrs[0].ptrLength, mapFlags, mappedPtrs[1].size, mappedPtrs[1].offset);
+
+    EXPECT_EQ(mappedPtrs[0].size, mockHandler.getMapInfo(mappedPtrs[0].ptr).size);
+    mockHandler.remove(mappedPtrs[0].ptr);
+    EXPECT_EQ(mappedPtrs[1].size, mockHandler.getMapInfo(mappedPtrs[0].ptr).size);
+    mockHandler.remove(mappedPtrs[0].ptr);
+    EXPECT_EQ(0u, mockHandler.size());
+}
+
+TEST_F(MapOperationsHandlerTests, givenManyWritablePtrsAddedOutOfOrderWhenFindingThenAllAreFound) {
+    cl_map_flags writeFlags = CL_MAP_WRITE;
+    const size_t count = 100;
+    for (size_t i = 0; i < count; i++) {
+        auto tile = (i * 37) % count;
+        MemObjSizeArray size = {{tile, 1, 1}};
+        EXPECT_TRUE(mockHandler.add(ptrOffset(mappedPtrs[0].ptr, tile * 0x100), 0x80, writeFlags, size, mappedPtrs[0].offset));
+    }
+    EXPECT_EQ(count, mockHandler.size());
+    EXPECT_LT(1u, mockHandler.storages.size());
+
+    for (size_t tile = 0; tile < count; tile++) {
+        auto mapInfo = mockHandler.getMapInfo(ptrOffset(mappedPtrs[0].ptr, tile * 0x100));
+        EXPECT_EQ(tile, mapInfo.size[0]);
+        EXPECT_EQ(0x80u, mapInfo.ptrLength);
+        EXPECT_FALSE(mapInfo.readOnly);
+    }
+
+    MapInfo receivedMapInfo;
+    EXPECT_FALSE(mockHandler.find(ptrOffset(mappedPtrs[0].ptr, 0x40), receivedMapInfo));
+    EXPECT_FALSE(mockHandler.add(ptrOffset(mappedPtrs[0].ptr, 0x40), 0x10, writeFlags, mappedPtrs[0].size, mappedPtrs[0].offset));
+    EXPECT_TRUE(mockHandler.add(ptrOffset(mappedPtrs[0].ptr, 0x90), 0x10, writeFlags, mappedPtrs[0].size, mappedPtrs[0].offset));
+
+    for (size_t tile = 0; tile < count; tile++) {
+        mockHandler.remove(ptrOffset(mappedPtrs[0].ptr, tile * 0x100));
+    }
+    EXPECT_EQ(1u, mockHandler.size());
+}
+
+TEST_F(MapOperationsHandlerTests, givenEveryOtherPtrRemovedWhenFindingThenRemainingPtrsAreStillFound) {
+    cl_map_flags writeFlags = CL_MAP_WRITE;
+    const size_t count = 64;
+    for (size_t tile = 0; tile < count; tile++) {
+        MemObjSizeArray size = {{tile, 1, 1}};
+        EXPECT_TRUE(mockHandler.add(ptrOffset(mappedPtrs[0].ptr, tile * 0x80), 0x40, writeFlags, size, mappedPtrs[0].offset));
+    }
+    for (size_t tile = 0; tile < count; tile += 2) {
+        mockHandler.remove(ptrOffset(mappedPtrs[0].ptr, tile * 0x80));
+    }
+    EXPECT_EQ(count / 2, mockHandler.size());
+
+    MapInfo receivedMapInfo;
+    for (size_t tile = 0; tile < count; tile++) {
+        auto mappedPtr = ptrOffset(mappedPtrs[0].ptr, tile * 0x80);
+        EXPECT_EQ(tile % 2 == 1, mockHandler.find(mappedPtr, receivedMapInfo));
+        EXPECT_EQ(tile % 2 == 0, mockHandler.add(mappedPtr, 0x40, writeFlags, mappedPtrs[0].size, mappedPtrs[0].offset));
+    }
+}
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017, Intel Corporation
+ * Copyright (c) 2017 - 2018, Intel Corporation
  *
  * Permission is hereby granted, free of charge, to any person obtaining a
  * copy of this software and associated documentation files (the "Software"),
@@ -30,6 +30,7 @@
 #include "unit_tests/helpers/memory_management.h"
 
 #include <memory>
+#include <vector>
 
 using namespace OCLRT;
 
@@ -90,3 +91,26 @@ TEST_F(AddressMapperTests, unmapNotMapped) {
     EXPECT_NE(m1, m2);
     EXPECT_EQ(0x2000u, m2);
 }
+
+TEST_F(AddressMapperTests, givenManyMappingsWhenRemappedAndUnmappedThenEachKeepsItsOwnRange) {
+    const uint32_t numMappings = 1000;
+    std::vector<uint32_t> ggtt(numMappings);
+    for (uint32_t i = 0; i < numMappings; i++) {
+        ggtt[i] = mapper->map(reinterpret_cast<void *>(uintptr_t(i + 1) * 0x10000), MemoryConstants::pageSize);
+        EXPECT_EQ((i + 1) * MemoryConstants::pageSize, ggtt[i]);
+    }
+    for (uint32_t i = 0; i < numMappings; i++) {
+        EXPECT_EQ(ggtt[i], mapper->map(reinterpret_cast<void *>(uintptr_t(i + 1) * 0x10000 + 0x10), 0x100));
+    }
+    for (uint32_t i = 0; i < numMappings; i += 2) {
+        mapper->unmap(reinterpret_cast<void *>(uintptr_t(i + 1) * 0x10000));
+    }
+    for (uint32_t i = 0; i < numMappings; i++) {
+        auto m = mapper->map(reinterpret_cast<void *>(uintptr_t(i + 1) * 0x10000), MemoryConstants::pageSize);
+        if (i % 2) {
+            EXPECT_EQ(ggtt[i], m);
+        } else {
+            EXPECT_LT(ggtt[numMappings - 1], m);
+        }
+    }
+}
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017, Intel Corporation
+ * Copyright (c) 2017 - 2018, Intel Corporation
  *
  * Permission is hereby granted, free of charge, to any person obtaining a
  * copy of this software and associated documentation files (the "Software"),
@@ -785,3 +785,74 @@ TEST(HostPtrManager, GivenHostPtrManagerFilledWithFragmentsWhenAskedForOverlapin
     EXPECT_EQ(OverlapStatus::FRAGMENT_WITHIN_STORED_FRAGMENT, overlapStatus);
     EXPECT_NE(nullptr, fragment3);
 }
+
+TEST(HostPtrManager, GivenFragmentSpanningMultipleRegionsWhenQueriedFromAnyRegionThenFragmentIsFound) {
+    auto regionSize = static_cast<size_t>(1) << HostPtrManager::regionShift;
+    auto bigPtr = (void *)(regionSize - MemoryConstants::pageSize);
+    auto bigSize = 2 * regionSize + 2 * MemoryConstants::pageSize;
+
+    FragmentStorage fragment;
+    fragment.fragmentCpuPointer = bigPtr;
+    fragment.fragmentSize = bigSize;
+    HostPtrManager hostPtrManager;
+    hostPtrManager.storeFragment(fragment);
+    EXPECT_EQ(1u, hostPtrManager.getFragmentCount());
+
+    auto ptrInSecondRegion = (void *)(regionSize + MemoryConstants::pageSize);
+    auto ptrInLastRegion = ptrOffset(bigPtr, bigSize - 1);
+    auto storedFragment = hostPtrManager.getFragment(bigPtr);
+    ASSERT_NE(nullptr, storedFragment);
+    EXPECT_EQ(storedFragment, hostPtrManager.getFragment(ptrInSecondRegion));
+    EXPECT_EQ(storedFragment, hostPtrManager.getFragment(ptrInLastRegion));
+    EXPECT_EQ(nullptr, hostPtrManager.getFragment(ptrOffset(bigPtr, bigSize)));
+
+    OverlapStatus overlapStatus;
+    auto fragment1 = hostPtrManager.getFragmentAndCheckForOverlaps(ptrInSecondRegion, regionSize, overlapStatus);
+    EXPECT_EQ(OverlapStatus::FRAGMENT_WITHIN_STORED_FRAGMENT, overlapStatus);
+    EXPECT_EQ(storedFragment, fragment1);
+
+    auto fragment2 = hostPtrManager.getFragmentAndCheckForOverlaps(ptrInLastRegion, MemoryConstants::pageSize, overlapStatus);
+    EXPECT_EQ(OverlapStatus::FRAGMENT_OVERLAPING_AND_BIGGER_THEN_STORED_FRAGMENT, overlapStatus);
+    EXPECT_EQ(nullptr, fragment2);
+
+    auto fragment3 = hostPtrManager.getFragmentAndCheckForOverlaps(nullptr, 2 * regionSize, overlapStatus);
+    EXPECT_EQ(OverlapStatus::FRAGMENT_OVERLAPING_AND_BIGGER_THEN_STORED_FRAGMENT, overlapStatus);
+    EXPECT_EQ(nullptr, fragment3);
+
+    EXPECT_TRUE(hostPtrManager.releaseHostPtr(ptrInSecondRegion));
+    EXPECT_EQ(0u, hostPtrManager.getFragmentCount());
+    EXPECT_EQ(nullptr, hostPtrManager.getFragment(bigPtr));
+    EXPECT_EQ(nullptr, hostPtrManager.getFragment(ptrInSecondRegion));
+    EXPECT_EQ(nullptr, hostPtrManager.getFragment(ptrInLastRegion));
+}
+
+TEST(HostPtrManager, GivenFragmentsInRegionsSharingShardWhenQueriedThenOnlyFragmentFromQueriedRegionIsReturned) {
+    auto regionSize = static_cast<size_t>(1) << HostPtrManager::regionShift;
+    auto ptr1 = (void *)MemoryConstants::pageSize;
+    auto ptr2 = ptrOffset(ptr1, HostPtrManager::numShards * regionSize);
+
+    FragmentStorage fragment;
+    fragment.fragmentCpuPointer = ptr1;
+    fragment.fragmentSize = MemoryConstants::pageSize;
+    HostPtrManager hostPtrManager;
+    hostPtrManager.storeFragment(fragment);
+
+    EXPECT_EQ(nullptr, hostPtrManager.getFragment(ptr2));
+    OverlapStatus overlapStatus;
+    EXPECT_EQ(nullptr, hostPtrManager.getFragmentAndCheckForOverlaps(ptr2, MemoryConstants::pageSize, overlapStatus));
+    EXPECT_EQ(OverlapStatus::FRAGMENT_NOT_OVERLAPING_WITH_ANY_OTHER, overlapStatus);
+
+    FragmentStorage fragment2;
+    fragment2.fragmentCpuPointer = ptr2;
+    fragment2.fragmentSize = MemoryConstants::pageSize;
+    hostPtrManager.storeFragment(fragment2);
+    EXPECT_EQ(2u, hostPtrManager.getFragmentCount());
+    auto storedFragment = hostPtrManager.getFragment(ptr2);
+    ASSERT_NE(nullptr, storedFragment);
+    EXPECT_EQ(ptr2, storedFragment->fragmentCpuPointer);
+
+    EXPECT_TRUE(hostPtrManager.releaseHostPtr(ptr1));
+    EXPECT_EQ(storedFragment, hostPtrManager.getFragment(ptr2));
+    EXPECT_TRUE(hostPtrManager.releaseHostPtr(ptr2));
+    EXPECT_EQ(0u, hostPtrManager.getFragmentCount());
+}
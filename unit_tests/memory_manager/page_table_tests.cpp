@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017, Intel Corporation
+ * Copyright (c) 2017 - 2018, Intel Corporation
  *
  * Permission is hereby granted, free of charge, to any person obtaining a
  * copy of this software and associated documentation files (the "Software"),
@@ -29,6 +29,8 @@
 #include "unit_tests/helpers/memory_management.h"
 
 #include <memory>
+#include <tuple>
+#include <vector>
 
 using namespace OCLRT;
 
@@ -141,7 +143,6 @@ TEST_F(PageTableTests48, pageWalkSimple) {
     size_t lastOffset = 0;
     PageWalker walker = [&](uint64_t physAddress, size_t size, size_t offset) {
         EXPECT_EQ(lastOffset, offset);
-        EXPECT_GE(pageSize, size);
 
         walked += size;
         lastOffset += size;
@@ -150,6 +151,71 @@ TEST_F(PageTableTests48, pageWalkSimple) {
     EXPECT_EQ(lSize, walked);
 }
 
+TEST_F(PageTableTests48, givenUnmappedRangeWhenPageWalkedThenSinglePhysicallyContiguousRunIsReported) {
+    std::unique_ptr<PPGTTPageTable> pageTable(new PPGTTPageTable);
+    uintptr_t addr1 = refAddr + (510 * pageSize) + 0x10;
+    size_t lSize = 8 * pageSize;
+
+    uint32_t calls = 0;
+    pageTable->pageWalk(addr1, lSize, 0, [&](uint64_t physAddress, size_t size, size_t offset) {
+        EXPECT_EQ(startAddress + 0x10, physAddress);
+        EXPECT_EQ(lSize, size);
+        EXPECT_EQ(0u, offset);
+        calls++;
+    });
+    EXPECT_EQ(1u, calls);
+    EXPECT_EQ(PTE::initialPage + 9u, this->getNextPage());
+}
+
+TEST_F(PageTableTests48, givenPhysicallyDiscontiguousPagesWhenPageWalkedThenRunsAreSplitAndMatchMappedAddresses) {
+    std::unique_ptr<PPGTTPageTable> pageTable(new PPGTTPageTable);
+    uintptr_t addr1 = refAddr;
+
+    // map the middle page first so it gets a lower physical page than its neighbours
+    auto physMiddle = pageTable->map(addr1 + 2 * pageSize, pageSize);
+
+    std::vector<std::tuple<uint64_t, size_t, size_t>> runs;
+    pageTable->pageWalk(addr1, 5 * pageSize, 0, [&](uint64_t physAddress, size_t size, size_t offset) {
+        runs.push_back(std::make_tuple(physAddress, size, offset));
+    });
+
+    ASSERT_EQ(3u, runs.size());
+    EXPECT_EQ(2 * pageSize, std::get<1>(runs[0]));
+    EXPECT_EQ(0u, std::get<2>(runs[0]));
+    EXPECT_EQ(physMiddle, std::get<0>(runs[1]));
+    EXPECT_EQ(pageSize, std::get<1>(runs[1]));
+    EXPECT_EQ(2 * pageSize, std::get<2>(runs[1]));
+    EXPECT_EQ(2 * pageSize, std::get<1>(runs[2]));
+    EXPECT_EQ(3 * pageSize, std::get<2>(runs[2]));
+
+    for (auto &run : runs) {
+        for (size_t page = 0; page < std::get<1>(run) / pageSize; page++) {
+            auto vm = addr1 + std::get<2>(run) + page * pageSize;
+            EXPECT_EQ(std::get<0>(run) + page * pageSize, pageTable->map(vm, pageSize));
+        }
+    }
+    EXPECT_EQ(PTE::initialPage + 5u, this->getNextPage());
+}
+
+TEST_F(PageTableTests48, givenStdFunctionWalkerWhenPageWalkedThenSameRunsAsTemplatedWalkerAreReported) {
+    std::unique_ptr<PPGTTPageTable> pageTable(new PPGTTPageTable);
+    uintptr_t addr1 = refAddr + 0x123;
+    pageTable->map(addr1 + 3 * pageSize, pageSize);
+
+    std::vector<std::tuple<uint64_t, size_t, size_t>> templatedRuns;
+    pageTable->pageWalk(addr1, 6 * pageSize, 0, [&](uint64_t physAddress, size_t size, size_t offset) {
+        templatedRuns.push_back(std::make_tuple(physAddress, size, offset));
+    });
+
+    std::vector<std::tuple<uint64_t, size_t, size_t>> functionRuns;
+    PageWalker walker = [&](uint64_t physAddress, size_t size, size_t offset) {
+        functionRuns.push_back(std::make_tuple(physAddress, size, offset));
+    };
+    pageTable->pageWalk(addr1, 6 * pageSize, 0, walker);
+
+    EXPECT_EQ(templatedRuns, functionRuns);
+}
+
 TEST_F(PageTableTests48, mapPageMapByteInMapped) {
     std::unique_ptr<PPGTTPageTable> pageTable(new PPGTTPageTable);
     uintptr_t addr1 = refAddr;
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017, Intel Corporation
+ * Copyright (c) 2017 - 2018, Intel Corporation
  *
  * Permission is hereby granted, free of charge, to any person obtaining a
  * copy of this software and associated documentation files (the "Software"),
@@ -29,8 +29,10 @@
 #include "unit_tests/utilities/containers_tests_helpers.h"
 #include "unit_tests/fixtures/memory_allocator_fixture.h"
 #include "unit_tests/mocks/mock_context.h"
+#include "unit_tests/mocks/mock_csr.h"
 
 #include <future>
+#include <thread>
 
 using namespace OCLRT;
 
@@ -131,7 +133,7 @@ TEST_F(SVMMemoryAllocatorTest, WhenCouldNotAllocateInMemoryManagerThenReturnsNul
             : SVMAllocsManager(m) {
         }
 
-        MapBasedAllocationTracker &GetSVMAllocs() {
+        RangeAllocationTracker &GetSVMAllocs() {
             return SVMAllocs;
         }
     };
@@ -145,3 +147,219 @@ TEST_F(SVMMemoryAllocatorTest, WhenCouldNotAllocateInMemoryManagerThenReturnsNul
         EXPECT_EQ(0U, svmM.GetSVMAllocs().getNumAllocs());
     }
 }
+
+TEST_F(SVMMemoryAllocatorTest, givenSmallAllocationsWhenCreatedThenTheyAreCarvedOutOfOneChunk) {
+    OsAgnosticMemoryManager umm;
+    {
+        SVMAllocsManager svmM(&umm);
+        char *ptr1 = (char *)svmM.createSVMAlloc(100);
+        char *ptr2 = (char *)svmM.createSVMAlloc(256);
+        ASSERT_NE(nullptr, ptr1);
+        ASSERT_NE(nullptr, ptr2);
+        EXPECT_EQ(ptr1 + SVMAllocsManager::minPooledSize, ptr2);
+        EXPECT_TRUE(isAligned<SVMAllocsManager::minPooledSize>(ptr1));
+        EXPECT_EQ(2u, svmM.getNumAllocs());
+
+        auto GA1 = svmM.getSVMAlloc(ptr1);
+        auto GA2 = svmM.getSVMAlloc(ptr2 + 255);
+        ASSERT_NE(nullptr, GA1);
+        EXPECT_EQ(GA1, GA2);
+        EXPECT_EQ(SVMAllocsManager::poolChunkSize, GA1->getUnderlyingBufferSize());
+        EXPECT_EQ(nullptr, svmM.getSVMAlloc(ptr2 + 256));
+
+        svmM.freeSVMAlloc(ptr1);
+        svmM.freeSVMAlloc(ptr2);
+        EXPECT_EQ(0u, svmM.getNumAllocs());
+    }
+}
+
+TEST_F(SVMMemoryAllocatorTest, givenAllocationsOfDifferentSizeClassesWhenCreatedThenEachIsAlignedToItsClass) {
+    OsAgnosticMemoryManager umm;
+    {
+        SVMAllocsManager svmM(&umm);
+        void *ptr512 = svmM.createSVMAlloc(300);
+        void *ptr2048 = svmM.createSVMAlloc(SVMAllocsManager::maxPooledSize);
+        void *coherentPtr = svmM.createSVMAlloc(300, true);
+
+        EXPECT_TRUE(isAligned<512>(ptr512));
+        EXPECT_TRUE(isAligned<SVMAllocsManager::maxPooledSize>(ptr2048));
+        EXPECT_NE(svmM.getSVMAlloc(ptr512), svmM.getSVMAlloc(ptr2048));
+        EXPECT_NE(svmM.getSVMAlloc(ptr512), svmM.getSVMAlloc(coherentPtr));
+        EXPECT_FALSE(svmM.getSVMAlloc(ptr512)->isCoherent());
+        EXPECT_TRUE(svmM.getSVMAlloc(coherentPtr)->isCoherent());
+
+        svmM.freeSVMAlloc(ptr512);
+        svmM.freeSVMAlloc(ptr2048);
+        svmM.freeSVMAlloc(coherentPtr);
+    }
+}
+
+TEST_F(SVMMemoryAllocatorTest, givenFreedPooledAllocationWhenLookedUpThenNullIsReturnedAndBlockIsReused) {
+    OsAgnosticMemoryManager umm;
+    {
+        SVMAllocsManager svmM(&umm);
+        void *ptr1 = svmM.createSVMAlloc(64);
+        void *ptr2 = svmM.createSVMAlloc(64);
+
+        svmM.freeSVMAlloc(ptr1);
+        EXPECT_EQ(nullptr, svmM.getSVMAlloc(ptr1));
+        EXPECT_NE(nullptr, svmM.getSVMAlloc(ptr2));
+        EXPECT_EQ(1u, svmM.getNumAllocs());
+
+        svmM.freeSVMAlloc(ptr1);
+        EXPECT_EQ(1u, svmM.getNumAllocs());
+
+        EXPECT_EQ(ptr1, svmM.createSVMAlloc(64));
+        svmM.freeSVMAlloc(ptr1);
+        svmM.freeSVMAlloc(ptr2);
+    }
+}
+
+TEST_F(SVMMemoryAllocatorTest, givenPooledAllocationFreedWhileChunkIsUsedByGpuWhenAllocatingThenBlockIsReusedOnlyAfterCompletion) {
+    uint32_t gpuTag = 1;
+    MockCommandStreamReceiver csr;
+    csr.tagAddress = &gpuTag;
+    OsAgnosticMemoryManager umm;
+    umm.csr = &csr;
+    {
+        SVMAllocsManager svmM(&umm);
+        void *ptr = svmM.createSVMAlloc(256);
+        auto chunk = svmM.getSVMAlloc(ptr);
+        chunk->taskCount = 2;
+
+        svmM.freeSVMAlloc(ptr);
+        void *ptrWhileBusy = svmM.createSVMAlloc(256);
+        EXPECT_NE(ptr, ptrWhileBusy);
+        EXPECT_EQ(chunk, svmM.getSVMAlloc(ptrWhileBusy));
+
+        gpuTag = 2;
+        EXPECT_EQ(ptr, svmM.createSVMAlloc(256));
+
+        svmM.freeSVMAlloc(ptr);
+        svmM.freeSVMAlloc(ptrWhileBusy);
+    }
+    umm.csr = nullptr;
+}
+
+TEST_F(SVMMemoryAllocatorTest, givenNeighbouringPooledAllocationsWhenRangeIsLookedUpThenItIsValidatedAgainstOwnBlock) {
+    OsAgnosticMemoryManager umm;
+    {
+        SVMAllocsManager svmM(&umm);
+        char *ptr1 = (char *)svmM.createSVMAlloc(256);
+        char *ptr2 = (char *)svmM.createSVMAlloc(256);
+        ASSERT_EQ(ptr1 + 256, ptr2);
+
+        SVMAllocsManager::SvmAllocationData allocData;
+        ASSERT_TRUE(svmM.getSVMAllocData(ptr1 + 10, allocData));
+        EXPECT_EQ(ptr1, allocData.baseAddress);
+        EXPECT_EQ(256u, allocData.size);
+        EXPECT_EQ(svmM.getSVMAlloc(ptr1), allocData.gpuAllocation);
+
+        EXPECT_NE(nullptr, svmM.getSVMAlloc(ptr1, 256));
+        EXPECT_NE(nullptr, svmM.getSVMAlloc(ptr1 + 128, 128));
+        EXPECT_EQ(nullptr, svmM.getSVMAlloc(ptr1, 257));
+        EXPECT_EQ(nullptr, svmM.getSVMAlloc(ptr1 + 128, 129));
+        EXPECT_NE(nullptr, svmM.getSVMAlloc(ptr2, 256));
+
+        svmM.freeSVMAlloc(ptr2);
+        EXPECT_FALSE(svmM.getSVMAllocData(ptr2, allocData));
+        svmM.freeSVMAlloc(ptr1);
+    }
+}
+
+TEST_F(SVMMemoryAllocatorTest, givenDedicatedAllocationWhenRangeIsLookedUpThenItIsValidatedAgainstAllocationSize) {
+    OsAgnosticMemoryManager umm;
+    {
+        SVMAllocsManager svmM(&umm);
+        char *ptr = (char *)svmM.createSVMAlloc(4096);
+        auto GA = svmM.getSVMAlloc(ptr);
+        ASSERT_NE(nullptr, GA);
+
+        EXPECT_EQ(GA, svmM.getSVMAlloc(ptr, GA->getUnderlyingBufferSize()));
+        EXPECT_EQ(nullptr, svmM.getSVMAlloc(ptr + 1, GA->getUnderlyingBufferSize()));
+        EXPECT_EQ(GA, svmM.getSVMAlloc(ptr + 1, 0));
+        svmM.freeSVMAlloc(ptr);
+    }
+}
+
+TEST_F(SVMMemoryAllocatorTest, givenFullChunkWhenAllocatingThenNewChunkIsAdded) {
+    OsAgnosticMemoryManager umm;
+    {
+        SVMAllocsManager svmM(&umm);
+        auto blocksPerChunk = SVMAllocsManager::poolChunkSize / SVMAllocsManager::maxPooledSize;
+        std::vector<void *> ptrs;
+        for (size_t i = 0; i <= blocksPerChunk; i++) {
+            ptrs.push_back(svmM.createSVMAlloc(SVMAllocsManager::maxPooledSize));
+        }
+        EXPECT_EQ(svmM.getSVMAlloc(ptrs[0]), svmM.getSVMAlloc(ptrs[blocksPerChunk - 1]));
+        EXPECT_NE(svmM.getSVMAlloc(ptrs[0]), svmM.getSVMAlloc(ptrs[blocksPerChunk]));
+        EXPECT_EQ(blocksPerChunk + 1, svmM.getNumAllocs());
+
+        for (auto ptr : ptrs) {
+            svmM.freeSVMAlloc(ptr);
+        }
+    }
+}
+
+TEST(SVMRangeAllocationTrackerTest, givenManyAllocationsInsertedOutOfOrderWhenLookedUpThenEachRangeIsFound) {
+    const size_t numAllocations = 200;
+    char memory[numAllocations * 2];
+    std::vector<std::unique_ptr<GraphicsAllocation>> allocations;
+    SVMAllocsManager::RangeAllocationTracker tracker;
+    for (size_t i = 0; i < numAllocations; i++) {
+        auto index = (i * 7) % numAllocations;
+        allocations.emplace_back(new GraphicsAllocation(memory + index * 2, 1));
+        tracker.insert(*allocations.back());
+    }
+    EXPECT_EQ(numAllocations, tracker.getNumAllocs());
+
+    for (size_t i = 0; i < numAllocations; i++) {
+        auto allocation = tracker.get(memory + i * 2);
+        ASSERT_NE(nullptr, allocation);
+        EXPECT_EQ(memory + i * 2, allocation->getUnderlyingBuffer());
+        EXPECT_EQ(nullptr, tracker.get(memory + i * 2 + 1));
+    }
+
+    for (auto &allocation : allocations) {
+        tracker.remove(*allocation);
+        EXPECT_EQ(nullptr, tracker.get(allocation->getUnderlyingBuffer()));
+    }
+    EXPECT_EQ(0u, tracker.getNumAllocs());
+}
+
+TEST(SVMRangeAllocationTrackerTest, givenConcurrentWriterWhenReadersLookUpStableRangeThenItIsAlwaysFound) {
+    char stableMemory[64];
+    char churnMemory[256];
+    GraphicsAllocation stableAllocation(stableMemory, sizeof(stableMemory));
+    std::vector<std::unique_ptr<GraphicsAllocation>> churnAllocations;
+    for (size_t i = 0; i < sizeof(churnMemory); i++) {
+        churnAllocations.emplace_back(new GraphicsAllocation(churnMemory + i, 1));
+    }
+
+    SVMAllocsManager::RangeAllocationTracker tracker;
+    tracker.insert(stableAllocation);
+
+    std::atomic<bool> done(false);
+    std::atomic<size_t> misses(0);
+    auto reader = [&]() {
+        while (!done) {
+            if (tracker.get(stableMemory + 32) != &stableAllocation) {
+                misses++;
+            }
+        }
+    };
+    std::thread readerThread(reader);
+    for (int iteration = 0; iteration < 20; iteration++) {
+        for (auto &allocation : churnAllocations) {
+            tracker.insert(*allocation);
+        }
+        for (auto &allocation : churnAllocations) {
+            tracker.remove(*allocation);
+        }
+    }
+    done = true;
+    readerThread.join();
+
+    EXPECT_EQ(0u, misses.load());
+    EXPECT_EQ(1u, tracker.getNumAllocs());
+}
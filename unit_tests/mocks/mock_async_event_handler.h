@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017, Intel Corporation
+ * Copyright (c) 2017 - 2018, Intel Corporation
  *
  * Permission is hereby granted, free of charge, to any person obtaining a
  * copy of this software and associated documentation files (the "Software"),
@@ -37,6 +37,8 @@ class MockHandler : public AsyncEventsHandler {
     using AsyncEventsHandler::allowAsyncProcess;
     using AsyncEventsHandler::asyncMtx;
     using AsyncEventsHandler::asyncProcess;
+    using AsyncEventsHandler::csrHeaps;
+    using AsyncEventsHandler::eventsInCsrHeaps;
     using AsyncEventsHandler::openThread;
     using AsyncEventsHandler::thread;
 
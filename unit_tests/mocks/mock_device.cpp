@@ -63,6 +63,7 @@ void MockDevice::injectMemoryManager(MockMemoryManager *memoryManager) {
 
 void MockDevice::resetCommandStreamReceiver(CommandStreamReceiver *newCsr) {
     if (commandStreamReceiver) {
+        commandStreamReceiver->closeAdaptiveDispatcher();
         delete commandStreamReceiver;
     }
     commandStreamReceiver = newCsr;
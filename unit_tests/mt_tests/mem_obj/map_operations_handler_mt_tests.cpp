@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/helpers/ptr_math.h"
+#include "runtime/mem_obj/map_operations_handler.h"
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace OCLRT;
+
+struct MapOperationsHandlerFindTest : public ::testing::Test,
+                                      public ::testing::WithParamInterface<int /*reader count*/> {
+    static const size_t tiles = 512;
+    static const size_t tileStride = 0x100;
+    static const int iterations = 50;
+
+    static void *getTilePtr(size_t tile) {
+        return ptrOffset(reinterpret_cast<void *>(0x10000000), tile * tileStride);
+    }
+
+    static void mapTile(MapOperationsHandler *handler, size_t tile) {
+        cl_map_flags mapFlags = CL_MAP_WRITE;
+        MemObjSizeArray size = {{tile, 1, 1}};
+        MemObjOffsetArray offset = {{0, 0, 0}};
+        handler->add(getTilePtr(tile), 0x80, mapFlags, size, offset);
+    }
+
+    static void readerMethod(MapOperationsHandler *handler, std::atomic<bool> *start, std::atomic<bool> *done, std::atomic<int> *errors) {
+        while (!*start)
+            ;
+        while (!*done) {
+            for (size_t tile = 0; tile < tiles; tile++) {
+                MapInfo mapInfo;
+                bool found = handler->find(getTilePtr(tile), mapInfo);
+                // even tiles stay mapped, odd ones are remapped by the writer and may be missing
+                if ((!found && tile % 2 == 0) || (found && (mapInfo.ptr != getTilePtr(tile) || mapInfo.size[0] != tile))) {
+                    (*errors)++;
+                }
+            }
+        }
+    }
+};
+
+TEST_P(MapOperationsHandlerFindTest, givenWriterMappingAndUnmappingWhenFindingConcurrentlyThenMapInfoIsNeverTorn) {
+    auto readerCount = GetParam();
+    MapOperationsHandler handler;
+    std::atomic<bool> start(false);
+    std::atomic<bool> done(false);
+    std::atomic<int> errors(0);
+
+    for (size_t tile = 0; tile < tiles; tile += 2) {
+        mapTile(&handler, tile);
+    }
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < readerCount; i++) {
+        threads.push_back(std::thread(readerMethod, &handler, &start, &done, &errors));
+    }
+
+    start = true;
+    for (int i = 0; i < iterations; i++) {
+        for (size_t tile = 1; tile < tiles; tile += 2) {
+            mapTile(&handler, tile);
+        }
+        for (size_t tile = 1; tile < tiles; tile += 2) {
+            handler.remove(getTilePtr(tile));
+        }
+    }
+    done = true;
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(0, errors);
+    EXPECT_EQ(tiles / 2, handler.size());
+}
+
+int readerCountsForMapOperationsHandlerFindTest[] = {1, 2, 4, 8};
+
+INSTANTIATE_TEST_CASE_P(MapOperationsHandlerMT,
+                        MapOperationsHandlerFindTest,
+                        ::testing::ValuesIn(readerCountsForMapOperationsHandlerFindTest));
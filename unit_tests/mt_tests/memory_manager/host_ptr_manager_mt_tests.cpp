@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/helpers/ptr_math.h"
+#include "runtime/memory_manager/host_ptr_manager.h"
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace OCLRT;
+
+struct HostPtrManagerStressTest : public ::testing::Test,
+                                  public ::testing::WithParamInterface<int /*thread count*/> {
+    static const int iterations = 2000;
+    static const int fragmentsPerThread = 8;
+
+    static void threadMethod(HostPtrManager *hostPtrManager, int threadId, void *sharedPtr, std::atomic<bool> *start, std::atomic<int> *errors) {
+        auto regionSize = static_cast<size_t>(1) << HostPtrManager::regionShift;
+        // every thread works in its own regions, fragments cross region boundaries
+        auto threadBase = (threadId + 1) * fragmentsPerThread * regionSize;
+
+        while (!*start)
+            ;
+        for (int i = 0; i < iterations; i++) {
+            for (int f = 0; f < fragmentsPerThread; f++) {
+                FragmentStorage fragment;
+                fragment.fragmentCpuPointer = reinterpret_cast<void *>(threadBase + f * regionSize + regionSize / 2);
+                fragment.fragmentSize = regionSize / 2 + MemoryConstants::pageSize * (i % 4 + 1);
+                hostPtrManager->storeFragment(fragment);
+            }
+
+            OverlapStatus overlapStatus;
+            for (int f = 0; f < fragmentsPerThread; f++) {
+                auto ptr = reinterpret_cast<void *>(threadBase + (f + 1) * regionSize);
+                auto fragment = hostPtrManager->getFragmentAndCheckForOverlaps(ptr, MemoryConstants::pageSize, overlapStatus);
+                if (fragment == nullptr || overlapStatus != OverlapStatus::FRAGMENT_WITHIN_STORED_FRAGMENT) {
+                    (*errors)++;
+                }
+            }
+
+            FragmentStorage sharedFragment;
+            sharedFragment.fragmentCpuPointer = sharedPtr;
+            sharedFragment.fragmentSize = MemoryConstants::pageSize;
+            hostPtrManager->storeFragment(sharedFragment);
+            if (hostPtrManager->getFragmentAndCheckForOverlaps(sharedPtr, MemoryConstants::pageSize, overlapStatus) == nullptr) {
+                (*errors)++;
+            }
+            hostPtrManager->releaseHostPtr(sharedPtr);
+
+            for (int f = 0; f < fragmentsPerThread; f++) {
+                auto ptr = reinterpret_cast<void *>(threadBase + f * regionSize + regionSize / 2);
+                if (!hostPtrManager->releaseHostPtr(ptr)) {
+                    (*errors)++;
+                }
+            }
+        }
+    }
+};
+
+TEST_P(HostPtrManagerStressTest, givenManyThreadsStoringQueryingAndReleasingFragmentsThenManagerStaysConsistent) {
+    auto threadCount = GetParam();
+    HostPtrManager hostPtrManager;
+    std::atomic<bool> start(false);
+    std::atomic<int> errors(0);
+    void *sharedPtr = reinterpret_cast<void *>(MemoryConstants::pageSize);
+
+    // keep the shared fragment alive so releases from worker threads never drop it
+    FragmentStorage sharedFragment;
+    sharedFragment.fragmentCpuPointer = sharedPtr;
+    sharedFragment.fragmentSize = MemoryConstants::pageSize;
+    hostPtrManager.storeFragment(sharedFragment);
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < threadCount; i++) {
+        threads.push_back(std::thread(threadMethod, &hostPtrManager, i, sharedPtr, &start, &errors));
+    }
+    start = true;
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(0, errors);
+    EXPECT_EQ(1u, hostPtrManager.getFragmentCount());
+    auto fragment = hostPtrManager.getFragment(sharedPtr);
+    ASSERT_NE(nullptr, fragment);
+    EXPECT_EQ(1, fragment->refCount);
+    EXPECT_TRUE(hostPtrManager.releaseHostPtr(sharedPtr));
+    EXPECT_EQ(0u, hostPtrManager.getFragmentCount());
+}
+
+int threadCountsForHostPtrManagerStressTest[] = {1, 2, 4, 8};
+
+INSTANTIATE_TEST_CASE_P(HostPtrManagerMT,
+                        HostPtrManagerStressTest,
+                        ::testing::ValuesIn(threadCountsForHostPtrManagerStressTest));
@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/memory_manager/os_agnostic_memory_manager.h"
+#include "runtime/utilities/tag_allocator.h"
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace OCLRT;
+
+struct TagAllocatorContentionTest : public ::testing::Test,
+                                    public ::testing::WithParamInterface<int /*thread count*/> {
+    struct TestTag {
+        uint64_t owner;
+        uint64_t sequence;
+    };
+    using TestTagAllocator = TagAllocator<TestTag>;
+
+    static const int iterations = 20000;
+    static const int tagsHeldPerThread = 4;
+
+    static void threadMethod(TestTagAllocator *allocator, int threadId, std::atomic<bool> *start, std::atomic<int> *errors) {
+        TagNode<TestTag> *nodes[tagsHeldPerThread];
+
+        while (!*start)
+            ;
+        for (int i = 0; i < iterations; i++) {
+            for (int n = 0; n < tagsHeldPerThread; n++) {
+                nodes[n] = allocator->getTag();
+                if (nodes[n] == nullptr) {
+                    (*errors)++;
+                    return;
+                }
+                nodes[n]->tag->owner = threadId;
+                nodes[n]->tag->sequence = i;
+            }
+            // a tag handed out to two threads at once gets overwritten by the other one
+            for (int n = 0; n < tagsHeldPerThread; n++) {
+                if (nodes[n]->tag->owner != static_cast<uint64_t>(threadId) || nodes[n]->tag->sequence != static_cast<uint64_t>(i)) {
+                    (*errors)++;
+                }
+                allocator->returnTag(nodes[n]);
+            }
+        }
+    }
+};
+
+TEST_P(TagAllocatorContentionTest, givenManyThreadsGettingAndReturningTagsThenEachTagIsOwnedByOneThreadAtATime) {
+    auto threadCount = GetParam();
+    OsAgnosticMemoryManager memoryManager;
+    std::atomic<bool> start(false);
+    std::atomic<int> errors(0);
+    {
+        // pool is smaller than the number of tags held at once, so threads also race on pool growth
+        TestTagAllocator allocator(&memoryManager, 8, 64, 0);
+
+        std::vector<std::thread> threads;
+        for (int i = 0; i < threadCount; i++) {
+            threads.push_back(std::thread(threadMethod, &allocator, i, &start, &errors));
+        }
+
+        start = true;
+        for (auto &thread : threads) {
+            thread.join();
+        }
+    }
+
+    EXPECT_EQ(0, errors);
+}
+
+int threadCountsForTagAllocatorContentionTest[] = {1, 2, 4, 8};
+
+INSTANTIATE_TEST_CASE_P(TagAllocatorMT,
+                        TagAllocatorContentionTest,
+                        ::testing::ValuesIn(threadCountsForTagAllocatorContentionTest));
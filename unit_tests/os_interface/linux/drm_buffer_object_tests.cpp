@@ -110,6 +110,36 @@ TEST_F(DrmBufferObjectTest, givenDrmWithCoherencyPatchActiveWhenExecIsCalledWith
     EXPECT_EQ(expectedFlag, currentFlag);
 }
 
+TEST_F(DrmBufferObjectTest, givenExecObjectsVersionsWhenExecIsCalledAgainThenOnlyChangedResidencyEntriesAreFilled) {
+    mock->ioctl_expected.total = 3;
+    mock->ioctl_res = 0;
+
+    TestedBufferObject residentBo(this->mock);
+    residentBo.softPin(0x1000);
+    std::vector<BufferObject *> residency = {&residentBo};
+    bo->swapResidencyVector(&residency);
+
+    uint64_t execObjectsVersions[256] = {};
+    bo->setExecObjectsVersions(execObjectsVersions);
+
+    bo->exec(0, 0, 0);
+    EXPECT_EQ(2u, bo->peekExecObjectsFilled());
+    EXPECT_EQ(&execObjectsStorage[0], residentBo.execObjectPointerFilled);
+    EXPECT_EQ(0x1000u, execObjectsStorage[0].offset);
+
+    residentBo.execObjectPointerFilled = nullptr;
+    bo->exec(0, 0, 0);
+    EXPECT_EQ(1u, bo->peekExecObjectsFilled());
+    EXPECT_EQ(nullptr, residentBo.execObjectPointerFilled);
+
+    residentBo.softPin(0x2000);
+    bo->exec(0, 0, 0);
+    EXPECT_EQ(2u, bo->peekExecObjectsFilled());
+    EXPECT_EQ(0x2000u, execObjectsStorage[0].offset);
+
+    bo->getResidency()->clear();
+}
+
 TEST_F(DrmBufferObjectTest, exec_ioctlFailed) {
     mock->ioctl_expected.total = 1;
     mock->ioctl_res = -1;
@@ -940,6 +940,142 @@ TEST_F(DrmCommandStreamGemWorkerTests, givenDrmCsrCreatedWithInactiveGemCloseWor
     EXPECT_EQ(gemCloseWorkerMode::gemCloseWorkerInactive, testedCsr.peekGemCloseWorkerOperationMode());
 }
 
+TEST_F(DrmCommandStreamGemWorkerTests, givenAllocationPassedTwiceWhenResidencyIsProcessedThenBufferObjectIsAddedOnce) {
+    tCsr->overrideGemCloseWorkerOperationMode(gemCloseWorkerMode::gemCloseWorkerInactive);
+
+    auto allocation = mm->allocateGraphicsMemory(1024, 4096);
+    ASSERT_NE(nullptr, allocation);
+
+    ResidencyContainer residencyList;
+    residencyList.push_back(allocation);
+    residencyList.push_back(allocation);
+
+    csr->makeResident(*allocation);
+    tCsr->processResidency(&residencyList);
+    EXPECT_EQ(1u, tCsr->getResidencyVector()->size());
+    EXPECT_EQ(1u, tCsr->peekResidencyStats().duplicatesSkipped);
+
+    tCsr->processResidency(&residencyList);
+    EXPECT_EQ(1u, tCsr->getResidencyVector()->size());
+    EXPECT_EQ(3u, tCsr->peekResidencyStats().duplicatesSkipped);
+
+    csr->makeNonResident(*allocation);
+    EXPECT_EQ(0u, tCsr->getResidencyVector()->size());
+
+    csr->makeResident(*allocation);
+    tCsr->processResidency(&residencyList);
+    EXPECT_EQ(1u, tCsr->getResidencyVector()->size());
+
+    csr->makeNonResident(*allocation);
+    mm->freeGraphicsMemory(allocation);
+}
+
+TEST_F(DrmCommandStreamGemWorkerTests, givenTwoCsrsSharingBufferObjectWhenResidencyIsProcessedThenBufferObjectIsAddedToBoth) {
+    tCsr->overrideGemCloseWorkerOperationMode(gemCloseWorkerMode::gemCloseWorkerInactive);
+    TestedDrmCommandStreamReceiver<DEFAULT_TEST_FAMILY_NAME> secondCsr(mock, gemCloseWorkerMode::gemCloseWorkerInactive);
+
+    auto allocation = mm->allocateGraphicsMemory(1024, 4096);
+    ASSERT_NE(nullptr, allocation);
+    auto bo = static_cast<DrmAllocation *>(allocation)->getBO();
+
+    ResidencyContainer residencyList;
+    residencyList.push_back(allocation);
+
+    tCsr->processResidency(&residencyList);
+    secondCsr.processResidency(&residencyList);
+    EXPECT_TRUE(tCsr->isResident(bo));
+    EXPECT_TRUE(secondCsr.isResident(bo));
+    EXPECT_EQ(0u, secondCsr.peekResidencyStats().duplicatesSkipped);
+
+    tCsr->getResidencyVector()->clear();
+    secondCsr.getResidencyVector()->clear();
+    mm->freeGraphicsMemory(allocation);
+}
+
+TEST_F(DrmCommandStreamGemWorkerTests, givenUnchangedResidencyWhenFlushedAgainThenOnlyBatchBufferExecObjectIsFilled) {
+    tCsr->overrideGemCloseWorkerOperationMode(gemCloseWorkerMode::gemCloseWorkerInactive);
+
+    auto commandBuffer = mm->allocateGraphicsMemory(1024, 4096);
+    auto allocation1 = mm->allocateGraphicsMemory(1024, 4096);
+    auto allocation2 = mm->allocateGraphicsMemory(1024, 4096);
+    ASSERT_NE(nullptr, commandBuffer);
+    ASSERT_NE(nullptr, allocation1);
+    ASSERT_NE(nullptr, allocation2);
+    LinearStream cs(commandBuffer);
+    csr->addBatchBufferEnd(cs, nullptr);
+    csr->alignToCacheLine(cs);
+
+    ResidencyContainer residencyList;
+    residencyList.push_back(allocation1);
+    residencyList.push_back(allocation2);
+
+    BatchBuffer batchBuffer{cs.getGraphicsAllocation(), 0, 0, nullptr, false, false, QueueThrottle::MEDIUM, cs.getUsed(), &cs};
+    csr->flush(batchBuffer, EngineType::ENGINE_RCS, &residencyList);
+    EXPECT_EQ(3u, tCsr->peekResidencyStats().lastFlushExecObjects);
+    EXPECT_EQ(3u, tCsr->peekResidencyStats().lastFlushExecObjectsFilled);
+
+    csr->flush(batchBuffer, EngineType::ENGINE_RCS, &residencyList);
+    EXPECT_EQ(3u, this->mock->execBuffer.buffer_count);
+    EXPECT_EQ(3u, tCsr->peekResidencyStats().lastFlushExecObjects);
+    EXPECT_EQ(1u, tCsr->peekResidencyStats().lastFlushExecObjectsFilled);
+
+    auto &execStorage = tCsr->getExecStorage();
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(allocation1->getUnderlyingBuffer()), execStorage[0].offset);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(allocation2->getUnderlyingBuffer()), execStorage[1].offset);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(commandBuffer->getUnderlyingBuffer()), execStorage[2].offset);
+
+    EXPECT_EQ(2u, tCsr->peekResidencyStats().flushes);
+    EXPECT_EQ(6u, tCsr->peekResidencyStats().execObjects);
+    EXPECT_EQ(4u, tCsr->peekResidencyStats().execObjectsFilled);
+
+    mm->freeGraphicsMemory(allocation1);
+    mm->freeGraphicsMemory(allocation2);
+    mm->freeGraphicsMemory(commandBuffer);
+}
+
+TEST_F(DrmCommandStreamGemWorkerTests, givenChangedResidencyWhenFlushedAgainThenOnlyChangedExecObjectsAreFilled) {
+    tCsr->overrideGemCloseWorkerOperationMode(gemCloseWorkerMode::gemCloseWorkerInactive);
+
+    auto commandBuffer = mm->allocateGraphicsMemory(1024, 4096);
+    auto allocation1 = mm->allocateGraphicsMemory(1024, 4096);
+    auto allocation2 = mm->allocateGraphicsMemory(1024, 4096);
+    auto allocation3 = mm->allocateGraphicsMemory(1024, 4096);
+    ASSERT_NE(nullptr, commandBuffer);
+    ASSERT_NE(nullptr, allocation1);
+    ASSERT_NE(nullptr, allocation2);
+    ASSERT_NE(nullptr, allocation3);
+    LinearStream cs(commandBuffer);
+    csr->addBatchBufferEnd(cs, nullptr);
+    csr->alignToCacheLine(cs);
+
+    ResidencyContainer residencyList;
+    residencyList.push_back(allocation1);
+    residencyList.push_back(allocation2);
+
+    BatchBuffer batchBuffer{cs.getGraphicsAllocation(), 0, 0, nullptr, false, false, QueueThrottle::MEDIUM, cs.getUsed(), &cs};
+    csr->flush(batchBuffer, EngineType::ENGINE_RCS, &residencyList);
+
+    residencyList[1] = allocation3;
+    csr->flush(batchBuffer, EngineType::ENGINE_RCS, &residencyList);
+    EXPECT_EQ(2u, tCsr->peekResidencyStats().lastFlushExecObjectsFilled);
+
+    auto &execStorage = tCsr->getExecStorage();
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(allocation1->getUnderlyingBuffer()), execStorage[0].offset);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(allocation3->getUnderlyingBuffer()), execStorage[1].offset);
+
+    residencyList.push_back(allocation2);
+    csr->flush(batchBuffer, EngineType::ENGINE_RCS, &residencyList);
+    EXPECT_EQ(4u, this->mock->execBuffer.buffer_count);
+    EXPECT_EQ(2u, tCsr->peekResidencyStats().lastFlushExecObjectsFilled);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(allocation2->getUnderlyingBuffer()), execStorage[2].offset);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(commandBuffer->getUnderlyingBuffer()), execStorage[3].offset);
+
+    mm->freeGraphicsMemory(allocation1);
+    mm->freeGraphicsMemory(allocation2);
+    mm->freeGraphicsMemory(allocation3);
+    mm->freeGraphicsMemory(commandBuffer);
+}
+
 typedef Test<DrmCommandStreamEnhancedFixture> DrmCommandStreamBatchingTests;
 
 TEST_F(DrmCommandStreamBatchingTests, givenCSRWhenFlushIsCalledThenProperFlagsArePassed) {
@@ -42,6 +42,7 @@
 #include "unit_tests/os_interface/linux/device_command_stream_fixture.h"
 #include "runtime/os_interface/32bit_memory.h"
 #include "unit_tests/mocks/mock_32bitAllocator.h"
+#include "unit_tests/mocks/mock_csr.h"
 #include "unit_tests/mocks/mock_device.h"
 #include "unit_tests/mocks/mock_gmm.h"
 #include "drm/i915_drm.h"
@@ -79,6 +80,7 @@ int closeMock(int) {
 class TestedDrmMemoryManager : public DrmMemoryManager {
   public:
     using DrmMemoryManager::allocUserptr;
+    using DrmMemoryManager::bufferObjectCacheSizeLimit;
     using DrmMemoryManager::setDomainCpu;
 
     TestedDrmMemoryManager(Drm *drm) : DrmMemoryManager(drm, gemCloseWorkerMode::gemCloseWorkerConsumingCommandBuffers, false, false) {
@@ -171,7 +173,27 @@ class DrmMemoryManagerFixtureWithoutQuietIoctlExpectation : public MemoryManagem
     DrmMockCustom::IoctlResExt ioctlResExt = {0, 0};
 };
 
+class DrmMemoryManagerWithCsrFixture : public DrmMemoryManagerFixture {
+  public:
+    std::unique_ptr<MockCommandStreamReceiver> csr;
+    uint32_t tagValue = 1;
+
+    void SetUp() override {
+        DrmMemoryManagerFixture::SetUp();
+        csr.reset(new MockCommandStreamReceiver);
+        csr->tagAddress = &tagValue;
+        memoryManager->csr = csr.get();
+    }
+
+    void TearDown() override {
+        memoryManager->csr = nullptr;
+        csr.reset();
+        DrmMemoryManagerFixture::TearDown();
+    }
+};
+
 typedef Test<DrmMemoryManagerFixture> DrmMemoryManagerTest;
+typedef Test<DrmMemoryManagerWithCsrFixture> DrmMemoryManagerBufferObjectCacheTest;
 typedef Test<DrmMemoryManagerFixtureWithoutQuietIoctlExpectation> DrmMemoryManagerWithExplicitExpectationsTest;
 
 TEST_F(DrmMemoryManagerWithExplicitExpectationsTest, givenDefaultDrmMemoryMangerWhenItIsCreatedThenItContainsInternal32BitAllocator) {
@@ -2617,3 +2639,185 @@ TEST_F(DrmMemoryManagerWithExplicitExpectationsTest, givenEnabledValidateHostMem
 
     testedMemoryManager->cleanOsHandles(handleStorage);
 }
+
+TEST_F(DrmMemoryManagerBufferObjectCacheTest, givenMemoryManagerWithoutCsrWhenAllocationIsFreedThenBufferObjectIsClosed) {
+    mock->ioctl_expected.gemUserptr = 1;
+    mock->ioctl_expected.gemWait = 1;
+    mock->ioctl_expected.gemClose = 1;
+
+    memoryManager->csr = nullptr;
+    auto allocation = memoryManager->allocateGraphicsMemory(MemoryConstants::pageSize, MemoryConstants::pageSize);
+    ASSERT_NE(nullptr, allocation);
+    memoryManager->freeGraphicsMemory(allocation);
+
+    EXPECT_EQ(0u, memoryManager->peekBufferObjectCacheSize());
+}
+
+TEST_F(DrmMemoryManagerBufferObjectCacheTest, givenCompletedAllocationWhenSameSizeIsAllocatedThenBufferObjectIsReused) {
+    mock->ioctl_expected.gemUserptr = 1;
+    mock->ioctl_expected.gemWait = 1;
+    mock->ioctl_expected.gemClose = 1;
+
+    auto allocation = memoryManager->allocateGraphicsMemory(MemoryConstants::pageSize, MemoryConstants::pageSize);
+    ASSERT_NE(nullptr, allocation);
+    auto bo = allocation->getBO();
+    auto cpuPtr = allocation->getUnderlyingBuffer();
+    allocation->taskCount = tagValue;
+    memoryManager->freeGraphicsMemory(allocation);
+    EXPECT_EQ(MemoryConstants::pageSize, memoryManager->peekBufferObjectCacheSize());
+
+    auto reusedAllocation = memoryManager->allocateGraphicsMemory(MemoryConstants::pageSize, MemoryConstants::pageSize);
+    ASSERT_NE(nullptr, reusedAllocation);
+    EXPECT_EQ(bo, reusedAllocation->getBO());
+    EXPECT_EQ(cpuPtr, reusedAllocation->getUnderlyingBuffer());
+    EXPECT_EQ(MemoryConstants::pageSize, reusedAllocation->getUnderlyingBufferSize());
+    EXPECT_EQ(0u, memoryManager->peekBufferObjectCacheSize());
+
+    auto stats = memoryManager->peekBufferObjectCacheStats();
+    EXPECT_EQ(1u, stats.hits);
+    EXPECT_EQ(1u, stats.misses);
+
+    memoryManager->freeGraphicsMemory(reusedAllocation);
+}
+
+TEST_F(DrmMemoryManagerBufferObjectCacheTest, givenNotCompletedAllocationWhenSameSizeIsAllocatedThenNewBufferObjectIsCreatedUntilTaskCountCompletes) {
+    mock->ioctl_expected.gemUserptr = 2;
+    mock->ioctl_expected.gemWait = 2;
+    mock->ioctl_expected.gemClose = 2;
+
+    auto allocation = memoryManager->allocateGraphicsMemory(MemoryConstants::pageSize, MemoryConstants::pageSize);
+    ASSERT_NE(nullptr, allocation);
+    auto bo = allocation->getBO();
+    allocation->taskCount = tagValue + 1;
+    memoryManager->freeGraphicsMemory(allocation);
+
+    auto newAllocation = memoryManager->allocateGraphicsMemory(MemoryConstants::pageSize, MemoryConstants::pageSize);
+    ASSERT_NE(nullptr, newAllocation);
+    EXPECT_NE(bo, newAllocation->getBO());
+
+    tagValue++;
+    auto reusedAllocation = memoryManager->allocateGraphicsMemory(MemoryConstants::pageSize, MemoryConstants::pageSize);
+    ASSERT_NE(nullptr, reusedAllocation);
+    EXPECT_EQ(bo, reusedAllocation->getBO());
+
+    auto stats = memoryManager->peekBufferObjectCacheStats();
+    EXPECT_EQ(1u, stats.hits);
+    EXPECT_EQ(2u, stats.misses);
+
+    memoryManager->freeGraphicsMemory(newAllocation);
+    memoryManager->freeGraphicsMemory(reusedAllocation);
+}
+
+TEST_F(DrmMemoryManagerBufferObjectCacheTest, givenCachedBufferObjectWhenDifferentSizeIsAllocatedThenItIsNotReused) {
+    mock->ioctl_expected.gemUserptr = 2;
+    mock->ioctl_expected.gemWait = 2;
+    mock->ioctl_expected.gemClose = 2;
+
+    auto allocation = memoryManager->allocateGraphicsMemory(MemoryConstants::pageSize, MemoryConstants::pageSize);
+    ASSERT_NE(nullptr, allocation);
+    auto bo = allocation->getBO();
+    memoryManager->freeGraphicsMemory(allocation);
+
+    auto biggerAllocation = memoryManager->allocateGraphicsMemory(2 * MemoryConstants::pageSize, MemoryConstants::pageSize);
+    ASSERT_NE(nullptr, biggerAllocation);
+    EXPECT_NE(bo, biggerAllocation->getBO());
+    EXPECT_EQ(MemoryConstants::pageSize, memoryManager->peekBufferObjectCacheSize());
+
+    memoryManager->freeGraphicsMemory(biggerAllocation);
+}
+
+TEST_F(DrmMemoryManagerBufferObjectCacheTest, givenAllocationBiggerThanMaxCachedSizeWhenItIsFreedThenBufferObjectIsClosed) {
+    mock->ioctl_expected.gemUserptr = 1;
+    mock->ioctl_expected.gemWait = 1;
+    mock->ioctl_expected.gemClose = 1;
+
+    auto allocation = memoryManager->allocateGraphicsMemory(DrmMemoryManager::maxCachedBufferObjectSize + MemoryConstants::pageSize, MemoryConstants::pageSize);
+    ASSERT_NE(nullptr, allocation);
+    memoryManager->freeGraphicsMemory(allocation);
+
+    EXPECT_EQ(0u, memoryManager->peekBufferObjectCacheSize());
+    mock->testIoctls();
+}
+
+TEST_F(DrmMemoryManagerBufferObjectCacheTest, givenCacheSizeLimitWhenLimitIsExceededThenOldestBufferObjectsAreEvicted) {
+    mock->ioctl_expected.gemUserptr = 3;
+    mock->ioctl_expected.gemWait = 3;
+    mock->ioctl_expected.gemClose = 3;
+
+    memoryManager->bufferObjectCacheSizeLimit = 3 * MemoryConstants::pageSize;
+
+    auto allocation1 = memoryManager->allocateGraphicsMemory(MemoryConstants::pageSize, MemoryConstants::pageSize);
+    auto allocation2 = memoryManager->allocateGraphicsMemory(2 * MemoryConstants::pageSize, MemoryConstants::pageSize);
+    auto allocation3 = memoryManager->allocateGraphicsMemory(MemoryConstants::pageSize, MemoryConstants::pageSize);
+    ASSERT_NE(nullptr, allocation1);
+    ASSERT_NE(nullptr, allocation2);
+    ASSERT_NE(nullptr, allocation3);
+    auto bo2 = allocation2->getBO();
+    auto bo3 = allocation3->getBO();
+
+    memoryManager->freeGraphicsMemory(allocation1);
+    memoryManager->freeGraphicsMemory(allocation2);
+    EXPECT_EQ(3 * MemoryConstants::pageSize, memoryManager->peekBufferObjectCacheSize());
+    EXPECT_EQ(0, mock->ioctl_cnt.gemClose);
+
+    memoryManager->freeGraphicsMemory(allocation3);
+    EXPECT_EQ(3 * MemoryConstants::pageSize, memoryManager->peekBufferObjectCacheSize());
+    EXPECT_EQ(1u, memoryManager->peekBufferObjectCacheStats().evictions);
+    EXPECT_EQ(1, mock->ioctl_cnt.gemClose);
+
+    auto reusedAllocation2 = memoryManager->allocateGraphicsMemory(2 * MemoryConstants::pageSize, MemoryConstants::pageSize);
+    auto reusedAllocation3 = memoryManager->allocateGraphicsMemory(MemoryConstants::pageSize, MemoryConstants::pageSize);
+    EXPECT_EQ(bo2, reusedAllocation2->getBO());
+    EXPECT_EQ(bo3, reusedAllocation3->getBO());
+
+    memoryManager->freeGraphicsMemory(reusedAllocation2);
+    memoryManager->freeGraphicsMemory(reusedAllocation3);
+}
+
+TEST_F(DrmMemoryManagerBufferObjectCacheTest, givenCachedBufferObjectsWhenCacheIsTrimmedThenIdleBufferObjectsAreClosed) {
+    mock->ioctl_expected.gemUserptr = 2;
+    mock->ioctl_expected.gemWait = 2;
+    mock->ioctl_expected.gemClose = 2;
+
+    auto allocation1 = memoryManager->allocateGraphicsMemory(MemoryConstants::pageSize, MemoryConstants::pageSize);
+    auto allocation2 = memoryManager->allocateGraphicsMemory(MemoryConstants::pageSize, MemoryConstants::pageSize);
+    ASSERT_NE(nullptr, allocation1);
+    ASSERT_NE(nullptr, allocation2);
+    memoryManager->freeGraphicsMemory(allocation1);
+    memoryManager->freeGraphicsMemory(allocation2);
+    EXPECT_EQ(2 * MemoryConstants::pageSize, memoryManager->peekBufferObjectCacheSize());
+
+    memoryManager->trimBufferObjectCache(0);
+    EXPECT_EQ(0u, memoryManager->peekBufferObjectCacheSize());
+    EXPECT_EQ(2u, memoryManager->peekBufferObjectCacheStats().evictions);
+    mock->testIoctls();
+}
+
+TEST_F(DrmMemoryManagerBufferObjectCacheTest, givenDebugVariableDisablingCacheWhenAllocationIsFreedThenBufferObjectIsClosed) {
+    DebugManagerStateRestore restorer;
+    DebugManager.flags.EnableBufferObjectCache.set(0);
+
+    mock->ioctl_expected.gemUserptr = 1;
+    mock->ioctl_expected.gemWait = 1;
+    mock->ioctl_expected.gemClose = 1;
+
+    std::unique_ptr<TestedDrmMemoryManager> mm(new TestedDrmMemoryManager(this->mock));
+    mm->getgemCloseWorker()->close(true);
+    mm->csr = csr.get();
+    EXPECT_FALSE(mm->isBufferObjectCacheEnabled());
+
+    auto allocation = mm->allocateGraphicsMemory(MemoryConstants::pageSize, MemoryConstants::pageSize);
+    ASSERT_NE(nullptr, allocation);
+    mm->freeGraphicsMemory(allocation);
+    EXPECT_EQ(0u, mm->peekBufferObjectCacheSize());
+    mm->csr = nullptr;
+}
+
+TEST_F(DrmMemoryManagerBufferObjectCacheTest, givenDebugVariableOverridingCacheSizeLimitWhenMemoryManagerIsCreatedThenLimitIsApplied) {
+    DebugManagerStateRestore restorer;
+    DebugManager.flags.OverrideBufferObjectCacheSizeLimitMB.set(3);
+
+    std::unique_ptr<TestedDrmMemoryManager> mm(new TestedDrmMemoryManager(this->mock));
+    EXPECT_EQ(3 * MemoryConstants::megaByte, mm->bufferObjectCacheSizeLimit);
+    EXPECT_EQ(DrmMemoryManager::defaultBufferObjectCacheSizeLimit, memoryManager->bufferObjectCacheSizeLimit);
+}
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017, Intel Corporation
+ * Copyright (c) 2017 - 2018, Intel Corporation
  *
  * Permission is hereby granted, free of charge, to any person obtaining a
  * copy of this software and associated documentation files (the "Software"),
@@ -20,6 +20,7 @@
  * OTHER DEALINGS IN THE SOFTWARE.
  */
 
+#include "unit_tests/helpers/debug_manager_state_restore.h"
 #include "unit_tests/os_interface/linux/device_command_stream_fixture.h"
 #include "unit_tests/os_interface/linux/mock_os_time_linux.h"
 #include "runtime/os_interface/linux/drm_neo.h"
@@ -41,6 +42,28 @@ int getTimeFuncTrue(clockid_t clkId, struct timespec *tp) throw() {
     return 0;
 }
 
+static uint64_t modeledCpuTime = 0;
+
+int getTimeFuncModeled(clockid_t clkId, struct timespec *tp) throw() {
+    tp->tv_sec = modeledCpuTime / NSEC_PER_SEC;
+    tp->tv_nsec = modeledCpuTime % NSEC_PER_SEC;
+    return 0;
+}
+
+// GPU counter running at 12 ticks per microsecond of modeledCpuTime
+class DrmMockModeledTime : public DrmMockSuccess {
+  public:
+    int ioctl(unsigned long request, void *arg) override {
+        if (request == DRM_IOCTL_I915_REG_READ) {
+            regReads++;
+            reinterpret_cast<drm_i915_reg_read *>(arg)->val = modeledCpuTime * 12 / 1000 + gpuOffset;
+        }
+        return 0;
+    }
+    uint32_t regReads = 0;
+    uint64_t gpuOffset = 0;
+};
+
 int resolutionFuncFalse(clockid_t clkId, struct timespec *res) throw() {
     return -1;
 }
@@ -229,3 +252,84 @@ TEST_F(DrmTimeTest, givenAlwaysPassingResolutionFuncWhenGetCpuRawTimestampIsCall
     auto retVal = osTime->getCpuRawTimestamp();
     EXPECT_EQ(1ull, retVal);
 }
+
+TEST_F(DrmTimeTest, givenCalibratedTimestampModelWhenGetCpuGpuTimeIsCalledWithinResyncIntervalThenGpuCounterIsNotRead) {
+    DebugManagerStateRestore dbgRestore;
+    DebugManager.flags.GpuTimestampModelResyncInterval.set(10000);
+    std::unique_ptr<DrmMockModeledTime> drm(new DrmMockModeledTime);
+    osTime->setGetTimeFunc(getTimeFuncModeled);
+    modeledCpuTime = NSEC_PER_SEC;
+    osTime->updateDrm(drm.get());
+
+    auto model = osTime->getTimestampModel();
+    ASSERT_NE(nullptr, model);
+    EXPECT_EQ(10000000u, model->getResyncIntervalInNs());
+    EXPECT_EQ(TimestampModel::defaultErrorBoundInNs, model->getErrorBoundInNs());
+
+    TimeStampData timestamp = {0, 0};
+    drm->regReads = 0;
+    EXPECT_TRUE(osTime->getCpuGpuTime(&timestamp));
+    modeledCpuTime += 2000000;
+    EXPECT_TRUE(osTime->getCpuGpuTime(&timestamp));
+    EXPECT_EQ(2u, drm->regReads);
+    EXPECT_TRUE(model->isCalibrated());
+
+    for (int i = 0; i < 10; i++) {
+        modeledCpuTime += 500000;
+        EXPECT_TRUE(osTime->getCpuGpuTime(&timestamp));
+        EXPECT_EQ(modeledCpuTime, timestamp.CPUTimeinNS);
+        EXPECT_NEAR(static_cast<double>(modeledCpuTime * 12 / 1000), static_cast<double>(timestamp.GPUTimeStamp), 1.0);
+    }
+    EXPECT_EQ(2u, drm->regReads);
+
+    modeledCpuTime += 10000000;
+    EXPECT_TRUE(osTime->getCpuGpuTime(&timestamp));
+    EXPECT_EQ(3u, drm->regReads);
+    EXPECT_EQ(modeledCpuTime * 12 / 1000, timestamp.GPUTimeStamp);
+}
+
+TEST_F(DrmTimeTest, givenGpuCounterJumpWhenTimestampModelResyncsThenModelIsRecalibrated) {
+    DebugManagerStateRestore dbgRestore;
+    DebugManager.flags.GpuTimestampModelResyncInterval.set(10000);
+    DebugManager.flags.GpuTimestampModelErrorBound.set(1000);
+    std::unique_ptr<DrmMockModeledTime> drm(new DrmMockModeledTime);
+    osTime->setGetTimeFunc(getTimeFuncModeled);
+    modeledCpuTime = NSEC_PER_SEC;
+    osTime->updateDrm(drm.get());
+
+    auto model = osTime->getTimestampModel();
+    ASSERT_NE(nullptr, model);
+    EXPECT_EQ(1000u, model->getErrorBoundInNs());
+
+    TimeStampData timestamp = {0, 0};
+    EXPECT_TRUE(osTime->getCpuGpuTime(&timestamp));
+    modeledCpuTime += 2000000;
+    EXPECT_TRUE(osTime->getCpuGpuTime(&timestamp));
+    EXPECT_TRUE(model->isCalibrated());
+
+    drm->gpuOffset = 1200;
+    modeledCpuTime += 10000000;
+    EXPECT_TRUE(osTime->getCpuGpuTime(&timestamp));
+    EXPECT_EQ(modeledCpuTime * 12 / 1000 + 1200, timestamp.GPUTimeStamp);
+    EXPECT_FALSE(model->isCalibrated());
+    EXPECT_EQ(1u, model->getRecalibrationCount());
+    EXPECT_EQ(100000u, model->getLastErrorInNs());
+}
+
+TEST_F(DrmTimeTest, givenTimestampModelDisabledWhenGetCpuGpuTimeIsCalledThenGpuCounterIsReadEveryTime) {
+    DebugManagerStateRestore dbgRestore;
+    DebugManager.flags.GpuTimestampModelResyncInterval.set(0);
+    std::unique_ptr<DrmMockModeledTime> drm(new DrmMockModeledTime);
+    osTime->setGetTimeFunc(getTimeFuncModeled);
+    modeledCpuTime = NSEC_PER_SEC;
+    osTime->updateDrm(drm.get());
+    EXPECT_EQ(nullptr, osTime->getTimestampModel());
+
+    TimeStampData timestamp = {0, 0};
+    drm->regReads = 0;
+    for (int i = 0; i < 4; i++) {
+        modeledCpuTime += 2000000;
+        EXPECT_TRUE(osTime->getCpuGpuTime(&timestamp));
+    }
+    EXPECT_EQ(4u, drm->regReads);
+}
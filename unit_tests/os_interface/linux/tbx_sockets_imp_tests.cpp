@@ -0,0 +1,278 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/os_interface/debug_settings_manager.h"
+#include "runtime/tbx/tbx_proto.h"
+#include "runtime/tbx/tbx_sockets_imp.h"
+#include "unit_tests/helpers/debug_manager_state_restore.h"
+#include "gtest/gtest.h"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+using namespace OCLRT;
+
+namespace {
+// Stand-in TBX server on loopback - records every request and answers reads
+class LoopbackTbxServer {
+  public:
+    struct Request {
+        HAS_MSG msg;
+        std::vector<char> payload;
+    };
+
+    LoopbackTbxServer() {
+        listenSocket = ::socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+        sockaddr_in address = {};
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        address.sin_port = 0;
+        ::bind(listenSocket, reinterpret_cast<sockaddr *>(&address), sizeof(address));
+        ::listen(listenSocket, 1);
+
+        socklen_t addressSize = sizeof(address);
+        ::getsockname(listenSocket, reinterpret_cast<sockaddr *>(&address), &addressSize);
+        port = ntohs(address.sin_port);
+        serverThread = std::thread(&LoopbackTbxServer::run, this);
+    }
+
+    ~LoopbackTbxServer() {
+        join();
+        ::close(listenSocket);
+    }
+
+    // returns once client closed the connection and all its requests were recorded
+    void join() {
+        if (serverThread.joinable()) {
+            serverThread.join();
+        }
+    }
+
+    uint16_t port = 0;
+    std::vector<Request> requests;
+    uint32_t responsesSent = 0;
+
+  protected:
+    bool receive(int socket, void *buffer, size_t size) {
+        auto data = reinterpret_cast<char *>(buffer);
+        while (size > 0) {
+            auto received = ::recv(socket, data, size, 0);
+            if (received <= 0) {
+                return false;
+            }
+            data += received;
+            size -= received;
+        }
+        return true;
+    }
+
+    void respond(int socket, const HAS_MSG &resp, const void *payload, size_t payloadSize) {
+        ::send(socket, &resp, sizeof(HAS_HDR) + resp.hdr.size, 0);
+        if (payloadSize > 0) {
+            ::send(socket, payload, payloadSize, 0);
+        }
+        responsesSent++;
+    }
+
+    void run() {
+        auto socket = ::accept(listenSocket, nullptr, nullptr);
+        Request request;
+        while (receive(socket, &request.msg.hdr, sizeof(HAS_HDR)) &&
+               receive(socket, &request.msg.u, request.msg.hdr.size)) {
+            request.payload.clear();
+            if (request.msg.hdr.msg_type == HAS_WRITE_DATA_REQ_TYPE) {
+                request.payload.resize(request.msg.u.write_req.size);
+                if (!receive(socket, request.payload.data(), request.payload.size())) {
+                    break;
+                }
+            }
+            requests.push_back(request);
+
+            HAS_MSG resp;
+            memset(&resp, 0, sizeof(resp));
+            resp.hdr.trans_id = request.msg.hdr.trans_id;
+            if (request.msg.hdr.msg_type == HAS_MMIO_REQ_TYPE && !request.msg.u.mmio_req.write) {
+                resp.hdr.msg_type = HAS_MMIO_RES_TYPE;
+                resp.hdr.size = sizeof(HAS_MMIO_RES);
+                resp.u.mmio_res.data = request.msg.u.mmio_req.offset ^ 0xFFFF;
+                respond(socket, resp, nullptr, 0);
+            } else if (request.msg.hdr.msg_type == HAS_READ_DATA_REQ_TYPE) {
+                std::vector<char> data(request.msg.u.read_req.size);
+                for (size_t i = 0; i < data.size(); i++) {
+                    data[i] = static_cast<char>(request.msg.u.read_req.address + i);
+                }
+                resp.hdr.msg_type = HAS_READ_DATA_RES_TYPE;
+                resp.hdr.size = sizeof(HAS_READ_DATA_RES);
+                resp.u.read_res.address = request.msg.u.read_req.address;
+                resp.u.read_res.size = request.msg.u.read_req.size;
+                respond(socket, resp, data.data(), data.size());
+            }
+        }
+        ::close(socket);
+    }
+
+    int listenSocket;
+    std::thread serverThread;
+};
+
+std::vector<char> getPageData(size_t size, char seed) {
+    std::vector<char> data(size);
+    for (size_t i = 0; i < size; i++) {
+        data[i] = static_cast<char>(seed + i * 7);
+    }
+    return data;
+}
+} // namespace
+
+TEST(TbxSocketsImpLoopback, givenAdjacentMemoryWritesWhenMmioIsReadThenWritesAreCoalescedAndSentInOneBatch) {
+    DebugManagerStateRestore stateRestore;
+    DebugManager.flags.TbxSocketBatching.set(-1);
+    LoopbackTbxServer server;
+    std::stringstream errors;
+    TbxSocketsImp tbx(errors);
+    ASSERT_TRUE(tbx.init("127.0.0.1", server.port));
+    auto sendCallsAfterInit = tbx.getStatistics().sendCalls;
+
+    auto page0 = getPageData(4096, 1);
+    auto page1 = getPageData(4096, 2);
+    auto page2 = getPageData(4096, 3);
+    EXPECT_TRUE(tbx.writeMemory(0x10000, page0.data(), page0.size()));
+    EXPECT_TRUE(tbx.writeMemory(0x11000, page1.data(), page1.size()));
+    EXPECT_TRUE(tbx.writeMemory(0x12000, page2.data(), page2.size()));
+    EXPECT_TRUE(tbx.writeMemory(0x40000, page0.data(), 64));
+    EXPECT_TRUE(tbx.writeMMIO(0x2000, 5));
+
+    uint32_t value = 0;
+    EXPECT_TRUE(tbx.readMMIO(0x2234, &value));
+    EXPECT_EQ(0x2234u ^ 0xFFFFu, value);
+
+    EXPECT_EQ(2u, tbx.getStatistics().coalescedWrites);
+    EXPECT_EQ(1u, tbx.getStatistics().roundTrips);
+    EXPECT_EQ(sendCallsAfterInit + 1, tbx.getStatistics().sendCalls);
+
+    tbx.close();
+    server.join();
+    EXPECT_TRUE(errors.str().empty());
+
+    // control request, coalesced write, small write, mmio write, mmio read
+    ASSERT_EQ(5u, server.requests.size());
+    EXPECT_EQ(static_cast<uint32_t>(HAS_CONTROL_REQ_TYPE), server.requests[0].msg.hdr.msg_type);
+    auto &coalesced = server.requests[1];
+    EXPECT_EQ(static_cast<uint32_t>(HAS_WRITE_DATA_REQ_TYPE), coalesced.msg.hdr.msg_type);
+    EXPECT_EQ(0x10000u, coalesced.msg.u.write_req.address);
+    EXPECT_EQ(3 * 4096u, coalesced.msg.u.write_req.size);
+    std::vector<char> expected(page0);
+    expected.insert(expected.end(), page1.begin(), page1.end());
+    expected.insert(expected.end(), page2.begin(), page2.end());
+    EXPECT_EQ(expected, coalesced.payload);
+    EXPECT_EQ(0x40000u, server.requests[2].msg.u.write_req.address);
+    EXPECT_EQ(64u, server.requests[2].msg.u.write_req.size);
+    EXPECT_EQ(static_cast<uint32_t>(HAS_MMIO_REQ_TYPE), server.requests[3].msg.hdr.msg_type);
+    EXPECT_EQ(1u, server.requests[3].msg.u.mmio_req.write);
+    EXPECT_EQ(0u, server.requests[4].msg.u.mmio_req.write);
+    EXPECT_EQ(1u, server.responsesSent);
+
+    for (size_t i = 1; i < server.requests.size(); i++) {
+        EXPECT_LT(server.requests[i - 1].msg.hdr.trans_id, server.requests[i].msg.hdr.trans_id);
+    }
+}
+
+TEST(TbxSocketsImpLoopback, givenLargeMemoryWriteWhenSentThenPayloadArrivesIntact) {
+    LoopbackTbxServer server;
+    std::stringstream errors;
+    TbxSocketsImp tbx(errors);
+    ASSERT_TRUE(tbx.init("127.0.0.1", server.port));
+
+    auto small = getPageData(128, 4);
+    auto large = getPageData(4 * TbxSocketsImp::directSendThreshold + 3, 5);
+    EXPECT_TRUE(tbx.writeMemory(0x1000, small.data(), small.size()));
+    EXPECT_TRUE(tbx.writeMemory(0x1000 + small.size(), large.data(), large.size()));
+    EXPECT_EQ(0u, tbx.getStatistics().coalescedWrites);
+
+    tbx.close();
+    server.join();
+
+    ASSERT_EQ(3u, server.requests.size());
+    EXPECT_EQ(small, server.requests[1].payload);
+    EXPECT_EQ(large, server.requests[2].payload);
+}
+
+TEST(TbxSocketsImpLoopback, givenReadMemoryWhenResponseArrivesThenDataIsReturned) {
+    LoopbackTbxServer server;
+    std::stringstream errors;
+    TbxSocketsImp tbx(errors);
+    ASSERT_TRUE(tbx.init("127.0.0.1", server.port));
+
+    std::vector<char> data(300);
+    EXPECT_TRUE(tbx.readMemory(0x2000, data.data(), data.size()));
+    for (size_t i = 0; i < data.size(); i++) {
+        EXPECT_EQ(static_cast<char>(0x2000 + i), data[i]);
+    }
+    EXPECT_EQ(1u, tbx.getStatistics().roundTrips);
+
+    tbx.close();
+    server.join();
+}
+
+TEST(TbxSocketsImpLoopback, givenWritesPendingWhenSocketIsClosedThenWritesAreSent) {
+    LoopbackTbxServer server;
+    std::stringstream errors;
+    TbxSocketsImp tbx(errors);
+    ASSERT_TRUE(tbx.init("127.0.0.1", server.port));
+
+    EXPECT_TRUE(tbx.writeGTT(0x80, 0x1234000));
+    EXPECT_TRUE(tbx.writeMMIO(0x2000, 1));
+    tbx.close();
+    server.join();
+
+    ASSERT_EQ(3u, server.requests.size());
+    EXPECT_EQ(static_cast<uint32_t>(HAS_GTT_REQ_TYPE), server.requests[1].msg.hdr.msg_type);
+    EXPECT_EQ(0x80u / sizeof(uint64_t), server.requests[1].msg.u.gtt64_req.offset);
+    EXPECT_EQ(static_cast<uint32_t>(HAS_MMIO_REQ_TYPE), server.requests[2].msg.hdr.msg_type);
+}
+
+TEST(TbxSocketsImpLoopback, givenBatchingDisabledWhenWritesAreIssuedThenEachIsSentImmediately) {
+    DebugManagerStateRestore stateRestore;
+    DebugManager.flags.TbxSocketBatching.set(0);
+    LoopbackTbxServer server;
+    std::stringstream errors;
+    TbxSocketsImp tbx(errors);
+    ASSERT_TRUE(tbx.init("127.0.0.1", server.port));
+    auto sendCallsAfterInit = tbx.getStatistics().sendCalls;
+
+    auto page0 = getPageData(4096, 1);
+    EXPECT_TRUE(tbx.writeMemory(0x10000, page0.data(), page0.size()));
+    EXPECT_TRUE(tbx.writeMemory(0x11000, page0.data(), page0.size()));
+    EXPECT_EQ(0u, tbx.getStatistics().coalescedWrites);
+    EXPECT_LE(sendCallsAfterInit + 2, tbx.getStatistics().sendCalls);
+
+    tbx.close();
+    server.join();
+    EXPECT_EQ(3u, server.requests.size());
+}
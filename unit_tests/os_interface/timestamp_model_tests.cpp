@@ -0,0 +1,175 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/os_interface/timestamp_model.h"
+#include "gtest/gtest.h"
+
+#include <algorithm>
+
+using namespace OCLRT;
+
+namespace {
+const uint64_t resyncInterval = 50000000;
+const uint64_t errorBound = 10000;
+const uint64_t ms = 1000000;
+
+// 12 GPU ticks per microsecond
+uint64_t gpuTicksAt(uint64_t cpuTimeInNs) {
+    return cpuTimeInNs * 12 / 1000;
+}
+} // namespace
+
+TEST(TimestampModelTest, givenSingleSampleWhenGpuTimestampIsQueriedThenModelIsNotUsed) {
+    TimestampModel model(resyncInterval, errorBound, 36);
+    model.addSample(ms, gpuTicksAt(ms));
+
+    uint64_t gpuTimestamp = 0;
+    EXPECT_FALSE(model.isCalibrated());
+    EXPECT_FALSE(model.getGpuTimestamp(ms + 1, gpuTimestamp));
+}
+
+TEST(TimestampModelTest, givenSamplesCloserThanCalibrationWindowWhenGpuTimestampIsQueriedThenModelIsNotUsed) {
+    TimestampModel model(resyncInterval, errorBound, 36);
+    model.addSample(ms, gpuTicksAt(ms));
+    model.addSample(ms + TimestampModel::minCalibrationWindowInNs - 1, gpuTicksAt(ms + TimestampModel::minCalibrationWindowInNs - 1));
+
+    uint64_t gpuTimestamp = 0;
+    EXPECT_FALSE(model.isCalibrated());
+    EXPECT_FALSE(model.getGpuTimestamp(2 * ms, gpuTimestamp));
+}
+
+TEST(TimestampModelTest, givenCalibratedModelWhenGpuTimestampIsQueriedWithinResyncIntervalThenItIsExtrapolatedFromLastSample) {
+    TimestampModel model(resyncInterval, errorBound, 36);
+    model.addSample(ms, gpuTicksAt(ms));
+    model.addSample(11 * ms, gpuTicksAt(11 * ms));
+
+    ASSERT_TRUE(model.isCalibrated());
+    EXPECT_DOUBLE_EQ(0.012, model.getGpuTicksPerNs());
+
+    uint64_t gpuTimestamp = 0;
+    EXPECT_TRUE(model.getGpuTimestamp(16 * ms, gpuTimestamp));
+    EXPECT_NEAR(static_cast<double>(gpuTicksAt(16 * ms)), static_cast<double>(gpuTimestamp), 1.0);
+
+    EXPECT_FALSE(model.getGpuTimestamp(11 * ms + resyncInterval, gpuTimestamp));
+    EXPECT_FALSE(model.getGpuTimestamp(11 * ms - 1, gpuTimestamp));
+}
+
+TEST(TimestampModelTest, givenSampleMatchingPredictionWhenAddedThenErrorIsReportedAndModelStaysCalibrated) {
+    TimestampModel model(resyncInterval, errorBound, 36);
+    model.addSample(ms, gpuTicksAt(ms));
+    model.addSample(11 * ms, gpuTicksAt(11 * ms));
+    // 60 ticks = 5 us away from the prediction
+    model.addSample(51 * ms, gpuTicksAt(51 * ms) + 60);
+
+    EXPECT_TRUE(model.isCalibrated());
+    EXPECT_EQ(5000u, model.getLastErrorInNs());
+    EXPECT_EQ(5000u, model.getMaxErrorInNs());
+    EXPECT_EQ(0u, model.getRecalibrationCount());
+}
+
+TEST(TimestampModelTest, givenSampleExceedingErrorBoundWhenAddedThenModelIsRecalibrated) {
+    TimestampModel model(resyncInterval, errorBound, 36);
+    model.addSample(ms, gpuTicksAt(ms));
+    model.addSample(11 * ms, gpuTicksAt(11 * ms));
+    model.addSample(51 * ms, gpuTicksAt(51 * ms) + 1200);
+
+    uint64_t gpuTimestamp = 0;
+    EXPECT_FALSE(model.isCalibrated());
+    EXPECT_EQ(100000u, model.getLastErrorInNs());
+    EXPECT_EQ(1u, model.getRecalibrationCount());
+    EXPECT_FALSE(model.getGpuTimestamp(52 * ms, gpuTimestamp));
+
+    model.addSample(61 * ms, gpuTicksAt(61 * ms) + 1200);
+    EXPECT_TRUE(model.getGpuTimestamp(62 * ms, gpuTimestamp));
+    EXPECT_NEAR(static_cast<double>(gpuTicksAt(62 * ms) + 1200), static_cast<double>(gpuTimestamp), 1.0);
+}
+
+TEST(TimestampModelTest, givenGpuCounterWrappingWithinCalibrationWindowWhenGpuTimestampIsQueriedThenWrappedValueIsReturned) {
+    const uint64_t counterMask = (1ull << 36) - 1;
+    const uint64_t gpuStart = counterMask - gpuTicksAt(5 * ms);
+
+    TimestampModel model(resyncInterval, errorBound, 36);
+    model.addSample(ms, gpuStart);
+    model.addSample(11 * ms, (gpuStart + gpuTicksAt(10 * ms)) & counterMask);
+
+    ASSERT_TRUE(model.isCalibrated());
+    EXPECT_DOUBLE_EQ(0.012, model.getGpuTicksPerNs());
+
+    uint64_t gpuTimestamp = 0;
+    EXPECT_TRUE(model.getGpuTimestamp(21 * ms, gpuTimestamp));
+    EXPECT_NEAR(static_cast<double>((gpuStart + gpuTicksAt(20 * ms)) & counterMask), static_cast<double>(gpuTimestamp), 1.0);
+}
+
+TEST(TimestampModelTest, givenOutOfOrderSampleWhenAddedThenItIsIgnored) {
+    TimestampModel model(resyncInterval, errorBound, 36);
+    model.addSample(ms, gpuTicksAt(ms));
+    model.addSample(11 * ms, gpuTicksAt(11 * ms));
+    model.addSample(10 * ms, 0);
+
+    uint64_t gpuTimestamp = 0;
+    EXPECT_TRUE(model.getGpuTimestamp(12 * ms, gpuTimestamp));
+    EXPECT_EQ(0u, model.getRecalibrationCount());
+}
+
+TEST(TimestampModelTest, givenUncertainSamplesWhenCalibratedOverShortWindowThenExtrapolationIsLimitedBelowResyncInterval) {
+    TimestampModel model(resyncInterval, errorBound, 36);
+    model.addSample(ms, gpuTicksAt(ms), 4000);
+    model.addSample(3 * ms, gpuTicksAt(3 * ms), 4000);
+
+    ASSERT_TRUE(model.isCalibrated());
+    // (10 us bound - 4 us anchor uncertainty) * 2 ms window / 8 us rate uncertainty
+    EXPECT_EQ(1500000u, model.getExtrapolationLimitInNs());
+
+    uint64_t gpuTimestamp = 0;
+    EXPECT_TRUE(model.getGpuTimestamp(3 * ms + 1499999, gpuTimestamp));
+    EXPECT_FALSE(model.getGpuTimestamp(3 * ms + 1500000, gpuTimestamp));
+}
+
+TEST(TimestampModelTest, givenSamplesWithPairingJitterWhenModelIsQueriedLikeOsTimeThenItConvergesToResyncIntervalWithinErrorBound) {
+    const uint64_t jitter = 4000;
+    const uint64_t gpuOffset = 12345;
+    TimestampModel model(resyncInterval, errorBound, 36);
+
+    uint32_t seed = 1;
+    uint64_t maxServedErrorInTicks = 0;
+    uint32_t samplesInLastSecond = 0;
+    for (uint64_t cpuTime = ms; cpuTime < 3000 * ms; cpuTime += 100000) {
+        auto gpuTruth = gpuTicksAt(cpuTime) + gpuOffset;
+        uint64_t gpuTimestamp = 0;
+        if (model.getGpuTimestamp(cpuTime, gpuTimestamp)) {
+            auto errorInTicks = gpuTimestamp > gpuTruth ? gpuTimestamp - gpuTruth : gpuTruth - gpuTimestamp;
+            maxServedErrorInTicks = std::max(maxServedErrorInTicks, errorInTicks);
+            continue;
+        }
+        seed = seed * 1664525u + 1013904223u;
+        auto pairingError = static_cast<int64_t>((seed >> 8) % (2 * jitter + 1)) - static_cast<int64_t>(jitter);
+        model.addSample(cpuTime + pairingError, gpuTruth, jitter);
+        if (cpuTime >= 2000 * ms) {
+            samplesInLastSecond++;
+        }
+    }
+
+    EXPECT_EQ(0u, model.getRecalibrationCount());
+    EXPECT_EQ(resyncInterval, model.getExtrapolationLimitInNs());
+    EXPECT_LE(samplesInLastSecond, 1000 * ms / resyncInterval + 1);
+    EXPECT_LE(maxServedErrorInTicks, gpuTicksAt(errorBound));
+}
@@ -0,0 +1,197 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/command_queue/local_id_gen.h"
+#include "runtime/helpers/aligned_memory.h"
+#include "runtime/utilities/cpu_info.h"
+#include "unit_tests/perf_tests/perf_test_utils.h"
+
+#include <cstring>
+#include <tuple>
+
+using namespace OCLRT;
+
+namespace OCLRT {
+struct uint16x8_t;
+struct uint16x16_t;
+struct uint16x32_t;
+} // namespace OCLRT
+
+namespace ULT {
+
+typedef void (*LocalIdGenerator)(void *buffer, size_t lwsX, size_t lwsY, size_t threadsPerWorkGroup);
+
+// instruction set specific generators, nullptr where a variant does not handle the SIMD size
+struct LocalIdGenVariant {
+    uint64_t requiredCpuFeature;
+    LocalIdGenerator generateSimd8;
+    LocalIdGenerator generateSimd16;
+    LocalIdGenerator generateSimd32;
+};
+
+const LocalIdGenVariant sse4Variant = {CpuInfo::featureNone, generateLocalIDsSimd<uint16x8_t, 8>, generateLocalIDsSimd<uint16x8_t, 16>, generateLocalIDsSimd<uint16x8_t, 32>};
+const LocalIdGenVariant avx2Variant = {CpuInfo::featureAvX2, nullptr, generateLocalIDsSimd<uint16x16_t, 16>, generateLocalIDsSimd<uint16x16_t, 32>};
+const LocalIdGenVariant avx512Variant = {CpuInfo::featureAvX512Bw, nullptr, nullptr, generateLocalIDsSimd<uint16x32_t, 32>};
+
+// multiplier of reference ratio that is compared ( checked if less than ) with current result
+const double multiplier = 1.5000;
+// ratio results that are not checked be EXPECT ( very short time tests are not chceked due to high fluctuations )
+const double ratioThreshold = 0.005;
+
+typedef std::tuple<uint32_t, size_t, size_t, size_t> WorkGroupShape;
+
+struct LocalIdGenPerfFixture {
+    void SetUp(const WorkGroupShape &shape) {
+        setReferenceTime();
+        std::tie(simd, lwsX, lwsY, lwsZ) = shape;
+        threadsPerWorkGroup = getThreadsPerWG(simd, lwsX * lwsY * lwsZ);
+        size = threadsPerWorkGroup * getPerThreadSizeLocalIDs(simd);
+        reference = alignedMalloc(size, 64);
+        buffer = alignedMalloc(size, 64);
+        // SIMD8 leaves upper half of each GRF untouched, keep it equal in both buffers
+        memset(reference, 0xff, size);
+        if (simd == 32) {
+            generateLocalIDsSimd<uint16x8_t, 32>(reference, lwsX, lwsY, threadsPerWorkGroup);
+        } else if (simd == 16) {
+            generateLocalIDsSimd<uint16x8_t, 16>(reference, lwsX, lwsY, threadsPerWorkGroup);
+        } else if (simd == 8) {
+            generateLocalIDsSimd<uint16x8_t, 8>(reference, lwsX, lwsY, threadsPerWorkGroup);
+        }
+        memset(buffer, 0xff, size);
+    }
+
+    void TearDown() {
+        alignedFree(reference);
+        alignedFree(buffer);
+    }
+
+    template <typename Generator>
+    long long measureOnce(Generator generator) {
+        Timer t;
+        t.start();
+        for (int i = 0; i < iterations; i++) {
+            generator();
+        }
+        t.end();
+        return t.get();
+    }
+
+    template <typename Generator>
+    void checkTime(Generator generator) {
+        double previousRatio = -1.0;
+        uint64_t hash = getCurrentTestHash();
+
+        bool success = getTestRatio(hash, previousRatio);
+
+        long long time = majorityVote(measureOnce(generator), measureOnce(generator), measureOnce(generator));
+        EXPECT_EQ(0, memcmp(reference, buffer, size));
+
+        double ratio = static_cast<double>(time) / static_cast<double>(refTime);
+
+        if (success && previousRatio > ratioThreshold) {
+            EXPECT_TRUE(isLowerThanReference(ratio, previousRatio, multiplier)) << "Current: " << ratio << " previous: " << previousRatio << "\n";
+        }
+
+        updateTestRatio(hash, ratio);
+    }
+
+    static const int iterations = 10000;
+    uint32_t simd;
+    size_t lwsX, lwsY, lwsZ;
+    size_t threadsPerWorkGroup;
+    size_t size;
+    void *reference = nullptr;
+    void *buffer = nullptr;
+};
+
+struct LocalIdGenPerfTest : public LocalIdGenPerfFixture,
+                            public ::testing::TestWithParam<WorkGroupShape> {
+    void SetUp() override {
+        LocalIdGenPerfFixture::SetUp(GetParam());
+    }
+
+    void TearDown() override {
+        LocalIdGenPerfFixture::TearDown();
+    }
+};
+
+struct LocalIdGenVariantPerfTest : public LocalIdGenPerfFixture,
+                                   public ::testing::TestWithParam<std::tuple<const LocalIdGenVariant *, WorkGroupShape>> {
+    void SetUp() override {
+        LocalIdGenPerfFixture::SetUp(std::get<1>(GetParam()));
+        auto variant = std::get<0>(GetParam());
+        generator = (simd == 32) ? variant->generateSimd32 : (simd == 16) ? variant->generateSimd16 : variant->generateSimd8;
+        if (!CpuInfo::getInstance().isFeatureSupported(variant->requiredCpuFeature)) {
+            generator = nullptr;
+        }
+    }
+
+    void TearDown() override {
+        LocalIdGenPerfFixture::TearDown();
+    }
+
+    LocalIdGenerator generator = nullptr;
+};
+
+const WorkGroupShape commonWorkGroupShapes[] = {
+    WorkGroupShape(8u, 8u, 8u, 1u),
+    WorkGroupShape(16u, 16u, 16u, 1u),
+    WorkGroupShape(16u, 64u, 1u, 1u),
+    WorkGroupShape(16u, 256u, 1u, 1u),
+    WorkGroupShape(32u, 32u, 1u, 1u),
+    WorkGroupShape(32u, 16u, 16u, 1u),
+    WorkGroupShape(32u, 8u, 8u, 4u),
+    WorkGroupShape(32u, 256u, 1u, 1u)};
+
+TEST_P(LocalIdGenVariantPerfTest, givenCommonWorkGroupShapeWhenGeneratingLocalIdsWithVariantThenTimeIsNotWorseThanReference) {
+    // variant not built for this SIMD size or not supported by the CPU
+    if (generator == nullptr) {
+        return;
+    }
+    checkTime([&]() {
+        generator(buffer, lwsX, lwsY, threadsPerWorkGroup);
+    });
+}
+
+TEST_P(LocalIdGenPerfTest, givenCommonWorkGroupShapeWhenGeneratingLocalIdsThenTimeIsNotWorseThanReference) {
+    checkTime([&]() {
+        generateLocalIDsUncached(buffer, simd, lwsX, lwsY, threadsPerWorkGroup);
+    });
+}
+
+TEST_P(LocalIdGenPerfTest, givenCachedWorkGroupShapeWhenCopyingLocalIdsThenTimeIsNotWorseThanReference) {
+    LocalIDCache cache;
+    cache.store(reference, simd, lwsX, lwsY, threadsPerWorkGroup, size);
+    checkTime([&]() {
+        cache.copyIfCached(buffer, simd, lwsX, lwsY, threadsPerWorkGroup, size);
+    });
+}
+
+INSTANTIATE_TEST_CASE_P(LocalIdGenPerfTest,
+                        LocalIdGenPerfTest,
+                        ::testing::ValuesIn(commonWorkGroupShapes));
+
+INSTANTIATE_TEST_CASE_P(LocalIdGenVariantPerfTest,
+                        LocalIdGenVariantPerfTest,
+                        ::testing::Combine(::testing::Values(&sse4Variant, &avx2Variant, &avx512Variant),
+                                           ::testing::ValuesIn(commonWorkGroupShapes)));
+} // namespace ULT
@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/command_queue/dispatch_walker.h"
+#include "runtime/command_queue/local_work_size_cache.h"
+#include "unit_tests/perf_tests/perf_test_utils.h"
+
+#include <tuple>
+
+using namespace OCLRT;
+
+namespace ULT {
+
+// multiplier of reference ratio that is compared ( checked if less than ) with current result
+const double multiplier = 1.5000;
+// ratio results that are not checked be EXPECT ( very short time tests are not chceked due to high fluctuations )
+const double ratioThreshold = 0.005;
+
+// Times the ND search over divisors of the global size that computeWorkgroupSize
+// does on a cache miss, and the lookup that replaces it on a cache hit.
+struct LocalWorkSizeCachePerfTest : public ::testing::TestWithParam<std::tuple<size_t, size_t, size_t, uint32_t>> {
+    void SetUp() override {
+        setReferenceTime();
+        std::tie(gws[0], gws[1], gws[2], slmTotalSize) = GetParam();
+        workDim = gws[2] > 1 ? 3 : gws[1] > 1 ? 2 : 1;
+        key = {};
+        std::copy(gws, gws + 3, key.gws);
+        key.workDim = workDim;
+        key.simdSize = simd;
+        key.slmTotalSize = slmTotalSize;
+        key.useND = true;
+    }
+
+    WorkSizeInfo createWorkSizeInfo() {
+        return WorkSizeInfo(256, false, simd, slmTotalSize, IGFX_GEN9_CORE, 56u, 64 * 1024u, false, false);
+    }
+
+    long long measureCompute() {
+        size_t lws[3];
+        Timer t;
+        t.start();
+        for (int i = 0; i < iterations; i++) {
+            computeWorkgroupSizeND(createWorkSizeInfo(), lws, gws, workDim);
+        }
+        t.end();
+        return t.get();
+    }
+
+    long long measureLookup(LocalWorkSizeCache &cache) {
+        size_t lws[3];
+        Timer t;
+        t.start();
+        for (int i = 0; i < iterations; i++) {
+            cache.find(key, lws);
+        }
+        t.end();
+        return t.get();
+    }
+
+    void checkTime(long long time) {
+        double previousRatio = -1.0;
+        uint64_t hash = getCurrentTestHash();
+
+        bool success = getTestRatio(hash, previousRatio);
+
+        double ratio = static_cast<double>(time) / static_cast<double>(refTime);
+
+        if (success && previousRatio > ratioThreshold) {
+            EXPECT_TRUE(isLowerThanReference(ratio, previousRatio, multiplier)) << "Current: " << ratio << " previous: " << previousRatio << "\n";
+        }
+
+        updateTestRatio(hash, ratio);
+    }
+
+    static const int iterations = 2000;
+    static const uint32_t simd = 16;
+    size_t gws[3];
+    uint32_t workDim;
+    uint32_t slmTotalSize;
+    LocalWorkSizeCacheKey key;
+};
+
+TEST_P(LocalWorkSizeCachePerfTest, givenDispatchWhenLwsIsNotCachedThenComputeTimeIsNotWorseThanReference) {
+    checkTime(majorityVote(measureCompute(), measureCompute(), measureCompute()));
+}
+
+TEST_P(LocalWorkSizeCachePerfTest, givenRepeatedDispatchWhenLwsIsTakenFromCacheThenTimeIsNotWorseThanReference) {
+    size_t computedLws[3];
+    computeWorkgroupSizeND(createWorkSizeInfo(), computedLws, gws, workDim);
+
+    LocalWorkSizeCache cache;
+    // keep the entry at the back so every lookup walks the whole cache
+    cache.store(key, computedLws);
+    for (size_t i = 1; i < LocalWorkSizeCache::maxEntries; i++) {
+        auto otherKey = key;
+        otherKey.gws[0] += i;
+        cache.store(otherKey, computedLws);
+    }
+
+    long long time = majorityVote(measureLookup(cache), measureLookup(cache), measureLookup(cache));
+
+    size_t cachedLws[3] = {};
+    EXPECT_TRUE(cache.find(key, cachedLws));
+    EXPECT_EQ(computedLws[0], cachedLws[0]);
+    EXPECT_EQ(computedLws[1], cachedLws[1]);
+    EXPECT_EQ(computedLws[2], cachedLws[2]);
+
+    checkTime(time);
+}
+
+INSTANTIATE_TEST_CASE_P(LocalWorkSizeCachePerfTest,
+                        LocalWorkSizeCachePerfTest,
+                        ::testing::Values(std::make_tuple(1000u, 1u, 1u, 0u),
+                                          std::make_tuple(1920u, 1080u, 1u, 0u),
+                                          std::make_tuple(1000u, 1000u, 1u, 0u),
+                                          std::make_tuple(224u, 224u, 3u, 0u),
+                                          std::make_tuple(1920u, 1080u, 1u, 4096u),
+                                          std::make_tuple(999u, 997u, 1u, 0u)));
+} // namespace ULT
@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/event/user_event.h"
+#include "unit_tests/perf_tests/perf_test_utils.h"
+
+#include <memory>
+#include <vector>
+
+using namespace OCLRT;
+
+namespace ULT {
+
+// multiplier of reference ratio that is compared ( checked if less than ) with current result
+const double multiplier = 1.5000;
+// ratio results that are not checked be EXPECT ( very short time tests are not chceked due to high fluctuations )
+const double ratioThreshold = 0.005;
+
+// Measures how long it takes for a user event completion to propagate
+// through childEventsToNotify to every event of the DAG.
+struct EventDagPerfTest : public ::testing::TestWithParam<size_t /*events in DAG*/> {
+    void SetUp() override {
+        setReferenceTime();
+    }
+
+    Event *createChild() {
+        children.emplace_back(new Event(nullptr, CL_COMMAND_NDRANGE_KERNEL, Event::eventNotReady, Event::eventNotReady));
+        return children.back().get();
+    }
+
+    long long measureFanOut(bool deep) {
+        UserEvent root;
+        children.clear();
+        Event *parent = &root;
+        for (size_t i = 0; i < GetParam(); i++) {
+            auto child = createChild();
+            parent->addChild(*child);
+            if (deep) {
+                parent = child;
+            }
+        }
+
+        Timer t;
+        t.start();
+        root.setStatus(CL_COMPLETE);
+        t.end();
+
+        for (auto &child : children) {
+            EXPECT_FALSE(child->peekIsBlocked());
+        }
+        return t.get();
+    }
+
+    void checkFanOutTime(bool deep) {
+        double previousRatio = -1.0;
+        uint64_t hash = getCurrentTestHash();
+
+        bool success = getTestRatio(hash, previousRatio);
+
+        long long time = majorityVote(measureFanOut(deep), measureFanOut(deep), measureFanOut(deep));
+
+        double ratio = static_cast<double>(time) / static_cast<double>(refTime);
+
+        if (success && previousRatio > ratioThreshold) {
+            EXPECT_TRUE(isLowerThanReference(ratio, previousRatio, multiplier)) << "Current: " << ratio << " previous: " << previousRatio << "\n";
+        }
+
+        updateTestRatio(hash, ratio);
+    }
+
+    std::vector<std::unique_ptr<Event>> children;
+};
+
+TEST_P(EventDagPerfTest, givenWideDagWhenUserEventCompletesThenUnblockingTimeIsNotWorseThanReference) {
+    checkFanOutTime(false);
+}
+
+TEST_P(EventDagPerfTest, givenDeepDagWhenUserEventCompletesThenUnblockingTimeIsNotWorseThanReference) {
+    checkFanOutTime(true);
+}
+
+INSTANTIATE_TEST_CASE_P(EventDagPerfTest,
+                        EventDagPerfTest,
+                        ::testing::Values(16u, 128u, 512u));
+} // namespace ULT
@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/helpers/ptr_math.h"
+#include "runtime/mem_obj/map_operations_handler.h"
+#include "unit_tests/perf_tests/perf_test_utils.h"
+
+#include <vector>
+
+using namespace OCLRT;
+
+namespace ULT {
+
+// multiplier of reference ratio that is compared ( checked if less than ) with current result
+const double multiplier = 1.5000;
+// ratio results that are not checked be EXPECT ( very short time tests are not chceked due to high fluctuations )
+const double ratioThreshold = 0.005;
+
+// Maps count tiles of one buffer, looks every tile up and unmaps them in scattered order
+static long long measureTileMaps(size_t count) {
+    MapOperationsHandler handler;
+    cl_map_flags mapFlags = CL_MAP_WRITE;
+    MemObjSizeArray size = {{256, 1, 1}};
+    MemObjOffsetArray offset = {{0, 0, 0}};
+    auto basePtr = reinterpret_cast<void *>(0x10000000);
+    const size_t tileStride = 0x400;
+
+    size_t found = 0;
+    Timer t;
+    t.start();
+    for (size_t i = 0; i < count; i++) {
+        auto tile = (i * 7919) % count;
+        handler.add(ptrOffset(basePtr, tile * tileStride), size[0], mapFlags, size, offset);
+    }
+    for (size_t i = 0; i < count; i++) {
+        MapInfo mapInfo;
+        found += handler.find(ptrOffset(basePtr, i * tileStride), mapInfo);
+    }
+    for (size_t i = 0; i < count; i++) {
+        auto tile = (i * 104729) % count;
+        handler.remove(ptrOffset(basePtr, tile * tileStride));
+    }
+    t.end();
+
+    EXPECT_EQ(count, found);
+    EXPECT_EQ(0u, handler.size());
+    return t.get();
+}
+
+struct MapOperationsHandlerPerfTest : public ::testing::Test {
+    void SetUp() override {
+        setReferenceTime();
+    }
+};
+
+TEST_F(MapOperationsHandlerPerfTest, givenThousandsOfOutstandingMapsWhenMappedAndUnmappedThenTimeIsNotWorseThanReference) {
+    double previousRatio = -1.0;
+    uint64_t hash = getCurrentTestHash();
+
+    bool success = getTestRatio(hash, previousRatio);
+
+    long long time = majorityVote(measureTileMaps(4096), measureTileMaps(4096), measureTileMaps(4096));
+
+    double ratio = static_cast<double>(time) / static_cast<double>(refTime);
+
+    if (success && previousRatio > ratioThreshold) {
+        EXPECT_TRUE(isLowerThanReference(ratio, previousRatio, multiplier)) << "Current: " << ratio << " previous: " << previousRatio << "\n";
+    }
+
+    updateTestRatio(hash, ratio);
+}
+} // namespace ULT
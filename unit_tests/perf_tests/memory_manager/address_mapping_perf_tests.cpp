@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/helpers/aligned_memory.h"
+#include "runtime/helpers/selectors.h"
+#include "runtime/memory_manager/address_mapper.h"
+#include "runtime/memory_manager/memory_constants.h"
+#include "runtime/memory_manager/page_table.h"
+#include "unit_tests/perf_tests/perf_test_utils.h"
+
+#include <memory>
+#include <vector>
+
+using namespace OCLRT;
+
+namespace ULT {
+
+// multiplier of reference ratio that is compared ( checked if less than ) with current result
+const double multiplier = 1.5000;
+// ratio results that are not checked be EXPECT ( very short time tests are not chceked due to high fluctuations )
+const double ratioThreshold = 0.005;
+
+struct MappedAllocation {
+    uintptr_t address;
+    size_t size;
+};
+
+// Packs allocations of 1-3 pages with a one page gap between them, the gaps keep
+// neighbours from sharing a page table entry
+static std::vector<MappedAllocation> buildAllocations(uintptr_t base, size_t count) {
+    std::vector<MappedAllocation> allocations(count);
+    auto address = base;
+    for (size_t i = 0; i < count; i++) {
+        allocations[i].address = address;
+        allocations[i].size = (i % 3 + 1) * MemoryConstants::pageSize - (i % 5) * 64;
+        address += alignUp(allocations[i].size, MemoryConstants::pageSize) + MemoryConstants::pageSize;
+    }
+    return allocations;
+}
+
+static long long measureAddressMapper(const std::vector<MappedAllocation> &allocations) {
+    AddressMapper mapper;
+
+    Timer t;
+    t.start();
+    for (auto &allocation : allocations) {
+        mapper.map(reinterpret_cast<void *>(allocation.address), allocation.size);
+    }
+    for (auto &allocation : allocations) {
+        mapper.map(reinterpret_cast<void *>(allocation.address), allocation.size);
+    }
+    for (auto &allocation : allocations) {
+        mapper.unmap(reinterpret_cast<void *>(allocation.address));
+    }
+    t.end();
+    return t.get();
+}
+
+static long long measurePageTable(const std::vector<MappedAllocation> &allocations, size_t &runs) {
+    typedef TypeSelector<PML4, PDPE, sizeof(void *) == 8>::type PPGTTPageTable;
+    std::unique_ptr<PPGTTPageTable> ppgtt(new PPGTTPageTable);
+    size_t walked = 0;
+    runs = 0;
+
+    Timer t;
+    t.start();
+    for (auto &allocation : allocations) {
+        ppgtt->pageWalk(allocation.address, allocation.size, 0, [&](uint64_t physAddress, size_t size, size_t offset) {
+            walked += size;
+            runs++;
+        });
+    }
+    t.end();
+
+    size_t expectedSize = 0;
+    for (auto &allocation : allocations) {
+        expectedSize += allocation.size;
+    }
+    EXPECT_EQ(expectedSize, walked);
+    return t.get();
+}
+
+struct AddressMappingPerfTest : public ::testing::Test {
+    void SetUp() override {
+        setReferenceTime();
+    }
+};
+
+TEST_F(AddressMappingPerfTest, givenManyAllocationsWhenMappedByAddressMapperThenTimeIsNotWorseThanReference) {
+    double previousRatio = -1.0;
+    uint64_t hash = getCurrentTestHash();
+
+    bool success = getTestRatio(hash, previousRatio);
+
+    auto allocations = buildAllocations(0x100000, 100000);
+    long long time = majorityVote(measureAddressMapper(allocations), measureAddressMapper(allocations), measureAddressMapper(allocations));
+
+    double ratio = static_cast<double>(time) / static_cast<double>(refTime);
+
+    if (success && previousRatio > ratioThreshold) {
+        EXPECT_TRUE(isLowerThanReference(ratio, previousRatio, multiplier)) << "Current: " << ratio << " previous: " << previousRatio << "\n";
+    }
+
+    updateTestRatio(hash, ratio);
+}
+
+TEST_F(AddressMappingPerfTest, givenManyAllocationsWhenWalkedInPpgttThenEachAllocationIsSingleRunAndTimeIsNotWorseThanReference) {
+    double previousRatio = -1.0;
+    uint64_t hash = getCurrentTestHash();
+
+    bool success = getTestRatio(hash, previousRatio);
+
+    size_t runs = 0;
+    auto allocations = buildAllocations(0x100000, 100000);
+
+    // physical pages are never released, so the set is mapped only once
+    long long time = measurePageTable(allocations, runs);
+    EXPECT_EQ(allocations.size(), runs);
+
+    double ratio = static_cast<double>(time) / static_cast<double>(refTime);
+
+    if (success && previousRatio > ratioThreshold) {
+        EXPECT_TRUE(isLowerThanReference(ratio, previousRatio, multiplier)) << "Current: " << ratio << " previous: " << previousRatio << "\n";
+    }
+
+    updateTestRatio(hash, ratio);
+}
+} // namespace ULT
@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/helpers/ptr_math.h"
+#include "runtime/memory_manager/os_agnostic_memory_manager.h"
+#include "runtime/memory_manager/svm_memory_manager.h"
+#include "unit_tests/perf_tests/perf_test_utils.h"
+
+#include <vector>
+
+using namespace OCLRT;
+
+namespace ULT {
+
+// multiplier of reference ratio that is compared ( checked if less than ) with current result
+const double multiplier = 1.5000;
+// ratio results that are not checked be EXPECT ( very short time tests are not chceked due to high fluctuations )
+const double ratioThreshold = 0.005;
+
+static long long measureAllocFree(size_t allocationSize, size_t count) {
+    OsAgnosticMemoryManager memoryManager;
+    SVMAllocsManager svmManager(&memoryManager);
+    std::vector<void *> ptrs(count);
+
+    Timer t;
+    t.start();
+    for (int iteration = 0; iteration < 4; iteration++) {
+        for (auto &ptr : ptrs) {
+            ptr = svmManager.createSVMAlloc(allocationSize);
+        }
+        for (auto ptr : ptrs) {
+            svmManager.freeSVMAlloc(ptr);
+        }
+    }
+    t.end();
+    return t.get();
+}
+
+static long long measureLookup(size_t count) {
+    OsAgnosticMemoryManager memoryManager;
+    SVMAllocsManager svmManager(&memoryManager);
+    std::vector<void *> ptrs(count);
+    for (auto &ptr : ptrs) {
+        ptr = svmManager.createSVMAlloc(2 * MemoryConstants::pageSize);
+    }
+
+    size_t found = 0;
+    Timer t;
+    t.start();
+    for (size_t i = 0; i < 100000; i++) {
+        found += svmManager.getSVMAlloc(ptrOffset(ptrs[(i * 7919) % count], 64)) != nullptr;
+    }
+    t.end();
+
+    for (auto ptr : ptrs) {
+        svmManager.freeSVMAlloc(ptr);
+    }
+    EXPECT_EQ(100000u, found);
+    return t.get();
+}
+
+struct SvmAllocationPerfTest : public ::testing::Test {
+    void SetUp() override {
+        setReferenceTime();
+    }
+
+    void checkTime(long long time) {
+        double previousRatio = -1.0;
+        uint64_t hash = getCurrentTestHash();
+
+        bool success = getTestRatio(hash, previousRatio);
+
+        double ratio = static_cast<double>(time) / static_cast<double>(refTime);
+
+        if (success && previousRatio > ratioThreshold) {
+            EXPECT_TRUE(isLowerThanReference(ratio, previousRatio, multiplier)) << "Current: " << ratio << " previous: " << previousRatio << "\n";
+        }
+
+        updateTestRatio(hash, ratio);
+    }
+};
+
+TEST_F(SvmAllocationPerfTest, givenSmallAllocationsWhenAllocatedAndFreedFromPoolThenTimeIsNotWorseThanReference) {
+    const size_t count = 2000;
+    checkTime(majorityVote(measureAllocFree(256, count), measureAllocFree(256, count), measureAllocFree(256, count)));
+}
+
+TEST_F(SvmAllocationPerfTest, givenManyAllocationsWhenLookedUpThenTimeIsNotWorseThanReference) {
+    checkTime(majorityVote(measureLookup(5000), measureLookup(5000), measureLookup(5000)));
+}
+} // namespace ULT
@@ -151,3 +151,11 @@ bool updateTestRatio(uint64_t hash, double ratio) {
     }
     return false;
 }
+
+uint64_t getCurrentTestHash() {
+    auto testInfo = ::testing::UnitTest::GetInstance()->current_test_info();
+    string testName(testInfo->test_case_name());
+    testName.append(".");
+    testName.append(testInfo->name());
+    return Hash::hash(testName.c_str(), testName.size());
+}
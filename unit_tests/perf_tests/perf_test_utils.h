@@ -38,6 +38,9 @@ bool isLowerThanReference(double data, double reference, double rangePercentage)
 
 bool updateTestRatio(uint64_t hash, double ratio);
 
+// Identifies currently running test in perf logs, value-parameterized tests get one entry per parameter
+uint64_t getCurrentTestHash();
+
 template <typename T>
 T majorityVote(T time1, T time2, T time3) {
     T minTime1 = 0;
@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/helpers/aligned_memory.h"
+#include "runtime/helpers/hash.h"
+#include "unit_tests/helpers/debug_manager_state_restore.h"
+#include "unit_tests/perf_tests/api/api_tests.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace OCLRT;
+using namespace iOpenCL;
+
+namespace ULT {
+
+// multiplier of reference ratio that is compared ( checked if less than ) with current result
+const double multiplier = 1.5000;
+// ratio results that are not checked be EXPECT ( very short time tests are not chceked due to high fluctuations )
+const double ratioThreshold = 0.005;
+
+// Measures how long processGenBinary takes for a synthetic binary holding
+// many kernels, with sequential and parallel parsing and with ISA upload
+// done eagerly or deferred to the first clCreateKernel.
+struct ProgramBinaryPerfTest : public api_tests {
+    template <typename TokenT>
+    static void pushBackToken(std::vector<char> &binary, const TokenT &token) {
+        binary.insert(binary.end(), reinterpret_cast<const char *>(&token), reinterpret_cast<const char *>(&token) + sizeof(token));
+    }
+
+    void createBinary(uint32_t numKernels, uint32_t kernelHeapSize) {
+        binary.clear();
+
+        SProgramBinaryHeader programHeader = {};
+        programHeader.Magic = MAGIC_CL;
+        programHeader.Version = CURRENT_ICBE_VERSION;
+        programHeader.Device = pContext->getDevice(0)->getHardwareInfo().pPlatform->eRenderCoreFamily;
+        programHeader.GPUPointerSizeInBytes = 8;
+        programHeader.NumberOfKernels = numKernels;
+        pushBackToken(binary, programHeader);
+
+        for (uint32_t i = 0; i < numKernels; i++) {
+            std::string kernelName = "kernel" + std::to_string(i);
+            kernelName.resize(alignUp(kernelName.size() + 1, 4), '\0');
+
+            std::vector<char> kernelBody(kernelName.begin(), kernelName.end());
+            kernelBody.resize(kernelBody.size() + kernelHeapSize, static_cast<char>(i));
+
+            SPatchExecutionEnvironment executionEnvironment = {};
+            executionEnvironment.Token = PATCH_TOKEN_EXECUTION_ENVIRONMENT;
+            executionEnvironment.Size = sizeof(SPatchExecutionEnvironment);
+            executionEnvironment.LargestCompiledSIMDSize = 16;
+            pushBackToken(kernelBody, executionEnvironment);
+
+            SPatchDataParameterStream dataParameterStream = {};
+            dataParameterStream.Token = PATCH_TOKEN_DATA_PARAMETER_STREAM;
+            dataParameterStream.Size = sizeof(SPatchDataParameterStream);
+            dataParameterStream.DataParameterStreamSize = 256;
+            pushBackToken(kernelBody, dataParameterStream);
+
+            SKernelBinaryHeaderCommon kernelHeader = {};
+            kernelHeader.KernelNameSize = static_cast<uint32_t>(kernelName.size());
+            kernelHeader.KernelHeapSize = kernelHeapSize;
+            kernelHeader.PatchListSize = sizeof(SPatchExecutionEnvironment) + sizeof(SPatchDataParameterStream);
+            kernelHeader.CheckSum = static_cast<uint32_t>(Hash::hash(kernelBody.data(), kernelBody.size()) & 0xFFFFFFFF);
+            pushBackToken(binary, kernelHeader);
+            binary.insert(binary.end(), kernelBody.begin(), kernelBody.end());
+        }
+    }
+
+    long long measureProcessGenBinary(int32_t parsingThreads, bool deferIsaUpload) {
+        DebugManagerStateRestore dbgRestore;
+        DebugManager.flags.KernelParsingThreads.set(parsingThreads);
+        DebugManager.flags.DeferKernelIsaUpload.set(deferIsaUpload);
+
+        cl_int retVal = CL_SUCCESS;
+        std::unique_ptr<Program> program(Program::createFromGenBinary(pContext, binary.data(), binary.size(), false, &retVal));
+        EXPECT_EQ(CL_SUCCESS, retVal);
+
+        Timer t;
+        t.start();
+        retVal = program->processGenBinary();
+        t.end();
+
+        EXPECT_EQ(CL_SUCCESS, retVal);
+        EXPECT_EQ(numKernels, program->getNumKernels());
+        return t.get();
+    }
+
+    void checkProcessGenBinaryTime(int32_t parsingThreads, bool deferIsaUpload) {
+        double previousRatio = -1.0;
+        uint64_t hash = getCurrentTestHash();
+
+        bool success = getTestRatio(hash, previousRatio);
+
+        createBinary(numKernels, kernelHeapSize);
+        long long time = majorityVote(measureProcessGenBinary(parsingThreads, deferIsaUpload),
+                                      measureProcessGenBinary(parsingThreads, deferIsaUpload),
+                                      measureProcessGenBinary(parsingThreads, deferIsaUpload));
+
+        double ratio = static_cast<double>(time) / static_cast<double>(refTime);
+
+        if (success && previousRatio > ratioThreshold) {
+            EXPECT_TRUE(isLowerThanReference(ratio, previousRatio, multiplier)) << "Current: " << ratio << " previous: " << previousRatio << "\n";
+        }
+
+        updateTestRatio(hash, ratio);
+    }
+
+    const uint32_t numKernels = 320;
+    const uint32_t kernelHeapSize = 16 * 1024;
+    std::vector<char> binary;
+};
+
+TEST_F(ProgramBinaryPerfTest, givenBinaryWithManyKernelsWhenParsedSequentiallyThenTimeIsNotWorseThanReference) {
+    checkProcessGenBinaryTime(0, false);
+}
+
+TEST_F(ProgramBinaryPerfTest, givenBinaryWithManyKernelsWhenParsedInParallelThenTimeIsNotWorseThanReference) {
+    checkProcessGenBinaryTime(-1, false);
+}
+
+TEST_F(ProgramBinaryPerfTest, givenBinaryWithManyKernelsWhenParsedInParallelWithDeferredIsaUploadThenTimeIsNotWorseThanReference) {
+    checkProcessGenBinaryTime(-1, true);
+}
+} // namespace ULT
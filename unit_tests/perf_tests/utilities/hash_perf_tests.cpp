@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/helpers/fast_hash.h"
+#include "runtime/helpers/hash.h"
+#include "unit_tests/perf_tests/perf_test_utils.h"
+
+#include <vector>
+
+using namespace OCLRT;
+
+namespace ULT {
+
+// multiplier of reference ratio that is compared ( checked if less than ) with current result
+const double multiplier = 1.5000;
+// ratio results that are not checked be EXPECT ( very short time tests are not chceked due to high fluctuations )
+const double ratioThreshold = 0.005;
+
+struct HashPerfTest : public ::testing::TestWithParam<size_t> {
+    void SetUp() override {
+        setReferenceTime();
+        data.resize(GetParam() + 1);
+        for (size_t i = 0; i < data.size(); i++) {
+            data[i] = static_cast<char>(i * 131 + 7);
+        }
+    }
+
+    // HashT::hash runs update and finish over the whole buffer
+    template <typename HashT>
+    long long measureHash(size_t offset, uint64_t &result) {
+        Timer t;
+        t.start();
+        result = HashT::hash(data.data() + offset, data.size() - offset);
+        t.end();
+        return t.get();
+    }
+
+    template <typename HashT>
+    void checkHashTime(size_t offset) {
+        double previousRatio = -1.0;
+        uint64_t hash = getCurrentTestHash();
+
+        bool success = getTestRatio(hash, previousRatio);
+
+        uint64_t r1, r2, r3;
+        long long time = majorityVote(measureHash<HashT>(offset, r1), measureHash<HashT>(offset, r2), measureHash<HashT>(offset, r3));
+        EXPECT_EQ(r1, r2);
+        EXPECT_EQ(r1, r3);
+
+        double ratio = static_cast<double>(time) / static_cast<double>(refTime);
+
+        if (success && previousRatio > ratioThreshold) {
+            EXPECT_TRUE(isLowerThanReference(ratio, previousRatio, multiplier)) << "Current: " << ratio << " previous: " << previousRatio << "\n";
+        }
+
+        updateTestRatio(hash, ratio);
+    }
+
+    std::vector<char> data;
+};
+
+TEST_P(HashPerfTest, givenAlignedBufferWhenHashedWithHashThenTimeIsNotWorseThanReference) {
+    checkHashTime<Hash>(0);
+}
+
+TEST_P(HashPerfTest, givenUnalignedBufferWhenHashedWithHashThenTimeIsNotWorseThanReference) {
+    checkHashTime<Hash>(1);
+}
+
+TEST_P(HashPerfTest, givenAlignedBufferWhenHashedWithFastHashThenTimeIsNotWorseThanReference) {
+    checkHashTime<FastHash>(0);
+}
+
+TEST_P(HashPerfTest, givenUnalignedBufferWhenHashedWithFastHashThenTimeIsNotWorseThanReference) {
+    checkHashTime<FastHash>(1);
+}
+
+INSTANTIATE_TEST_CASE_P(HashPerfTest,
+                        HashPerfTest,
+                        ::testing::Values(4u * 1024u, 256u * 1024u, 16u * 1024u * 1024u));
+} // namespace ULT
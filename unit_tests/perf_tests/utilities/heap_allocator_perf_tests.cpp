@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/utilities/heap_allocator.h"
+#include "runtime/utilities/segregated_heap_allocator.h"
+#include "unit_tests/perf_tests/perf_test_utils.h"
+
+#include <random>
+#include <vector>
+
+using namespace OCLRT;
+
+namespace ULT {
+
+struct AllocatorTraceEntry {
+    bool allocate;
+    size_t size;
+    size_t slot;
+};
+
+// Builds alloc/free trace keeping around liveAllocations allocations of the given
+// page counts, frees hit random live allocations like kernel ISA and internal heaps do.
+static std::vector<AllocatorTraceEntry> buildTrace(size_t liveAllocations, size_t operations, const std::vector<size_t> &pageCounts) {
+    std::vector<AllocatorTraceEntry> trace;
+    std::vector<size_t> liveSlots;
+    std::mt19937 generator(liveAllocations);
+    size_t nextSlot = 0;
+
+    trace.reserve(operations + liveAllocations);
+    for (size_t i = 0; i < operations; i++) {
+        if (liveSlots.size() < liveAllocations || (generator() % 2)) {
+            auto size = pageCounts[generator() % pageCounts.size()] * MemoryConstants::pageSize;
+            trace.push_back({true, size, nextSlot});
+            liveSlots.push_back(nextSlot++);
+        } else {
+            auto index = generator() % liveSlots.size();
+            trace.push_back({false, 0, liveSlots[index]});
+            liveSlots[index] = liveSlots.back();
+            liveSlots.pop_back();
+        }
+    }
+    for (auto slot : liveSlots) {
+        trace.push_back({false, 0, slot});
+    }
+    return trace;
+}
+
+template <typename AllocatorT>
+long long replayTrace(const std::vector<AllocatorTraceEntry> &trace) {
+    const uint64_t heapSize = 4 * MemoryConstants::gigaByte - 2 * MemoryConstants::pageSize;
+    AllocatorT allocator(reinterpret_cast<void *>(0x10000), heapSize);
+    std::vector<std::pair<void *, size_t>> slots(trace.size());
+
+    Timer t;
+    t.start();
+    for (auto &entry : trace) {
+        auto &slot = slots[entry.slot];
+        if (entry.allocate) {
+            slot.second = entry.size;
+            slot.first = allocator.allocate(slot.second);
+        } else {
+            allocator.free(slot.first, slot.second);
+        }
+    }
+    t.end();
+    return t.get();
+}
+
+template <typename AllocatorT>
+long long measureTrace(const std::vector<AllocatorTraceEntry> &trace) {
+    return majorityVote(replayTrace<AllocatorT>(trace), replayTrace<AllocatorT>(trace), replayTrace<AllocatorT>(trace));
+}
+
+// multiplier of reference ratio that is compared ( checked if less than ) with current result
+const double multiplier = 1.5000;
+// ratio results that are not checked be EXPECT ( very short time tests are not chceked due to high fluctuations )
+const double ratioThreshold = 0.005;
+
+struct HeapAllocatorPerfTest : public ::testing::TestWithParam<size_t> {
+    void SetUp() override {
+        setReferenceTime();
+    }
+
+    template <typename AllocatorT>
+    void checkTraceTime(const std::vector<AllocatorTraceEntry> &trace) {
+        double previousRatio = -1.0;
+        uint64_t hash = getCurrentTestHash();
+
+        bool success = getTestRatio(hash, previousRatio);
+
+        long long time = measureTrace<AllocatorT>(trace);
+
+        double ratio = static_cast<double>(time) / static_cast<double>(refTime);
+
+        if (success && previousRatio > ratioThreshold) {
+            EXPECT_TRUE(isLowerThanReference(ratio, previousRatio, multiplier)) << "Current: " << ratio << " previous: " << previousRatio << "\n";
+        }
+
+        updateTestRatio(hash, ratio);
+    }
+};
+
+// HeapAllocator runs replay the same traces, their ratios are the baseline for the segregated allocator ones
+
+TEST_P(HeapAllocatorPerfTest, givenSameSizesChurnWhenReplayedOnHeapAllocatorThenTimeIsNotWorseThanReference) {
+    checkTraceTime<HeapAllocator>(buildTrace(GetParam(), 200000, {1, 2, 4, 16}));
+}
+
+TEST_P(HeapAllocatorPerfTest, givenSameSizesChurnWhenReplayedOnSegregatedAllocatorThenTimeIsNotWorseThanReference) {
+    checkTraceTime<SegregatedHeapAllocator>(buildTrace(GetParam(), 200000, {1, 2, 4, 16}));
+}
+
+TEST_P(HeapAllocatorPerfTest, givenMixedSizesWhenReplayedOnHeapAllocatorThenTimeIsNotWorseThanReference) {
+    checkTraceTime<HeapAllocator>(buildTrace(GetParam(), 200000, {1, 3, 5, 8, 24, 64, 100}));
+}
+
+TEST_P(HeapAllocatorPerfTest, givenMixedSizesWhenReplayedOnSegregatedAllocatorThenTimeIsNotWorseThanReference) {
+    checkTraceTime<SegregatedHeapAllocator>(buildTrace(GetParam(), 200000, {1, 3, 5, 8, 24, 64, 100}));
+}
+
+INSTANTIATE_TEST_CASE_P(HeapAllocatorPerfTest,
+                        HeapAllocatorPerfTest,
+                        ::testing::Values(1000u, 5000u, 20000u));
+} // namespace ULT
@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/helpers/host_copy.h"
+#include "runtime/utilities/worker_pool.h"
+#include "unit_tests/perf_tests/perf_test_utils.h"
+
+#include <vector>
+
+using namespace OCLRT;
+
+namespace ULT {
+
+// multiplier of reference ratio that is compared ( checked if less than ) with current result
+const double multiplier = 1.5000;
+// ratio results that are not checked be EXPECT ( very short time tests are not chceked due to high fluctuations )
+const double ratioThreshold = 0.005;
+
+struct HostCopyPerfParams {
+    size_t rowSize;
+    size_t numRows;
+    size_t numSlices;
+    size_t rowPadding;
+};
+
+struct HostCopyPerfTest : public ::testing::TestWithParam<HostCopyPerfParams> {
+    void SetUp() override {
+        setReferenceTime();
+    }
+
+    long long measureCopy(const HostCopyRegion &region, WorkerPool &workerPool) {
+        Timer t;
+        t.start();
+        HostCopy::copy(region, &workerPool);
+        t.end();
+        return t.get();
+    }
+};
+
+TEST_P(HostCopyPerfTest, givenImageSizedRegionWhenCopiedWithHostCopyThenTimeIsNotWorseThanReference) {
+    double previousRatio = -1.0;
+    uint64_t hash = getCurrentTestHash();
+
+    bool success = getTestRatio(hash, previousRatio);
+
+    auto params = GetParam();
+    auto rowPitch = params.rowSize + params.rowPadding;
+    auto slicePitch = rowPitch * params.numRows;
+    std::vector<char> src(slicePitch * params.numSlices, 1);
+    std::vector<char> dst(slicePitch * params.numSlices, 0);
+
+    HostCopyRegion region;
+    region.dst = dst.data();
+    region.dstRowPitch = rowPitch;
+    region.dstSlicePitch = slicePitch;
+    region.src = src.data();
+    region.srcRowPitch = rowPitch;
+    region.srcSlicePitch = slicePitch;
+    region.rowSize = params.rowSize;
+    region.numRows = params.numRows;
+    region.numSlices = params.numSlices;
+
+    WorkerPool workerPool(-1);
+    long long time = majorityVote(measureCopy(region, workerPool), measureCopy(region, workerPool), measureCopy(region, workerPool));
+
+    double ratio = static_cast<double>(time) / static_cast<double>(refTime);
+
+    if (success && previousRatio > ratioThreshold) {
+        EXPECT_TRUE(isLowerThanReference(ratio, previousRatio, multiplier)) << "Current: " << ratio << " previous: " << previousRatio << "\n";
+    }
+
+    updateTestRatio(hash, ratio);
+}
+
+INSTANTIATE_TEST_CASE_P(HostCopyPerfTest,
+                        HostCopyPerfTest,
+                        ::testing::Values(HostCopyPerfParams{256 * 4, 256, 1, 0},
+                                          HostCopyPerfParams{1920 * 4, 1080, 1, 0},
+                                          HostCopyPerfParams{1920 * 4, 1080, 1, 256},
+                                          HostCopyPerfParams{3840 * 4, 2160, 1, 256},
+                                          HostCopyPerfParams{256 * 4, 256, 64, 64}));
+} // namespace ULT
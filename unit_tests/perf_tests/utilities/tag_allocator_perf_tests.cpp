@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/memory_manager/os_agnostic_memory_manager.h"
+#include "runtime/utilities/tag_allocator.h"
+#include "unit_tests/perf_tests/perf_test_utils.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace OCLRT;
+
+namespace ULT {
+
+struct PerfTestTag {
+    uint64_t value;
+};
+using PerfTestTagAllocator = TagAllocator<PerfTestTag>;
+
+// Every thread does the same amount of get/return work, so with no contention
+// wall time stays flat as threads are added
+static const int iterationsPerThread = 50000;
+static const int tagsHeldPerThread = 4;
+
+static void getAndReturnTags(PerfTestTagAllocator *allocator, std::atomic<bool> *start) {
+    TagNode<PerfTestTag> *nodes[tagsHeldPerThread];
+
+    while (!*start)
+        ;
+    for (int i = 0; i < iterationsPerThread; i++) {
+        for (int n = 0; n < tagsHeldPerThread; n++) {
+            nodes[n] = allocator->getTag();
+            nodes[n]->tag->value = i;
+        }
+        for (int n = 0; n < tagsHeldPerThread; n++) {
+            allocator->returnTag(nodes[n]);
+        }
+    }
+}
+
+static long long runContention(int threadCount) {
+    OsAgnosticMemoryManager memoryManager;
+    std::atomic<bool> start(false);
+    Timer t;
+    {
+        // pool already holds tags for all threads, only list contention is timed
+        PerfTestTagAllocator allocator(&memoryManager, threadCount * tagsHeldPerThread, 64, 0);
+
+        std::vector<std::thread> threads;
+        for (int i = 0; i < threadCount; i++) {
+            threads.push_back(std::thread(getAndReturnTags, &allocator, &start));
+        }
+
+        t.start();
+        start = true;
+        for (auto &thread : threads) {
+            thread.join();
+        }
+        t.end();
+    }
+    return t.get();
+}
+
+// multiplier of reference ratio that is compared ( checked if less than ) with current result
+const double multiplier = 1.5000;
+// ratio results that are not checked be EXPECT ( very short time tests are not chceked due to high fluctuations )
+const double ratioThreshold = 0.005;
+
+struct TagAllocatorContentionPerfTest : public ::testing::TestWithParam<int /*thread count*/> {
+    void SetUp() override {
+        setReferenceTime();
+    }
+};
+
+// Single thread run is the uncontended baseline, ratios of the other thread counts show contention cost
+TEST_P(TagAllocatorContentionPerfTest, givenThreadsGettingAndReturningTagsWhenTimedThenTimeIsNotWorseThanReference) {
+    auto threadCount = GetParam();
+    double previousRatio = -1.0;
+    uint64_t hash = getCurrentTestHash();
+
+    bool success = getTestRatio(hash, previousRatio);
+
+    long long time = majorityVote(runContention(threadCount), runContention(threadCount), runContention(threadCount));
+
+    double ratio = static_cast<double>(time) / static_cast<double>(refTime);
+
+    if (success && previousRatio > ratioThreshold) {
+        EXPECT_TRUE(isLowerThanReference(ratio, previousRatio, multiplier)) << "Current: " << ratio << " previous: " << previousRatio << "\n";
+    }
+
+    updateTestRatio(hash, ratio);
+}
+
+INSTANTIATE_TEST_CASE_P(TagAllocatorContentionPerfTest,
+                        TagAllocatorContentionPerfTest,
+                        ::testing::Values(1, 2, 4, 8));
+} // namespace ULT
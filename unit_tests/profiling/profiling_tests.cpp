@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017, Intel Corporation
+ * Copyright (c) 2017 - 2018, Intel Corporation
  *
  * Permission is hereby granted, free of charge, to any person obtaining a
  * copy of this software and associated documentation files (the "Software"),
@@ -428,6 +428,8 @@ TEST(EventProfilingTest, calcProfilingDataSetsEndTimestampInCompleteTimestampWhe
     event.calcProfilingData();
 
     EXPECT_EQ(timestamp.ContextEndTS, timestamp.ContextCompleteTS);
+    // node does not come from the allocator, it must not be returned to it
+    event.timeStampNode = nullptr;
     cmdQ.device = nullptr;
     delete device;
 }
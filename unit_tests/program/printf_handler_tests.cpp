@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017, Intel Corporation
+ * Copyright (c) 2017 - 2018, Intel Corporation
  *
  * Permission is hereby granted, free of charge, to any person obtaining a
  * copy of this software and associated documentation files (the "Software"),
@@ -123,3 +123,37 @@ TEST(PrintfHandlerTest, givenParentKernelWithPrintfAndBlockKernelWithoutPrintfWh
 
     ASSERT_NE(nullptr, printfHandler);
 }
+
+TEST(PrintfHandlerTest, givenPrintfHandlerWithPrintedOutputWhenNextHandlerIsPreparedThenPrintfSurfaceIsReused) {
+    std::unique_ptr<MockDevice> device(DeviceHelper<>::create());
+    MockContext context;
+    SPatchAllocateStatelessPrintfSurface printfSurface = {};
+    printfSurface.DataParamOffset = 0;
+    printfSurface.DataParamSize = 8;
+
+    KernelInfo kernelInfo;
+    kernelInfo.patchInfo.pAllocateStatelessPrintfSurface = &printfSurface;
+
+    std::unique_ptr<MockProgram> program(new MockProgram(&context, false));
+
+    uint64_t crossThread[10];
+    std::unique_ptr<MockKernel> kernel(new MockKernel(program.get(), kernelInfo, *device));
+    kernel->setCrossThreadData(&crossThread, sizeof(uint64_t) * 8);
+
+    MockMultiDispatchInfo multiDispatchInfo(kernel.get());
+    std::unique_ptr<PrintfHandler> printfHandler(PrintfHandler::create(multiDispatchInfo, *device));
+    printfHandler->prepareDispatch(multiDispatchInfo);
+    auto firstSurface = printfHandler->getSurface();
+    ASSERT_NE(nullptr, firstSurface);
+    *reinterpret_cast<uint32_t *>(firstSurface->getUnderlyingBuffer()) = 64;
+
+    printfHandler->printEnqueueOutput();
+    printfHandler.reset();
+    EXPECT_FALSE(device->getMemoryManager()->printfSurfacesForReuse.peekIsEmpty());
+
+    printfHandler.reset(PrintfHandler::create(multiDispatchInfo, *device));
+    printfHandler->prepareDispatch(multiDispatchInfo);
+    EXPECT_EQ(firstSurface, printfHandler->getSurface());
+    EXPECT_EQ(sizeof(uint32_t), *reinterpret_cast<uint32_t *>(printfHandler->getSurface()->getUnderlyingBuffer()));
+    EXPECT_TRUE(device->getMemoryManager()->printfSurfacesForReuse.peekIsEmpty());
+}
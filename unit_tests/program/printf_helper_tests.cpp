@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017, Intel Corporation
+ * Copyright (c) 2017 - 2018, Intel Corporation
  *
  * Permission is hereby granted, free of charge, to any person obtaining a
  * copy of this software and associated documentation files (the "Software"),
@@ -29,6 +29,7 @@
 #include "gtest/gtest.h"
 
 #include <cmath>
+#include <vector>
 
 using namespace OCLRT;
 using namespace iOpenCL;
@@ -802,6 +803,73 @@ TEST_F(PrintFormatterTest, GivenEmptyBufferWhenPrintingThenFailSafely) {
     EXPECT_STREQ("", actualOutput);
 }
 
+TEST_F(PrintFormatterTest, GivenMultipleRecordsWhenPrintingThenAllRecordsArePassedToPrintInOneBatch) {
+    auto stringIndex = injectFormatString("%d\\n");
+    for (int i = 0; i < 3; i++) {
+        storeData(stringIndex);
+        injectValue(i);
+    }
+
+    std::vector<std::string> printedChunks;
+    printFormatter->printKernelOutput([&printedChunks](char *str) { printedChunks.push_back(str); });
+
+    ASSERT_EQ(1u, printedChunks.size());
+    EXPECT_STREQ("0\n1\n2\n", printedChunks[0].c_str());
+}
+
+TEST_F(PrintFormatterTest, GivenFormatStringStoredInKernelInfoWhenQueryingPrintfFormatThenCompiledFormatIsReturned) {
+    auto stringIndex = injectFormatString("value %v4hld\\n");
+
+    auto format = kernelInfo->queryPrintfFormat(stringIndex);
+    ASSERT_NE(nullptr, format);
+    ASSERT_EQ(3u, format->getTokens().size());
+    EXPECT_EQ(PrintfFormatToken::Type::Text, format->getTokens()[0].type);
+    EXPECT_EQ("value ", format->getTokens()[0].format);
+    EXPECT_EQ(PrintfFormatToken::Type::Conversion, format->getTokens()[1].type);
+    EXPECT_EQ("%v4hld", format->getTokens()[1].format);
+    EXPECT_EQ("%d", format->getTokens()[1].vectorFormat);
+    EXPECT_EQ(PrintfFormatToken::Type::Text, format->getTokens()[2].type);
+    EXPECT_EQ("\n", format->getTokens()[2].format);
+
+    EXPECT_EQ(nullptr, kernelInfo->queryPrintfFormat(stringIndex + 1));
+}
+
+TEST_F(PrintFormatterTest, GivenFormatStringWithoutCompiledFormatWhenPrintingThenFormatIsCompiledOnTheFly) {
+    auto stringIndex = injectFormatString("%d");
+    kernelInfo->printfFormats.clear();
+    storeData(stringIndex);
+    injectValue(7);
+
+    char actualOutput[PrintFormatter::maxPrintfOutputLength];
+    printFormatter->printKernelOutput([&actualOutput](char *str) { strncpy_s(actualOutput, PrintFormatter::maxPrintfOutputLength, str, PrintFormatter::maxPrintfOutputLength); });
+
+    EXPECT_STREQ("7", actualOutput);
+}
+
+TEST(PrintfFormatTest, GivenStringFormatWhenCompilingThenStringTokenIsCreated) {
+    auto format = PrintfFormat::compile("%10s!");
+
+    ASSERT_EQ(2u, format.getTokens().size());
+    EXPECT_EQ(PrintfFormatToken::Type::String, format.getTokens()[0].type);
+    EXPECT_EQ("%10s", format.getTokens()[0].format);
+    EXPECT_EQ(PrintfFormatToken::Type::Text, format.getTokens()[1].type);
+    EXPECT_EQ("!", format.getTokens()[1].format);
+}
+
+TEST(PrintfFormatTest, GivenSixteenChannelVectorWhenCompilingThenChannelFormatIsStripped) {
+    auto format = PrintfFormat::compile("%v16hhx");
+
+    ASSERT_EQ(1u, format.getTokens().size());
+    EXPECT_EQ("%hhx", format.getTokens()[0].vectorFormat);
+}
+
+TEST(PrintfFormatTest, GivenTrailingBackslashWhenCompilingThenTextEndsBeforeIt) {
+    auto format = PrintfFormat::compile(R"(abc\)");
+
+    ASSERT_EQ(1u, format.getTokens().size());
+    EXPECT_EQ("abc", format.getTokens()[0].format);
+}
+
 TEST(printToSTDOUTTest, GivenStringWhenPrintingToSTDOUTThenExpectOutput) {
     testing::internal::CaptureStdout();
     printToSTDOUT("test");
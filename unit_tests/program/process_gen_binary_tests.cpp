@@ -0,0 +1,208 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/helpers/aligned_memory.h"
+#include "runtime/helpers/hash.h"
+#include "runtime/program/program.h"
+#include "unit_tests/fixtures/device_fixture.h"
+#include "unit_tests/helpers/debug_manager_state_restore.h"
+#include "unit_tests/mocks/mock_program.h"
+#include "test.h"
+
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace OCLRT;
+using namespace iOpenCL;
+
+extern GFXCORE_FAMILY renderCoreFamily;
+
+namespace {
+template <typename TokenT>
+void pushBackToken(std::vector<char> &binary, const TokenT &token) {
+    binary.insert(binary.end(), reinterpret_cast<const char *>(&token), reinterpret_cast<const char *>(&token) + sizeof(token));
+}
+
+std::vector<char> createProgramBinary(uint32_t numKernels, uint32_t kernelHeapSize, uint32_t invalidKernel = std::numeric_limits<uint32_t>::max()) {
+    std::vector<char> binary;
+
+    SProgramBinaryHeader programHeader = {};
+    programHeader.Magic = MAGIC_CL;
+    programHeader.Version = CURRENT_ICBE_VERSION;
+    programHeader.Device = renderCoreFamily;
+    programHeader.GPUPointerSizeInBytes = 8;
+    programHeader.NumberOfKernels = numKernels;
+    pushBackToken(binary, programHeader);
+
+    for (uint32_t i = 0; i < numKernels; i++) {
+        std::string kernelName = "kernel" + std::to_string(i);
+        kernelName.resize(alignUp(kernelName.size() + 1, 4), '\0');
+
+        std::vector<char> kernelBody(kernelName.begin(), kernelName.end());
+        for (uint32_t byte = 0; byte < kernelHeapSize; byte++) {
+            kernelBody.push_back(static_cast<char>(i + byte));
+        }
+
+        SPatchDataParameterStream dataParameterStream = {};
+        dataParameterStream.Token = PATCH_TOKEN_DATA_PARAMETER_STREAM;
+        dataParameterStream.Size = sizeof(SPatchDataParameterStream);
+        dataParameterStream.DataParameterStreamSize = 64;
+        pushBackToken(kernelBody, dataParameterStream);
+        uint32_t patchListSize = sizeof(SPatchDataParameterStream);
+
+        if (i == invalidKernel) {
+            SPatchItemHeader unhandledToken = {};
+            unhandledToken.Token = NUM_PATCH_TOKENS;
+            unhandledToken.Size = sizeof(SPatchItemHeader);
+            pushBackToken(kernelBody, unhandledToken);
+            patchListSize += sizeof(SPatchItemHeader);
+        }
+
+        SKernelBinaryHeaderCommon kernelHeader = {};
+        kernelHeader.KernelNameSize = static_cast<uint32_t>(kernelName.size());
+        kernelHeader.KernelHeapSize = kernelHeapSize;
+        kernelHeader.PatchListSize = patchListSize;
+        kernelHeader.CheckSum = static_cast<uint32_t>(Hash::hash(kernelBody.data(), kernelBody.size()) & 0xFFFFFFFF);
+        pushBackToken(binary, kernelHeader);
+        binary.insert(binary.end(), kernelBody.begin(), kernelBody.end());
+    }
+    return binary;
+}
+
+struct MockProgramRejectingUnhandledTokens : MockProgram {
+    using MockProgram::MockProgram;
+
+    bool isSafeToSkipUnhandledToken(unsigned int) const override {
+        return false;
+    }
+};
+} // namespace
+
+struct ProcessGenBinaryTest : public DeviceFixture,
+                              public ::testing::Test {
+    void SetUp() override {
+        DeviceFixture::SetUp();
+    }
+
+    void TearDown() override {
+        DeviceFixture::TearDown();
+    }
+
+    template <typename ProgramT = MockProgram>
+    std::unique_ptr<ProgramT> createProgram(const std::vector<char> &binary) {
+        cl_int retVal = CL_INVALID_BINARY;
+        std::unique_ptr<ProgramT> program(Program::createFromGenBinary<ProgramT>(nullptr, binary.data(), binary.size(), false, &retVal));
+        EXPECT_EQ(CL_SUCCESS, retVal);
+        program->SetDevice(pDevice);
+        return program;
+    }
+
+    DebugManagerStateRestore dbgRestore;
+};
+
+TEST_F(ProcessGenBinaryTest, givenManyKernelsWhenParsedInParallelThenKernelInfosMatchSequentialParsing) {
+    auto binary = createProgramBinary(64, 256);
+
+    DebugManager.flags.KernelParsingThreads.set(0);
+    auto sequentialProgram = createProgram(binary);
+    EXPECT_EQ(CL_SUCCESS, sequentialProgram->processGenBinary());
+
+    DebugManager.flags.KernelParsingThreads.set(4);
+    auto parallelProgram = createProgram(binary);
+    EXPECT_EQ(CL_SUCCESS, parallelProgram->processGenBinary());
+
+    ASSERT_EQ(64u, parallelProgram->getNumKernels());
+    ASSERT_EQ(sequentialProgram->getNumKernels(), parallelProgram->getNumKernels());
+    for (size_t i = 0; i < parallelProgram->getNumKernels(); i++) {
+        auto sequentialInfo = sequentialProgram->getKernelInfo(i);
+        auto parallelInfo = parallelProgram->getKernelInfo(i);
+        EXPECT_EQ(sequentialInfo->name, parallelInfo->name);
+        EXPECT_TRUE(parallelInfo->isValid);
+        EXPECT_EQ(sequentialInfo->heapInfo.pKernelHeap, parallelInfo->heapInfo.pKernelHeap);
+        EXPECT_EQ(sequentialInfo->heapInfo.blobSize, parallelInfo->heapInfo.blobSize);
+        ASSERT_NE(nullptr, parallelInfo->patchInfo.dataParameterStream);
+        EXPECT_EQ(64u, parallelInfo->patchInfo.dataParameterStream->DataParameterStreamSize);
+        ASSERT_NE(nullptr, parallelInfo->getGraphicsAllocation());
+        EXPECT_EQ(0, memcmp(parallelInfo->getGraphicsAllocation()->getUnderlyingBuffer(), parallelInfo->heapInfo.pKernelHeap, 256));
+    }
+}
+
+TEST_F(ProcessGenBinaryTest, givenInvalidKernelWhenParsedInParallelThenKernelsBeforeItAreKeptAndErrorIsReturned) {
+    auto binary = createProgramBinary(64, 64, 40);
+
+    DebugManager.flags.KernelParsingThreads.set(0);
+    auto sequentialProgram = createProgram<MockProgramRejectingUnhandledTokens>(binary);
+    EXPECT_EQ(CL_INVALID_KERNEL, sequentialProgram->processGenBinary());
+
+    DebugManager.flags.KernelParsingThreads.set(4);
+    auto parallelProgram = createProgram<MockProgramRejectingUnhandledTokens>(binary);
+    EXPECT_EQ(CL_INVALID_KERNEL, parallelProgram->processGenBinary());
+
+    EXPECT_EQ(40u, sequentialProgram->getNumKernels());
+    EXPECT_EQ(sequentialProgram->getNumKernels(), parallelProgram->getNumKernels());
+}
+
+TEST_F(ProcessGenBinaryTest, givenNumberOfKernelsExceedingBinaryWhenParsedInParallelThenInvalidBinaryIsReturned) {
+    auto binary = createProgramBinary(16, 64);
+    reinterpret_cast<SProgramBinaryHeader *>(binary.data())->NumberOfKernels = std::numeric_limits<uint32_t>::max();
+
+    DebugManager.flags.KernelParsingThreads.set(4);
+    auto program = createProgram(binary);
+    EXPECT_EQ(CL_INVALID_BINARY, program->processGenBinary());
+    EXPECT_EQ(0u, program->getNumKernels());
+}
+
+TEST_F(ProcessGenBinaryTest, givenTruncatedKernelWhenParsedInParallelThenInvalidBinaryIsReturned) {
+    auto binary = createProgramBinary(16, 64);
+    binary.resize(binary.size() - 1);
+
+    DebugManager.flags.KernelParsingThreads.set(4);
+    auto program = createProgram(binary);
+    EXPECT_EQ(CL_INVALID_BINARY, program->processGenBinary());
+    EXPECT_EQ(0u, program->getNumKernels());
+}
+
+TEST_F(ProcessGenBinaryTest, givenFewKernelsWhenParsingThreadsAreRequestedThenAllKernelsAreProcessed) {
+    DebugManager.flags.KernelParsingThreads.set(4);
+    auto program = createProgram(createProgramBinary(4, 64));
+    EXPECT_EQ(CL_SUCCESS, program->processGenBinary());
+    EXPECT_EQ(4u, program->getNumKernels());
+}
+
+TEST_F(ProcessGenBinaryTest, givenDeferKernelIsaUploadWhenProgramIsProcessedThenIsaIsUploadedOnFirstUse) {
+    DebugManager.flags.DeferKernelIsaUpload.set(true);
+    auto program = createProgram(createProgramBinary(2, 128));
+    EXPECT_EQ(CL_SUCCESS, program->processGenBinary());
+
+    auto kernelInfo = program->getKernelInfo(size_t{1});
+    EXPECT_EQ(nullptr, kernelInfo->getGraphicsAllocation());
+
+    auto kernelAllocation = program->getKernelIsaAllocation(*kernelInfo);
+    ASSERT_NE(nullptr, kernelAllocation);
+    EXPECT_EQ(kernelAllocation, kernelInfo->getGraphicsAllocation());
+    EXPECT_EQ(0, memcmp(kernelAllocation->getUnderlyingBuffer(), kernelInfo->heapInfo.pKernelHeap, 128));
+    EXPECT_EQ(kernelAllocation, program->getKernelIsaAllocation(*kernelInfo));
+
+    EXPECT_EQ(nullptr, program->getKernelInfo(size_t{0})->getGraphicsAllocation());
+}
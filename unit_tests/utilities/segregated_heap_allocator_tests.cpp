@@ -0,0 +1,233 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "test.h"
+#include "gtest/gtest.h"
+#include "runtime/utilities/segregated_heap_allocator.h"
+
+#include <map>
+#include <random>
+
+using namespace OCLRT;
+
+class SegregatedHeapAllocatorUnderTest : public SegregatedHeapAllocator {
+  public:
+    using SegregatedHeapAllocator::SegregatedHeapAllocator;
+    using SegregatedHeapAllocator::flushSizeClasses;
+    using SegregatedHeapAllocator::freedChunks;
+    using SegregatedHeapAllocator::freedChunksBySize;
+    using SegregatedHeapAllocator::pLeftBound;
+    using SegregatedHeapAllocator::pRightBound;
+    using SegregatedHeapAllocator::sizeClasses;
+};
+
+const uint64_t heapBase = 0x100000;
+const uint64_t heapSize = 1024 * MemoryConstants::pageSize;
+const size_t threshold = 16 * MemoryConstants::pageSize;
+
+TEST(SegregatedHeapAllocatorTest, givenSmallAndBigRequestsWhenAllocatingThenSmallComeFromTopAndBigFromBottom) {
+    SegregatedHeapAllocatorUnderTest allocator(reinterpret_cast<void *>(heapBase), heapSize, threshold);
+
+    size_t smallSize = MemoryConstants::pageSize;
+    auto smallPtr = allocator.allocate(smallSize);
+    EXPECT_EQ(reinterpret_cast<void *>(heapBase + heapSize - MemoryConstants::pageSize), smallPtr);
+
+    size_t bigSize = threshold + MemoryConstants::pageSize;
+    auto bigPtr = allocator.allocate(bigSize);
+    EXPECT_EQ(reinterpret_cast<void *>(heapBase), bigPtr);
+
+    EXPECT_EQ(smallSize + bigSize, allocator.getUsedSize());
+    allocator.free(smallPtr, smallSize);
+    allocator.free(bigPtr, bigSize);
+    EXPECT_EQ(heapSize, allocator.getLeftSize());
+    EXPECT_EQ(heapBase, allocator.pLeftBound);
+    EXPECT_EQ(heapBase + heapSize, allocator.pRightBound);
+}
+
+TEST(SegregatedHeapAllocatorTest, givenUnalignedSizeWhenAllocatingThenSizeIsAlignedToPage) {
+    SegregatedHeapAllocatorUnderTest allocator(reinterpret_cast<void *>(heapBase), heapSize, threshold);
+
+    size_t size = 10;
+    auto ptr = allocator.allocate(size);
+    EXPECT_NE(nullptr, ptr);
+    EXPECT_EQ(MemoryConstants::pageSize, size);
+    allocator.free(ptr, size);
+}
+
+TEST(SegregatedHeapAllocatorTest, givenFreedSmallChunkWhenSameSizeIsRequestedThenChunkIsReusedFromSizeClass) {
+    SegregatedHeapAllocatorUnderTest allocator(reinterpret_cast<void *>(heapBase), heapSize, threshold);
+
+    size_t size = 2 * MemoryConstants::pageSize;
+    auto ptr1 = allocator.allocate(size);
+    auto ptr2 = allocator.allocate(size);
+    allocator.free(ptr1, size);
+
+    EXPECT_EQ(1u, allocator.sizeClasses[2].size());
+    EXPECT_TRUE(allocator.freedChunks.empty());
+
+    auto ptr3 = allocator.allocate(size);
+    EXPECT_EQ(ptr1, ptr3);
+    EXPECT_TRUE(allocator.sizeClasses[2].empty());
+
+    allocator.free(ptr3, size);
+    allocator.free(ptr2, size);
+}
+
+TEST(SegregatedHeapAllocatorTest, givenFreedChunkSmallerThanTwiceRequestedSizeWhenAllocatingThenWholeChunkIsReturned) {
+    SegregatedHeapAllocatorUnderTest allocator(reinterpret_cast<void *>(heapBase), heapSize, threshold);
+
+    size_t size = 4 * MemoryConstants::pageSize;
+    auto ptr = allocator.allocate(size);
+    size_t guardSize = MemoryConstants::pageSize;
+    auto guard = allocator.allocate(guardSize);
+    allocator.free(ptr, size);
+
+    size_t smallerSize = 3 * MemoryConstants::pageSize;
+    auto reused = allocator.allocate(smallerSize);
+    EXPECT_EQ(ptr, reused);
+    EXPECT_EQ(size, smallerSize);
+
+    allocator.free(reused, smallerSize);
+    allocator.free(guard, guardSize);
+}
+
+TEST(SegregatedHeapAllocatorTest, givenFreedChunkAtLeastTwiceRequestedSizeWhenAllocatingThenChunkIsSplit) {
+    SegregatedHeapAllocatorUnderTest allocator(reinterpret_cast<void *>(heapBase), heapSize, static_cast<size_t>(heapSize));
+
+    size_t size = (SegregatedHeapAllocator::numSizeClasses + 8) * MemoryConstants::pageSize;
+    auto ptr = allocator.allocate(size);
+    size_t guardSize = MemoryConstants::pageSize;
+    auto guard = allocator.allocate(guardSize);
+    allocator.free(ptr, size);
+    ASSERT_EQ(1u, allocator.freedChunks.size());
+
+    size_t smallSize = MemoryConstants::pageSize;
+    auto splitPtr = allocator.allocate(smallSize);
+    EXPECT_EQ(MemoryConstants::pageSize, smallSize);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(ptr) + size - smallSize, reinterpret_cast<uintptr_t>(splitPtr));
+    ASSERT_EQ(1u, allocator.freedChunks.size());
+    EXPECT_EQ(size - smallSize, allocator.freedChunks.begin()->second);
+    EXPECT_EQ(1u, allocator.freedChunksBySize.count(std::make_pair(static_cast<uint64_t>(size - smallSize), static_cast<uint64_t>(reinterpret_cast<uintptr_t>(ptr)))));
+
+    allocator.free(splitPtr, smallSize);
+    allocator.free(guard, guardSize);
+}
+
+TEST(SegregatedHeapAllocatorTest, givenAdjacentFreedChunksWhenStoredThenTheyAreCoalesced) {
+    SegregatedHeapAllocatorUnderTest allocator(reinterpret_cast<void *>(heapBase), heapSize, static_cast<size_t>(heapSize));
+
+    size_t size = (SegregatedHeapAllocator::numSizeClasses + 1) * MemoryConstants::pageSize;
+    void *ptrs[3];
+    size_t sizes[3] = {size, size, size};
+    for (auto i = 0; i < 3; i++) {
+        ptrs[i] = allocator.allocate(sizes[i]);
+    }
+    size_t guardSize = MemoryConstants::pageSize;
+    auto guard = allocator.allocate(guardSize);
+
+    allocator.free(ptrs[0], sizes[0]);
+    allocator.free(ptrs[2], sizes[2]);
+    EXPECT_EQ(2u, allocator.freedChunks.size());
+    allocator.free(ptrs[1], sizes[1]);
+    ASSERT_EQ(1u, allocator.freedChunks.size());
+    EXPECT_EQ(3 * size, allocator.freedChunks.begin()->second);
+    EXPECT_EQ(1u, allocator.freedChunksBySize.size());
+
+    allocator.free(guard, guardSize);
+    EXPECT_TRUE(allocator.freedChunks.empty());
+    EXPECT_EQ(heapBase + heapSize, allocator.pRightBound);
+}
+
+TEST(SegregatedHeapAllocatorTest, givenChunksParkedInSizeClassesWhenHeapIsExhaustedThenTheyAreCoalescedToSatisfyRequest) {
+    SegregatedHeapAllocatorUnderTest allocator(reinterpret_cast<void *>(heapBase), 8 * MemoryConstants::pageSize, threshold);
+
+    void *ptrs[8];
+    for (auto &ptr : ptrs) {
+        size_t size = MemoryConstants::pageSize;
+        ptr = allocator.allocate(size);
+        ASSERT_NE(nullptr, ptr);
+    }
+    for (auto i = 1; i < 7; i++) {
+        allocator.free(ptrs[i], MemoryConstants::pageSize);
+    }
+    EXPECT_EQ(6u, allocator.sizeClasses[1].size());
+
+    size_t bigSize = 6 * MemoryConstants::pageSize;
+    auto bigPtr = allocator.allocate(bigSize);
+    EXPECT_EQ(ptrs[6], bigPtr);
+    EXPECT_TRUE(allocator.sizeClasses[1].empty());
+
+    allocator.free(bigPtr, bigSize);
+    allocator.free(ptrs[0], MemoryConstants::pageSize);
+    allocator.free(ptrs[7], MemoryConstants::pageSize);
+    allocator.flushSizeClasses();
+    EXPECT_EQ(allocator.pLeftBound, allocator.pRightBound - 8 * MemoryConstants::pageSize);
+}
+
+TEST(SegregatedHeapAllocatorTest, givenRequestBiggerThanAvailableSizeWhenAllocatingThenNullptrIsReturned) {
+    SegregatedHeapAllocatorUnderTest allocator(reinterpret_cast<void *>(heapBase), heapSize, threshold);
+
+    size_t size = static_cast<size_t>(heapSize) + MemoryConstants::pageSize;
+    EXPECT_EQ(nullptr, allocator.allocate(size));
+}
+
+TEST(SegregatedHeapAllocatorTest, givenRandomAllocationsAndFreesWhenAllIsFreedThenWholeHeapIsAvailableAndNoAllocationsOverlapped) {
+    const uint64_t size = 256 * MemoryConstants::megaByte;
+    SegregatedHeapAllocatorUnderTest allocator(reinterpret_cast<void *>(heapBase), size, threshold);
+    std::map<uint64_t, size_t> allocations;
+    std::mt19937 generator(0);
+
+    for (auto i = 0; i < 20000; i++) {
+        if (allocations.size() < 500 || (generator() % 2)) {
+            size_t allocationSize = ((generator() % 32) + 1) * MemoryConstants::pageSize;
+            auto ptr = reinterpret_cast<uintptr_t>(allocator.allocate(allocationSize));
+            if (ptr == 0) {
+                continue;
+            }
+            auto next = allocations.lower_bound(ptr);
+            if (next != allocations.end()) {
+                ASSERT_LE(ptr + allocationSize, next->first);
+            }
+            if (next != allocations.begin()) {
+                auto prev = std::prev(next);
+                ASSERT_LE(prev->first + prev->second, ptr);
+            }
+            allocations[ptr] = allocationSize;
+        } else {
+            auto it = allocations.begin();
+            std::advance(it, generator() % allocations.size());
+            allocator.free(reinterpret_cast<void *>(static_cast<uintptr_t>(it->first)), it->second);
+            allocations.erase(it);
+        }
+    }
+
+    for (auto &allocation : allocations) {
+        allocator.free(reinterpret_cast<void *>(static_cast<uintptr_t>(allocation.first)), allocation.second);
+    }
+    allocator.flushSizeClasses();
+
+    EXPECT_EQ(size, allocator.getLeftSize());
+    EXPECT_TRUE(allocator.freedChunks.empty());
+    EXPECT_TRUE(allocator.freedChunksBySize.empty());
+    EXPECT_EQ(heapBase, allocator.pLeftBound);
+    EXPECT_EQ(heapBase + size, allocator.pRightBound);
+}
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017, Intel Corporation
+ * Copyright (c) 2017 - 2018, Intel Corporation
  *
  * Permission is hereby granted, free of charge, to any person obtaining a
  * copy of this software and associated documentation files (the "Software"),
@@ -24,6 +24,8 @@
 #include "gtest/gtest.h"
 #include "runtime/utilities/tag_allocator.h"
 #include "unit_tests/fixtures/memory_allocator_fixture.h"
+#include "unit_tests/helpers/debug_manager_state_restore.h"
+#include "unit_tests/mocks/mock_csr.h"
 
 #include <cstdint>
 
@@ -47,15 +49,33 @@ class MockTagAllocator : public TagAllocator<timeStamps> {
     }
 
     TagNode<timeStamps> *getFreeTagsHead() {
-        return TagAllocator<timeStamps>::freeTags.peekHead();
+        auto link = static_cast<uint32_t>(freeTagsHead.load());
+        return link ? getNodeFromLink(link) : nullptr;
     }
 
     TagNode<timeStamps> *getUsedTagsHead() {
         return TagAllocator<timeStamps>::usedTags.peekHead();
     }
 
-    IDList<TagNode<timeStamps>> &getFreeTags() {
-        return TagAllocator<timeStamps>::freeTags;
+    bool freeTagsContain(TagNode<timeStamps> *node) {
+        auto link = static_cast<uint32_t>(freeTagsHead.load());
+        while (link) {
+            auto freeNode = getNodeFromLink(link);
+            if (freeNode == node) {
+                return true;
+            }
+            link = freeNode->nextFree.load();
+        }
+        return false;
+    }
+
+    bool pendingTagsContain(TagNode<timeStamps> *node) {
+        for (auto pendingNode = pendingTags.load(); pendingNode; pendingNode = pendingNode->nextPending) {
+            if (pendingNode == node) {
+                return true;
+            }
+        }
+        return false;
     }
 
     IDList<TagNode<timeStamps>> &getUsedTags() {
@@ -86,6 +106,8 @@ TEST_F(TagAllocatorTest, Initialize) {
 }
 
 TEST_F(TagAllocatorTest, GetReturnTagCheckFreeAndUsedLists) {
+    DebugManagerStateRestore dbgRestore;
+    DebugManager.flags.TrackUsedTags.set(true);
 
     MockTagAllocator<> tagAllocator(memoryManager, 10, 16);
 
@@ -97,11 +119,10 @@ TEST_F(TagAllocatorTest, GetReturnTagCheckFreeAndUsedLists) {
 
     EXPECT_NE(nullptr, tagNode);
 
-    IDList<TagNode<timeStamps>> &freeList = tagAllocator.getFreeTags();
     IDList<TagNode<timeStamps>> &usedList = tagAllocator.getUsedTags();
 
     bool isFoundOnUsedList = usedList.peekContains(*tagNode);
-    bool isFoundOnFreeList = freeList.peekContains(*tagNode);
+    bool isFoundOnFreeList = tagAllocator.freeTagsContain(tagNode);
 
     EXPECT_FALSE(isFoundOnFreeList);
     EXPECT_TRUE(isFoundOnUsedList);
@@ -109,12 +130,24 @@ TEST_F(TagAllocatorTest, GetReturnTagCheckFreeAndUsedLists) {
     tagAllocator.returnTag(tagNode);
 
     isFoundOnUsedList = usedList.peekContains(*tagNode);
-    isFoundOnFreeList = freeList.peekContains(*tagNode);
+    isFoundOnFreeList = tagAllocator.freeTagsContain(tagNode);
 
     EXPECT_TRUE(isFoundOnFreeList);
     EXPECT_FALSE(isFoundOnUsedList);
 }
 
+TEST_F(TagAllocatorTest, givenUsedTagsTrackingDisabledWhenTagIsTakenThenUsedListIsNotUpdated) {
+    MockTagAllocator<> tagAllocator(memoryManager, 10, 16);
+
+    TagNode<timeStamps> *tagNode = tagAllocator.getTag();
+    ASSERT_NE(nullptr, tagNode);
+    EXPECT_EQ(nullptr, tagAllocator.getUsedTagsHead());
+    EXPECT_FALSE(tagAllocator.freeTagsContain(tagNode));
+
+    tagAllocator.returnTag(tagNode);
+    EXPECT_EQ(tagNode, tagAllocator.getFreeTagsHead());
+}
+
 TEST_F(TagAllocatorTest, TagAlignment) {
 
     size_t alignment = 64;
@@ -168,24 +201,23 @@ TEST_F(TagAllocatorTest, GetTagsAndReturnInDifferentOrder) {
     TagNode<timeStamps> *nullTag = tagAllocator.getTag();
     EXPECT_EQ(nullptr, nullTag);
 
-    IDList<TagNode<timeStamps>> &freeList = tagAllocator.getFreeTags();
-    bool isFoundOnFreeList = freeList.peekContains(*tagNodes[0]);
+    bool isFoundOnFreeList = tagAllocator.freeTagsContain(tagNodes[0]);
     EXPECT_FALSE(isFoundOnFreeList);
 
     tagAllocator.returnTag(tagNodes[2]);
-    isFoundOnFreeList = freeList.peekContains(*tagNodes[2]);
+    isFoundOnFreeList = tagAllocator.freeTagsContain(tagNodes[2]);
     EXPECT_TRUE(isFoundOnFreeList);
     EXPECT_NE(nullptr, tagAllocator.getFreeTagsHead());
 
     tagAllocator.returnTag(tagNodes[3]);
-    isFoundOnFreeList = freeList.peekContains(*tagNodes[3]);
+    isFoundOnFreeList = tagAllocator.freeTagsContain(tagNodes[3]);
     EXPECT_TRUE(isFoundOnFreeList);
 
     tagAllocator.returnTag(tagNodes[1]);
-    isFoundOnFreeList = freeList.peekContains(*tagNodes[1]);
+    isFoundOnFreeList = tagAllocator.freeTagsContain(tagNodes[1]);
     EXPECT_TRUE(isFoundOnFreeList);
 
-    isFoundOnFreeList = freeList.peekContains(*tagNodes[0]);
+    isFoundOnFreeList = tagAllocator.freeTagsContain(tagNodes[0]);
     EXPECT_FALSE(isFoundOnFreeList);
 
     tagAllocator.returnTag(tagNodes[0]);
@@ -245,3 +277,36 @@ TEST_F(TagAllocatorTest, CleanupResources) {
     EXPECT_EQ(0u, tagAllocator.getGraphicsAllocationsCount());
     EXPECT_EQ(0u, tagAllocator.getTagPoolCount());
 }
+
+TEST_F(TagAllocatorTest, givenTagReturnedBeforeItsTaskCompletedWhenTagsRunOutThenItIsReusedOnlyAfterCompletion) {
+    uint32_t gpuTag = 1;
+    MockCommandStreamReceiver csr;
+    csr.tagAddress = &gpuTag;
+    memoryManager->csr = &csr;
+
+    // Big alignment to force only 1 tag
+    size_t alignment = 4096;
+    MockTagAllocator<2> tagAllocator(memoryManager, 1, alignment);
+
+    TagNode<timeStamps> *tagNode1 = tagAllocator.getTag();
+    ASSERT_NE(nullptr, tagNode1);
+
+    tagAllocator.returnTagWhenCompleted(tagNode1, 2);
+    EXPECT_TRUE(tagAllocator.pendingTagsContain(tagNode1));
+    EXPECT_FALSE(tagAllocator.freeTagsContain(tagNode1));
+
+    TagNode<timeStamps> *tagNode2 = tagAllocator.getTag();
+    ASSERT_NE(nullptr, tagNode2);
+    EXPECT_NE(tagNode1, tagNode2);
+    EXPECT_EQ(nullptr, tagAllocator.getTag());
+
+    gpuTag = 2;
+    EXPECT_EQ(tagNode1, tagAllocator.getTag());
+    EXPECT_FALSE(tagAllocator.pendingTagsContain(tagNode1));
+
+    tagAllocator.returnTagWhenCompleted(tagNode1, 1);
+    EXPECT_TRUE(tagAllocator.freeTagsContain(tagNode1));
+    tagAllocator.returnTag(tagNode2);
+
+    memoryManager->csr = nullptr;
+}
@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/utilities/worker_pool.h"
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace OCLRT;
+
+TEST(WorkerPool, givenDefaultWorkerCountWhenCreatedThenItIsBelowHardwareConcurrencyAndCapped) {
+    WorkerPool pool(-1);
+    EXPECT_LE(pool.getNumWorkers(), WorkerPool::maxDefaultWorkers);
+    EXPECT_LT(pool.getNumWorkers(), std::max(std::thread::hardware_concurrency(), 1u));
+}
+
+TEST(WorkerPool, givenNoWorkersWhenParallelForIsCalledThenAllTasksRunOnCallingThread) {
+    WorkerPool pool(0);
+    auto callingThread = std::this_thread::get_id();
+    std::vector<int> executed(100, 0);
+    pool.parallelFor(executed.size(), [&](size_t taskIndex) {
+        EXPECT_EQ(callingThread, std::this_thread::get_id());
+        executed[taskIndex]++;
+    });
+    for (auto count : executed) {
+        EXPECT_EQ(1, count);
+    }
+}
+
+TEST(WorkerPool, givenWorkersWhenManyJobsAreRunThenEachTaskRunsExactlyOnce) {
+    WorkerPool pool(3);
+    std::vector<std::atomic<int>> executed(257);
+    for (int job = 0; job < 200; job++) {
+        for (auto &count : executed) {
+            count = 0;
+        }
+        pool.parallelFor(executed.size(), [&](size_t taskIndex) {
+            executed[taskIndex]++;
+        });
+        for (auto &count : executed) {
+            EXPECT_EQ(1, count.load());
+        }
+    }
+}
+
+TEST(WorkerPool, givenTaskCallingParallelForWhenRunThenNestedTasksRunInlineWithoutDeadlock) {
+    WorkerPool pool(2);
+    std::atomic<int> nestedTasks{0};
+    pool.parallelFor(4, [&](size_t) {
+        pool.parallelFor(8, [&](size_t) {
+            nestedTasks++;
+        });
+    });
+    EXPECT_EQ(32, nestedTasks.load());
+}
+
+TEST(WorkerPool, givenConcurrentCallersWhenParallelForIsCalledThenAllTasksComplete) {
+    WorkerPool pool(2);
+    std::atomic<int> tasks{0};
+    std::vector<std::thread> callers;
+    for (int i = 0; i < 4; i++) {
+        callers.emplace_back([&]() {
+            for (int job = 0; job < 50; job++) {
+                pool.parallelFor(16, [&](size_t) {
+                    tasks++;
+                });
+            }
+        });
+    }
+    for (auto &caller : callers) {
+        caller.join();
+    }
+    EXPECT_EQ(4 * 50 * 16, tasks.load());
+}
+
+TEST(WorkerPool, givenShutdownPoolWhenParallelForIsCalledThenWorkersAreRestarted) {
+    WorkerPool pool(2);
+    std::atomic<int> tasks{0};
+    pool.parallelFor(10, [&](size_t) { tasks++; });
+    pool.shutdown();
+    pool.shutdown();
+    pool.parallelFor(10, [&](size_t) { tasks++; });
+    EXPECT_EQ(20, tasks.load());
+}